@@ -15,7 +15,7 @@ declare -A MODULE_LIST_PER_PLATFORM=(
 ['linux_x86_64']="matrix_sdk vrp_sdk vp_sdk "
 )
 
-LINUX_APPS="vrp_run_bare_app vrp_test_solver "
+LINUX_APPS="vrp_run_bare_app vrp_test_solver vrp_matrix_converter "
 
 
 SELECTED_PLATFORM_LIST=""
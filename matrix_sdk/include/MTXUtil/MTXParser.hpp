@@ -32,8 +32,12 @@ namespace MTXParser {
      * Function used to parse and MTX file and generate a CSR matrix.
      * Real an Complex values are supported.
      * Indeces in matrix are 1-based
+     * Symmetric matrices are expanded to full storage, unless a_symmetric_half is set: the lower triangle of real
+     * symmetric matrices is then kept alone (crs_t::SYMMETRIC_HALF).
+     * The file is memory mapped and split in line aligned chunks parsed in parallel; the CSR is then built with a
+     * counting sort on the rows. A cell given several times keeps its first value.
      */
-    crs_t* parseFileToCRS(std::string a_mtx_file_path);
+    crs_t* parseFileToCRS(std::string a_mtx_file_path, bool a_symmetric_half = false);
 
     /*
      * Display CSR matrice with 1-based indeces.
@@ -33,6 +33,8 @@ typedef struct crs {
   /* valide uniquement pour des matrices en double !! */
   csr_value_type_t VALUE_TYPE; 
   int M,N, NZNUM;
+  /* 1 quand seul le triangle inferieur d'une matrice symetrique est stocke */
+  int SYMMETRIC_HALF;
   int * COL_IND; 
   int * ROW_PTR;
   double *VAL;
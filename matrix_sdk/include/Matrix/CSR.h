@@ -75,4 +75,10 @@ typedef struct __dmatCSR_t {
 
 typedef _dmatCSR_t * dmatCSR_t;
 
+/**
+ *  Symmetric matrices may be stored as a single triangle, the other one being implied: the lower one when only
+ *  stored.is_lower is set, the upper one when only stored.is_upper is set. Both flags are set for full storage.
+ */
+#define CSR_IS_SYMMETRIC_HALF(csr) ( (csr)->stored.is_upper != (csr)->stored.is_lower )
+
 #endif /* _CSR_H_ */
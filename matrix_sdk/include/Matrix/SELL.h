@@ -0,0 +1,56 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : SELL-C-sigma (sliced ELLPACK) sparse matrix format.
+ **/
+
+#ifndef _SELL_H_
+#define _SELL_H_
+
+/**
+ *  SELL-C-sigma format
+ *  Double precision
+ *
+ *  Rows are sorted by decreasing number of non zero values inside windows of sort_window rows, then grouped in
+ *  chunks of chunk_size consecutive sorted rows. A chunk is stored column major with the width of its longest row:
+ *  the j-th non zero value of the r-th row of chunk c is at chunk_ptr[c] + j * chunk_size + r in ind and val, so
+ *  consecutive rows of a chunk are at a stride of 1.
+ *
+ *  Shorter rows are padded with 0.0 values whose column index is the one of the last non zero value of the row (0
+ *  for empty rows), so kernels may process the whole chunk width without testing the row length. The last chunk is
+ *  completed with empty rows whose perm entry is -1.
+ *
+ *  All indices are 0-based.
+ */
+typedef struct __dmatSELL_t {
+    int chunk_size;     // C
+    int sort_window;    // sigma
+
+    int num_chunks;
+
+    int * chunk_ptr;    // num_chunks + 1 offsets in ind and val
+    int * row_len;      // number of non zero values of each sorted row (num_chunks * chunk_size)
+    int * perm;         // row of the matrix stored at each sorted row (num_chunks * chunk_size)
+
+    int * ind;
+    double * val;
+} _dmatSELL_t;
+
+typedef _dmatSELL_t * dmatSELL_t;
+
+#endif /* _SELL_H_ */
@@ -52,7 +52,8 @@ typedef enum types {
     GCSR,
     DENSE,
     MBCSR,
-    VBR
+    VBR,
+    SELL
 } types_e;
 
 typedef enum types_value {
@@ -92,8 +93,48 @@ typedef _matrix_t * matrix_t;
 
 matrix_t buildCSR(int a_num_rows, int a_num_cols, int * a_row_ptr, int * a_col_ind, double * a_val, int a_base_index);
 matrix_t buildComplexCSR(int a_num_rows, int a_num_cols, int * a_row_ptr, int * a_col_ind, complex_value_t * a_val, int a_base_index);
+/**
+ *  Builds a CSR matrix storing a single triangle of a symmetric matrix: the lower one (column <= row) when a_uplo is
+ *  'L', the upper one when a_uplo is 'U'. The other triangle is implied by the products.
+ */
+matrix_t buildSymmetricCSR(int a_num_rows, int * a_row_ptr, int * a_col_ind, double * a_val, int a_base_index, char a_uplo);
 matrix_t buildDiagCSR(int a_num_rows, double * a_val, int a_base_index);
 
+/**
+ *  Builds a SELL-C-sigma copy of a real CSR matrix, with chunks of a_chunk_size rows sorted inside windows of
+ *  a_sort_window rows (1 to keep the rows in their order). Returns NULL on failure.
+ */
+matrix_t buildSELL(matrix_t a_csr_matrix, int a_chunk_size, int a_sort_window);
+
+/**
+ *  Reorderings of square real CSR matrices, computed on the structure of A + A^T. They return a permutation to free
+ *  by the caller, a_permutation[i] being the row (0-based) of the matrix moved to row i, or NULL on failure.
+ *
+ *  reorderRCM reduces the bandwidth with the Reverse Cuthill-McKee ordering. reorderPartition splits the rows in
+ *  a_nb_parts parts of connected rows by recursive bisection of breadth first orderings, each part being numbered
+ *  consecutively.
+ */
+int * reorderRCM(matrix_t a_csr_matrix);
+int * reorderPartition(matrix_t a_csr_matrix, int a_nb_parts);
+
+/**
+ *  Builds the symmetric permutation P A P^T of a real CSR matrix: the value (a_permutation[i], a_permutation[j]) of
+ *  the matrix moves to (i, j). Half stored symmetric matrices keep the same stored triangle. Returns NULL on
+ *  failure.
+ */
+matrix_t permuteCSR(matrix_t a_csr_matrix, const int * a_permutation);
+
+/**
+ *  Largest distance between a non zero value and the diagonal.
+ */
+int getCSRBandwidth(matrix_t a_csr_matrix);
+
+/**
+ *  a_permuted_x = P a_x and a_x = P^T a_permuted_x: right hand sides and solutions of P A P^T systems.
+ */
+void permuteVector(int a_n, const int * a_permutation, const double * a_x, double * a_permuted_x);
+void unpermuteVector(int a_n, const int * a_permutation, const double * a_permuted_x, double * a_x);
+
 void displayMatrix(matrix_t a_matrix, int a_display_precision);
 int displayMatrixCharacteristics(matrix_t a_matrix);
 void displayCSRStruct(matrix_t a_matrix, int a_display_precision);
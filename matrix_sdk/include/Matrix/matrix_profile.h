@@ -0,0 +1,125 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Structure analysis of CSR matrices and storage format recommendation.
+ **/
+
+#ifndef __MATRIX_PROFILE_H__
+#define __MATRIX_PROFILE_H__
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Largest BCSR block shape analyzed, the largest block rows the VRP BCSR kernels handle.
+ */
+#define MATRIX_PROFILE_MAX_BLOCK_SIZE 8
+
+/**
+ *  Row length histogram: bucket 0 counts the empty rows, bucket k the rows with a length in [2^(k-1), 2^k), the
+ *  last bucket the longer rows.
+ */
+#define MATRIX_PROFILE_HISTOGRAM_SIZE 16
+
+/**
+ *  SELL-C-sigma shape of the recommendation: chunks of 8 rows match the VRP SELL kernel.
+ */
+#define MATRIX_PROFILE_SELL_CHUNK_SIZE 8
+#define MATRIX_PROFILE_SELL_SORT_WINDOW 256
+
+/**
+ *  Density from which the DENSE format is recommended.
+ */
+#define MATRIX_PROFILE_DENSE_THRESHOLD 0.3
+
+typedef struct matrix_profile {
+    int m;
+    int n;
+    int64_t nnz;                        // non zero values of the whole matrix
+    int symmetric_half;                 // half stored symmetric matrix, analyzed with its implied triangle
+
+    /* Row lengths */
+    int min_row_length;
+    int max_row_length;
+    double mean_row_length;
+    double row_length_stddev;
+    int64_t row_length_histogram[MATRIX_PROFILE_HISTOGRAM_SIZE];
+
+    /* Bandwidth and profile (sum over the rows of the distance between the first non zero value and the diagonal) */
+    int bandwidth;
+    int64_t profile;
+
+    /* Diagonal dominance: |a_ii| >= sum_j!=i |a_ij| (weak) or > (strict) */
+    int64_t nb_weakly_dominant_rows;
+    int64_t nb_strictly_dominant_rows;
+    int64_t nb_zero_diagonal_rows;
+    int is_diagonally_dominant;
+
+    /* Symmetry: same structure, and same values */
+    int is_structurally_symmetric;
+    int is_numerically_symmetric;
+
+    /* Stored values per non zero value for each r x c BCSR shape, bcsr_fill[r - 1][c - 1] */
+    double bcsr_fill[MATRIX_PROFILE_MAX_BLOCK_SIZE][MATRIX_PROFILE_MAX_BLOCK_SIZE];
+    double sell_fill;
+
+    /*
+     * Estimated bytes moved per flop (2 flops per non zero value) by a product y = A x: the matrix arrays, one load
+     * of an x element per non zero value (per block column for BCSR) and one load and store of the y elements.
+     */
+    size_t x_element_size;
+    double csr_bytes_per_flop;
+    double bcsr_bytes_per_flop[MATRIX_PROFILE_MAX_BLOCK_SIZE][MATRIX_PROFILE_MAX_BLOCK_SIZE];
+    double sell_bytes_per_flop;
+    double dense_bytes_per_flop;
+
+    /* Recommendation */
+    types_e recommended_format;
+    int recommended_block_row_size;     // BCSR
+    int recommended_block_col_size;
+    int recommended_chunk_size;         // SELL
+    int recommended_sort_window;
+} matrix_profile_t;
+
+/**
+ *  Analyzes a real CSR matrix and fills a_profile. a_x_element_size is the size in bytes of the elements of the
+ *  vectors the matrix is multiplied with: 8 for doubles, (precision + exponent size + stride size) / 8 for VPFloat
+ *  arrays. Returns 0 on success.
+ *
+ *  The recommendation is DENSE above MATRIX_PROFILE_DENSE_THRESHOLD, else the BCSR shape moving the fewest bytes per
+ *  flop when it saves 10% over CSR, else SELL when padding costs less than 10%, else CSR. Half stored symmetric
+ *  matrices are only supported by CSR.
+ */
+int analyzeMatrix(matrix_t a_csr_matrix, size_t a_x_element_size, matrix_profile_t * a_profile);
+
+/**
+ *  Writes a profile as a JSON object.
+ */
+void writeMatrixProfileJSON(const matrix_profile_t * a_profile, FILE * a_stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MATRIX_PROFILE_H__ */
@@ -39,13 +39,48 @@ typedef struct {
     } oski_matrix;
 } oski_matrix_wrapper_t;
 
+/*
+ * Largest block row and column sizes considered by the BCSR autotuning (VRP BCSR kernels handle up to 8 rows per block).
+ */
+#define OSKIHELPER_BCSR_MAX_BLOCK_SIZE 8
+
+/*
+ * Time, in seconds, of one sparse matrix vector product with a_bcsr_matrix.
+ */
+typedef double (*bcsr_benchmark_t)(matrix_t a_bcsr_matrix, void * a_args);
+
+/*
+ * Cost per stored value (explicit zeros included) of a product with a BCSR matrix, for each r x c block shape.
+ */
+typedef struct {
+    int max_block_row_size;
+    int max_block_col_size;
+    double cost_per_value[OSKIHELPER_BCSR_MAX_BLOCK_SIZE][OSKIHELPER_BCSR_MAX_BLOCK_SIZE];
+} bcsr_profile_t;
+
 namespace VPFloatPackage::OSKIHelper {  
-    oski_matrix_wrapper_t loadFromFile(char * a_file_path);    
+    // With a_symmetric_half, real symmetric matrices keep their lower triangle only (see CSR_IS_SYMMETRIC_HALF)
+    oski_matrix_wrapper_t loadFromFile(char * a_file_path, bool a_symmetric_half=false);
 
     oski_matrix_wrapper_t fromCSRMatrix(matrix_t a_matrix);
 
     matrix_t toBCSR(oski_matrix_wrapper_t a_sparse_matrix, int a_block_row_size, int a_block_col_size);
 
+    /*
+     * BCSR autotuning: the block shape minimizing fill(r, c) * cost_per_value(r, c) is chosen, the fill ratio (stored
+     * values per non zero value) being estimated on a sample of the block rows of the matrix and the cost per value
+     * being measured once on a dense matrix, which has no fill whatever the shape.
+     */
+    double estimateBCSRFill(oski_matrix_wrapper_t a_sparse_matrix, int a_block_row_size, int a_block_col_size, double a_sampling_fraction=0.02);
+
+    bcsr_profile_t benchmarkBCSR(int a_max_block_row_size, int a_max_block_col_size, int a_dense_size, bcsr_benchmark_t a_benchmark, void * a_args);
+
+    // Returns the estimated cost per non zero value of the chosen shape
+    double tuneBCSR(oski_matrix_wrapper_t a_sparse_matrix, const bcsr_profile_t & a_profile, int * a_block_row_size, int * a_block_col_size, double a_sampling_fraction=0.02);
+
+    // SELL-C-sigma copy of the input CSR matrix (see buildSELL), real matrices only
+    matrix_t toSELL(oski_matrix_wrapper_t a_sparse_matrix, int a_chunk_size, int a_sort_window);
+
     oski_matrix_wrapper_t transpose(oski_matrix_wrapper_t a_matrix);
 
     // ATTENTION : OSKI convert DENSE matrices to Column Major format
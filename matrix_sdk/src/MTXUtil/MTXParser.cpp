@@ -24,224 +24,483 @@
 #include <iostream>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <climits>
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <utility>
 
-/******************************************************************************
- * Internal structure definitions
- *****************************************************************************/
-// Structure defined to map memory to a complex number
-typedef struct zcomplex {
-  double real;
-  double imag;
-} zcomplex_t;
-
-// Structure describing matrix cell meta information
-typedef struct cell_meta {
-  int col_index;
-  double * value;
-  struct cell_meta * next;
-} cell_meta_t;
-
-// Structure describing matrix row meta information
-typedef struct row_meta {
-  int row_index;
-  int nb_elements_in_row;
-  struct row_meta * next;
-  cell_meta_t * first_cell;
-  cell_meta_t * last_cell;
-} row_meta_t;
-
-// Structure describing matrix meta information
-typedef struct mtx_meta {
-  int non_empty_row_count;
-  int nb_rows;
-  int nb_cols;
-  int nb_non_zero_elements; 
-  bool complex;
-  row_meta_t * row_metas;
-  row_meta_t * last_row_meta;
-} mtx_meta_t;
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /******************************************************************************
- * Internal functions definitions
+ * Internal structure definitions
  *****************************************************************************/
 /*
- * Initialization function for the matrix meta information structure
- */
-void mtx_meta_init(mtx_meta_t * a_mtx_meta);
-
-/*
- * Function release memory used by matrix meta information structure and other linked structures.
- */
-void mtx_meta_clear(mtx_meta_t * a_mtx_meta);
-
-/*
- * Function used to linked a cell meta information structure to a row
+ * Smallest part of the file parsed by a thread: small files are parsed by a single thread.
  */
-bool row_meta_add_cell(mtx_meta_t * a_mtx_meta, row_meta_t * a_row_meta, cell_meta_t * a_cell_meta, int a_col_index, double * a_real);
+#define MTX_PARSER_MIN_CHUNK_BYTES (1 << 20)
 
 /*
- * Function that returns the structure containing meta information for a desired row of the matrix.
- * If needed the row meta information structure is created and initialized. This occures on first row retrieve.
+ * Longest number handed to strtod when the fast path of parse_double can not be used.
  */
-row_meta_t * mtx_meta_get_row_index(mtx_meta_t * a_mtx_meta, int a_new_index);
+#define MTX_PARSER_MAX_NUMBER_LENGTH 128
+
+// Structure describing the content of the file, as given by its banner and size line
+typedef struct mtx_layout {
+    int nb_rows;
+    int nb_cols;
+    int64_t nb_entries;     // number of entries written in the file
+    bool coordinate;        // false for array (dense column major) files
+    bool complex;
+    bool pattern;
+    bool symmetric;
+    bool symmetric_half;
+} mtx_layout_t;
+
+// Structure holding the entries parsed from a line aligned part of the file, in file order
+typedef struct mtx_chunk {
+    const char * begin;
+    const char * end;
+    std::vector<int> rows;          // 1-based, not filled for array files
+    std::vector<int> cols;          // 1-based, not filled for array files
+    std::vector<double> values;     // 2 values per entry for complex matrices
+    int64_t nb_entries;
+    bool failed;
+} mtx_chunk_t;
 
+/******************************************************************************
+ * Internal functions definitions
+ *****************************************************************************/
 /*
- * Debug function used to display matrix meta information content
+ * Function parsing the lines of a chunk. Comment and blank lines are skipped.
  */
-void display_mtx_meta(mtx_meta_t * a_mtx_meta);
+void mtx_chunk_parse(const mtx_layout_t * a_layout, mtx_chunk_t * a_chunk);
 
 /*
- * Function used to generate the CSR matrix structure from matrix meta information.
+ * Function used to generate the CSR matrix structure from the parsed chunks, with a counting sort on the rows.
  */
-crs_t * build_crs_matrix_from_meta(mtx_meta_t * a_mtx_meta);
+crs_t * build_crs_matrix_from_chunks(const mtx_layout_t * a_layout, std::vector<mtx_chunk_t> & a_chunks);
 
 
 /******************************************************************************
  * Internal functions implementation
  *****************************************************************************/
 
-void mtx_meta_init(mtx_meta_t * a_mtx_meta) {
-    a_mtx_meta->nb_rows = 0;
-    a_mtx_meta->nb_cols = 0;
-    a_mtx_meta->nb_non_zero_elements = 0;
-    a_mtx_meta->complex = false;
-    a_mtx_meta->non_empty_row_count = 0;
-    a_mtx_meta->row_metas = NULL;
-    a_mtx_meta->last_row_meta = NULL;
+static inline bool is_blank(char a_char) {
+    return ( a_char == ' ' ) || ( a_char == '\t' ) || ( a_char == '\r' );
 }
 
-void mtx_meta_clear(mtx_meta_t * a_mtx_meta) {
-    row_meta_t * l_current_row_meta = a_mtx_meta->row_metas;
-    row_meta_t * l_next_row_meta = NULL;
+static inline bool is_number_end(const char * a_cursor, const char * a_end) {
+    return ( a_cursor == a_end ) || is_blank(*a_cursor) || ( *a_cursor == '\n' );
+}
 
-    while ( l_current_row_meta != NULL) {
-        l_next_row_meta = l_current_row_meta->next;
-        free(l_current_row_meta);
-        l_current_row_meta = l_next_row_meta;
+static inline const char * skip_blanks(const char * a_cursor, const char * a_end) {
+    while ( ( a_cursor < a_end ) && is_blank(*a_cursor) ) {
+        a_cursor++;
     }
+
+    return a_cursor;
 }
 
-void display_mtx_meta(mtx_meta_t * a_mtx_meta) {
-  row_meta_t * l_current_row_meta = a_mtx_meta->row_metas;
+static inline const char * skip_line(const char * a_cursor, const char * a_end) {
+    const char * l_new_line = (const char *)memchr(a_cursor, '\n', a_end - a_cursor);
+
+    return ( l_new_line == NULL ) ? a_end : l_new_line + 1;
+}
 
-  while ( l_current_row_meta != NULL ) {
-    printf("%d => count : %d\n",
-        l_current_row_meta->row_index,
-        l_current_row_meta->nb_elements_in_row);
-    l_current_row_meta = l_current_row_meta->next;
-  }
+/*
+ * Parses a decimal integer starting at a_cursor. The file is not null terminated: a_end is never read.
+ */
+static bool parse_int(const char ** a_cursor, const char * a_end, int * a_value) {
+    const char * l_cursor = skip_blanks(*a_cursor, a_end);
+    const char * l_digits;
+    int64_t l_value = 0;
+    bool l_negative = false;
+
+    if ( ( l_cursor < a_end ) && ( ( *l_cursor == '-' ) || ( *l_cursor == '+' ) ) ) {
+        l_negative = ( *l_cursor == '-' );
+        l_cursor++;
+    }
 
-  printf("real row count : %d\n", a_mtx_meta->non_empty_row_count);
+    l_digits = l_cursor;
+    while ( ( l_cursor < a_end ) && ( *l_cursor >= '0' ) && ( *l_cursor <= '9' ) ) {
+        l_value = l_value * 10 + ( *l_cursor - '0' );
+        if ( l_value > INT_MAX ) {
+            return false;
+        }
+        l_cursor++;
+    }
+
+    if ( ( l_cursor == l_digits ) || ( ! is_number_end(l_cursor, a_end) ) ) {
+        return false;
+    }
+
+    *a_value = (int)( l_negative ? -l_value : l_value );
+    *a_cursor = l_cursor;
+
+    return true;
 }
 
-bool row_meta_add_cell(mtx_meta_t * a_mtx_meta, row_meta_t * a_row_meta, cell_meta_t * a_cell_meta, int a_col_index, double * a_value) {
-    if ( a_row_meta->first_cell == NULL ) {                                     // Insert first element in the list
-        a_cell_meta->col_index = a_col_index;
-        a_cell_meta->value = a_value;
-        a_cell_meta->next = NULL;
-        a_row_meta->first_cell = a_cell_meta;
-        a_row_meta->last_cell = a_cell_meta;
-    } else if ( a_col_index > a_row_meta->last_cell->col_index ) {   // Insert at end
-        a_cell_meta->col_index = a_col_index;
-        a_cell_meta->value = a_value;
-        a_row_meta->last_cell->next = a_cell_meta;
-        a_cell_meta->next = NULL;
-        a_row_meta->last_cell = a_cell_meta;
-    } else if ( a_col_index < a_row_meta->first_cell->col_index ) {  // Insert at begining
-        a_cell_meta->col_index = a_col_index;
-        a_cell_meta->value = a_value;
-        a_cell_meta->next = a_row_meta->first_cell;
-        a_row_meta->first_cell = a_cell_meta;
-    }  else {                                                                    // Insert in list
-        cell_meta_t * l_current_cell = a_row_meta->first_cell;
-        cell_meta_t * l_previous_cell = NULL;
-
-        // Walk through the list to find the right place
-        while ( l_current_cell->col_index < a_col_index ) {
-            l_previous_cell = l_current_cell;
-            l_current_cell = l_current_cell->next;
+/*
+ * Parses a floating point number starting at a_cursor, with the same result than strtod.
+ * Numbers with at most 15 significant digits and a small decimal exponent are exactly converted with a single
+ * rounded multiplication or division by a power of ten; the others are handed to strtod.
+ */
+static bool parse_double(const char ** a_cursor, const char * a_end, double * a_value) {
+    static const double l_powers_of_ten[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char * l_start = skip_blanks(*a_cursor, a_end);
+    const char * l_cursor = l_start;
+    uint64_t l_mantissa = 0;
+    int l_nb_significant_digits = 0;
+    int l_nb_digits = 0;
+    int l_exponent = 0;
+    bool l_negative = false;
+
+    if ( ( l_cursor < a_end ) && ( ( *l_cursor == '-' ) || ( *l_cursor == '+' ) ) ) {
+        l_negative = ( *l_cursor == '-' );
+        l_cursor++;
+    }
+
+    while ( ( l_cursor < a_end ) && ( *l_cursor >= '0' ) && ( *l_cursor <= '9' ) ) {
+        if ( ( l_mantissa != 0 ) || ( *l_cursor != '0' ) ) {
+            l_nb_significant_digits++;
         }
+        if ( l_nb_significant_digits <= 19 ) {
+            l_mantissa = l_mantissa * 10 + ( *l_cursor - '0' );
+        } else {
+            l_exponent++;
+        }
+        l_nb_digits++;
+        l_cursor++;
+    }
 
-        if ( l_current_cell->col_index == a_col_index ) {
-            printf("Warning: cell(%d,%d) already registered. Ignore this occurence\n", a_row_meta->row_index, l_current_cell->col_index);
-            return false;
+    if ( ( l_cursor < a_end ) && ( *l_cursor == '.' ) ) {
+        l_cursor++;
+        while ( ( l_cursor < a_end ) && ( *l_cursor >= '0' ) && ( *l_cursor <= '9' ) ) {
+            if ( ( l_mantissa != 0 ) || ( *l_cursor != '0' ) ) {
+                l_nb_significant_digits++;
+            }
+            if ( l_nb_significant_digits <= 19 ) {
+                l_mantissa = l_mantissa * 10 + ( *l_cursor - '0' );
+                l_exponent--;
+            }
+            l_nb_digits++;
+            l_cursor++;
+        }
+    }
+
+    if ( ( l_nb_digits > 0 ) && ( l_cursor < a_end ) && ( ( *l_cursor == 'e' ) || ( *l_cursor == 'E' ) ) ) {
+        const char * l_exponent_cursor = l_cursor + 1;
+        bool l_negative_exponent = false;
+        int l_exponent_value = 0;
+
+        if ( ( l_exponent_cursor < a_end ) && ( ( *l_exponent_cursor == '-' ) || ( *l_exponent_cursor == '+' ) ) ) {
+            l_negative_exponent = ( *l_exponent_cursor == '-' );
+            l_exponent_cursor++;
+        }
+
+        if ( ( l_exponent_cursor < a_end ) && ( *l_exponent_cursor >= '0' ) && ( *l_exponent_cursor <= '9' ) ) {
+            while ( ( l_exponent_cursor < a_end ) && ( *l_exponent_cursor >= '0' ) && ( *l_exponent_cursor <= '9' ) ) {
+                if ( l_exponent_value < 100000 ) {
+                    l_exponent_value = l_exponent_value * 10 + ( *l_exponent_cursor - '0' );
+                }
+                l_exponent_cursor++;
+            }
+            l_exponent += l_negative_exponent ? -l_exponent_value : l_exponent_value;
+            l_cursor = l_exponent_cursor;
+        }
+    }
+
+    if ( ( l_nb_digits > 0 ) && is_number_end(l_cursor, a_end)
+      && ( l_nb_significant_digits <= 15 ) && ( l_exponent >= -22 ) && ( l_exponent <= 22 ) ) {
+        double l_value = (double)l_mantissa;
+
+        if ( l_exponent < 0 ) {
+            l_value /= l_powers_of_ten[-l_exponent];
         } else {
-            a_cell_meta->col_index = a_col_index;
-            a_cell_meta->value = a_value;
-            l_previous_cell->next = a_cell_meta;
-            a_cell_meta->next = l_current_cell;
+            l_value *= l_powers_of_ten[l_exponent];
         }
+
+        *a_value = l_negative ? -l_value : l_value;
+        *a_cursor = l_cursor;
+
+        return true;
     }
-    
 
+    /*
+     * Slow path (long mantissa, large exponent, inf, nan, hexadecimal...): strtod needs a null terminated copy.
+     */
+    char l_buffer[MTX_PARSER_MAX_NUMBER_LENGTH];
+    char * l_number_end;
+    size_t l_length = 0;
+
+    while ( ! is_number_end(l_start + l_length, a_end) ) {
+        if ( l_length == MTX_PARSER_MAX_NUMBER_LENGTH - 1 ) {
+            return false;
+        }
+        l_length++;
+    }
 
-    a_row_meta->nb_elements_in_row++;
-    a_mtx_meta->nb_non_zero_elements++;
+    if ( l_length == 0 ) {
+        return false;
+    }
+
+    memcpy(l_buffer, l_start, l_length);
+    l_buffer[l_length] = '\0';
+
+    *a_value = strtod(l_buffer, &l_number_end);
+    if ( l_number_end != l_buffer + l_length ) {
+        return false;
+    }
+
+    *a_cursor = l_start + l_length;
 
     return true;
 }
 
-row_meta_t * create_new_row_meta(int a_new_index) {
-    row_meta_t * l_new_row_meta = (row_meta_t *) malloc(sizeof(row_meta_t));
+void mtx_chunk_parse(const mtx_layout_t * a_layout, mtx_chunk_t * a_chunk) {
+    const char * l_cursor = a_chunk->begin;
+    const char * l_end = a_chunk->end;
+    int l_nb_values_per_entry = a_layout->complex ? 2 : 1;
 
-    l_new_row_meta->row_index = a_new_index;
-    l_new_row_meta->nb_elements_in_row = 0;
-    l_new_row_meta->next = NULL;
-    l_new_row_meta->first_cell = NULL;
-    l_new_row_meta->last_cell = NULL;
+    a_chunk->nb_entries = 0;
+    a_chunk->failed = false;
 
-    return l_new_row_meta;
-}
+    while ( l_cursor < l_end ) {
+        int l_row_index_1_based = 0, l_col_index_1_based = 0;
+        double l_value[2] = { 1.0, 0.0 };       // pattern matrices have unit values
 
+        l_cursor = skip_blanks(l_cursor, l_end);
 
-row_meta_t * mtx_meta_get_row_index(mtx_meta_t * a_mtx_meta, int a_new_index) {
-    row_meta_t * l_row_meta = NULL;
+        if ( ( l_cursor == l_end ) || ( *l_cursor == '\n' ) || ( *l_cursor == '%' ) ) {
+            l_cursor = skip_line(l_cursor, l_end);
+            continue;
+        }
+
+        if ( a_layout->coordinate ) {
+            if ( ( ! parse_int(&l_cursor, l_end, &l_row_index_1_based) )
+              || ( ! parse_int(&l_cursor, l_end, &l_col_index_1_based) ) ) {
+                a_chunk->failed = true;
+                return;
+            }
+
+            if ( ( l_row_index_1_based < 1 ) || ( l_row_index_1_based > a_layout->nb_rows )
+              || ( l_col_index_1_based < 1 ) || ( l_col_index_1_based > a_layout->nb_cols ) ) {
+                printf("Cell(%d,%d) is out of the %d x %d matrix.\n", l_row_index_1_based, l_col_index_1_based, a_layout->nb_rows, a_layout->nb_cols);
+                a_chunk->failed = true;
+                return;
+            }
+        }
 
-    if ( a_mtx_meta->row_metas == NULL || a_new_index > a_mtx_meta->last_row_meta->row_index ) { 
-        // This row index is greater than all the previous ones
-        // Add a new row_meta
-        l_row_meta = create_new_row_meta(a_new_index);
+        if ( ! a_layout->pattern ) {
+            for ( int l_part = 0 ; l_part < l_nb_values_per_entry; l_part++ ) {
+                if ( ! parse_double(&l_cursor, l_end, &l_value[l_part]) ) {
+                    a_chunk->failed = true;
+                    return;
+                }
+            }
+        }
 
-        if ( a_mtx_meta->last_row_meta != NULL ) {
-            a_mtx_meta->last_row_meta->next = l_row_meta;
+        if ( a_layout->coordinate ) {
+            a_chunk->rows.push_back(l_row_index_1_based);
+            a_chunk->cols.push_back(l_col_index_1_based);
         }
-        a_mtx_meta->last_row_meta = l_row_meta;
+        a_chunk->values.insert(a_chunk->values.end(), l_value, l_value + l_nb_values_per_entry);
+        a_chunk->nb_entries++;
+
+        l_cursor = skip_line(l_cursor, l_end);
+    }
+}
 
-        if ( a_mtx_meta->row_metas == NULL ) {
-            a_mtx_meta->row_metas = l_row_meta;
+/*
+ * Calls a_visitor(row, col, value) for each cell of the matrix, in file order. Array files give their values in
+ * column major order; the mirrored cell of a symmetric matrix immediately follows the cell read in the file.
+ */
+template <typename Visitor>
+static void visit_cells(const mtx_layout_t * a_layout, std::vector<mtx_chunk_t> & a_chunks, Visitor & a_visitor) {
+    int l_nb_values_per_entry = a_layout->complex ? 2 : 1;
+    int64_t l_entry_index = 0;
+
+    for ( size_t l_chunk = 0 ; l_chunk < a_chunks.size(); l_chunk++ ) {
+        const mtx_chunk_t & l_parsed = a_chunks[l_chunk];
+
+        for ( int64_t l_index = 0 ; ( l_index < l_parsed.nb_entries ) && ( l_entry_index < a_layout->nb_entries ); l_index++, l_entry_index++ ) {
+            const double * l_value = &l_parsed.values[l_index * l_nb_values_per_entry];
+            int l_row_index_1_based, l_col_index_1_based;
+
+            if ( a_layout->coordinate ) {
+                l_row_index_1_based = l_parsed.rows[l_index];
+                l_col_index_1_based = l_parsed.cols[l_index];
+            } else {
+                l_row_index_1_based = (int)( l_entry_index % a_layout->nb_rows ) + 1;
+                l_col_index_1_based = (int)( l_entry_index / a_layout->nb_rows ) + 1;
+            }
+
+            // Half storage keeps the lower triangle, whatever the triangle used by the file
+            if ( a_layout->symmetric_half && ( l_col_index_1_based > l_row_index_1_based ) ) {
+                std::swap(l_row_index_1_based, l_col_index_1_based);
+            }
+
+            a_visitor(l_row_index_1_based, l_col_index_1_based, l_value);
+
+            if ( a_layout->symmetric && ( ! a_layout->symmetric_half ) && ( l_row_index_1_based != l_col_index_1_based ) ) {
+                a_visitor(l_col_index_1_based, l_row_index_1_based, l_value);
+            }
         }
+    }
+}
 
-        a_mtx_meta->non_empty_row_count++; // We register a new row
+// Counts the cells of each row (ROW_PTR[row] for the 1-based row)
+struct row_counter_t {
+    int64_t * row_counts;
 
-    } else {
-        row_meta_t * l_current_row_meta = a_mtx_meta->row_metas;
-        row_meta_t * l_previous_row_meta = NULL;
+    void operator()(int a_row_index_1_based, int, const double *) {
+        row_counts[a_row_index_1_based]++;
+    }
+};
+
+// Stores each cell at the next free place of its row
+struct cell_scatter_t {
+    int64_t * row_cursors;
+    int * col_ind;
+    double * val;
+    int nb_values_per_entry;
 
-        // Iterate to find the right place for insertion in the row metadata list
-        while ( l_current_row_meta != NULL && l_current_row_meta->row_index < a_new_index ) {        // Current element describes a row with smaller index than the searched one
-            l_previous_row_meta = l_current_row_meta;
-            l_current_row_meta = l_current_row_meta->next;
+    void operator()(int a_row_index_1_based, int a_col_index_1_based, const double * a_value) {
+        int64_t l_position = row_cursors[a_row_index_1_based - 1]++;
+
+        col_ind[l_position] = a_col_index_1_based;
+        for ( int l_part = 0 ; l_part < nb_values_per_entry; l_part++ ) {
+            val[l_position * nb_values_per_entry + l_part] = a_value[l_part];
+        }
+    }
+};
+
+crs_t * build_crs_matrix_from_chunks(const mtx_layout_t * a_layout, std::vector<mtx_chunk_t> & a_chunks) {
+    int l_nb_values_per_entry = a_layout->complex ? 2 : 1;
+    std::vector<int64_t> l_row_counts(a_layout->nb_rows + 1, 0);
+    std::vector<int64_t> l_row_starts(a_layout->nb_rows + 1, 0);
+    std::vector<int64_t> l_row_cursors;
+    std::vector<std::pair<int, int64_t> > l_sorted_row;
+    std::vector<double> l_row_values;
+    int64_t l_nb_cells = 0;
+    int64_t l_nb_stored_cells = 0;
+    int * l_col_ind;
+    double * l_val;
+    crs_t * l_crs;
+
+    /*
+     * Counting sort on the rows: cells keep the file order inside each row.
+     */
+    row_counter_t l_counter = { l_row_counts.data() };
+    visit_cells(a_layout, a_chunks, l_counter);
+
+    for ( int l_row = 0 ; l_row < a_layout->nb_rows; l_row++ ) {
+        l_row_starts[l_row] = l_nb_cells;
+        l_nb_cells += l_row_counts[l_row + 1];
+    }
+    l_row_starts[a_layout->nb_rows] = l_nb_cells;
+
+    if ( l_nb_cells > INT_MAX ) {
+        printf("Matrix with %ld non-zeros can not be stored in CSR.\n", (long)l_nb_cells);
+        return NULL;
+    }
+
+    l_col_ind = (int *) malloc(( l_nb_cells > 0 ? l_nb_cells : 1 ) * sizeof(int));
+    l_val = (double *) malloc(( l_nb_cells > 0 ? l_nb_cells : 1 ) * sizeof(double) * l_nb_values_per_entry);
+
+    l_row_cursors.assign(l_row_starts.begin(), l_row_starts.end());
+    cell_scatter_t l_scatter = { l_row_cursors.data(), l_col_ind, l_val, l_nb_values_per_entry };
+    visit_cells(a_layout, a_chunks, l_scatter);
+
+    /*
+     * Columns are sorted inside each row and cells given several times are ignored, except the first occurence.
+     * Rows are compacted in place.
+     */
+    for ( int l_row = 0 ; l_row < a_layout->nb_rows; l_row++ ) {
+        int64_t l_start = l_row_starts[l_row];
+        int64_t l_end = l_row_starts[l_row + 1];
+        int64_t l_row_start_after_compaction = l_nb_stored_cells;
+        bool l_sorted = true;
+
+        for ( int64_t l_index = l_start + 1 ; l_index < l_end; l_index++ ) {
+            if ( l_col_ind[l_index] <= l_col_ind[l_index - 1] ) {
+                l_sorted = false;
+                break;
+            }
         }
 
-        if ( l_current_row_meta == NULL || l_current_row_meta->row_index > a_new_index ) {
-            l_row_meta = create_new_row_meta(a_new_index);
+        if ( ! l_sorted ) {
+            // The position in the row breaks ties, so the first occurence of a cell stays in front
+            l_sorted_row.clear();
+            for ( int64_t l_index = l_start ; l_index < l_end; l_index++ ) {
+                l_sorted_row.push_back(std::make_pair(l_col_ind[l_index], l_index));
+            }
+            std::sort(l_sorted_row.begin(), l_sorted_row.end());
 
-            l_row_meta->next = l_current_row_meta;
+            l_row_values.assign(l_val + l_start * l_nb_values_per_entry, l_val + l_end * l_nb_values_per_entry);
+            for ( int64_t l_index = l_start ; l_index < l_end; l_index++ ) {
+                int64_t l_from = l_sorted_row[l_index - l_start].second - l_start;
 
-            if ( l_previous_row_meta != NULL ) {
-                l_previous_row_meta->next = l_row_meta;
+                l_col_ind[l_index] = l_sorted_row[l_index - l_start].first;
+                for ( int l_part = 0 ; l_part < l_nb_values_per_entry; l_part++ ) {
+                    l_val[l_index * l_nb_values_per_entry + l_part] = l_row_values[l_from * l_nb_values_per_entry + l_part];
+                }
             }
-            a_mtx_meta->non_empty_row_count++; // We register a new row
         }
 
-        if ( l_current_row_meta->row_index == a_new_index ) { // We have the right element
-            l_row_meta = l_current_row_meta;
+        for ( int64_t l_index = l_start ; l_index < l_end; l_index++ ) {
+            if ( ( l_nb_stored_cells > l_row_start_after_compaction ) && ( l_col_ind[l_index] == l_col_ind[l_nb_stored_cells - 1] ) ) {
+                printf("Warning: cell(%d,%d) already registered. Ignore this occurence\n", l_row + 1, l_col_ind[l_index]);
+                continue;
+            }
+
+            if ( l_nb_stored_cells != l_index ) {
+                l_col_ind[l_nb_stored_cells] = l_col_ind[l_index];
+                for ( int l_part = 0 ; l_part < l_nb_values_per_entry; l_part++ ) {
+                    l_val[l_nb_stored_cells * l_nb_values_per_entry + l_part] = l_val[l_index * l_nb_values_per_entry + l_part];
+                }
+            }
+            l_nb_stored_cells++;
         }
+
+        // From now on, l_row_starts holds the 0-based start of the compacted rows
+        l_row_starts[l_row] = l_row_start_after_compaction;
     }
+    l_row_starts[a_layout->nb_rows] = l_nb_stored_cells;
+
+    l_crs = (crs_t *)malloc(sizeof(crs_t));
 
-    return l_row_meta;
+    if ( a_layout->complex ) {
+        std::cout << "Set VALUE_TYPE to COMPLEX" << std::endl;
+        l_crs->VALUE_TYPE = COMPLEX;
+    } else {
+        std::cout << "Set VALUE_TYPE to REAL" << std::endl;
+        l_crs->VALUE_TYPE = REAL;
+    }
+    l_crs->M = a_layout->nb_rows;
+    l_crs->N = a_layout->nb_cols;
+    l_crs->NZNUM = (int)l_nb_stored_cells;
+    l_crs->SYMMETRIC_HALF = a_layout->symmetric_half ? 1 : 0;
+    l_crs->ROW_PTR = (int *) malloc((l_crs->M+1) * sizeof(int));
+    l_crs->COL_IND = l_col_ind;
+    l_crs->VAL = l_val;
+
+    for ( int l_row = 0 ; l_row <= l_crs->M; l_row++ ) {
+        l_crs->ROW_PTR[l_row] = (int)l_row_starts[l_row] + 1;
+    }
+
+    return l_crs;
 }
 
 void MTXParser::displayCSR(crs_t * SPM) {
@@ -276,98 +535,23 @@ void MTXParser::displayCSR(crs_t * SPM) {
 
 }
 
-crs_t * build_crs_matrix_from_meta(mtx_meta_t * a_mtx_meta) {
-    crs_t * l_crs = (crs_t *)malloc(sizeof(crs_t));
-    row_meta_t * l_current_row_meta = a_mtx_meta->row_metas;
-    cell_meta_t * l_current_cell_meta  = NULL;
-    int l_row_ptr_index = 0;
-    int l_cell_index_in_row = 0;
-    int l_current_csr_col_val_start_index = 0;
-
-    if ( a_mtx_meta->complex ) {
-        std::cout << "Set VALUE_TYPE to COMPLEX" << std::endl;
-        l_crs->VALUE_TYPE = COMPLEX;
-    } else {
-        std::cout << "Set VALUE_TYPE to REAL" << std::endl;
-        l_crs->VALUE_TYPE = REAL;
-    }
-    l_crs->M = a_mtx_meta->nb_rows;
-    l_crs->N = a_mtx_meta->nb_cols;
-    l_crs->NZNUM = a_mtx_meta->nb_non_zero_elements;
-    l_crs->ROW_PTR = (int *) malloc((l_crs->M+1) * sizeof(int));
-    l_crs->COL_IND = (int *) malloc(l_crs->NZNUM * sizeof(int));
-
-    if ( l_crs->VALUE_TYPE == COMPLEX ){
-        l_crs->VAL = (double *) malloc(l_crs->NZNUM * sizeof(double) * 2);
-    } else {
-        l_crs->VAL = (double *) malloc(l_crs->NZNUM * sizeof(double));
-    }
-
-    l_crs->ROW_PTR[l_row_ptr_index++] = 1;
-
-    // Walk through the list of rows and fill the CSR accordingly
-    while (l_row_ptr_index < l_crs->M+1) {
-        // If needed add entries for empty lines in ROW_PTR
-        if ( l_current_row_meta == NULL || l_row_ptr_index < l_current_row_meta->row_index ) {
-            printf("%d empty line : %d\n", l_crs->ROW_PTR[l_row_ptr_index-1], l_row_ptr_index);
-            l_crs->ROW_PTR[l_row_ptr_index] = l_crs->ROW_PTR[l_row_ptr_index-1];
-        } else {
-            // After empty line process next valid line
-            l_crs->ROW_PTR[l_row_ptr_index] = l_crs->ROW_PTR[l_row_ptr_index - 1] + l_current_row_meta->nb_elements_in_row;
-
-            // Walk through the list of values an store them to the right place in CSR
-            l_current_cell_meta = l_current_row_meta->first_cell;
-            l_cell_index_in_row = 0;
-
-            while ( l_current_cell_meta != NULL ) {
-                l_crs->COL_IND[l_current_csr_col_val_start_index + l_cell_index_in_row ] = l_current_cell_meta->col_index;
-
-                if ( l_crs->VALUE_TYPE == COMPLEX ) {
-                    zcomplex_t * l_complex = (zcomplex_t *)(l_current_cell_meta->value);
-                    l_crs->VAL[(l_current_csr_col_val_start_index * 2) + ( l_cell_index_in_row * 2 )] = l_complex->real;
-                    l_crs->VAL[(l_current_csr_col_val_start_index * 2) + ( l_cell_index_in_row * 2 ) + 1] = l_complex->imag;
-                } else {
-                    l_crs->VAL[l_current_csr_col_val_start_index  + l_cell_index_in_row] = *(l_current_cell_meta->value);
-                }
-                
-                l_current_cell_meta = l_current_cell_meta->next;
-                l_cell_index_in_row++;
-            }
-
-            l_current_csr_col_val_start_index += l_current_row_meta->nb_elements_in_row;
-            l_current_row_meta = l_current_row_meta->next;
-        }
-        l_row_ptr_index++;
-    }
-
-    // If needed add entries for empty lines in ROW_PTR
-    for(l_row_ptr_index; l_row_ptr_index < l_crs->M+1; l_row_ptr_index++ ) {
-        l_crs->ROW_PTR[l_row_ptr_index] = l_crs->ROW_PTR[l_row_ptr_index-1];
-    }
-
-    return l_crs;
-}
-
-
-crs_t  * MTXParser::parseFileToCRS(std::string a_mtx_file_path) {
+crs_t  * MTXParser::parseFileToCRS(std::string a_mtx_file_path, bool a_symmetric_half) {
     FILE * l_mtx_file;
     MM_typecode l_matcode;
-    
-    crs_t * l_crs = NULL; 
-    int l_nb_fields;
-    int l_mtx_element_counter = 0 ;
-    int l_row_index_1_based, l_col_index_1_based;
-    mtx_meta_t l_mtx_meta;
-    row_meta_t * l_current_row_meta = NULL, * l_current_symmetric_row_meta = NULL;
-    cell_meta_t * l_cell_meta_pool = NULL;
-    int l_cell_meta_index = 0;
-
-    double * l_value_pool = NULL;
-    int l_nb_cells = 0, l_nb_cells_in_mtx_file=0;
-    int l_value_index = 0;
-    bool l_row_added = false;
-
-    mtx_meta_init(&l_mtx_meta);
+    mtx_layout_t l_layout;
+    int l_nb_cells_in_mtx_file = 0;
+    long l_data_offset;
+    int l_file_descriptor;
+    struct stat l_file_status;
+    size_t l_file_size;
+    void * l_mapping = NULL;
+    const char * l_data_begin;
+    const char * l_data_end;
+    std::vector<mtx_chunk_t> l_chunks;
+    std::vector<std::thread> l_threads;
+    int64_t l_nb_parsed_entries = 0;
+    bool l_failed = false;
+    crs_t * l_crs = NULL;
 
     if ((l_mtx_file = fopen(a_mtx_file_path.c_str(), "r")) == NULL) {
         fprintf(stderr,"could not find this file %s\n", a_mtx_file_path.c_str());
@@ -376,96 +560,137 @@ crs_t  * MTXParser::parseFileToCRS(std::string a_mtx_file_path) {
 
     if (mm_read_banner(l_mtx_file, &l_matcode) != 0) {
         printf("Could not process Matrix Market banner.\n");
+        fclose(l_mtx_file);
         return NULL;
     }
 
-    if (mm_read_mtx_crd_size(l_mtx_file, &l_mtx_meta.nb_rows, &l_mtx_meta.nb_cols, &l_nb_cells_in_mtx_file)  !=0 ) {
+    if (mm_read_mtx_crd_size(l_mtx_file, &l_layout.nb_rows, &l_layout.nb_cols, &l_nb_cells_in_mtx_file)  !=0 ) {
+        fclose(l_mtx_file);
         return NULL;
     }
 
-    l_nb_cells = l_nb_cells_in_mtx_file;
-    
-    if ( mm_is_symmetric(l_matcode) ) {
-        fprintf(stderr, " symmetric ");
-        l_nb_cells *= 2; 
+    // The values start after the size line, the rest of the file is memory mapped
+    l_data_offset = ftell(l_mtx_file);
+    fclose(l_mtx_file);
+
+    l_layout.coordinate = mm_is_coordinate(l_matcode);
+    l_layout.complex = mm_is_complex(l_matcode);
+    l_layout.pattern = mm_is_pattern(l_matcode);
+    l_layout.symmetric = mm_is_symmetric(l_matcode);
+    // Only real symmetric matrices are kept in half storage, the others are expanded
+    l_layout.symmetric_half = a_symmetric_half && l_layout.symmetric && ( ! l_layout.complex );
+    l_layout.nb_entries = l_layout.coordinate ? l_nb_cells_in_mtx_file : (int64_t)l_layout.nb_rows * l_layout.nb_cols;
+
+    if ( ( ! l_layout.coordinate ) && ( l_layout.symmetric || l_layout.pattern ) ) {
+        printf("Only general array MTX files are supported.\n");
+        return NULL;
     }
 
-    // Allocate all cell metadata strucutures needed
-    l_cell_meta_pool = (cell_meta_t *) malloc(sizeof(cell_meta_t) * l_nb_cells);
+    if ( l_layout.symmetric ) {
+        fprintf(stderr, " symmetric ");
+    }
 
-    // Allocate memory to store all values
-    if (mm_is_complex(l_matcode) && mm_is_matrix(l_matcode) && mm_is_sparse(l_matcode) ) {        
+    if ( l_layout.complex ) {
         fprintf(stderr, " complex ");
-        l_mtx_meta.complex = true;
-        l_value_pool = (double *)malloc(sizeof(zcomplex_t) * l_nb_cells);    
+    }
+
+    fprintf(stderr,"matrix %d x %d with %d non-zeros\n",l_layout.nb_rows, l_layout.nb_cols, l_nb_cells_in_mtx_file);
+
+    if ((l_file_descriptor = open(a_mtx_file_path.c_str(), O_RDONLY)) < 0) {
+        fprintf(stderr,"could not open this file %s\n", a_mtx_file_path.c_str());
+        return NULL;
+    }
+
+    if ( fstat(l_file_descriptor, &l_file_status) != 0 ) {
+        fprintf(stderr,"could not get the size of this file %s\n", a_mtx_file_path.c_str());
+        close(l_file_descriptor);
+        return NULL;
+    }
+    l_file_size = (size_t)l_file_status.st_size;
+
+    if ( l_file_size > (size_t)l_data_offset ) {
+        l_mapping = mmap(NULL, l_file_size, PROT_READ, MAP_PRIVATE, l_file_descriptor, 0);
+        if ( l_mapping == MAP_FAILED ) {
+            fprintf(stderr,"could not map this file %s\n", a_mtx_file_path.c_str());
+            close(l_file_descriptor);
+            return NULL;
+        }
+        madvise(l_mapping, l_file_size, MADV_SEQUENTIAL);
+        l_data_begin = (const char *)l_mapping + l_data_offset;
+        l_data_end = (const char *)l_mapping + l_file_size;
     } else {
-        l_value_pool = (double *)malloc(sizeof(double) * l_nb_cells);
+        l_data_begin = l_data_end = NULL;
     }
+    close(l_file_descriptor);
 
-    fprintf(stderr,"matrix %d x %d with %d non-zeros\n",l_mtx_meta.nb_rows, l_mtx_meta.nb_cols, l_nb_cells_in_mtx_file);
+    /*
+     * The values are split in line aligned chunks parsed in parallel.
+     */
+    size_t l_data_size = l_data_end - l_data_begin;
+    size_t l_nb_chunks = std::thread::hardware_concurrency();
 
-    // Parse mtx file
-    for (l_mtx_element_counter=0; l_mtx_element_counter < l_nb_cells_in_mtx_file; l_mtx_element_counter++)
-    {
-        if ( l_mtx_meta.complex ) { // Processing file describing a complex matrix
-            if (l_mtx_meta.nb_cols == 1 ) { // Processing file describing a vector
-                l_nb_fields = fscanf(l_mtx_file, "%lg %lg\n", &l_value_pool[l_value_index], &l_value_pool[l_value_index+1]) ;
-                l_row_index_1_based=l_mtx_element_counter+1;
-                l_col_index_1_based=1;
-            } else {
-                l_nb_fields = fscanf(l_mtx_file, "%d %d %lg %lg\n", &l_row_index_1_based, &l_col_index_1_based, &l_value_pool[l_value_index], &l_value_pool[l_value_index+1]) ;
-            }
-        } else { // Processing file describing a real matrix
-            if (l_mtx_meta.nb_cols == 1 ) { // Processing file describing a vector
-                l_nb_fields = fscanf(l_mtx_file, "%lg\n", &l_value_pool[l_value_index]);
-                l_row_index_1_based=l_mtx_element_counter+1;
-                l_col_index_1_based=1;
-            } else { 
-                l_nb_fields = fscanf(l_mtx_file, "%d %d %lg\n", &l_row_index_1_based, &l_col_index_1_based, &l_value_pool[l_value_index]) ;
+    if ( l_nb_chunks > l_data_size / MTX_PARSER_MIN_CHUNK_BYTES ) {
+        l_nb_chunks = l_data_size / MTX_PARSER_MIN_CHUNK_BYTES;
+    }
+    if ( l_nb_chunks < 1 ) {
+        l_nb_chunks = 1;
+    }
+
+    l_chunks.resize(l_nb_chunks);
+    for ( size_t l_chunk = 0 ; l_chunk < l_nb_chunks; l_chunk++ ) {
+        l_chunks[l_chunk].begin = ( l_chunk == 0 ) ? l_data_begin : l_chunks[l_chunk - 1].end;
+        l_chunks[l_chunk].end = l_data_end;
+
+        if ( l_chunk + 1 < l_nb_chunks ) {
+            const char * l_split = l_data_begin + ( l_data_size * ( l_chunk + 1 ) ) / l_nb_chunks;
+
+            if ( l_split < l_chunks[l_chunk].begin ) {
+                l_split = l_chunks[l_chunk].begin;
             }
+            l_chunks[l_chunk].end = ( l_split < l_data_end ) ? skip_line(l_split, l_data_end) : l_data_end;
         }
 
-        if ( l_nb_fields == 0) {
-            printf("Fail parsing MTX file line.\n");
-            break;
-        }
+        // Reserve with the average entry size seen on the file, to avoid most reallocations
+        if ( l_layout.nb_entries > 0 ) {
+            size_t l_expected_entries = (size_t)( ( (double)( l_chunks[l_chunk].end - l_chunks[l_chunk].begin ) * l_layout.nb_entries ) / l_data_size ) + 1;
 
-        if ( l_current_row_meta == NULL || l_current_row_meta->row_index != l_row_index_1_based ) {
-            l_current_row_meta = mtx_meta_get_row_index(&l_mtx_meta, l_row_index_1_based);
+            if ( l_layout.coordinate ) {
+                l_chunks[l_chunk].rows.reserve(l_expected_entries);
+                l_chunks[l_chunk].cols.reserve(l_expected_entries);
+            }
+            l_chunks[l_chunk].values.reserve(l_expected_entries * ( l_layout.complex ? 2 : 1 ));
         }
+    }
 
-        l_row_added = row_meta_add_cell(&l_mtx_meta, l_current_row_meta, &l_cell_meta_pool[l_cell_meta_index++], l_col_index_1_based, &l_value_pool[l_value_index]);
-        // l_mtx_element_counter++;
+    for ( size_t l_chunk = 1 ; l_chunk < l_nb_chunks; l_chunk++ ) {
+        l_threads.push_back(std::thread(mtx_chunk_parse, &l_layout, &l_chunks[l_chunk]));
+    }
+    mtx_chunk_parse(&l_layout, &l_chunks[0]);
 
-        // If matrix is symmetric register sysmmetric elements
-        if ( l_row_added && mm_is_symmetric(l_matcode) && ( l_row_index_1_based != l_col_index_1_based ) ) {
-            // je rajoute le symetrique a la fin
-            if ( l_current_symmetric_row_meta == NULL || l_current_symmetric_row_meta->row_index != l_col_index_1_based ) {
-                l_current_symmetric_row_meta = mtx_meta_get_row_index(&l_mtx_meta, l_col_index_1_based);
-            }    
+    for ( size_t l_thread = 0 ; l_thread < l_threads.size(); l_thread++ ) {
+        l_threads[l_thread].join();
+    }
 
-            // Parsing complex element line
-            l_row_added = row_meta_add_cell(&l_mtx_meta, l_current_symmetric_row_meta, &l_cell_meta_pool[l_cell_meta_index++], l_row_index_1_based, &l_value_pool[l_value_index]);
-            // l_mtx_element_counter++; fix
-        }
+    if ( l_mapping != NULL ) {
+        munmap(l_mapping, l_file_size);
+    }
 
-        if ( l_mtx_meta.complex ) {
-            // Parsing complex element line
-            l_value_index += 2;
-        } else {
-            // Parsing real element line
-            l_value_index += 1;
-        }
+    for ( size_t l_chunk = 0 ; l_chunk < l_nb_chunks; l_chunk++ ) {
+        l_failed = l_failed || l_chunks[l_chunk].failed;
+        l_nb_parsed_entries += l_chunks[l_chunk].nb_entries;
     }
 
-    fclose(l_mtx_file);
+    if ( l_failed ) {
+        printf("Fail parsing MTX file line.\n");
+        return NULL;
+    }
 
-    l_crs = build_crs_matrix_from_meta(&l_mtx_meta);
+    // Truncated files are accepted, the cells found are kept
+    if ( l_nb_parsed_entries < l_layout.nb_entries ) {
+        printf("Warning: %ld values found instead of %ld.\n", (long)l_nb_parsed_entries, (long)l_layout.nb_entries);
+    }
 
-    free(l_cell_meta_pool);
-    free(l_value_pool);
-   
-    mtx_meta_clear(&l_mtx_meta);
+    l_crs = build_crs_matrix_from_chunks(&l_layout, l_chunks);
 
     return l_crs;
-}
\ No newline at end of file
+}
@@ -172,6 +172,7 @@ int crsIdent(int n, crs_t * Ident) {
   Ident->COL_IND=myCOL_IND;
   Ident->VAL=myval;
   Ident->NZNUM=n;
+  Ident->SYMMETRIC_HALF=0;
   Ident->M=n;
   Ident->N=n;
   return(n);
@@ -219,6 +219,7 @@ int readMMfile(char * filename, crs_t * SPM ) {
   SPM->M=M;
   SPM->N=N;
   SPM->NZNUM=nz;
+  SPM->SYMMETRIC_HALF=0;
   SPM->VAL=val_ORD;
   // construire COL_IND & ROW_PTR
   // les colonnes indexees de 0 à _M-1
@@ -28,6 +28,7 @@
 #include "Matrix/CSR.h"
 #include "Matrix/DENSE.h"
 #include "Matrix/BCSR.h"
+#include "Matrix/SELL.h"
 
 void freeDenseMatrix(_dmatDENSE_t * a_dense_matrix) {
     free(a_dense_matrix->val);
@@ -41,6 +42,14 @@ void freeBCSRMatrix(_dmatBCSR_t * a_dense_matrix) {
     std::cout << __FUNCTION__ << "Need to be implemented!!!!!" << std::endl;
 }
 
+void freeSELLMatrix(_dmatSELL_t * a_sell_matrix) {
+    free(a_sell_matrix->chunk_ptr);
+    free(a_sell_matrix->row_len);
+    free(a_sell_matrix->perm);
+    free(a_sell_matrix->ind);
+    free(a_sell_matrix->val);
+}
+
 void freeMatrix(matrix_t a_matrix) {
     switch(a_matrix->matrix->type_id) {
         case DENSE:
@@ -52,6 +61,9 @@ void freeMatrix(matrix_t a_matrix) {
         case BCSR:
             freeBCSRMatrix((_dmatBCSR_t *)(a_matrix->matrix->repr));
             break;
+        case SELL:
+            freeSELLMatrix((_dmatSELL_t *)(a_matrix->matrix->repr));
+            break;
         default :
             std::cout << "type_id" << a_matrix->matrix->type_id << " not supported for display." << std::endl;
             break;
@@ -108,7 +120,7 @@ matrix_t buildCSR(int a_num_rows, int a_num_cols, int * a_row_ptr, int * a_col_i
     l_csr_matrix->has_sorted_indices = 0;
     l_csr_matrix->has_sorted_indices = 0;
     l_csr_matrix->stored.is_upper = 1;
-    l_csr_matrix->stored.is_upper = 1;
+    l_csr_matrix->stored.is_lower = 1;
     l_csr_matrix->is_shared = 1;
 
     l_csr_matrix->ptr = a_row_ptr;
@@ -118,6 +130,24 @@ matrix_t buildCSR(int a_num_rows, int a_num_cols, int * a_row_ptr, int * a_col_i
     return l_matrix;
 }
 
+matrix_t buildSymmetricCSR(int a_num_rows, int * a_row_ptr, int * a_col_ind, double * a_val, int a_base_index, char a_uplo) {
+    if ( a_uplo != 'L' && a_uplo != 'U' ) {
+        std::cout << __FUNCTION__ << " : stored triangle must be 'L' or 'U'." << std::endl;
+        return NULL;
+    }
+
+    matrix_t l_matrix = buildCSR(a_num_rows, a_num_rows, a_row_ptr, a_col_ind, a_val, a_base_index);
+
+    if ( l_matrix != NULL ) {
+        dmatCSR_t l_csr_matrix = (dmatCSR_t)(l_matrix->matrix->repr);
+
+        l_csr_matrix->stored.is_upper = ( a_uplo == 'U' );
+        l_csr_matrix->stored.is_lower = ( a_uplo == 'L' );
+    }
+
+    return l_matrix;
+}
+
 matrix_t buildDiagCSR(int a_num_rows, double * a_val, int a_base_index) {
     int * l_ptr = (int *)malloc(sizeof(int) * a_num_rows);
     int * l_ind = (int *)malloc(sizeof(int) * a_num_rows);
@@ -130,6 +160,184 @@ matrix_t buildDiagCSR(int a_num_rows, double * a_val, int a_base_index) {
     return buildCSR(a_num_rows, a_num_rows, l_ptr, l_ind, a_val, a_base_index);
 }
 
+/*
+ * Row of a CSR matrix being sorted by buildSELL.
+ */
+typedef struct {
+    int row;
+    int len;
+} SELLRow_t;
+
+/*
+ * Decreasing number of non zero values, then increasing row index so rows of the same length keep their order.
+ */
+static int compareSELLRows(const void * a_lhs, const void * a_rhs) {
+    const SELLRow_t * l_lhs = (const SELLRow_t *)a_lhs;
+    const SELLRow_t * l_rhs = (const SELLRow_t *)a_rhs;
+
+    if ( l_lhs->len != l_rhs->len ) {
+        return ( l_lhs->len > l_rhs->len ) ? -1 : 1;
+    }
+
+    return l_lhs->row - l_rhs->row;
+}
+
+matrix_t buildSELL(matrix_t a_csr_matrix, int a_chunk_size, int a_sort_window) {
+    matrix_t l_matrix = NULL;
+
+    if ( a_csr_matrix->type_matrix != CSR || a_csr_matrix->type_value != REAL_VALUE ) {
+        std::cout << __FUNCTION__ << " : only real CSR matrices can be converted to SELL format." << std::endl;
+        return NULL;
+    }
+
+    if ( CSR_IS_SYMMETRIC_HALF((dmatCSR_t)(a_csr_matrix->matrix->repr)) ) {
+        std::cout << __FUNCTION__ << " : half stored symmetric matrices can not be converted to SELL format." << std::endl;
+        return NULL;
+    }
+
+    if ( a_chunk_size < 1 ) {
+        std::cout << __FUNCTION__ << " : invalid chunk size " << a_chunk_size << "." << std::endl;
+        return NULL;
+    }
+
+    if ( a_sort_window < 1 ) {
+        a_sort_window = 1;
+    }
+
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_base_index = l_csr_matrix->base_index;
+    int l_num_rows = a_csr_matrix->m;
+    int l_num_chunks = ( l_num_rows + a_chunk_size - 1 ) / a_chunk_size;
+    int l_num_sorted_rows = l_num_chunks * a_chunk_size;
+
+    l_matrix = (matrix_t)malloc(sizeof(_matrix_t));
+
+    if ( l_matrix == NULL ) {
+        std::cout << "Fail allocating memory for new _matrix_t structure." << std::endl;
+        return NULL;
+    }
+
+    l_matrix->m = a_csr_matrix->m;
+    l_matrix->n = a_csr_matrix->n;
+    l_matrix->base_index = a_csr_matrix->base_index;
+    l_matrix->type_matrix = SELL;
+    l_matrix->type_value = REAL_VALUE;
+    l_matrix->format = MATRIX_ROW_MAJOR;
+    l_matrix->lda = a_csr_matrix->lda;
+
+    l_matrix->matrix = (oski_mat_t)malloc(sizeof(_oski_mat_t));
+
+    if ( l_matrix->matrix == NULL ) {
+        std::cout << "Fail allocating memory for _oski_mat_t structure." << std::endl;
+        free(l_matrix);
+        return NULL;
+    }
+
+    l_matrix->matrix->type_id = SELL;
+
+    dmatSELL_t l_sell_matrix = (dmatSELL_t)malloc(sizeof(_dmatSELL_t));
+    SELLRow_t * l_rows = (SELLRow_t *)malloc(sizeof(SELLRow_t) * ( l_num_rows + 1 ));
+
+    if ( l_sell_matrix != NULL ) {
+        l_sell_matrix->chunk_ptr = (int *)malloc(sizeof(int) * ( l_num_chunks + 1 ));
+        l_sell_matrix->row_len = (int *)malloc(sizeof(int) * ( l_num_sorted_rows + 1 ));
+        l_sell_matrix->perm = (int *)malloc(sizeof(int) * ( l_num_sorted_rows + 1 ));
+        l_sell_matrix->ind = NULL;
+        l_sell_matrix->val = NULL;
+    }
+
+    if ( l_sell_matrix == NULL || l_rows == NULL || l_sell_matrix->chunk_ptr == NULL || l_sell_matrix->row_len == NULL || l_sell_matrix->perm == NULL ) {
+        std::cout << "Fail allocating memory for _dmatSELL_t structure." << std::endl;
+        if ( l_sell_matrix != NULL ) {
+            freeSELLMatrix(l_sell_matrix);
+            free(l_sell_matrix);
+        }
+        free(l_rows);
+        free(l_matrix->matrix);
+        free(l_matrix);
+        return NULL;
+    }
+
+    l_sell_matrix->chunk_size = a_chunk_size;
+    l_sell_matrix->sort_window = a_sort_window;
+    l_sell_matrix->num_chunks = l_num_chunks;
+
+    // Sort rows by decreasing length inside each window
+    for ( int l_row = 0; l_row < l_num_rows; l_row++ ) {
+        l_rows[l_row].row = l_row;
+        l_rows[l_row].len = l_csr_matrix->ptr[l_row + 1] - l_csr_matrix->ptr[l_row];
+    }
+
+    for ( int l_window_start = 0; l_window_start < l_num_rows; l_window_start += a_sort_window ) {
+        int l_window_size = ( l_num_rows - l_window_start < a_sort_window ) ? l_num_rows - l_window_start : a_sort_window;
+
+        qsort(l_rows + l_window_start, l_window_size, sizeof(SELLRow_t), compareSELLRows);
+    }
+
+    for ( int l_sorted_row = 0; l_sorted_row < l_num_sorted_rows; l_sorted_row++ ) {
+        l_sell_matrix->perm[l_sorted_row] = ( l_sorted_row < l_num_rows ) ? l_rows[l_sorted_row].row : -1;
+        l_sell_matrix->row_len[l_sorted_row] = ( l_sorted_row < l_num_rows ) ? l_rows[l_sorted_row].len : 0;
+    }
+
+    free(l_rows);
+
+    // Each chunk is as wide as its longest row
+    l_sell_matrix->chunk_ptr[0] = 0;
+
+    for ( int l_chunk = 0; l_chunk < l_num_chunks; l_chunk++ ) {
+        int l_chunk_width = 0;
+
+        for ( int l_row_in_chunk = 0; l_row_in_chunk < a_chunk_size; l_row_in_chunk++ ) {
+            int l_row_len = l_sell_matrix->row_len[l_chunk * a_chunk_size + l_row_in_chunk];
+
+            if ( l_row_len > l_chunk_width ) {
+                l_chunk_width = l_row_len;
+            }
+        }
+
+        l_sell_matrix->chunk_ptr[l_chunk + 1] = l_sell_matrix->chunk_ptr[l_chunk] + l_chunk_width * a_chunk_size;
+    }
+
+    l_sell_matrix->ind = (int *)malloc(sizeof(int) * ( l_sell_matrix->chunk_ptr[l_num_chunks] + 1 ));
+    l_sell_matrix->val = (double *)malloc(sizeof(double) * ( l_sell_matrix->chunk_ptr[l_num_chunks] + 1 ));
+
+    if ( l_sell_matrix->ind == NULL || l_sell_matrix->val == NULL ) {
+        std::cout << "Fail allocating memory for SELL matrix values." << std::endl;
+        freeSELLMatrix(l_sell_matrix);
+        free(l_sell_matrix);
+        free(l_matrix->matrix);
+        free(l_matrix);
+        return NULL;
+    }
+
+    // Column major copy of the rows of each chunk
+    for ( int l_chunk = 0; l_chunk < l_num_chunks; l_chunk++ ) {
+        int l_chunk_width = ( l_sell_matrix->chunk_ptr[l_chunk + 1] - l_sell_matrix->chunk_ptr[l_chunk] ) / a_chunk_size;
+
+        for ( int l_row_in_chunk = 0; l_row_in_chunk < a_chunk_size; l_row_in_chunk++ ) {
+            int l_sorted_row = l_chunk * a_chunk_size + l_row_in_chunk;
+            int l_row_len = l_sell_matrix->row_len[l_sorted_row];
+            int l_csr_offset = ( l_row_len > 0 ) ? l_csr_matrix->ptr[l_sell_matrix->perm[l_sorted_row]] - l_base_index : 0;
+
+            for ( int l_col_in_row = 0; l_col_in_row < l_chunk_width; l_col_in_row++ ) {
+                int l_sell_offset = l_sell_matrix->chunk_ptr[l_chunk] + l_col_in_row * a_chunk_size + l_row_in_chunk;
+
+                if ( l_col_in_row < l_row_len ) {
+                    l_sell_matrix->ind[l_sell_offset] = l_csr_matrix->ind[l_csr_offset + l_col_in_row] - l_base_index;
+                    l_sell_matrix->val[l_sell_offset] = l_csr_matrix->val[l_csr_offset + l_col_in_row];
+                } else {
+                    l_sell_matrix->ind[l_sell_offset] = ( l_row_len > 0 ) ? l_csr_matrix->ind[l_csr_offset + l_row_len - 1] - l_base_index : 0;
+                    l_sell_matrix->val[l_sell_offset] = 0.0;
+                }
+            }
+        }
+    }
+
+    l_matrix->matrix->repr = l_sell_matrix;
+
+    return l_matrix;
+}
+
 void displayDENSEMatrix(matrix_t a_matrix) {
 
     dmatDENSE_t l_dense_matrix = (dmatDENSE_t)(a_matrix->matrix->repr);
@@ -290,6 +498,45 @@ void displayCSRStruct(matrix_t a_matrix, int a_display_precision) {
 
 }
 
+void displaySELLMatrix(matrix_t a_matrix) {
+    dmatSELL_t l_sell_matrix = (dmatSELL_t)(a_matrix->matrix->repr);
+    double * l_dense_row_display = (double *)malloc(sizeof(double) * a_matrix->n);
+
+    if ( l_dense_row_display == NULL ){
+        std::cout << "Fail allocating memory for SELL matrix display." << std::endl;
+        return;
+    }
+
+    std::cout << "chunk_size : " << l_sell_matrix->chunk_size << " - sort_window : " << l_sell_matrix->sort_window << std::endl;
+
+    for ( int l_row_index = 0 ; l_row_index < a_matrix->m; l_row_index++ ) {
+        memset(l_dense_row_display, 0, sizeof(double) * a_matrix->n);
+
+        // Look for the position of the row in the chunks
+        for ( int l_sorted_row = 0; l_sorted_row < l_sell_matrix->num_chunks * l_sell_matrix->chunk_size; l_sorted_row++ ) {
+            if ( l_sell_matrix->perm[l_sorted_row] == l_row_index ) {
+                int l_chunk = l_sorted_row / l_sell_matrix->chunk_size;
+                int l_row_in_chunk = l_sorted_row % l_sell_matrix->chunk_size;
+
+                for ( int l_col_in_row = 0; l_col_in_row < l_sell_matrix->row_len[l_sorted_row]; l_col_in_row++ ) {
+                    int l_sell_offset = l_sell_matrix->chunk_ptr[l_chunk] + l_col_in_row * l_sell_matrix->chunk_size + l_row_in_chunk;
+
+                    l_dense_row_display[l_sell_matrix->ind[l_sell_offset]] = l_sell_matrix->val[l_sell_offset];
+                }
+                break;
+            }
+        }
+
+        std::cout << std::setw(2) << l_row_index + a_matrix->base_index << " : ";
+        for ( int l_col_index = 0 ; l_col_index < a_matrix->n; l_col_index++ ) {
+            std::cout << std::setw(6) << l_dense_row_display[l_col_index] << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    free(l_dense_row_display);
+}
+
 int displayMatrixCharacteristics(matrix_t a_matrix) {
     switch( a_matrix->type_matrix ) {
       case DENSE:
@@ -297,10 +544,16 @@ int displayMatrixCharacteristics(matrix_t a_matrix) {
         break;
       case CSR:
         std::cout << "sparse CSR";
+        if ( a_matrix->type_value == REAL_VALUE && CSR_IS_SYMMETRIC_HALF((dmatCSR_t)(a_matrix->matrix->repr)) ) {
+            std::cout << ( ((dmatCSR_t)(a_matrix->matrix->repr))->stored.is_lower ? " (symmetric, lower half)" : " (symmetric, upper half)" );
+        }
         break;
       case BCSR:
         std::cout << "sparse BCSR";
         break;
+      case SELL:
+        std::cout << "sparse SELL";
+        break;
       default:
         std::cout << "Matrix type " << a_matrix->type_matrix << " is not known" << std::endl;
         return 1;
@@ -341,6 +594,9 @@ void displayMatrix(matrix_t a_matrix, int a_display_precision) {
         case BCSR:
             displayBCSRMatrix(a_matrix);
             break;
+        case SELL:
+            displaySELLMatrix(a_matrix);
+            break;
         default :
             std::cout << "type_id" << a_matrix->matrix->type_id << " not supported for display." << std::endl;
             break;
@@ -430,6 +686,34 @@ double getCSR(matrix_t a_matrix, int a_m, int a_n) {
     return NAN;
 }
 
+double getSELL(matrix_t a_matrix, int a_m, int a_n) {
+    dmatSELL_t l_sell_matrix = (dmatSELL_t)(a_matrix->matrix->repr);
+    int l_row_index = a_m - a_matrix->base_index;
+    int l_col_index = a_n - a_matrix->base_index;
+
+    if ( a_m > a_matrix->m || a_n > a_matrix->n ) {
+        return NAN;
+    }
+
+    for ( int l_sorted_row = 0; l_sorted_row < l_sell_matrix->num_chunks * l_sell_matrix->chunk_size; l_sorted_row++ ) {
+        if ( l_sell_matrix->perm[l_sorted_row] == l_row_index ) {
+            int l_chunk = l_sorted_row / l_sell_matrix->chunk_size;
+            int l_row_in_chunk = l_sorted_row % l_sell_matrix->chunk_size;
+
+            for ( int l_col_in_row = 0; l_col_in_row < l_sell_matrix->row_len[l_sorted_row]; l_col_in_row++ ) {
+                int l_sell_offset = l_sell_matrix->chunk_ptr[l_chunk] + l_col_in_row * l_sell_matrix->chunk_size + l_row_in_chunk;
+
+                if ( l_sell_matrix->ind[l_sell_offset] == l_col_index ) {
+                    return l_sell_matrix->val[l_sell_offset];
+                }
+            }
+            break;
+        }
+    }
+
+    return NAN;
+}
+
 double get(matrix_t a_matrix, int a_m, int a_n) {
     double l_value = NAN;
 
@@ -439,12 +723,22 @@ double get(matrix_t a_matrix, int a_m, int a_n) {
             case DENSE:
                 l_value = getDENSE(a_matrix, a_m, a_n);
                 break;
-            case CSR:
-                l_value = getCSR(a_matrix, a_m, a_n);
-                break;
+            case CSR: {
+                dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_matrix->matrix->repr);
+
+                // Values of the implied triangle of a half stored symmetric matrix are read in the stored one
+                if ( CSR_IS_SYMMETRIC_HALF(l_csr_matrix) && ( l_csr_matrix->stored.is_lower ? ( a_n > a_m ) : ( a_n < a_m ) ) ) {
+                    l_value = getCSR(a_matrix, a_n, a_m);
+                } else {
+                    l_value = getCSR(a_matrix, a_m, a_n);
+                }
+            }; break;
             case BCSR:
                 l_value = getBCSR(a_matrix, a_m, a_n);
                 break;
+            case SELL:
+                l_value = getSELL(a_matrix, a_m, a_n);
+                break;
             default:
                 std::cout << "type_id" << a_matrix->matrix->type_id << " not supported for display." << std::endl;
                 break;
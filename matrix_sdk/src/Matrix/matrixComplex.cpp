@@ -72,7 +72,7 @@ matrix_t buildComplexCSR(int a_num_rows, int a_num_cols, int * a_row_ptr, int *
     l_complex_csr_matrix->has_sorted_indices = 0;
     l_complex_csr_matrix->has_sorted_indices = 0;
     l_complex_csr_matrix->stored.is_upper = 1;
-    l_complex_csr_matrix->stored.is_upper = 1;
+    l_complex_csr_matrix->stored.is_lower = 1;
     l_complex_csr_matrix->is_shared = 1;
 
     l_complex_csr_matrix->ptr = a_row_ptr;
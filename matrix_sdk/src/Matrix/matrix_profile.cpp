@@ -0,0 +1,419 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Structure analysis of CSR matrices and storage format recommendation.
+ **/
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <math.h>
+#include <string.h>
+
+#include "Matrix/matrix.h"
+#include "Matrix/matrix_profile.h"
+#include "Matrix/CSR.h"
+
+/*
+ * Calls a_visitor(row, col, value) (0-based) for each non zero value of the matrix, including the implied ones of
+ * half stored symmetric matrices.
+ */
+static void visitValues(matrix_t a_csr_matrix, const std::function<void(int, int, double)> & a_visitor) {
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_base_index = l_csr_matrix->base_index;
+    bool l_half = CSR_IS_SYMMETRIC_HALF(l_csr_matrix);
+
+    for ( int l_row = 0; l_row < a_csr_matrix->m; l_row++ ) {
+        for ( int l_offset = l_csr_matrix->ptr[l_row] - l_base_index; l_offset < l_csr_matrix->ptr[l_row + 1] - l_base_index; l_offset++ ) {
+            int l_col = l_csr_matrix->ind[l_offset] - l_base_index;
+
+            a_visitor(l_row, l_col, l_csr_matrix->val[l_offset]);
+
+            if ( l_half && l_col != l_row ) {
+                a_visitor(l_col, l_row, l_csr_matrix->val[l_offset]);
+            }
+        }
+    }
+}
+
+/*
+ * Rows of a matrix with their column indices sorted, as the transpose of its transpose.
+ */
+static void transposeCSR(int a_m, int a_n, const std::vector<int> & a_ptr, const std::vector<int> & a_ind, const std::vector<double> & a_val, std::vector<int> & a_transposed_ptr, std::vector<int> & a_transposed_ind, std::vector<double> & a_transposed_val) {
+    a_transposed_ptr.assign(a_n + 1, 0);
+    a_transposed_ind.resize(a_ind.size());
+    a_transposed_val.resize(a_val.size());
+
+    for ( size_t l_offset = 0; l_offset < a_ind.size(); l_offset++ ) {
+        a_transposed_ptr[a_ind[l_offset] + 1]++;
+    }
+
+    for ( int l_col = 0; l_col < a_n; l_col++ ) {
+        a_transposed_ptr[l_col + 1] += a_transposed_ptr[l_col];
+    }
+
+    std::vector<int> l_fill(a_transposed_ptr.begin(), a_transposed_ptr.end() - 1);
+
+    for ( int l_row = 0; l_row < a_m; l_row++ ) {
+        for ( int l_offset = a_ptr[l_row]; l_offset < a_ptr[l_row + 1]; l_offset++ ) {
+            int l_target = l_fill[a_ind[l_offset]]++;
+
+            a_transposed_ind[l_target] = l_row;
+            a_transposed_val[l_target] = a_val[l_offset];
+        }
+    }
+}
+
+static void analyzeSymmetry(matrix_t a_csr_matrix, matrix_profile_t * a_profile) {
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_base_index = l_csr_matrix->base_index;
+    int l_m = a_csr_matrix->m;
+    int l_n = a_csr_matrix->n;
+
+    a_profile->is_structurally_symmetric = 0;
+    a_profile->is_numerically_symmetric = 0;
+
+    if ( CSR_IS_SYMMETRIC_HALF(l_csr_matrix) ) {
+        a_profile->is_structurally_symmetric = 1;
+        a_profile->is_numerically_symmetric = 1;
+        return;
+    }
+
+    if ( l_m != l_n ) {
+        return;
+    }
+
+    std::vector<int> l_ptr(l_m + 1);
+    std::vector<int> l_ind(l_csr_matrix->ind, l_csr_matrix->ind + a_profile->nnz);
+    std::vector<double> l_val(l_csr_matrix->val, l_csr_matrix->val + a_profile->nnz);
+
+    for ( int l_row = 0; l_row <= l_m; l_row++ ) {
+        l_ptr[l_row] = l_csr_matrix->ptr[l_row] - l_base_index;
+    }
+    for ( size_t l_offset = 0; l_offset < l_ind.size(); l_offset++ ) {
+        l_ind[l_offset] -= l_base_index;
+    }
+
+    std::vector<int> l_t_ptr, l_t_ind, l_sorted_ptr, l_sorted_ind;
+    std::vector<double> l_t_val, l_sorted_val;
+
+    transposeCSR(l_m, l_n, l_ptr, l_ind, l_val, l_t_ptr, l_t_ind, l_t_val);
+    transposeCSR(l_n, l_m, l_t_ptr, l_t_ind, l_t_val, l_sorted_ptr, l_sorted_ind, l_sorted_val);
+
+    a_profile->is_structurally_symmetric = ( l_sorted_ptr == l_t_ptr ) && ( l_sorted_ind == l_t_ind );
+    a_profile->is_numerically_symmetric = a_profile->is_structurally_symmetric && ( l_sorted_val == l_t_val );
+}
+
+/*
+ * Number of r x c blocks holding at least one non zero value, for every shape up to the maximum block size.
+ */
+static void countBCSRBlocks(matrix_t a_csr_matrix, int64_t a_nb_blocks[MATRIX_PROFILE_MAX_BLOCK_SIZE][MATRIX_PROFILE_MAX_BLOCK_SIZE]) {
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_base_index = l_csr_matrix->base_index;
+    int l_m = a_csr_matrix->m;
+
+    for ( int l_r = 1; l_r <= MATRIX_PROFILE_MAX_BLOCK_SIZE; l_r++ ) {
+        // Last block row having a value in each block column, for each block width
+        std::vector<int> l_last_block_row[MATRIX_PROFILE_MAX_BLOCK_SIZE];
+
+        for ( int l_c = 1; l_c <= MATRIX_PROFILE_MAX_BLOCK_SIZE; l_c++ ) {
+            l_last_block_row[l_c - 1].assign(( a_csr_matrix->n + l_c - 1 ) / l_c, -1);
+            a_nb_blocks[l_r - 1][l_c - 1] = 0;
+        }
+
+        for ( int l_row = 0; l_row < l_m; l_row++ ) {
+            int l_block_row = l_row / l_r;
+
+            for ( int l_offset = l_csr_matrix->ptr[l_row] - l_base_index; l_offset < l_csr_matrix->ptr[l_row + 1] - l_base_index; l_offset++ ) {
+                int l_col = l_csr_matrix->ind[l_offset] - l_base_index;
+
+                for ( int l_c = 1; l_c <= MATRIX_PROFILE_MAX_BLOCK_SIZE; l_c++ ) {
+                    int & l_last = l_last_block_row[l_c - 1][l_col / l_c];
+
+                    if ( l_last != l_block_row ) {
+                        l_last = l_block_row;
+                        a_nb_blocks[l_r - 1][l_c - 1]++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Stored values of SELL-C-sigma with the recommended shape: rows sorted by decreasing length inside windows, chunks
+ * as wide as their longest row.
+ */
+static int64_t countSELLValues(matrix_t a_csr_matrix) {
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_m = a_csr_matrix->m;
+    std::vector<int> l_row_lengths(l_m);
+    int64_t l_nb_values = 0;
+
+    for ( int l_row = 0; l_row < l_m; l_row++ ) {
+        l_row_lengths[l_row] = l_csr_matrix->ptr[l_row + 1] - l_csr_matrix->ptr[l_row];
+    }
+
+    for ( int l_window_start = 0; l_window_start < l_m; l_window_start += MATRIX_PROFILE_SELL_SORT_WINDOW ) {
+        int l_window_end = std::min(l_m, l_window_start + MATRIX_PROFILE_SELL_SORT_WINDOW);
+
+        std::sort(l_row_lengths.begin() + l_window_start, l_row_lengths.begin() + l_window_end, std::greater<int>());
+    }
+
+    for ( int l_chunk_start = 0; l_chunk_start < l_m; l_chunk_start += MATRIX_PROFILE_SELL_CHUNK_SIZE ) {
+        int l_chunk_end = std::min(l_m, l_chunk_start + MATRIX_PROFILE_SELL_CHUNK_SIZE);
+
+        l_nb_values += (int64_t)( *std::max_element(l_row_lengths.begin() + l_chunk_start, l_row_lengths.begin() + l_chunk_end) ) * MATRIX_PROFILE_SELL_CHUNK_SIZE;
+    }
+
+    return l_nb_values;
+}
+
+int analyzeMatrix(matrix_t a_csr_matrix, size_t a_x_element_size, matrix_profile_t * a_profile) {
+    if ( a_csr_matrix == NULL || a_csr_matrix->type_matrix != CSR || a_csr_matrix->type_value != REAL_VALUE ) {
+        std::cout << __FUNCTION__ << " : only real CSR matrices can be analyzed." << std::endl;
+        return 1;
+    }
+
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_m = a_csr_matrix->m;
+    int l_n = a_csr_matrix->n;
+    int64_t l_nb_stored_values = l_csr_matrix->ptr[l_m] - l_csr_matrix->ptr[0];
+
+    memset(a_profile, 0, sizeof(matrix_profile_t));
+
+    a_profile->m = l_m;
+    a_profile->n = l_n;
+    a_profile->symmetric_half = CSR_IS_SYMMETRIC_HALF(l_csr_matrix);
+    a_profile->x_element_size = a_x_element_size;
+
+    /*
+     * Row lengths, bandwidth, profile and diagonal dominance of the whole matrix
+     */
+    std::vector<int> l_row_lengths(l_m, 0);
+    std::vector<int> l_first_col(l_m, l_n);
+    std::vector<double> l_diagonal(l_m, 0.0);
+    std::vector<double> l_off_diagonal_sum(l_m, 0.0);
+
+    visitValues(a_csr_matrix, [&](int a_row, int a_col, double a_value) {
+        l_row_lengths[a_row]++;
+        l_first_col[a_row] = std::min(l_first_col[a_row], a_col);
+        a_profile->bandwidth = std::max(a_profile->bandwidth, abs(a_col - a_row));
+
+        if ( a_col == a_row ) {
+            l_diagonal[a_row] += fabs(a_value);
+        } else {
+            l_off_diagonal_sum[a_row] += fabs(a_value);
+        }
+    });
+
+    double l_sum_squares = 0.0;
+
+    a_profile->min_row_length = ( l_m > 0 ) ? l_row_lengths[0] : 0;
+
+    for ( int l_row = 0; l_row < l_m; l_row++ ) {
+        int l_length = l_row_lengths[l_row];
+        int l_bucket = 0;
+
+        a_profile->nnz += l_length;
+        a_profile->min_row_length = std::min(a_profile->min_row_length, l_length);
+        a_profile->max_row_length = std::max(a_profile->max_row_length, l_length);
+        l_sum_squares += double(l_length) * double(l_length);
+
+        while ( ( l_length >> l_bucket ) != 0 && l_bucket < MATRIX_PROFILE_HISTOGRAM_SIZE - 1 ) {
+            l_bucket++;
+        }
+        a_profile->row_length_histogram[l_bucket]++;
+
+        if ( l_first_col[l_row] < l_row ) {
+            a_profile->profile += l_row - l_first_col[l_row];
+        }
+
+        if ( l_diagonal[l_row] == 0.0 ) {
+            a_profile->nb_zero_diagonal_rows++;
+        }
+        if ( l_diagonal[l_row] >= l_off_diagonal_sum[l_row] ) {
+            a_profile->nb_weakly_dominant_rows++;
+        }
+        if ( l_diagonal[l_row] > l_off_diagonal_sum[l_row] ) {
+            a_profile->nb_strictly_dominant_rows++;
+        }
+    }
+
+    if ( l_m > 0 ) {
+        a_profile->mean_row_length = double(a_profile->nnz) / double(l_m);
+        a_profile->row_length_stddev = sqrt(std::max(0.0, l_sum_squares / double(l_m) - a_profile->mean_row_length * a_profile->mean_row_length));
+    }
+
+    a_profile->is_diagonally_dominant = ( l_m == l_n ) && ( a_profile->nb_weakly_dominant_rows == l_m ) && ( a_profile->nb_strictly_dominant_rows > 0 );
+
+    analyzeSymmetry(a_csr_matrix, a_profile);
+
+    /*
+     * Bytes moved per flop by each format
+     */
+    double l_flops = 2.0 * double(std::max<int64_t>(a_profile->nnz, 1));
+    double l_x_size = double(a_x_element_size);
+    double l_y_bytes = 2.0 * double(l_m) * l_x_size;
+    int64_t l_lda = MATRIX_OPTIMIZE_LDA(l_n);
+
+    a_profile->csr_bytes_per_flop = ( double(l_nb_stored_values) * ( sizeof(double) + sizeof(int) ) + double(l_m + 1) * sizeof(int) + double(a_profile->nnz) * l_x_size + l_y_bytes ) / l_flops;
+    a_profile->dense_bytes_per_flop = ( double(l_m) * double(l_lda) * sizeof(double) + double(l_m) * double(l_n) * l_x_size + l_y_bytes ) / l_flops;
+
+    if ( ! a_profile->symmetric_half && a_profile->nnz > 0 ) {
+        int64_t l_nb_blocks[MATRIX_PROFILE_MAX_BLOCK_SIZE][MATRIX_PROFILE_MAX_BLOCK_SIZE];
+
+        countBCSRBlocks(a_csr_matrix, l_nb_blocks);
+
+        for ( int l_r = 1; l_r <= MATRIX_PROFILE_MAX_BLOCK_SIZE; l_r++ ) {
+            for ( int l_c = 1; l_c <= MATRIX_PROFILE_MAX_BLOCK_SIZE; l_c++ ) {
+                double l_blocks = double(l_nb_blocks[l_r - 1][l_c - 1]);
+
+                a_profile->bcsr_fill[l_r - 1][l_c - 1] = l_blocks * l_r * l_c / double(a_profile->nnz);
+                a_profile->bcsr_bytes_per_flop[l_r - 1][l_c - 1] = ( l_blocks * l_r * l_c * sizeof(double) + l_blocks * sizeof(int) + double(( l_m + l_r - 1 ) / l_r + 1) * sizeof(int) + l_blocks * l_c * l_x_size + l_y_bytes ) / l_flops;
+            }
+        }
+
+        int64_t l_nb_sell_values = countSELLValues(a_csr_matrix);
+        int l_nb_chunks = ( l_m + MATRIX_PROFILE_SELL_CHUNK_SIZE - 1 ) / MATRIX_PROFILE_SELL_CHUNK_SIZE;
+
+        // SELL kernels skip the padding of each row: x is loaded once per non zero value
+        a_profile->sell_fill = double(l_nb_sell_values) / double(a_profile->nnz);
+        a_profile->sell_bytes_per_flop = ( double(l_nb_sell_values) * ( sizeof(double) + sizeof(int) ) + double(l_nb_chunks + 1) * sizeof(int) + 2.0 * double(l_nb_chunks) * MATRIX_PROFILE_SELL_CHUNK_SIZE * sizeof(int) + double(a_profile->nnz) * l_x_size + l_y_bytes ) / l_flops;
+    }
+
+    /*
+     * Recommendation
+     */
+    a_profile->recommended_format = CSR;
+
+    if ( a_profile->symmetric_half || a_profile->nnz == 0 ) {
+        return 0;
+    }
+
+    if ( double(a_profile->nnz) >= MATRIX_PROFILE_DENSE_THRESHOLD * double(l_m) * double(l_n) ) {
+        a_profile->recommended_format = DENSE;
+        return 0;
+    }
+
+    int l_best_r = 1;
+    int l_best_c = 1;
+
+    for ( int l_r = 1; l_r <= MATRIX_PROFILE_MAX_BLOCK_SIZE; l_r++ ) {
+        for ( int l_c = 1; l_c <= MATRIX_PROFILE_MAX_BLOCK_SIZE; l_c++ ) {
+            if ( a_profile->bcsr_bytes_per_flop[l_r - 1][l_c - 1] < a_profile->bcsr_bytes_per_flop[l_best_r - 1][l_best_c - 1] ) {
+                l_best_r = l_r;
+                l_best_c = l_c;
+            }
+        }
+    }
+
+    if ( ( l_best_r * l_best_c > 1 ) && ( a_profile->bcsr_bytes_per_flop[l_best_r - 1][l_best_c - 1] <= 0.9 * a_profile->csr_bytes_per_flop ) ) {
+        a_profile->recommended_format = BCSR;
+        a_profile->recommended_block_row_size = l_best_r;
+        a_profile->recommended_block_col_size = l_best_c;
+    } else if ( ( l_m >= MATRIX_PROFILE_SELL_CHUNK_SIZE ) && ( a_profile->sell_fill <= 1.1 ) ) {
+        a_profile->recommended_format = SELL;
+        a_profile->recommended_chunk_size = MATRIX_PROFILE_SELL_CHUNK_SIZE;
+        a_profile->recommended_sort_window = MATRIX_PROFILE_SELL_SORT_WINDOW;
+    }
+
+    return 0;
+}
+
+void writeMatrixProfileJSON(const matrix_profile_t * a_profile, FILE * a_stream) {
+    const char * l_format = "CSR";
+
+    switch ( a_profile->recommended_format ) {
+        case BCSR:
+            l_format = "BCSR";
+            break;
+        case SELL:
+            l_format = "SELL";
+            break;
+        case DENSE:
+            l_format = "DENSE";
+            break;
+        default:
+            break;
+    }
+
+    fprintf(a_stream, "{\n");
+    fprintf(a_stream, "  \"m\": %d,\n", a_profile->m);
+    fprintf(a_stream, "  \"n\": %d,\n", a_profile->n);
+    fprintf(a_stream, "  \"nnz\": %lld,\n", (long long)a_profile->nnz);
+    fprintf(a_stream, "  \"symmetric_half\": %s,\n", a_profile->symmetric_half ? "true" : "false");
+    fprintf(a_stream, "  \"row_length\": {\n");
+    fprintf(a_stream, "    \"min\": %d,\n", a_profile->min_row_length);
+    fprintf(a_stream, "    \"max\": %d,\n", a_profile->max_row_length);
+    fprintf(a_stream, "    \"mean\": %.6g,\n", a_profile->mean_row_length);
+    fprintf(a_stream, "    \"stddev\": %.6g,\n", a_profile->row_length_stddev);
+    fprintf(a_stream, "    \"histogram\": [");
+    for ( int l_bucket = 0; l_bucket < MATRIX_PROFILE_HISTOGRAM_SIZE; l_bucket++ ) {
+        fprintf(a_stream, "%s{\"min\": %d, \"count\": %lld}", ( l_bucket > 0 ) ? ", " : "", ( l_bucket > 0 ) ? ( 1 << ( l_bucket - 1 ) ) : 0, (long long)a_profile->row_length_histogram[l_bucket]);
+    }
+    fprintf(a_stream, "]\n");
+    fprintf(a_stream, "  },\n");
+    fprintf(a_stream, "  \"bandwidth\": %d,\n", a_profile->bandwidth);
+    fprintf(a_stream, "  \"profile\": %lld,\n", (long long)a_profile->profile);
+    fprintf(a_stream, "  \"diagonal\": {\n");
+    fprintf(a_stream, "    \"weakly_dominant_rows\": %lld,\n", (long long)a_profile->nb_weakly_dominant_rows);
+    fprintf(a_stream, "    \"strictly_dominant_rows\": %lld,\n", (long long)a_profile->nb_strictly_dominant_rows);
+    fprintf(a_stream, "    \"zero_rows\": %lld,\n", (long long)a_profile->nb_zero_diagonal_rows);
+    fprintf(a_stream, "    \"dominant\": %s\n", a_profile->is_diagonally_dominant ? "true" : "false");
+    fprintf(a_stream, "  },\n");
+    fprintf(a_stream, "  \"symmetry\": {\n");
+    fprintf(a_stream, "    \"structural\": %s,\n", a_profile->is_structurally_symmetric ? "true" : "false");
+    fprintf(a_stream, "    \"numerical\": %s\n", a_profile->is_numerically_symmetric ? "true" : "false");
+    fprintf(a_stream, "  },\n");
+    fprintf(a_stream, "  \"bcsr_fill\": [");
+    for ( int l_r = 0; l_r < MATRIX_PROFILE_MAX_BLOCK_SIZE; l_r++ ) {
+        fprintf(a_stream, "%s[", ( l_r > 0 ) ? ", " : "");
+        for ( int l_c = 0; l_c < MATRIX_PROFILE_MAX_BLOCK_SIZE; l_c++ ) {
+            fprintf(a_stream, "%s%.4f", ( l_c > 0 ) ? ", " : "", a_profile->bcsr_fill[l_r][l_c]);
+        }
+        fprintf(a_stream, "]");
+    }
+    fprintf(a_stream, "],\n");
+    fprintf(a_stream, "  \"sell_fill\": %.4f,\n", a_profile->sell_fill);
+    fprintf(a_stream, "  \"bytes_per_flop\": {\n");
+    fprintf(a_stream, "    \"x_element_size\": %zu,\n", a_profile->x_element_size);
+    fprintf(a_stream, "    \"csr\": %.4f,\n", a_profile->csr_bytes_per_flop);
+    fprintf(a_stream, "    \"bcsr\": [");
+    for ( int l_r = 0; l_r < MATRIX_PROFILE_MAX_BLOCK_SIZE; l_r++ ) {
+        fprintf(a_stream, "%s[", ( l_r > 0 ) ? ", " : "");
+        for ( int l_c = 0; l_c < MATRIX_PROFILE_MAX_BLOCK_SIZE; l_c++ ) {
+            fprintf(a_stream, "%s%.4f", ( l_c > 0 ) ? ", " : "", a_profile->bcsr_bytes_per_flop[l_r][l_c]);
+        }
+        fprintf(a_stream, "]");
+    }
+    fprintf(a_stream, "],\n");
+    fprintf(a_stream, "    \"sell\": %.4f,\n", a_profile->sell_bytes_per_flop);
+    fprintf(a_stream, "    \"dense\": %.4f\n", a_profile->dense_bytes_per_flop);
+    fprintf(a_stream, "  },\n");
+    fprintf(a_stream, "  \"recommendation\": {\n");
+    fprintf(a_stream, "    \"format\": \"%s\"", l_format);
+    if ( a_profile->recommended_format == BCSR ) {
+        fprintf(a_stream, ",\n    \"block_row_size\": %d,\n    \"block_col_size\": %d", a_profile->recommended_block_row_size, a_profile->recommended_block_col_size);
+    } else if ( a_profile->recommended_format == SELL ) {
+        fprintf(a_stream, ",\n    \"chunk_size\": %d,\n    \"sort_window\": %d", a_profile->recommended_chunk_size, a_profile->recommended_sort_window);
+    }
+    fprintf(a_stream, "\n  }\n");
+    fprintf(a_stream, "}\n");
+}
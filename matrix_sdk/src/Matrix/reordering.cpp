@@ -0,0 +1,521 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Bandwidth reducing reorderings of CSR matrices.
+ *
+ *                 Orderings are computed on the graph of the structure of A + A^T, so they also apply to non
+ *                 symmetric matrices, and are applied as symmetric permutations P A P^T which keep the diagonal on
+ *                 the diagonal.
+ **/
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "Matrix/matrix.h"
+#include "Matrix/CSR.h"
+
+/*
+ * Adjacency lists of the graph of A + A^T, without self loops (0-based).
+ */
+typedef struct {
+    int n;
+    std::vector<int> ptr;
+    std::vector<int> adj;
+} ReorderingGraph_t;
+
+/*
+ * Checks that a matrix can be reordered: square real CSR matrix.
+ */
+static bool isReorderable(matrix_t a_matrix, const char * a_function) {
+    if ( a_matrix == NULL || a_matrix->type_matrix != CSR || a_matrix->type_value != REAL_VALUE ) {
+        std::cout << a_function << " : only real CSR matrices can be reordered." << std::endl;
+        return false;
+    }
+
+    if ( a_matrix->m != a_matrix->n ) {
+        std::cout << a_function << " : only square matrices can be reordered." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static void buildReorderingGraph(matrix_t a_csr_matrix, ReorderingGraph_t & a_graph) {
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_base_index = l_csr_matrix->base_index;
+    int l_n = a_csr_matrix->n;
+
+    a_graph.n = l_n;
+    a_graph.ptr.assign(l_n + 1, 0);
+
+    // Each off diagonal value (i, j) links i to j and j to i
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        for ( int l_offset = l_csr_matrix->ptr[l_row] - l_base_index; l_offset < l_csr_matrix->ptr[l_row + 1] - l_base_index; l_offset++ ) {
+            int l_col = l_csr_matrix->ind[l_offset] - l_base_index;
+
+            if ( l_col != l_row ) {
+                a_graph.ptr[l_row + 1]++;
+                a_graph.ptr[l_col + 1]++;
+            }
+        }
+    }
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        a_graph.ptr[l_row + 1] += a_graph.ptr[l_row];
+    }
+
+    std::vector<int> l_fill(a_graph.ptr.begin(), a_graph.ptr.end() - 1);
+    a_graph.adj.resize(a_graph.ptr[l_n]);
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        for ( int l_offset = l_csr_matrix->ptr[l_row] - l_base_index; l_offset < l_csr_matrix->ptr[l_row + 1] - l_base_index; l_offset++ ) {
+            int l_col = l_csr_matrix->ind[l_offset] - l_base_index;
+
+            if ( l_col != l_row ) {
+                a_graph.adj[l_fill[l_row]++] = l_col;
+                a_graph.adj[l_fill[l_col]++] = l_row;
+            }
+        }
+    }
+
+    // Symmetric values appear twice: remove the duplicated edges in place
+    int l_size = 0;
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        int l_start = a_graph.ptr[l_row];
+        int l_end = a_graph.ptr[l_row + 1];
+
+        std::sort(a_graph.adj.begin() + l_start, a_graph.adj.begin() + l_end);
+
+        a_graph.ptr[l_row] = l_size;
+
+        for ( int l_offset = l_start; l_offset < l_end; l_offset++ ) {
+            if ( l_offset == l_start || a_graph.adj[l_offset] != a_graph.adj[l_offset - 1] ) {
+                a_graph.adj[l_size++] = a_graph.adj[l_offset];
+            }
+        }
+    }
+
+    a_graph.ptr[l_n] = l_size;
+    a_graph.adj.resize(l_size);
+}
+
+static int degree(const ReorderingGraph_t & a_graph, int a_vertex) {
+    return a_graph.ptr[a_vertex + 1] - a_graph.ptr[a_vertex];
+}
+
+/*
+ * Breadth first search from a_root over the vertices of a_part (a_label[v] == a_part), appending them to a_order.
+ * With a_sort_by_degree, the neighbours of a vertex are visited by increasing degree (Cuthill-McKee). Marks the
+ * visited vertices in a_visited, returns the number of levels and the offset in a_order of the last level.
+ */
+static int breadthFirstSearch(const ReorderingGraph_t & a_graph, int a_root, const std::vector<int> & a_label, int a_part, std::vector<char> & a_visited, bool a_sort_by_degree, std::vector<int> & a_order, size_t * a_last_level_start = NULL) {
+    size_t l_level_start = a_order.size();
+    int l_nb_levels = 0;
+
+    a_order.push_back(a_root);
+    a_visited[a_root] = 1;
+
+    while ( l_level_start < a_order.size() ) {
+        size_t l_level_end = a_order.size();
+
+        if ( a_last_level_start != NULL ) {
+            *a_last_level_start = l_level_start;
+        }
+
+        for ( size_t l_index = l_level_start; l_index < l_level_end; l_index++ ) {
+            int l_vertex = a_order[l_index];
+            size_t l_first_neighbour = a_order.size();
+
+            for ( int l_offset = a_graph.ptr[l_vertex]; l_offset < a_graph.ptr[l_vertex + 1]; l_offset++ ) {
+                int l_neighbour = a_graph.adj[l_offset];
+
+                if ( ! a_visited[l_neighbour] && a_label[l_neighbour] == a_part ) {
+                    a_visited[l_neighbour] = 1;
+                    a_order.push_back(l_neighbour);
+                }
+            }
+
+            if ( a_sort_by_degree ) {
+                std::stable_sort(a_order.begin() + l_first_neighbour, a_order.end(), [&a_graph](int a_lhs, int a_rhs) {
+                    return degree(a_graph, a_lhs) < degree(a_graph, a_rhs);
+                });
+            }
+        }
+
+        l_level_start = l_level_end;
+        l_nb_levels++;
+    }
+
+    return l_nb_levels;
+}
+
+/*
+ * George-Liu pseudo-peripheral vertex of the connected component of a_start in a_part: moves to the vertex of
+ * smallest degree of the last level while the number of levels grows.
+ */
+static int findPseudoPeripheralVertex(const ReorderingGraph_t & a_graph, int a_start, const std::vector<int> & a_label, int a_part, std::vector<char> & a_visited) {
+    std::vector<int> l_order;
+    int l_root = a_start;
+    int l_nb_levels = 0;
+
+    while ( true ) {
+        size_t l_last_level_start = 0;
+
+        l_order.clear();
+        int l_root_nb_levels = breadthFirstSearch(a_graph, l_root, a_label, a_part, a_visited, false, l_order, &l_last_level_start);
+
+        for ( int l_vertex : l_order ) {
+            a_visited[l_vertex] = 0;
+        }
+
+        if ( l_root_nb_levels <= l_nb_levels ) {
+            return l_root;
+        }
+
+        l_nb_levels = l_root_nb_levels;
+
+        int l_candidate = l_order[l_last_level_start];
+
+        for ( size_t l_index = l_last_level_start + 1; l_index < l_order.size(); l_index++ ) {
+            if ( degree(a_graph, l_order[l_index]) < degree(a_graph, l_candidate) ) {
+                l_candidate = l_order[l_index];
+            }
+        }
+
+        if ( l_candidate == l_root ) {
+            return l_root;
+        }
+
+        l_root = l_candidate;
+    }
+}
+
+/*
+ * Orders the vertices of a_vertices (all labelled a_part) component by component, each from a pseudo-peripheral
+ * vertex, and appends them to a_order.
+ */
+static void orderPart(const ReorderingGraph_t & a_graph, const std::vector<int> & a_vertices, const std::vector<int> & a_label, int a_part, std::vector<char> & a_visited, bool a_sort_by_degree, std::vector<int> & a_order) {
+    std::vector<int> l_by_degree(a_vertices);
+
+    std::stable_sort(l_by_degree.begin(), l_by_degree.end(), [&a_graph](int a_lhs, int a_rhs) {
+        return degree(a_graph, a_lhs) < degree(a_graph, a_rhs);
+    });
+
+    for ( int l_vertex : l_by_degree ) {
+        if ( ! a_visited[l_vertex] ) {
+            int l_root = findPseudoPeripheralVertex(a_graph, l_vertex, a_label, a_part, a_visited);
+
+            breadthFirstSearch(a_graph, l_root, a_label, a_part, a_visited, a_sort_by_degree, a_order);
+        }
+    }
+}
+
+int * reorderRCM(matrix_t a_csr_matrix) {
+    if ( ! isReorderable(a_csr_matrix, __FUNCTION__) ) {
+        return NULL;
+    }
+
+    ReorderingGraph_t l_graph;
+    buildReorderingGraph(a_csr_matrix, l_graph);
+
+    std::vector<int> l_vertices(l_graph.n);
+    std::vector<int> l_label(l_graph.n, 0);
+    std::vector<char> l_visited(l_graph.n, 0);
+    std::vector<int> l_order;
+
+    for ( int l_vertex = 0; l_vertex < l_graph.n; l_vertex++ ) {
+        l_vertices[l_vertex] = l_vertex;
+    }
+
+    l_order.reserve(l_graph.n);
+    orderPart(l_graph, l_vertices, l_label, 0, l_visited, true, l_order);
+
+    int * l_permutation = (int *)malloc(sizeof(int) * ( l_graph.n + 1 ));
+
+    if ( l_permutation == NULL ) {
+        std::cout << "Fail allocating memory for permutation." << std::endl;
+        return NULL;
+    }
+
+    for ( int l_index = 0; l_index < l_graph.n; l_index++ ) {
+        l_permutation[l_index] = l_order[l_graph.n - 1 - l_index];
+    }
+
+    return l_permutation;
+}
+
+int * reorderPartition(matrix_t a_csr_matrix, int a_nb_parts) {
+    if ( ! isReorderable(a_csr_matrix, __FUNCTION__) ) {
+        return NULL;
+    }
+
+    if ( a_nb_parts < 1 ) {
+        std::cout << __FUNCTION__ << " : invalid number of parts " << a_nb_parts << "." << std::endl;
+        return NULL;
+    }
+
+    ReorderingGraph_t l_graph;
+    buildReorderingGraph(a_csr_matrix, l_graph);
+
+    std::vector<int> l_label(l_graph.n, 0);
+    std::vector<char> l_visited(l_graph.n, 0);
+    std::vector<int> l_order;
+
+    /*
+     * Recursive bisection: the breadth first order of a part is split in two parts of sizes proportional to the
+     * number of parts each one is still divided in. Parts are processed in order, so the final order keeps the
+     * parts consecutive.
+     */
+    typedef struct {
+        std::vector<int> vertices;
+        int nb_parts;
+    } Part_t;
+
+    std::vector<Part_t> l_parts(1);
+    int l_nb_labels = 1;
+
+    l_parts[0].nb_parts = a_nb_parts;
+    l_parts[0].vertices.resize(l_graph.n);
+
+    for ( int l_vertex = 0; l_vertex < l_graph.n; l_vertex++ ) {
+        l_parts[0].vertices[l_vertex] = l_vertex;
+    }
+
+    l_order.reserve(l_graph.n);
+
+    // Empty matrix: no part to split
+    if ( l_graph.n == 0 ) {
+        l_parts.clear();
+    }
+
+    while ( ! l_parts.empty() ) {
+        Part_t l_part = l_parts.back();
+        l_parts.pop_back();
+
+        int l_part_label = l_label[l_part.vertices[0]];
+        std::vector<int> l_part_order;
+
+        orderPart(l_graph, l_part.vertices, l_label, l_part_label, l_visited, false, l_part_order);
+
+        if ( l_part.nb_parts == 1 || l_part_order.size() < 2 ) {
+            l_order.insert(l_order.end(), l_part_order.begin(), l_part_order.end());
+            continue;
+        }
+
+        for ( int l_vertex : l_part_order ) {
+            l_visited[l_vertex] = 0;
+        }
+
+        /*
+         * A part can not be divided in more parts than it has vertices, and both halves keep at least one vertex:
+         * with more parts than vertices (a_nb_parts > n, or small parts deep in the recursion) the split would
+         * otherwise leave the first half empty.
+         */
+        int l_nb_parts = std::min(l_part.nb_parts, (int)l_part_order.size());
+        int l_first_nb_parts = l_nb_parts / 2;
+        size_t l_split = ( l_part_order.size() * l_first_nb_parts ) / l_nb_parts;
+
+        l_split = std::min(std::max(l_split, (size_t)1), l_part_order.size() - 1);
+
+        Part_t l_first;
+        Part_t l_second;
+
+        l_first.nb_parts = l_first_nb_parts;
+        l_first.vertices.assign(l_part_order.begin(), l_part_order.begin() + l_split);
+        l_second.nb_parts = l_nb_parts - l_first_nb_parts;
+        l_second.vertices.assign(l_part_order.begin() + l_split, l_part_order.end());
+
+        for ( int l_vertex : l_second.vertices ) {
+            l_label[l_vertex] = l_nb_labels;
+        }
+        l_nb_labels++;
+
+        // The first part is processed first
+        l_parts.push_back(l_second);
+        l_parts.push_back(l_first);
+    }
+
+    int * l_permutation = (int *)malloc(sizeof(int) * ( l_graph.n + 1 ));
+
+    if ( l_permutation == NULL ) {
+        std::cout << "Fail allocating memory for permutation." << std::endl;
+        return NULL;
+    }
+
+    std::copy(l_order.begin(), l_order.end(), l_permutation);
+
+    return l_permutation;
+}
+
+matrix_t permuteCSR(matrix_t a_csr_matrix, const int * a_permutation) {
+    if ( ! isReorderable(a_csr_matrix, __FUNCTION__) ) {
+        return NULL;
+    }
+
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_base_index = l_csr_matrix->base_index;
+    int l_n = a_csr_matrix->n;
+    int l_nnz = l_csr_matrix->ptr[l_n] - l_base_index;
+    bool l_half = CSR_IS_SYMMETRIC_HALF(l_csr_matrix);
+
+    std::vector<int> l_inverse(l_n, -1);
+
+    for ( int l_index = 0; l_index < l_n; l_index++ ) {
+        if ( a_permutation[l_index] < 0 || a_permutation[l_index] >= l_n || l_inverse[a_permutation[l_index]] != -1 ) {
+            std::cout << __FUNCTION__ << " : invalid permutation." << std::endl;
+            return NULL;
+        }
+
+        l_inverse[a_permutation[l_index]] = l_index;
+    }
+
+    int * l_ptr = (int *)malloc(sizeof(int) * ( l_n + 1 ));
+    int * l_ind = (int *)malloc(sizeof(int) * ( l_nnz + 1 ));
+    double * l_val = (double *)malloc(sizeof(double) * ( l_nnz + 1 ));
+
+    if ( l_ptr == NULL || l_ind == NULL || l_val == NULL ) {
+        std::cout << "Fail allocating memory for permuted CSR matrix." << std::endl;
+        free(l_ptr);
+        free(l_ind);
+        free(l_val);
+        return NULL;
+    }
+
+    /*
+     * Value (i, j) moves to (inverse[i], inverse[j]). A half stored matrix keeps the same stored triangle, so the
+     * values crossing the diagonal are stored at their symmetric position.
+     */
+    auto l_target = [&](int a_row, int a_col, int & a_new_row, int & a_new_col) {
+        a_new_row = l_inverse[a_row];
+        a_new_col = l_inverse[a_col];
+
+        if ( l_half && ( l_csr_matrix->stored.is_lower ? ( a_new_col > a_new_row ) : ( a_new_col < a_new_row ) ) ) {
+            std::swap(a_new_row, a_new_col);
+        }
+    };
+
+    std::fill(l_ptr, l_ptr + l_n + 1, 0);
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        for ( int l_offset = l_csr_matrix->ptr[l_row] - l_base_index; l_offset < l_csr_matrix->ptr[l_row + 1] - l_base_index; l_offset++ ) {
+            int l_new_row, l_new_col;
+
+            l_target(l_row, l_csr_matrix->ind[l_offset] - l_base_index, l_new_row, l_new_col);
+            l_ptr[l_new_row + 1]++;
+        }
+    }
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        l_ptr[l_row + 1] += l_ptr[l_row];
+    }
+
+    std::vector<int> l_fill(l_ptr, l_ptr + l_n);
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        for ( int l_offset = l_csr_matrix->ptr[l_row] - l_base_index; l_offset < l_csr_matrix->ptr[l_row + 1] - l_base_index; l_offset++ ) {
+            int l_new_row, l_new_col;
+
+            l_target(l_row, l_csr_matrix->ind[l_offset] - l_base_index, l_new_row, l_new_col);
+            l_ind[l_fill[l_new_row]] = l_new_col;
+            l_val[l_fill[l_new_row]] = l_csr_matrix->val[l_offset];
+            l_fill[l_new_row]++;
+        }
+    }
+
+    // Sorted column indices, then back to the base index of the input matrix
+    std::vector<std::pair<int, double> > l_row_values;
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        l_row_values.clear();
+
+        for ( int l_offset = l_ptr[l_row]; l_offset < l_ptr[l_row + 1]; l_offset++ ) {
+            l_row_values.push_back(std::make_pair(l_ind[l_offset], l_val[l_offset]));
+        }
+
+        std::stable_sort(l_row_values.begin(), l_row_values.end(), [](const std::pair<int, double> & a_lhs, const std::pair<int, double> & a_rhs) {
+            return a_lhs.first < a_rhs.first;
+        });
+
+        for ( int l_offset = l_ptr[l_row]; l_offset < l_ptr[l_row + 1]; l_offset++ ) {
+            l_ind[l_offset] = l_row_values[l_offset - l_ptr[l_row]].first + l_base_index;
+            l_val[l_offset] = l_row_values[l_offset - l_ptr[l_row]].second;
+        }
+    }
+
+    for ( int l_row = 0; l_row <= l_n; l_row++ ) {
+        l_ptr[l_row] += l_base_index;
+    }
+
+    matrix_t l_matrix = NULL;
+
+    if ( l_half ) {
+        l_matrix = buildSymmetricCSR(l_n, l_ptr, l_ind, l_val, l_base_index, l_csr_matrix->stored.is_lower ? 'L' : 'U');
+    } else {
+        l_matrix = buildCSR(l_n, l_n, l_ptr, l_ind, l_val, l_base_index);
+    }
+
+    if ( l_matrix == NULL ) {
+        free(l_ptr);
+        free(l_ind);
+        free(l_val);
+        return NULL;
+    }
+
+    l_matrix->lda = a_csr_matrix->lda;
+    ((dmatCSR_t)(l_matrix->matrix->repr))->has_sorted_indices = 1;
+
+    return l_matrix;
+}
+
+int getCSRBandwidth(matrix_t a_csr_matrix) {
+    if ( a_csr_matrix == NULL || a_csr_matrix->type_matrix != CSR ) {
+        std::cout << __FUNCTION__ << " : only CSR matrices are supported." << std::endl;
+        return -1;
+    }
+
+    dmatCSR_t l_csr_matrix = (dmatCSR_t)(a_csr_matrix->matrix->repr);
+    int l_base_index = l_csr_matrix->base_index;
+    int l_bandwidth = 0;
+
+    for ( int l_row = 0; l_row < a_csr_matrix->m; l_row++ ) {
+        for ( int l_offset = l_csr_matrix->ptr[l_row] - l_base_index; l_offset < l_csr_matrix->ptr[l_row + 1] - l_base_index; l_offset++ ) {
+            int l_distance = abs(l_csr_matrix->ind[l_offset] - l_base_index - l_row);
+
+            if ( l_distance > l_bandwidth ) {
+                l_bandwidth = l_distance;
+            }
+        }
+    }
+
+    return l_bandwidth;
+}
+
+void permuteVector(int a_n, const int * a_permutation, const double * a_x, double * a_permuted_x) {
+    for ( int l_index = 0; l_index < a_n; l_index++ ) {
+        a_permuted_x[l_index] = a_x[a_permutation[l_index]];
+    }
+}
+
+void unpermuteVector(int a_n, const int * a_permutation, const double * a_permuted_x, double * a_x) {
+    for ( int l_index = 0; l_index < a_n; l_index++ ) {
+        a_x[a_permutation[l_index]] = a_permuted_x[l_index];
+    }
+}
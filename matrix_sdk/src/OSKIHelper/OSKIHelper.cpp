@@ -27,6 +27,7 @@
 #include "Matrix/BCSR.h"
 #include "Matrix/DENSE.h"
 #include <iostream>
+#include <algorithm>
 #include <string.h>
 #include <stdio.h>
 
@@ -50,21 +51,48 @@ void oski_helper_finalize() {
     oski_helper_initialized = false;
 }
 
+/*
+ * Marks the CSR input matrix of an OSKI matrix as a half stored symmetric one (see CSR_IS_SYMMETRIC_HALF), the
+ * products of VBLAS relying on dmatCSR_t::stored rather than on the OSKI properties.
+ */
+void oski_helper_set_stored_triangle(oski_matrix_t_Tid a_matrix, int a_is_upper, int a_is_lower) {
+    dmatCSR_t l_input_csr = (dmatCSR_t)(a_matrix->input_mat.repr);
+
+    l_input_csr->stored.is_upper = a_is_upper;
+    l_input_csr->stored.is_lower = a_is_lower;
+}
+
 oski_matrix_wrapper_t oski_helper_create_real_CSR_matrix(crs_t * a_csr) {
     oski_matrix_wrapper_t l_matrix;
 
     oski_helper_initialize();
 
     l_matrix.complex = false;
-    l_matrix.oski_matrix.real_matrix = oski_CreateMatCSR_Tid (
-        a_csr->ROW_PTR,
-        a_csr->COL_IND,
-        a_csr->VAL,
-        a_csr->M,
-        a_csr->N,
-        SHARE_INPUTMAT,
-        1,
-        INDEX_ONE_BASED );
+
+    if ( a_csr->SYMMETRIC_HALF ) {
+        l_matrix.oski_matrix.real_matrix = oski_CreateMatCSR_Tid (
+            a_csr->ROW_PTR,
+            a_csr->COL_IND,
+            a_csr->VAL,
+            a_csr->M,
+            a_csr->N,
+            SHARE_INPUTMAT,
+            2,
+            INDEX_ONE_BASED,
+            MAT_SYMM_LOWER );
+
+        oski_helper_set_stored_triangle(l_matrix.oski_matrix.real_matrix, 0, 1);
+    } else {
+        l_matrix.oski_matrix.real_matrix = oski_CreateMatCSR_Tid (
+            a_csr->ROW_PTR,
+            a_csr->COL_IND,
+            a_csr->VAL,
+            a_csr->M,
+            a_csr->N,
+            SHARE_INPUTMAT,
+            1,
+            INDEX_ONE_BASED );
+    }
 
     oski_helper_finalize();
 
@@ -92,8 +120,8 @@ oski_matrix_wrapper_t oski_helper_create_complex_CSR_matrix(crs_t * a_csr) {
     return l_matrix;
 }
 
-oski_matrix_wrapper_t OSKIHelper::loadFromFile(char * a_file_path) {
-    crs_t * l_csr = ::MTXParser::parseFileToCRS(a_file_path);
+oski_matrix_wrapper_t OSKIHelper::loadFromFile(char * a_file_path, bool a_symmetric_half) {
+    crs_t * l_csr = ::MTXParser::parseFileToCRS(a_file_path, a_symmetric_half);
 
     if ( l_csr == NULL ) {
         std::cout << __FUNCTION__ << "MTX file parsing failed. return NULL" << std::endl;
@@ -217,15 +245,30 @@ oski_matrix_wrapper_t OSKIHelper::fromCSRMatrix(matrix_t a_matrix) {
 
     oski_helper_initialize();
 
-    l_oski_matrix.oski_matrix.real_matrix = oski_CreateMatCSR_Tid (
-        l_csr_matrix->ptr,
-        l_csr_matrix->ind,
-        l_csr_matrix->val,
-        a_matrix->m,
-        a_matrix->n,
-        SHARE_INPUTMAT,
-        1,
-        INDEX_ONE_BASED );
+    if ( CSR_IS_SYMMETRIC_HALF(l_csr_matrix) ) {
+        l_oski_matrix.oski_matrix.real_matrix = oski_CreateMatCSR_Tid (
+            l_csr_matrix->ptr,
+            l_csr_matrix->ind,
+            l_csr_matrix->val,
+            a_matrix->m,
+            a_matrix->n,
+            SHARE_INPUTMAT,
+            2,
+            INDEX_ONE_BASED,
+            l_csr_matrix->stored.is_lower ? MAT_SYMM_LOWER : MAT_SYMM_UPPER );
+
+        oski_helper_set_stored_triangle(l_oski_matrix.oski_matrix.real_matrix, l_csr_matrix->stored.is_upper, l_csr_matrix->stored.is_lower);
+    } else {
+        l_oski_matrix.oski_matrix.real_matrix = oski_CreateMatCSR_Tid (
+            l_csr_matrix->ptr,
+            l_csr_matrix->ind,
+            l_csr_matrix->val,
+            a_matrix->m,
+            a_matrix->n,
+            SHARE_INPUTMAT,
+            1,
+            INDEX_ONE_BASED );
+    }
 
     oski_helper_finalize();
 
@@ -310,6 +353,18 @@ matrix_t OSKIHelper::toDense(oski_matrix_wrapper_t a_sparse_matrix, bool a_trans
 
             if ( a_sparse_matrix.complex ) {
                 l_matrix_data_struct->val[l_val_dense_val_offset+1] += l_input_csr->val[l_csr_col_index - l_dense_matrix->base_index + 1];
+            } else if ( CSR_IS_SYMMETRIC_HALF(l_input_csr) && ( l_real_col_index - l_input_csr->base_index != l_row_index ) ) {
+                // Half stored symmetric matrix: the value is also the one of the implied triangle, the cell opposite
+                // to the one written above
+                size_t l_mirror_offset = 0;
+
+                if ( a_transpose == false ) {
+                    l_mirror_offset = (l_row_index) + (l_real_col_index - l_input_csr->base_index) * l_dense_matrix->lda;
+                } else {
+                    l_mirror_offset = (l_real_col_index - l_input_csr->base_index) + (l_row_index) * l_dense_matrix->lda;
+                }
+
+                l_matrix_data_struct->val[l_mirror_offset] += l_input_csr->val[l_csr_col_index];
             }
         }
     }
@@ -322,6 +377,11 @@ matrix_t OSKIHelper::toDense(oski_matrix_wrapper_t a_sparse_matrix, bool a_trans
 matrix_t OSKIHelper::toBCSR(oski_matrix_wrapper_t a_sparse_matrix, int a_block_row_size, int a_block_col_size) {
     char l_lua_transform[1024];
 
+    if ( ( ! a_sparse_matrix.complex ) && CSR_IS_SYMMETRIC_HALF((dmatCSR_t)(a_sparse_matrix.oski_matrix.real_matrix->input_mat.repr)) ) {
+        std::cout << "BCSR format is not supported for half stored symmetric matrices." << std::endl;
+        return NULL;
+    }
+
     matrix_t l_bcsr_matrix = (matrix_t)malloc(sizeof(_matrix_t));
     l_bcsr_matrix->base_index = 1;
     l_bcsr_matrix->matrix = (oski_mat_t)malloc(sizeof(_oski_mat_t));
@@ -358,6 +418,209 @@ matrix_t OSKIHelper::toBCSR(oski_matrix_wrapper_t a_sparse_matrix, int a_block_r
     return l_bcsr_matrix;
 }
 
+matrix_t OSKIHelper::toSELL(oski_matrix_wrapper_t a_sparse_matrix, int a_chunk_size, int a_sort_window) {
+    if ( a_sparse_matrix.complex ) {
+        std::cout << "SELL format is not supported for complex matrices." << std::endl;
+        return NULL;
+    }
+
+    // CSR view of the OSKI input matrix: only the view itself is freed once copied
+    matrix_t l_csr_matrix = toMatrix(a_sparse_matrix);
+
+    if ( l_csr_matrix == NULL ) {
+        return NULL;
+    }
+
+    l_csr_matrix->type_matrix = CSR;
+
+    matrix_t l_sell_matrix = buildSELL(l_csr_matrix, a_chunk_size, a_sort_window);
+
+    free(l_csr_matrix);
+
+    return l_sell_matrix;
+}
+
+double OSKIHelper::estimateBCSRFill(oski_matrix_wrapper_t a_sparse_matrix, int a_block_row_size, int a_block_col_size, double a_sampling_fraction) {
+    dmatCSR_t l_input_csr = NULL;
+    int l_num_rows, l_num_cols;
+
+    // Only the structure of the matrix is read: real and complex CSR share the ptr and ind fields layout
+    if ( a_sparse_matrix.complex ) {
+        l_input_csr = (dmatCSR_t)(a_sparse_matrix.oski_matrix.complex_matrix->input_mat.repr);
+        l_num_rows = a_sparse_matrix.oski_matrix.complex_matrix->props.num_rows;
+        l_num_cols = a_sparse_matrix.oski_matrix.complex_matrix->props.num_cols;
+    } else {
+        l_input_csr = (dmatCSR_t)(a_sparse_matrix.oski_matrix.real_matrix->input_mat.repr);
+        l_num_rows = a_sparse_matrix.oski_matrix.real_matrix->props.num_rows;
+        l_num_cols = a_sparse_matrix.oski_matrix.real_matrix->props.num_cols;
+    }
+
+    if ( ( a_block_row_size < 1 ) || ( a_block_col_size < 1 ) ) {
+        std::cout << "Invalid BCSR block size " << a_block_row_size << "x" << a_block_col_size << "." << std::endl;
+        return 0.0;
+    }
+
+    int l_base = l_input_csr->base_index;
+    int l_num_block_rows = ( l_num_rows + a_block_row_size - 1 ) / a_block_row_size;
+    int l_num_block_cols = ( l_num_cols + a_block_col_size - 1 ) / a_block_col_size;
+
+    /*
+     * One block row every l_step block rows is scanned. The sample is regular rather than random so the chosen shape
+     * does not change from one run to another.
+     */
+    int l_step = 1;
+    if ( ( a_sampling_fraction > 0.0 ) && ( a_sampling_fraction < 1.0 ) ) {
+        l_step = (int)(1.0 / a_sampling_fraction);
+    }
+
+    // Last sampled block row in which each block column holds a non zero value
+    int * l_block_col_last_block_row = (int *)malloc(sizeof(int) * l_num_block_cols);
+    for ( int l_block_col = 0 ; l_block_col < l_num_block_cols; l_block_col++ ) {
+        l_block_col_last_block_row[l_block_col] = -1;
+    }
+
+    int64_t l_nb_blocks = 0;
+    int64_t l_nb_values = 0;
+
+    for ( int l_block_row = 0 ; l_block_row < l_num_block_rows; l_block_row += l_step ) {
+        int l_row_end = std::min(( l_block_row + 1 ) * a_block_row_size, l_num_rows);
+
+        for ( int l_row = l_block_row * a_block_row_size ; l_row < l_row_end; l_row++ ) {
+            for ( int k = l_input_csr->ptr[l_row] - l_base ; k < l_input_csr->ptr[l_row + 1] - l_base; k++ ) {
+                int l_block_col = ( l_input_csr->ind[k] - l_base ) / a_block_col_size;
+
+                if ( l_block_col_last_block_row[l_block_col] != l_block_row ) {
+                    l_block_col_last_block_row[l_block_col] = l_block_row;
+                    l_nb_blocks++;
+                }
+                l_nb_values++;
+            }
+        }
+    }
+
+    free(l_block_col_last_block_row);
+
+    if ( l_nb_values == 0 ) {
+        return 1.0;
+    }
+
+    return (double)(l_nb_blocks * a_block_row_size * a_block_col_size) / (double)l_nb_values;
+}
+
+/*
+ * Number of values, explicit zeros included, stored in a BCSR matrix and its leftover rows.
+ */
+static int64_t getBCSRNbStoredValues(dmatBCSR_t a_bcsr) {
+    int64_t l_nb_values = 0;
+
+    for ( dmatBCSR_t l_bcsr = a_bcsr; l_bcsr != NULL; l_bcsr = l_bcsr->leftover ) {
+        l_nb_values += (int64_t)( l_bcsr->bptr[l_bcsr->num_block_rows] - l_bcsr->bptr[0] ) * l_bcsr->row_block_size * l_bcsr->col_block_size;
+    }
+
+    return l_nb_values;
+}
+
+bcsr_profile_t OSKIHelper::benchmarkBCSR(int a_max_block_row_size, int a_max_block_col_size, int a_dense_size, bcsr_benchmark_t a_benchmark, void * a_args) {
+    bcsr_profile_t l_profile;
+    char l_lua_transform[1024];
+
+    l_profile.max_block_row_size = std::max(1, std::min(a_max_block_row_size, OSKIHELPER_BCSR_MAX_BLOCK_SIZE));
+    l_profile.max_block_col_size = std::max(1, std::min(a_max_block_col_size, OSKIHELPER_BCSR_MAX_BLOCK_SIZE));
+
+    /*
+     * Dense matrix stored as a CSR one: every shape stores exactly its a_dense_size * a_dense_size values (plus the
+     * padding of the last block row and column), so the measure only depends on the shape.
+     */
+    int * l_row_ptr = (int *)malloc(sizeof(int) * ( a_dense_size + 1 ));
+    int * l_col_ind = (int *)malloc(sizeof(int) * a_dense_size * a_dense_size);
+    double * l_val = (double *)malloc(sizeof(double) * a_dense_size * a_dense_size);
+
+    for ( int l_row = 0 ; l_row <= a_dense_size; l_row++ ) {
+        l_row_ptr[l_row] = l_row * a_dense_size + 1;
+    }
+
+    for ( int l_row = 0 ; l_row < a_dense_size; l_row++ ) {
+        for ( int l_col = 0 ; l_col < a_dense_size; l_col++ ) {
+            l_col_ind[l_row * a_dense_size + l_col] = l_col + 1;
+            l_val[l_row * a_dense_size + l_col] = 1.0 / (double)( l_row + l_col + 1 );
+        }
+    }
+
+    oski_matrix_wrapper_t l_dense_matrix = OSKIHelper::buildCSR(a_dense_size, a_dense_size, l_row_ptr, l_col_ind, l_val, 1);
+
+    for ( int l_block_row_size = 1 ; l_block_row_size <= l_profile.max_block_row_size; l_block_row_size++ ) {
+        for ( int l_block_col_size = 1 ; l_block_col_size <= l_profile.max_block_col_size; l_block_col_size++ ) {
+            /*
+             * Same conversion than toBCSR, but the OSKI copy is kept so it can be destroyed once measured.
+             */
+            snprintf(l_lua_transform, 1024, "A_new = BCSR(InputMat, %d, %d)\n return A_new\n", l_block_row_size, l_block_col_size);
+
+            oski_helper_initialize();
+
+            oski_matrix_t_Tid l_oski_bcsr_matrix = oski_CopyMat_Tid (l_dense_matrix.oski_matrix.real_matrix);
+            oski_ApplyMatTransforms_Tid(l_oski_bcsr_matrix, l_lua_transform);
+
+            oski_helper_finalize();
+
+            _oski_mat_t l_bcsr_repr;
+            l_bcsr_repr.type_id = BCSR;
+            l_bcsr_repr.repr = l_oski_bcsr_matrix->tuned_mat.repr;
+
+            _matrix_t l_bcsr_matrix;
+            l_bcsr_matrix.base_index = 1;
+            l_bcsr_matrix.matrix = &l_bcsr_repr;
+            l_bcsr_matrix.type_matrix = BCSR;
+            l_bcsr_matrix.type_value = REAL_VALUE;
+            l_bcsr_matrix.m = a_dense_size;
+            l_bcsr_matrix.n = a_dense_size;
+            l_bcsr_matrix.format = MATRIX_ROW_MAJOR;
+            l_bcsr_matrix.lda = ComputeOptimizedLDA(a_dense_size, 8);
+
+            double l_duration = a_benchmark(&l_bcsr_matrix, a_args);
+            int64_t l_nb_values = getBCSRNbStoredValues((dmatBCSR_t)l_bcsr_repr.repr);
+
+            l_profile.cost_per_value[l_block_row_size - 1][l_block_col_size - 1] = l_duration / (double)std::max(l_nb_values, (int64_t)1);
+
+            oski_helper_initialize();
+            oski_DestroyMat_Tid(l_oski_bcsr_matrix);
+            oski_helper_finalize();
+        }
+    }
+
+    oski_helper_initialize();
+    oski_DestroyMat_Tid(l_dense_matrix.oski_matrix.real_matrix);
+    oski_helper_finalize();
+
+    free(l_row_ptr);
+    free(l_col_ind);
+    free(l_val);
+
+    return l_profile;
+}
+
+double OSKIHelper::tuneBCSR(oski_matrix_wrapper_t a_sparse_matrix, const bcsr_profile_t & a_profile, int * a_block_row_size, int * a_block_col_size, double a_sampling_fraction) {
+    double l_best_cost = -1.0;
+
+    *a_block_row_size = 1;
+    *a_block_col_size = 1;
+
+    for ( int l_block_row_size = 1 ; l_block_row_size <= a_profile.max_block_row_size; l_block_row_size++ ) {
+        for ( int l_block_col_size = 1 ; l_block_col_size <= a_profile.max_block_col_size; l_block_col_size++ ) {
+            double l_fill = estimateBCSRFill(a_sparse_matrix, l_block_row_size, l_block_col_size, a_sampling_fraction);
+            double l_cost = l_fill * a_profile.cost_per_value[l_block_row_size - 1][l_block_col_size - 1];
+
+            // Strict comparison: on ties, the smallest shape is kept
+            if ( ( l_best_cost < 0.0 ) || ( l_cost < l_best_cost ) ) {
+                l_best_cost = l_cost;
+                *a_block_row_size = l_block_row_size;
+                *a_block_col_size = l_block_col_size;
+            }
+        }
+    }
+
+    return l_best_cost;
+}
+
 void transpose(oski_matrix_wrapper_t a_input_matrix , oski_matrix_wrapper_t a_transposed_matrix){
     int l_input_M,  l_input_N, l_input_NZ;
     int l_transposed_M, l_transposed_N, l_transposed_NZ;
@@ -503,6 +766,13 @@ oski_matrix_wrapper_t OSKIHelper::transpose(oski_matrix_wrapper_t a_matrix) {
 
         transpose(a_matrix, l_transposed_matrix);
 
+        // The transposed of a stored triangle is the other triangle of the same symmetric matrix
+        dmatCSR_t l_input_csr = (dmatCSR_t)(a_matrix.oski_matrix.real_matrix->input_mat.repr);
+
+        if ( CSR_IS_SYMMETRIC_HALF(l_input_csr) ) {
+            oski_helper_set_stored_triangle(l_transposed_matrix.oski_matrix.real_matrix, l_input_csr->stored.is_lower, l_input_csr->stored.is_upper);
+        }
+
         oski_helper_finalize();
     }
 
@@ -59,6 +59,7 @@ matrix_t jacobi(matrix_t a_input_matrix, double a_shifter) {
     SPM->M=a_input_matrix->n;
     SPM->N=a_input_matrix->n;
     SPM->NZNUM=a_input_matrix->n;
+    SPM->SYMMETRIC_HALF=0;
     SPM->VAL=val;
     SPM->COL_IND =(int *) malloc(SPM->NZNUM*sizeof(int));
     SPM->ROW_PTR =(int *) malloc((SPM->M+1)*sizeof(int));
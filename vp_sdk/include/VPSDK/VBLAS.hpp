@@ -36,6 +36,17 @@ namespace VPFloatPackage {
         *  Matrix-vector multiplication
         *
         *  y = (alpha * A * x) + (beta * y)
+        *
+        *  With trans != 'N', y = (alpha * A^T * x) + (beta * y): A has m rows and n columns, x has m elements and y n
+        *  elements (CSR, BCSR, SELL and DENSE matrices in the MPFR implementation, DENSE matrices only on VRP). Each
+        *  y[j] sums the m values of column j. Earlier versions of the MPFR DENSE kernel computed m elements of y,
+        *  each over n values of A: both conventions only agree on square matrices.
+        *
+        *  CSR indices are read relative to the base_index of the CSR structure, so both 0-based and 1-based matrices
+        *  are supported by the MPFR implementation.
+        *
+        *  Half stored symmetric CSR matrices (CSR_IS_SYMMETRIC_HALF) are supported by the MPFR implementation and on
+        *  VRP: the implied triangle is read from the stored one, and trans does not matter.
         ****************************************************************************************************************/
         void vgemvd( int precision, char trans, int m, int n,
                             double alpha,
@@ -44,6 +55,26 @@ namespace VPFloatPackage {
                             const VPFloat & beta,
                             VPFloatArray & y);
 
+        /*****************************************************************************************************************
+        *  Sparse matrix - multi-vector multiplication
+        *
+        *  Y = (alpha * A * X) + (beta * Y)
+        *
+        *  X and Y hold k vectors stored contiguously, vector j of X being x[j*n .. (j+1)*n[ and vector j of Y
+        *  y[j*m .. (j+1)*m[ (x[j*m ..] and y[j*n ..] with trans != 'N'). The result of each vector is the one of
+        *  vgemvd.
+        *
+        *  The MPFR implementation streams CSR (except half stored symmetric ones) and BCSR matrices once for the k
+        *  vectors when trans is 'N': each matrix value is loaded once and multiplied by the k vectors. The other
+        *  cases, and the VRP implementation, run one vgemvd per vector.
+        ****************************************************************************************************************/
+        void vgemmd( int precision, char trans, int m, int n, int k,
+                            double alpha,
+                            const matrix_t a,
+                            const VPFloatArray & x,
+                            const VPFloat & beta,
+                            VPFloatArray & y);
+
         /*****************************************************************************************************************
          *  Vector scaling - x = alpha*x
          ****************************************************************************************************************/
@@ -67,6 +98,16 @@ namespace VPFloatPackage {
 
         void vaxpy( int precision, int n, const VPFloat & alpha, const VPFloatArray & x, VPFloatArray & y);
 
+        /*****************************************************************************************************************
+         *  Vector addition with scaling of both vectors (AXPBY) - y = alpha*x + beta*y
+         ****************************************************************************************************************/
+        void vaxpby( int precision, int n, const VPFloat & alpha, const VPFloatArray & x, const VPFloat & beta, VPFloatArray & y);
+
+        /*****************************************************************************************************************
+         *  Vector addition with scaling of the result (XPAY) - y = x + alpha*y
+         ****************************************************************************************************************/
+        void vxpay( int precision, int n, const VPFloatArray & x, const VPFloat & alpha, VPFloatArray & y);
+
         /*****************************************************************************************************************
          *  Scalar vector-vector multiplication (dot product) - x * y
          ****************************************************************************************************************/
@@ -74,7 +115,39 @@ namespace VPFloatPackage {
 
         double ddot(int n, const double *x, vpfloat_off_t x_inc, const double *y, vpfloat_off_t y_inc);
 
-        void vdot( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, VPFloat & res);
+        /*
+         * Rounding of the dot products:
+         *   - VBLAS_DOT_ROUNDED : each accumulation is rounded to the precision of res.
+         *   - VBLAS_DOT_EXACT   : x * y is computed without error and rounded once to the precision of res
+         *                         (MPFR implementation only, the VRP implementation computes a rounded dot product).
+         */
+        enum VBLASDotMode { VBLAS_DOT_ROUNDED, VBLAS_DOT_EXACT };
+
+        void vdot( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, VPFloat & res, VBLASDotMode a_dot_mode = VBLAS_DOT_ROUNDED);
+
+        /*****************************************************************************************************************
+         *  AXPY fused with the dot product of the result - y = alpha*x + y, res = y * y
+         *  The vectors are read once, the results are the ones of vaxpy followed by vdot.
+         ****************************************************************************************************************/
+        void vaxpy_dot( int precision, int n, const VPFloat & alpha, const VPFloatArray & x, VPFloatArray & y, VPFloat & res, VBLASDotMode a_dot_mode = VBLAS_DOT_ROUNDED);
+
+        /*****************************************************************************************************************
+         *  Two dot products sharing a vector - res_y = x * y, res_z = x * z
+         *  A single reduction: x is read once, the results are the ones of two vdot calls.
+         ****************************************************************************************************************/
+        void vdot2( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, const VPFloatArray & z, VPFloat & res_y, VPFloat & res_z, VBLASDotMode a_dot_mode = VBLAS_DOT_ROUNDED);
+
+        /*****************************************************************************************************************
+         *  Block of k vectors of n elements stored contiguously in v, vector j being v[j*n .. (j+1)*n[
+         *
+         *  vdot_block  : res[j] = v_j * x for j < k (v^T x), a single reduction over the n elements. The results are
+         *                the ones of k vdot calls.
+         *  vaxpy_block : y = y + sum_j alpha[j] * v_j (y + v alpha), y being read and written once. The result is the
+         *                one of k vaxpy calls in increasing j order.
+         ****************************************************************************************************************/
+        void vdot_block( int precision, int n, int k, const VPFloatArray & v, const VPFloatArray & x, VPFloatArray & res, VBLASDotMode a_dot_mode = VBLAS_DOT_ROUNDED);
+
+        void vaxpy_block( int precision, int n, int k, const VPFloatArray & alpha, const VPFloatArray & v, VPFloatArray & y);
 
         void vzero(int precision, int n, VPFloatArray & x);
 
@@ -85,7 +158,7 @@ namespace VPFloatPackage {
 
         double dnrm2 (int n, const double *x, int x_inc);
 
-        void vnrm2 (int precision, int n, const VPFloatArray& x, VPFloat & res);
+        void vnrm2 (int precision, int n, const VPFloatArray& x, VPFloat & res, VBLASDotMode a_dot_mode = VBLAS_DOT_ROUNDED);
     };
 };
 
@@ -24,18 +24,22 @@
 
 #include <iostream>
 #include "VRPSDK/vblas_mt.h"
+#include "VPSDK/VBLAS.hpp"
 
 namespace VPFloatPackage {
 
     namespace VBLAS {
 
         struct VBLASConfig {
-            // Configuration parameters for vblas_mt_init
+            // Configuration parameters for vblas_mt_init (VRP) or for the host thread pool (MPFR)
             uint64_t nb_threads;
             uint64_t nb_rows_per_thread;
 
             // Configuration parameters of linear prefetcher
             uint64_t enable_prefetcher;
+
+            // Dot products of the solvers computed with VBLAS_DOT_EXACT instead of VBLAS_DOT_ROUNDED
+            uint64_t enable_exact_dot;
         };
 
         vblas_mt_config_t * getVBLAS_MT_Config();
@@ -48,6 +52,11 @@ namespace VPFloatPackage {
         VBLASConfig * VBLAS_getConfig(void);
 
         void VBLAS_setConfig(VBLASConfig * a_config_address);
+
+        /*
+         * Dot product mode to be used by the solvers according to enable_exact_dot.
+         */
+        VBLASDotMode VBLAS_getDotMode(void);
     }
 }
 
@@ -47,6 +47,12 @@ namespace VPFloatPackage {
             */
             VPComplex(const VPComplex & a_other);
 
+            /*
+            * Move constructor: the new complex takes over the memory of a_other, which is left empty.
+            * Nothing is allocated nor copied.
+            */
+            VPComplex(VPComplex && a_other);
+
             /*
              *
              */
@@ -100,6 +106,12 @@ namespace VPFloatPackage {
 
             VPComplex& operator =  (const int x);
             VPComplex& operator =  (const VPComplex &a_other);
+
+            /*
+             * Memory buffers are exchanged when both complex own their memory and share the same environment,
+             * otherwise the value is copied as done by the copy assignment.
+             */
+            VPComplex& operator =  (VPComplex &&a_other);
             VPComplex& operator += (const VPComplex &a_other) { this->add(a_other); return *this; }
             VPComplex& operator -= (const VPComplex &a_other) { this->sub(a_other); return *this; }
             VPComplex& operator *= (const VPComplex &a_other) { this->mul(a_other); return *this; }
@@ -112,6 +124,16 @@ namespace VPFloatPackage {
             friend VPComplex operator* (const VPComplex& a_lhs, const VPComplex& a_rhs);
             friend VPComplex operator* (const VPComplex& a_lhs, const VPFloat& a_rhs);
             friend VPComplex operator/ (const VPComplex& a_lhs, const VPComplex& a_rhs);
+
+            /*
+             * Operators taking an expiring left operand: when it owns its memory, the result is computed in place
+             * and the operand is moved to the returned complex.
+             */
+            friend VPComplex operator+ (VPComplex&& a_lhs, const VPComplex& a_rhs);
+            friend VPComplex operator- (VPComplex&& a_lhs, const VPComplex& a_rhs);
+            friend VPComplex operator* (VPComplex&& a_lhs, const VPComplex& a_rhs);
+            friend VPComplex operator* (VPComplex&& a_lhs, const VPFloat& a_rhs);
+            friend VPComplex operator/ (VPComplex&& a_lhs, const VPComplex& a_rhs);
             friend std::ostream& operator << (std::ostream & stream, const VPComplex & a_complex);
 
         private:
@@ -178,6 +200,18 @@ namespace VPFloatPackage {
             VPComplexArray(VPComplexArray & a_other);
 
             VPComplexArray(VPComplexArray * a_other);
+
+            /*
+             * Move constructor: the new array takes over the memory (and its ownership) of a_other, which is left
+             * empty.
+             */
+            VPComplexArray(VPComplexArray && a_other);
+
+            /*
+             * Move assignment: memory buffers of both arrays are exchanged, the previous memory of the current array
+             * is released with a_other.
+             */
+            VPComplexArray & operator=(VPComplexArray && a_other);
             
             VPComplexArray(float * a_data, int a_nb_elements);
 
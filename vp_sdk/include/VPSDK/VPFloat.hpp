@@ -29,6 +29,11 @@ namespace VPFloatPackage {
 
     enum VPFloatRoundingMode { VP_RNE, VP_RTZ, VP_RDN, VP_RUP, VP_RMM };
 
+    /*
+     * Base class of VPFloat expression templates (see VPSDK/VPFloatExpression.hpp)
+     */
+    template <typename E> class VPFloatExpression;
+
     /*******************************************************************************************************************
      * VPFloatComputingEnvironment
      * This class is used to manage the configuration environment for vpfloat arithmetic operations.
@@ -101,6 +106,13 @@ namespace VPFloatPackage {
 
             VPFloat(const VPFloat & a_other);
 
+            /*
+             * Move constructor: the new VPFloat takes over the memory and the environment of a_other, nothing is
+             * allocated nor copied. a_other is left empty: it can only be destroyed or be the target of a move
+             * assignment.
+             */
+            VPFloat(VPFloat && a_other);
+
             /*
              * This constructor allocate memory to store a vpfloat number that match  the environment defined by the parameters
              * given to the function:
@@ -248,18 +260,68 @@ namespace VPFloatPackage {
              */
             VPFloat & operator/=( const double a_other);
 
+            /*
+             * Fused multiply-add: the product of the two parameters is added to the value of the current VPFloat
+             * with a single rounding (this = this + a_x * a_y).
+             * The result is written in place, no temporary VPFloat is allocated. It is the operation to use in
+             * accumulation loops (dot products, matrix-vector products) on array elements.
+             * The environment of the result is the same than the one of the current VPFloat.
+             */
+            VPFloat & fma( const VPFloat & a_x, const VPFloat & a_y);
+
+            /*
+             * Fused multiply-add between the current VPFloat, a VPFloat and a double (this = this + a_x * a_y).
+             * The result is written in place, no temporary VPFloat is allocated.
+             * The environment of the result is the same than the one of the current VPFloat.
+             */
+            VPFloat & fma( const VPFloat & a_x, double a_y);
+
+            /*
+             * Fused multiply-substract: the product of the two parameters is substracted from the value of the current
+             * VPFloat with a single rounding (this = this - a_x * a_y).
+             * The result is written in place, no temporary VPFloat is allocated.
+             * The environment of the result is the same than the one of the current VPFloat.
+             */
+            VPFloat & fms( const VPFloat & a_x, const VPFloat & a_y);
+
+            /*
+             * Fused multiply-substract between the current VPFloat, a VPFloat and a double (this = this - a_x * a_y).
+             * The result is written in place, no temporary VPFloat is allocated.
+             * The environment of the result is the same than the one of the current VPFloat.
+             */
+            VPFloat & fms( const VPFloat & a_x, double a_y);
+
             /*
              * Store the value from the VPFloat number given as parameter into the current VPFloat. The value is
              * converted to the current VPFloat environment.
              */
             VPFloat & operator=( const VPFloat & a_other);
 
+            /*
+             * Store the value of an expiring VPFloat into the current VPFloat. When both VPFloat own their memory and
+             * share the same environment, memory buffers are exchanged instead of being copied. Otherwise (e.g. the
+             * current VPFloat is an element of a VPFloatArray) the value is converted to the current VPFloat
+             * environment as done by the copy assignment.
+             */
+            VPFloat & operator=( VPFloat && a_other);
+
             /*
              * Store the value from the double number given as parameter into the current VPFloat. The value is
              * converted to the current VPFloat environment.
              */
             VPFloat & operator=( double a_other);
 
+            /*
+             * Evaluate the expression given as parameter directly into the current VPFloat (see
+             * VPSDK/VPFloatExpression.hpp). Intermediate results are stored in scratch registers, no VPFloat is
+             * allocated.
+             */
+            template <typename E>
+            VPFloat & operator=( const VPFloatExpression<E> & a_expression) {
+                a_expression.evaluate(*this);
+                return *this;
+            }
+
             /*
              * Function returning a double approximation of the current VPFloat number
              */
@@ -281,12 +343,17 @@ namespace VPFloatPackage {
             void exponent(const int64_t a_exponent);
 
             /*
-             * Function returning current VPFloat mantissa chunk of index chunk_index
+             * Function returning current VPFloat mantissa chunk of index chunk_index.
+             * Chunks hold the P_CHUNK_LEN bits of the mantissa following its implicit leading bit, most significant
+             * bit first. The last chunk is padded with zeros.
              */
             uint64_t mantissaChunk(const uint16_t a_chunk_index) const;
 
             /*
-             * Function setting current VPFloat mantissa chunk of index chunk_index
+             * Function setting current VPFloat mantissa chunk of index chunk_index.
+             * Bits of the chunk beyond the precision of the number are rounded according the current rounding mode,
+             * also when the whole chunk is beyond it. With the MPFR backend, chunks are read and written directly in
+             * the significand limbs.
              */
             void mantissaChunk(const uint16_t a_chunk_index, const uint64_t a_chunk_value);
 
@@ -402,6 +469,35 @@ namespace VPFloatPackage {
              */
             friend VPFloat operator-( const VPFloat & a_rhs);
 
+            /*
+             * Arithmetic operators taking an expiring VPFloat (e.g. the result of another operator in a + b * c).
+             * When the expiring operand owns its memory and is configured with the temporary variable environment,
+             * the result is computed in place into its memory and moved to the returned VPFloat: no memory is
+             * allocated. Otherwise, they behave as the operators above.
+             */
+            friend VPFloat operator+( VPFloat && a_lhs, const VPFloat & a_rhs );
+            friend VPFloat operator+( const VPFloat & a_lhs, VPFloat && a_rhs );
+            friend VPFloat operator+( VPFloat && a_lhs, VPFloat && a_rhs );
+            friend VPFloat operator+( VPFloat && a_lhs, double a_rhs );
+            friend VPFloat operator-( VPFloat && a_lhs, const VPFloat & a_rhs );
+            friend VPFloat operator-( const VPFloat & a_lhs, VPFloat && a_rhs );
+            friend VPFloat operator-( VPFloat && a_lhs, VPFloat && a_rhs );
+            friend VPFloat operator-( VPFloat && a_lhs, double a_rhs );
+            friend VPFloat operator*( VPFloat && a_lhs, const VPFloat & a_rhs );
+            friend VPFloat operator*( const VPFloat & a_lhs, VPFloat && a_rhs );
+            friend VPFloat operator*( VPFloat && a_lhs, VPFloat && a_rhs );
+            friend VPFloat operator*( VPFloat && a_lhs, double a_rhs );
+            friend VPFloat operator/( VPFloat && a_lhs, const VPFloat & a_rhs );
+            friend VPFloat operator/( const VPFloat & a_lhs, VPFloat && a_rhs );
+            friend VPFloat operator/( VPFloat && a_lhs, VPFloat && a_rhs );
+            friend VPFloat operator/( VPFloat && a_lhs, double a_rhs );
+
+            /*
+             * Sign invertion operator taking an expiring VPFloat. When the operand owns its memory, the sign is
+             * inverted in place and the operand is moved to the returned VPFloat.
+             */
+            friend VPFloat operator-( VPFloat && a_rhs);
+
             /*
              * Comparison of two VPFloat scalar
              * This operator use to current configuration set into VPFloatComputingEnvironment.
@@ -467,6 +563,12 @@ namespace VPFloatPackage {
             static VPFloat pow2(int n, vpfloat_es_t a_exponent_size, vpfloat_prec_t a_bis, vpfloat_off_t a_stride );
 
         protected:
+            /*
+             * Returns true when the memory of the current VPFloat can receive the result of a binary operator:
+             * the memory is owned by the current VPFloat and its environment is the temporary variable environment.
+             */
+            bool isReusableAsTemporary() const;
+
             /*
              * Configuration environment for the current VPFloat
              */
@@ -493,6 +595,57 @@ namespace VPFloatPackage {
             bool m_release_m_data_on_destruction;
     };
 
+    /*******************************************************************************************************************
+     * VPFloatOperation Class
+     * In place arithmetic operations between VPFloat: the result is written into the memory of an existing VPFloat
+     * and rounded according its environment. No memory is allocated.
+     * These operations are the building blocks used to evaluate VPFloat expression templates.
+     ******************************************************************************************************************/
+    class VPFloatOperation {
+        public:
+            /* a_result = a_x */
+            static void set(VPFloat & a_result, const VPFloat & a_x);
+
+            /* a_result = a_x */
+            static void set(VPFloat & a_result, double a_x);
+
+            /* a_result = a_x + a_y */
+            static void add(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y);
+
+            /* a_result = a_x - a_y */
+            static void sub(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y);
+
+            /* a_result = a_x * a_y */
+            static void mul(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y);
+
+            /* a_result = a_x / a_y */
+            static void div(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y);
+
+            /* a_result = a_x + a_y */
+            static void add(VPFloat & a_result, const VPFloat & a_x, double a_y);
+
+            /* a_result = a_x - a_y */
+            static void sub(VPFloat & a_result, const VPFloat & a_x, double a_y);
+
+            /* a_result = a_x * a_y */
+            static void mul(VPFloat & a_result, const VPFloat & a_x, double a_y);
+
+            /* a_result = a_x / a_y */
+            static void div(VPFloat & a_result, const VPFloat & a_x, double a_y);
+
+            /* a_result = a_x * a_y + a_z */
+            static void fma(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z);
+
+            /* a_result = a_x * a_y - a_z */
+            static void fms(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z);
+
+            /* a_result = a_z - a_x * a_y */
+            static void fnma(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z);
+
+            /* a_result = -a_x */
+            static void neg(VPFloat & a_result, const VPFloat & a_x);
+    };
+
     /*******************************************************************************************************************
      * VPFloatArray Class
      * This class is used to manage array of vpfloats.
@@ -505,21 +658,48 @@ namespace VPFloatPackage {
              *   - bis
              *   - stride
              * The array will contain nb_elements contiguous vpfloat.
+             * With the MPFR backend, the whole array (numbers and their mantissa limbs) is stored in a single aligned
+             * memory block.
              */
             VPFloatArray(vpfloat_es_t a_exponent_size, vpfloat_prec_t a_bis, vpfloat_off_t a_stride, int a_nb_elements);
 
             /*
-             * Constructor used to copy one array to a new one.
-             * Data are copied.
+             * Constructor building a reference on an existing array.
+             * Data are not copied: the new array uses the memory of a_other, which keeps the ownership of it.
              */
             VPFloatArray(VPFloatArray & a_other);
 
             /*
-             * Constructor used to copy one array to a new one.
-             * Data are copied.
+             * Constructor building a reference on an existing array.
+             * Data are not copied: the new array uses the memory of a_other, which keeps the ownership of it.
              */
             VPFloatArray(VPFloatArray * a_other);
 
+            /*
+             * Constructor building a reference on the elements [a_first_element, a_first_element + a_nb_elements[ of
+             * an existing array, e.g. one vector of a block of vectors stored contiguously.
+             * Data are not copied: the new array uses the memory of a_other, which keeps the ownership of it.
+             */
+            VPFloatArray(VPFloatArray & a_other, int a_first_element, int a_nb_elements);
+
+            /*
+             * Same reference on the elements of a constant array, for the functions reading a block of vectors
+             * received as a constant. The elements must not be modified through the new array.
+             */
+            VPFloatArray(const VPFloatArray & a_other, int a_first_element, int a_nb_elements);
+
+            /*
+             * Move constructor: the new array takes over the memory (and its ownership) of a_other, which is left
+             * empty.
+             */
+            VPFloatArray(VPFloatArray && a_other);
+
+            /*
+             * Move assignment: memory buffers of both arrays are exchanged, the previous memory of the current array
+             * is released with a_other.
+             */
+            VPFloatArray & operator=( VPFloatArray && a_other);
+
             /*
              * Constructor used to build a VPFloatArray upon an existing double array.
              */
@@ -543,6 +723,9 @@ namespace VPFloatPackage {
             /*
              * This operator return a VPFloat object that point to the data of the element at index of the array.
              * If modification are made to the returned VPFloat, the data in the array are modified.
+             * The returned VPFloat is a reference on the element: no memory is allocated nor released by it, so
+             * in-place operations (+=, *=, fma, fms, =) on it are free of heap allocations. Binary operators
+             * (+, -, *, /) still build a new temporary VPFloat and should be avoided in inner loops.
              */
             VPFloat operator [](int index) const;
 
@@ -558,6 +741,31 @@ namespace VPFloatPackage {
              */
             void printAsVector(char * a_label) const;
 
+            /*
+             * Function writing the elements of the array into a_buffer with the VRP memory format of a_environment
+             * (sign, biased exponent on es bits and bis - es - 1 significand bits). Element n is stored at byte offset
+             * n * VPFLOAT_SIZEOF(a_environment). Values are rounded according the current rounding mode.
+             * This is the format used by the VRP to store vpfloat arrays: the buffer can be shipped to the VRP
+             * without loss of precision.
+             * The MPFR implementation supports es in [1, 63] and bis in [es + 2, BISMAX]: it returns -1 without
+             * writing a_buffer for other environments, and 0 on success.
+             */
+            int pack(void * a_buffer, vpfloat_evp_t a_environment) const;
+
+            /*
+             * Function loading the elements of the array from a_buffer, which holds nbElements() numbers stored with
+             * the VRP memory format of a_environment. Values are rounded to the environment of the array.
+             * Supported environments and return values are the ones of pack, the array is left unchanged on error.
+             */
+            int unpack(const void * a_buffer, vpfloat_evp_t a_environment);
+
+            /*
+             * Function returning the size in bytes of the array stored with the VRP memory format of a_environment
+             */
+            size_t packedSize(vpfloat_evp_t a_environment) const {
+                return (size_t)this->m_nb_elements * VPFLOAT_SIZEOF(a_environment);
+            }
+
         private:
             /*
              * Number of elements in the array.
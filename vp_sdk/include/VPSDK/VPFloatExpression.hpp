@@ -0,0 +1,372 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : August, 2023
+ * Description   : Expression templates used to evaluate VPFloat expressions directly into their destination.
+ **/
+
+#ifndef __VPFLOAT_EXPRESSION_HPP__
+#define __VPFLOAT_EXPRESSION_HPP__
+
+#include "VPSDK/VPFloat.hpp"
+
+namespace VPFloatPackage {
+
+    /*******************************************************************************************************************
+     * VPFloatScratchRegisters Class
+     * Pool of VPFloat used to store intermediate results while evaluating an expression.
+     * Registers are configured with the temporary variable environment (see VPFloatComputingEnvironment). They are
+     * allocated on first use and only reallocated when this environment changes, so evaluating an expression does not
+     * allocate memory.
+     * As VPFloatComputingEnvironment, the pool is shared by the whole program and is not thread safe.
+     ******************************************************************************************************************/
+    class VPFloatScratchRegisters {
+        public:
+            /*
+             * Number of registers of the pool. It bounds the depth of the expressions that can be evaluated.
+             */
+            static const int NB_REGISTERS = 8;
+
+            /*
+             * Returns the register of index a_index configured with the current temporary variable environment.
+             */
+            static VPFloat & get(int a_index);
+    };
+
+    /*******************************************************************************************************************
+     * VPFloatExpression Class
+     * Base class of all the nodes of an expression. An expression is only a description of the computation: nothing
+     * is computed until it is assigned to a VPFloat (or to an element of a VPFloatArray):
+     *
+     *   y[i] = vpexpr(res) * alpha + y[i];    // evaluated with a single mpfr_fma into y[i]
+     *
+     * Patterns a*b+c, c+a*b, a*b-c and c-a*b are evaluated with one fused operation (single rounding).
+     * Other intermediate results are stored in VPFloatScratchRegisters.
+     * Expressions keep references on their VPFloat operands, so they must be evaluated in the statement building them.
+     ******************************************************************************************************************/
+    template <typename E>
+    class VPFloatExpression {
+        public:
+            const E & self() const {
+                return static_cast<const E &>(*this);
+            }
+
+            /*
+             * Evaluate the expression and store the result into a_result.
+             */
+            void evaluate(VPFloat & a_result) const {
+                static_assert(E::registers <= VPFloatScratchRegisters::NB_REGISTERS, "VPFloat expression too deep for the scratch register pool.");
+                this->self().evaluateInto(a_result, 0);
+            }
+    };
+
+    /*
+     * Operation tags
+     */
+    struct VPAdd {};
+    struct VPSub {};
+    struct VPMul {};
+    struct VPDiv {};
+
+    /*******************************************************************************************************************
+     * Leaves of the expressions
+     *
+     * Each node defines:
+     *   - registers: number of scratch registers needed to evaluate the node into a destination
+     *   - held: number of registers still in use when the node is used as an operand
+     *   - operand(base): returns a VPFloat holding the value of the node, using registers from index base
+     ******************************************************************************************************************/
+    class VPFloatTerminal : public VPFloatExpression<VPFloatTerminal> {
+        public:
+            static const int registers = 0;
+            static const int held = 0;
+
+            explicit VPFloatTerminal(const VPFloat & a_value) : m_value(a_value) {}
+
+            void evaluateInto(VPFloat & a_result, int /* a_base */) const {
+                VPFloatOperation::set(a_result, this->m_value);
+            }
+
+            const VPFloat & operand(int /* a_base */) const {
+                return this->m_value;
+            }
+
+        private:
+            const VPFloat & m_value;
+    };
+
+    class VPDoubleTerminal : public VPFloatExpression<VPDoubleTerminal> {
+        public:
+            static const int registers = 0;
+            static const int held = 1;
+
+            explicit VPDoubleTerminal(double a_value) : m_value(a_value) {}
+
+            void evaluateInto(VPFloat & a_result, int /* a_base */) const {
+                VPFloatOperation::set(a_result, this->m_value);
+            }
+
+            const VPFloat & operand(int a_base) const {
+                VPFloat & l_register = VPFloatScratchRegisters::get(a_base);
+                VPFloatOperation::set(l_register, this->m_value);
+                return l_register;
+            }
+
+        private:
+            double m_value;
+    };
+
+    /*******************************************************************************************************************
+     * Inner nodes of the expressions
+     ******************************************************************************************************************/
+    template <typename Op, typename L, typename R>
+    struct VPFloatEvaluator;
+
+    template <typename Op, typename L, typename R>
+    class VPBinaryExpression : public VPFloatExpression< VPBinaryExpression<Op, L, R> > {
+        public:
+            static const int registers = VPFloatEvaluator<Op, L, R>::registers;
+            static const int held = 1;
+
+            VPBinaryExpression(const L & a_lhs, const R & a_rhs) : m_lhs(a_lhs), m_rhs(a_rhs) {}
+
+            const L & lhs() const { return this->m_lhs; }
+            const R & rhs() const { return this->m_rhs; }
+
+            void evaluateInto(VPFloat & a_result, int a_base) const {
+                VPFloatEvaluator<Op, L, R>::evaluate(a_result, this->m_lhs, this->m_rhs, a_base);
+            }
+
+            const VPFloat & operand(int a_base) const {
+                VPFloat & l_register = VPFloatScratchRegisters::get(a_base);
+                this->evaluateInto(l_register, a_base + 1);
+                return l_register;
+            }
+
+        private:
+            const L m_lhs;
+            const R m_rhs;
+    };
+
+    template <typename E>
+    class VPNegateExpression : public VPFloatExpression< VPNegateExpression<E> > {
+        public:
+            static const int registers = E::registers + E::held;
+            static const int held = 1;
+
+            explicit VPNegateExpression(const E & a_value) : m_value(a_value) {}
+
+            void evaluateInto(VPFloat & a_result, int a_base) const {
+                VPFloatOperation::neg(a_result, this->m_value.operand(a_base));
+            }
+
+            const VPFloat & operand(int a_base) const {
+                VPFloat & l_register = VPFloatScratchRegisters::get(a_base);
+                this->evaluateInto(l_register, a_base + 1);
+                return l_register;
+            }
+
+        private:
+            const E m_value;
+    };
+
+    /*******************************************************************************************************************
+     * Evaluation of the inner nodes
+     * The left operand is evaluated first, in registers starting at base. The right operand is then evaluated in
+     * registers located after the one holding the left operand.
+     ******************************************************************************************************************/
+    template <typename L, typename R>
+    struct VPFloatBinaryRegisters {
+        static const int left = L::registers + L::held;
+        static const int right = L::held + R::registers + R::held;
+        static const int value = left > right ? left : right;
+    };
+
+    template <typename A, typename B, typename C>
+    struct VPFloatTernaryRegisters {
+        static const int first = VPFloatBinaryRegisters<A, B>::value;
+        static const int last = A::held + B::held + C::registers + C::held;
+        static const int value = first > last ? first : last;
+    };
+
+    template <typename L, typename R>
+    struct VPFloatEvaluator<VPAdd, L, R> {
+        static const int registers = VPFloatBinaryRegisters<L, R>::value;
+        static void evaluate(VPFloat & a_result, const L & a_lhs, const R & a_rhs, int a_base) {
+            const VPFloat & l_lhs = a_lhs.operand(a_base);
+            VPFloatOperation::add(a_result, l_lhs, a_rhs.operand(a_base + L::held));
+        }
+    };
+
+    template <typename L, typename R>
+    struct VPFloatEvaluator<VPSub, L, R> {
+        static const int registers = VPFloatBinaryRegisters<L, R>::value;
+        static void evaluate(VPFloat & a_result, const L & a_lhs, const R & a_rhs, int a_base) {
+            const VPFloat & l_lhs = a_lhs.operand(a_base);
+            VPFloatOperation::sub(a_result, l_lhs, a_rhs.operand(a_base + L::held));
+        }
+    };
+
+    template <typename L, typename R>
+    struct VPFloatEvaluator<VPMul, L, R> {
+        static const int registers = VPFloatBinaryRegisters<L, R>::value;
+        static void evaluate(VPFloat & a_result, const L & a_lhs, const R & a_rhs, int a_base) {
+            const VPFloat & l_lhs = a_lhs.operand(a_base);
+            VPFloatOperation::mul(a_result, l_lhs, a_rhs.operand(a_base + L::held));
+        }
+    };
+
+    template <typename L, typename R>
+    struct VPFloatEvaluator<VPDiv, L, R> {
+        static const int registers = VPFloatBinaryRegisters<L, R>::value;
+        static void evaluate(VPFloat & a_result, const L & a_lhs, const R & a_rhs, int a_base) {
+            const VPFloat & l_lhs = a_lhs.operand(a_base);
+            VPFloatOperation::div(a_result, l_lhs, a_rhs.operand(a_base + L::held));
+        }
+    };
+
+    /*
+     * a*b + c
+     */
+    template <typename A, typename B, typename C>
+    struct VPFloatEvaluator<VPAdd, VPBinaryExpression<VPMul, A, B>, C> {
+        static const int registers = VPFloatTernaryRegisters<A, B, C>::value;
+        static void evaluate(VPFloat & a_result, const VPBinaryExpression<VPMul, A, B> & a_lhs, const C & a_rhs, int a_base) {
+            const VPFloat & l_a = a_lhs.lhs().operand(a_base);
+            const VPFloat & l_b = a_lhs.rhs().operand(a_base + A::held);
+            VPFloatOperation::fma(a_result, l_a, l_b, a_rhs.operand(a_base + A::held + B::held));
+        }
+    };
+
+    /*
+     * c + a*b
+     */
+    template <typename C, typename A, typename B>
+    struct VPFloatEvaluator<VPAdd, C, VPBinaryExpression<VPMul, A, B> > {
+        static const int registers = VPFloatTernaryRegisters<A, B, C>::value;
+        static void evaluate(VPFloat & a_result, const C & a_lhs, const VPBinaryExpression<VPMul, A, B> & a_rhs, int a_base) {
+            const VPFloat & l_a = a_rhs.lhs().operand(a_base);
+            const VPFloat & l_b = a_rhs.rhs().operand(a_base + A::held);
+            VPFloatOperation::fma(a_result, l_a, l_b, a_lhs.operand(a_base + A::held + B::held));
+        }
+    };
+
+    /*
+     * a*b + c*d: the second product is computed first, the first one is fused with the addition.
+     */
+    template <typename A, typename B, typename C, typename D>
+    struct VPFloatEvaluator<VPAdd, VPBinaryExpression<VPMul, A, B>, VPBinaryExpression<VPMul, C, D> > {
+        typedef VPBinaryExpression<VPMul, C, D> Product;
+        static const int registers = VPFloatTernaryRegisters<Product, A, B>::value;
+        static void evaluate(VPFloat & a_result, const VPBinaryExpression<VPMul, A, B> & a_lhs, const Product & a_rhs, int a_base) {
+            const VPFloat & l_c = a_rhs.operand(a_base);
+            const VPFloat & l_a = a_lhs.lhs().operand(a_base + Product::held);
+            VPFloatOperation::fma(a_result, l_a, a_lhs.rhs().operand(a_base + Product::held + A::held), l_c);
+        }
+    };
+
+    /*
+     * a*b - c
+     */
+    template <typename A, typename B, typename C>
+    struct VPFloatEvaluator<VPSub, VPBinaryExpression<VPMul, A, B>, C> {
+        static const int registers = VPFloatTernaryRegisters<A, B, C>::value;
+        static void evaluate(VPFloat & a_result, const VPBinaryExpression<VPMul, A, B> & a_lhs, const C & a_rhs, int a_base) {
+            const VPFloat & l_a = a_lhs.lhs().operand(a_base);
+            const VPFloat & l_b = a_lhs.rhs().operand(a_base + A::held);
+            VPFloatOperation::fms(a_result, l_a, l_b, a_rhs.operand(a_base + A::held + B::held));
+        }
+    };
+
+    /*
+     * c - a*b
+     */
+    template <typename C, typename A, typename B>
+    struct VPFloatEvaluator<VPSub, C, VPBinaryExpression<VPMul, A, B> > {
+        static const int registers = VPFloatTernaryRegisters<A, B, C>::value;
+        static void evaluate(VPFloat & a_result, const C & a_lhs, const VPBinaryExpression<VPMul, A, B> & a_rhs, int a_base) {
+            const VPFloat & l_a = a_rhs.lhs().operand(a_base);
+            const VPFloat & l_b = a_rhs.rhs().operand(a_base + A::held);
+            VPFloatOperation::fnma(a_result, l_a, l_b, a_lhs.operand(a_base + A::held + B::held));
+        }
+    };
+
+    /*
+     * a*b - c*d: the second product is computed first, the first one is fused with the substraction.
+     */
+    template <typename A, typename B, typename C, typename D>
+    struct VPFloatEvaluator<VPSub, VPBinaryExpression<VPMul, A, B>, VPBinaryExpression<VPMul, C, D> > {
+        typedef VPBinaryExpression<VPMul, C, D> Product;
+        static const int registers = VPFloatTernaryRegisters<Product, A, B>::value;
+        static void evaluate(VPFloat & a_result, const VPBinaryExpression<VPMul, A, B> & a_lhs, const Product & a_rhs, int a_base) {
+            const VPFloat & l_c = a_rhs.operand(a_base);
+            const VPFloat & l_a = a_lhs.lhs().operand(a_base + Product::held);
+            VPFloatOperation::fms(a_result, l_a, a_lhs.rhs().operand(a_base + Product::held + A::held), l_c);
+        }
+    };
+
+    /*******************************************************************************************************************
+     * Functions used to start an expression
+     ******************************************************************************************************************/
+    inline VPFloatTerminal vpexpr(const VPFloat & a_value) {
+        return VPFloatTerminal(a_value);
+    }
+
+    inline VPDoubleTerminal vpexpr(double a_value) {
+        return VPDoubleTerminal(a_value);
+    }
+
+    /*******************************************************************************************************************
+     * Operators building the expressions
+     ******************************************************************************************************************/
+#define VPFLOAT_EXPRESSION_OPERATOR(SYMBOL, TAG)                                                                               \
+    template <typename L, typename R>                                                                                          \
+    VPBinaryExpression<TAG, L, R> operator SYMBOL (const VPFloatExpression<L> & a_lhs, const VPFloatExpression<R> & a_rhs) {  \
+        return VPBinaryExpression<TAG, L, R>(a_lhs.self(), a_rhs.self());                                                      \
+    }                                                                                                                          \
+    template <typename L>                                                                                                      \
+    VPBinaryExpression<TAG, L, VPFloatTerminal> operator SYMBOL (const VPFloatExpression<L> & a_lhs, const VPFloat & a_rhs) { \
+        return VPBinaryExpression<TAG, L, VPFloatTerminal>(a_lhs.self(), VPFloatTerminal(a_rhs));                              \
+    }                                                                                                                          \
+    template <typename R>                                                                                                      \
+    VPBinaryExpression<TAG, VPFloatTerminal, R> operator SYMBOL (const VPFloat & a_lhs, const VPFloatExpression<R> & a_rhs) { \
+        return VPBinaryExpression<TAG, VPFloatTerminal, R>(VPFloatTerminal(a_lhs), a_rhs.self());                              \
+    }                                                                                                                          \
+    template <typename L>                                                                                                      \
+    VPBinaryExpression<TAG, L, VPDoubleTerminal> operator SYMBOL (const VPFloatExpression<L> & a_lhs, double a_rhs) {       \
+        return VPBinaryExpression<TAG, L, VPDoubleTerminal>(a_lhs.self(), VPDoubleTerminal(a_rhs));                            \
+    }                                                                                                                          \
+    template <typename R>                                                                                                      \
+    VPBinaryExpression<TAG, VPDoubleTerminal, R> operator SYMBOL (double a_lhs, const VPFloatExpression<R> & a_rhs) {       \
+        return VPBinaryExpression<TAG, VPDoubleTerminal, R>(VPDoubleTerminal(a_lhs), a_rhs.self());                            \
+    }
+
+    VPFLOAT_EXPRESSION_OPERATOR(+, VPAdd)
+    VPFLOAT_EXPRESSION_OPERATOR(-, VPSub)
+    VPFLOAT_EXPRESSION_OPERATOR(*, VPMul)
+    VPFLOAT_EXPRESSION_OPERATOR(/, VPDiv)
+
+#undef VPFLOAT_EXPRESSION_OPERATOR
+
+    template <typename E>
+    VPNegateExpression<E> operator-(const VPFloatExpression<E> & a_value) {
+        return VPNegateExpression<E>(a_value.self());
+    }
+
+}
+
+#endif /* __VPFLOAT_EXPRESSION_HPP__ */
@@ -27,17 +27,73 @@
 
 namespace VPFloatPackage::Solver {
 
-    int bicg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0);
+    int bicg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
 
-    int precond_bicg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, matrix_t iM, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0);
+    int precond_bicg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, matrix_t iM, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
 
-    int bicgstab(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0);
+    int bicgstab(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
 
-    int cg(int precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0);
+    int cg(int precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
 
-    int precond_cg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t iM, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0);
+    /*
+     * CG with an adaptive working precision: the iterations start at initial_precision, and the precision is doubled,
+     * up to precision, when the true residual b - op(A) x stagnates or drifts away from the recursive one. Each
+     * precision change replaces the recursive residual by the true one. Logs a "precision : <bits> - iter : <iteration>"
+     * trace line at each residual check. initial_precision must be in [1, precision] (-1 is returned otherwise).
+     */
+    int cg_adaptive(int precision, int initial_precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
 
-    int qmr(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0);
+    /*
+     * Pipelined CG (Ghysels and Vanroose): one merged reduction per iteration, independent of the matrix-vector
+     * product of the iteration. Same arguments as cg; its attainable accuracy is lower at the same precision.
+     */
+    int pipecg(int precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
+
+    /*
+     * CG for k right hand sides: x and b hold k vectors of n elements stored contiguously, vector j being
+     * x[j*n .. (j+1)*n[. The matrix products of all the vectors are made by a single VBLAS::vgemmd call per
+     * iteration, which reads A once.
+     *
+     * cg_multi runs k independent CG solves, each vector giving the solution and the iterations of cg. block_cg is
+     * the block CG of O'Leary: the search space is shared by the k vectors, which usually takes fewer iterations.
+     * Its dependent directions are deflated, so zero, duplicated or linearly dependent right hand sides are solved.
+     * Both return the iterations of the slowest vector, or -1 when a vector does not reach tolerance.
+     */
+    int cg_multi(int precision, int transpose, int n, int k, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
+
+    int block_cg(int precision, int transpose, int n, int k, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
+
+    int precond_cg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t iM, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
+
+    /*
+     * GMRES restarted every restart iterations: the Arnoldi basis holds restart + 1 vectors of n elements.
+     * restart must be at least 1 (-1 is returned otherwise), a restart above n is reduced to n.
+     */
+    int gmres(int precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, int restart = 30, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
+
+    /*
+     * Flexible GMRES: GMRES(restart) right preconditioned by iM. The preconditioned vectors iM v_j are kept, so the
+     * basis takes twice the memory of gmres.
+     */
+    int fgmres(int precision, int transpose, int n, double * x, matrix_t A, matrix_t iM, double * b, double tolerance, int restart = 30, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
+
+    int qmr(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, uint16_t exponent_size = 7, int32_t stride_size = 1, char * log_buffer = NULL, uint64_t log_buffer_size = 0, const int * permutation = NULL);
+
+    typedef enum {
+        REFINEMENT_CG,
+        REFINEMENT_BICGSTAB,
+        REFINEMENT_QMR
+    } refinement_solver_e;
+
+    /*
+     * Mixed precision iterative refinement of op(A) x = b, op(A) being A^T when transpose is 1. Each refinement
+     * computes r = b - op(A) x at precision, solves op(A) d = r with inner_solver at inner_precision up to a relative
+     * inner_tolerance, and adds d to x at precision. x holds the initial guess; the refinements stop when ||r|| is
+     * below tolerance, when ||r|| stops decreasing or after max_refinements corrections.
+     *
+     * Returns the total number of inner iterations, or -1 when tolerance is not reached.
+     */
+    int refine(refinement_solver_e inner_solver, int precision, int inner_precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, double inner_tolerance = 1e-6, int max_refinements = 50, uint16_t exponent_size = 7, int32_t stride_size = 1, const int * permutation = NULL);
 };
 
 #endif /* __SOLVERS_HPP__ */
\ No newline at end of file
@@ -28,13 +28,14 @@
 #include <stdint.h>
 
 namespace VPFloatPackage::Offloading::VRP_Matrix_BCSR_serializer {
-        dmatBCSR_t fromBuffer(uint64_t * a_address);
-        void flaten(matrix_t a_matrix, uint64_t * a_free_address);
-        void flatenBCSR(dmatBCSR_t a_bcsr, types_value_e a_type_value, uint64_t * a_free_address);
+        dmatBCSR_t fromBuffer(uint64_t * a_address, uint64_t a_buffer_start_address);
+        void flaten(matrix_t a_matrix, uint64_t * a_free_address, uint64_t a_buffer_start_address);
+        void flatenBCSR(dmatBCSR_t a_bcsr, types_value_e a_type_value, uint64_t * a_free_address, uint64_t a_buffer_start_address);
         void print(matrix_t a_matrix);
         void printBCSR(dmatBCSR_t a_bcsr);
-        size_t getSize(matrix_t a_matrix);
-        size_t getSizeBCSR(dmatBCSR_t a_bcsr, types_value_e a_type_value);
+        size_t getSize(matrix_t a_matrix, size_t a_offset);
+        size_t getSizeBCSR(dmatBCSR_t a_bcsr, types_value_e a_type_value, size_t a_offset);
+        size_t getAlignment();
 };
 
 #endif /* __VRP_BCSR_SERIALIZER_HPP__ */
\ No newline at end of file
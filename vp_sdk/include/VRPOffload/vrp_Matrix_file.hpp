@@ -0,0 +1,118 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Binary matrix files, memory mapped and used in place.
+ *
+ *                 A file starts with a 64 bytes header followed by a table of 64 bytes section descriptors. Each
+ *                 section holds a matrix as produced by VRP_Matrix_serializer::flaten and starts on a 64 bytes
+ *                 boundary of the file, so the mapping of a section is a valid offloading buffer and the arrays of
+ *                 the matrix keep the alignment they have in the serializer.
+ **/
+
+#ifndef __VRP_MATRIX_FILE_HPP__
+#define __VRP_MATRIX_FILE_HPP__
+
+#include "Matrix/matrix.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+
+#define VRP_MATRIX_FILE_MAGIC "VPMATRIX"
+#define VRP_MATRIX_FILE_VERSION 1
+#define VRP_MATRIX_FILE_ALIGNMENT 64
+
+/*
+ * Role of the matrices stored in a file.
+ */
+typedef enum vrp_matrix_file_role {
+    VRP_MATRIX_FILE_A,
+    VRP_MATRIX_FILE_A_TRANSPOSED,
+    VRP_MATRIX_FILE_PRECONDITIONER,
+    VRP_MATRIX_FILE_PRECONDITIONER_TRANSPOSED,
+    VRP_MATRIX_FILE_NB_ROLES
+} vrp_matrix_file_role_e;
+
+typedef struct vrp_matrix_file_header {
+    char magic[8];
+    uint64_t version;
+    uint64_t source_hash;       // hash of the file the matrices are built from
+    uint64_t nb_sections;
+    uint64_t reserved[4];
+} vrp_matrix_file_header_t;
+
+typedef struct vrp_matrix_file_section {
+    uint64_t role;
+    uint64_t offset;            // from the start of the file
+    uint64_t size;
+    uint64_t type_matrix;
+    uint64_t type_value;
+    uint64_t m;
+    uint64_t n;
+    uint64_t reserved;
+} vrp_matrix_file_section_t;
+
+/*
+ * Mapped file. The matrices point inside the mapping and are valid until unmap.
+ */
+typedef struct vrp_matrix_file {
+    void * address;
+    size_t size;
+    vrp_matrix_file_header_t * header;
+    vrp_matrix_file_section_t * sections;
+    matrix_t matrices[VRP_MATRIX_FILE_NB_ROLES];
+} vrp_matrix_file_t;
+
+namespace VPFloatPackage::Offloading::VRP_Matrix_file {
+        /*
+         * 64 bits FNV-1a hash of a file content, 0 when the file can not be read.
+         */
+        uint64_t hashFile(const char * a_file_path);
+
+        /*
+         * Path of the file caching the matrices built from a source file with a given hash, a_variant describing
+         * the way they are built (format, options...).
+         */
+        std::string getCachePath(const char * a_cache_directory, uint64_t a_source_hash, const char * a_variant);
+
+        /*
+         * Writes the non NULL matrices of a_matrices (indexed by role). The file is written aside and renamed,
+         * so processes mapping a previous version keep a valid mapping.
+         */
+        int save(const char * a_file_path, uint64_t a_source_hash, matrix_t a_matrices[VRP_MATRIX_FILE_NB_ROLES]);
+
+        /*
+         * Maps a file. Returns NULL when the file does not exist, is not valid or was not built from a source with
+         * a_source_hash (0 to accept any source).
+         */
+        vrp_matrix_file_t * map(const char * a_file_path, uint64_t a_source_hash);
+
+        /*
+         * Matrix with the given role, or NULL when the file does not hold it.
+         */
+        matrix_t getMatrix(vrp_matrix_file_t * a_file, vrp_matrix_file_role_e a_role);
+
+        /*
+         * Serialized matrix of a mapped file, used as is for offloading. Returns NULL when a_matrix does not come
+         * from a mapped file.
+         */
+        void * getFlatMatrix(matrix_t a_matrix, size_t * a_size);
+
+        void unmap(vrp_matrix_file_t * a_file);
+};
+
+#endif /* __VRP_MATRIX_FILE_HPP__ */
@@ -21,6 +21,7 @@
 
 #include "VPSDK/VBLASComplex.hpp"
 #include "VPSDK/VMath.hpp"
+#include "VBLASThreadPool.hpp"
 #include "Matrix/DENSE.h"
 #include <iostream>
 
@@ -162,9 +163,68 @@ void VBLAS::zdotc ( int n,
     } 
 }
 
+struct ComplexDotJob {
+    const VPComplexArray * x;
+    const VPComplexArray * y;
+    VPComplexArray * partials;
+};
+
+static void vcdotuBlock(void * a_args, int64_t a_block_index, int64_t a_start, int64_t a_end) {
+    ComplexDotJob * l_job = (ComplexDotJob *)a_args;
+    const VPComplexArray & x = *(l_job->x);
+    const VPComplexArray & y = *(l_job->y);
+    VPComplex l_partial = (*(l_job->partials))[a_block_index];
+
+    l_partial.real(0.0);
+    l_partial.imag(0.0);
+
+    for (int i=a_start; i<a_end; i++) {
+        l_partial += x[i]*y[i];
+    }
+}
+
+static void vcdotcBlock(void * a_args, int64_t a_block_index, int64_t a_start, int64_t a_end) {
+    ComplexDotJob * l_job = (ComplexDotJob *)a_args;
+    const VPComplexArray & x = *(l_job->x);
+    const VPComplexArray & y = *(l_job->y);
+    VPComplex l_partial = (*(l_job->partials))[a_block_index];
+
+    l_partial.real(0.0);
+    l_partial.imag(0.0);
+
+    for (int i=a_start; i<a_end; i++) {
+        l_partial += x[i].conjugate()*y[i];
+    }
+}
+
+/*
+ * Runs a complex dot product as a VBLAS reduction: one partial sum per block in the precision of r, combined along
+ * the fixed reduction tree, so the result does not depend on the number of threads.
+ */
+static void vcdotReduction(int n, const VPComplexArray & x, const VPComplexArray & y, VPComplex & r, VBLAS::VBLASThreadPoolRoutine a_block_routine) {
+    int64_t l_nb_blocks = VBLAS::VBLASReduction_nbBlocks(n);
+    vpfloat_evp_t l_r_env = r.getEnvironment();
+    VPComplexArray l_partials(l_r_env.es, l_r_env.bis, l_r_env.stride, l_nb_blocks);
+    ComplexDotJob l_job;
+
+    l_job.x = &x;
+    l_job.y = &y;
+    l_job.partials = &l_partials;
+
+    VBLAS::VBLASReduction_run(n, a_block_routine, &l_job);
+    VBLAS::VBLASReduction_combine(l_partials, l_nb_blocks);
+
+    r = l_partials[0];
+}
+
 void VBLAS::vcdotu(int precision , int n, const VPComplexArray & x, const VPComplexArray & y, VPComplex & r){
     int i;
-    
+
+    if ( VBLASReduction_nbBlocks(n) > 1 ) {
+        vcdotReduction(n, x, y, r, vcdotuBlock);
+        return;
+    }
+
     r.real(0.0);
     r.imag(0.0);
 
@@ -175,7 +235,12 @@ void VBLAS::vcdotu(int precision , int n, const VPComplexArray & x, const VPComp
 
 void  VBLAS::vcdotc(int precision , int n, const VPComplexArray & x, const VPComplexArray & y, VPComplex & r){
     int i;
-    
+
+    if ( VBLASReduction_nbBlocks(n) > 1 ) {
+        vcdotReduction(n, x, y, r, vcdotcBlock);
+        return;
+    }
+
     r.real(0.0);
     r.imag(0.0);
 
@@ -26,7 +26,8 @@ using namespace VPFloatPackage::VBLAS;
 
 static VBLASConfig g_vblas_config = {   .nb_threads = 1,
                                         .nb_rows_per_thread = 64,
-                                        .enable_prefetcher = 1};
+                                        .enable_prefetcher = 1,
+                                        .enable_exact_dot = 0};
 
 vblas_mt_config_t * VPFloatPackage::VBLAS::getVBLAS_MT_Config() {
     static vblas_mt_config_t vblas_mt_config;
@@ -55,4 +56,9 @@ void VPFloatPackage::VBLAS::VBLAS_setConfig(VBLASConfig* a_config_address) {
     std::cout << "VBLASConfig => nb_thread : " << g_vblas_config.nb_threads << std::endl;
     std::cout << "VBLASConfig => nb_rows_per_thread : " << g_vblas_config.nb_rows_per_thread << std::endl;
     std::cout << "VBLASConfig => enable_prefetcher : " << g_vblas_config.enable_prefetcher << std::endl;
+    std::cout << "VBLASConfig => enable_exact_dot : " << g_vblas_config.enable_exact_dot << std::endl;
+}
+
+VPFloatPackage::VBLAS::VBLASDotMode VPFloatPackage::VBLAS::VBLAS_getDotMode(void) {
+    return ( ::g_vblas_config.enable_exact_dot ) ? VBLAS_DOT_EXACT : VBLAS_DOT_ROUNDED;
 }
\ No newline at end of file
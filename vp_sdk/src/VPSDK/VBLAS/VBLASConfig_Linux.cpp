@@ -21,17 +21,25 @@
 
 
 #include "VPSDK/VBLASConfig.hpp"
+#include "VBLASThreadPool.hpp"
 
 using namespace VPFloatPackage::VBLAS;
 
 int VPFloatPackage::VBLAS::VBLAS_Init() {
     int l_rc = EXIT_SUCCESS;
 
+    /*
+     * Without initialization, the thread pool is started by the first VBLAS call needing it.
+     */
+    l_rc = VBLASThreadPool_start(VBLAS_getConfig()->nb_threads);
+
     return l_rc;
 }
 
 int VPFloatPackage::VBLAS::VBLAS_Destroy() {
     int l_rc = EXIT_SUCCESS;
 
+    VBLASThreadPool_stop();
+
     return l_rc;
 }
@@ -0,0 +1,95 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Host thread pool used by the MPFR implementation of VBLAS.
+ **/
+
+#ifndef __VBLASTHREADPOOL_HPP__
+#define __VBLASTHREADPOOL_HPP__
+
+#include <stdint.h>
+
+/*
+ * Number of items reduced into one partial result (see Reductions below).
+ */
+#define VBLAS_REDUCTION_BLOCK_SIZE 256
+
+namespace VPFloatPackage {
+
+    namespace VBLAS {
+
+        /*
+         * Routine processing the items [a_start, a_end[ of a job. a_chunk_index is the index of the chunk in the job,
+         * chunks being numbered in increasing item order.
+         */
+        typedef void (*VBLASThreadPoolRoutine)(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end);
+
+        /*
+         * Starts the workers of the pool (VBLASConfig::nb_threads - 1 workers, the calling thread being the last one).
+         */
+        int VBLASThreadPool_start(uint64_t a_nb_threads);
+
+        /*
+         * Stops and joins all the workers of the pool.
+         */
+        void VBLASThreadPool_stop();
+
+        /*
+         * Splits [0, a_nb_items[ in at most VBLASConfig::nb_threads contiguous chunks of at least a_min_items_per_chunk
+         * items and runs a_routine on each of them.
+         * The calling thread takes part in the job and returns once all the chunks are processed. The MPFR default
+         * rounding mode and precision of the calling thread are applied in the workers.
+         * The pool is (re)started on demand when VBLASConfig::nb_threads changed. The job is run by the calling thread
+         * alone when only one chunk is needed, or when the pool is already busy (nested or concurrent calls).
+         */
+        void VBLASThreadPool_run(int64_t a_nb_items, int64_t a_min_items_per_chunk, VBLASThreadPoolRoutine a_routine, void * a_args);
+
+        /*****************************************************************************************************************
+         * Reductions
+         *
+         * The items of a reduction are split in blocks of VBLAS_REDUCTION_BLOCK_SIZE items, each block giving one partial
+         * result, and the partial results are combined along a fixed binary tree. Neither the partitioning nor the
+         * combination order depend on VBLASConfig, so a reduction gives the same result whatever the number of threads.
+         ****************************************************************************************************************/
+        /*
+         * Number of blocks, and so of partial results, of a reduction over a_nb_items items.
+         */
+        int64_t VBLASReduction_nbBlocks(int64_t a_nb_items);
+
+        /*
+         * Runs a_routine on each block of a reduction over a_nb_items items. The chunk index given to a_routine is the
+         * index of the block, in which the routine stores its partial result.
+         */
+        void VBLASReduction_run(int64_t a_nb_items, VBLASThreadPoolRoutine a_routine, void * a_args);
+
+        /*
+         * Combines a_partials[0..a_nb_partials[ into a_partials[0]: a_partials[i] += a_partials[i + step], step being
+         * doubled at each level of the tree.
+         */
+        template <class T_ARRAY>
+        void VBLASReduction_combine(T_ARRAY & a_partials, int64_t a_nb_partials) {
+            for ( int64_t l_step = 1; l_step < a_nb_partials; l_step *= 2 ) {
+                for ( int64_t l_index = 0; l_index + l_step < a_nb_partials; l_index += 2 * l_step ) {
+                    a_partials[l_index] += a_partials[l_index + l_step];
+                }
+            }
+        }
+    }
+}
+
+#endif /* __VBLASTHREADPOOL_HPP__ */
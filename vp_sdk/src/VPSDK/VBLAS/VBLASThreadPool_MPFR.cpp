@@ -0,0 +1,281 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Host thread pool used by the MPFR implementation of VBLAS.
+ **/
+
+#include "VBLASThreadPool.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include <mpfr.h>
+#include <stdlib.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace VPFloatPackage::VBLAS;
+
+namespace {
+
+    struct VBLASThreadPoolJob {
+        VBLASThreadPoolRoutine routine;
+        void * args;
+        int64_t nb_items;
+        int64_t nb_chunks;
+
+        /*
+         * Number of items of each chunk (the last one may be smaller), or 0 to split the items evenly.
+         */
+        int64_t chunk_size;
+        std::atomic<int64_t> next_chunk;
+
+        /*
+         * MPFR defaults are thread local: the ones of the thread submitting the job are used by the workers.
+         */
+        mpfr_rnd_t rounding_mode;
+        mpfr_prec_t default_precision;
+    };
+
+    class VBLASThreadPool {
+        private:
+            std::vector<std::thread> m_workers;
+            std::mutex m_mutex;
+            std::condition_variable m_job_available;
+            std::condition_variable m_job_done;
+            VBLASThreadPoolJob * m_job;
+            uint64_t m_job_generation;
+            int m_nb_active_workers;
+            bool m_stop;
+
+            /*
+             * Only one job at a time is dispatched to the workers.
+             */
+            std::mutex m_run_mutex;
+
+            static void processChunks(VBLASThreadPoolJob * a_job) {
+                int64_t l_chunk;
+
+                while ( ( l_chunk = a_job->next_chunk.fetch_add(1) ) < a_job->nb_chunks ) {
+                    if ( a_job->chunk_size > 0 ) {
+                        int64_t l_end = ( l_chunk + 1 ) * a_job->chunk_size;
+
+                        a_job->routine( a_job->args,
+                                        l_chunk,
+                                        l_chunk * a_job->chunk_size,
+                                        ( l_end < a_job->nb_items ) ? l_end : a_job->nb_items);
+                    } else {
+                        a_job->routine( a_job->args,
+                                        l_chunk,
+                                        ( a_job->nb_items * l_chunk ) / a_job->nb_chunks,
+                                        ( a_job->nb_items * ( l_chunk + 1 ) ) / a_job->nb_chunks);
+                    }
+                }
+            }
+
+            void workerLoop() {
+                uint64_t l_last_generation = 0;
+                std::unique_lock<std::mutex> l_lock(m_mutex);
+
+                while ( true ) {
+                    m_job_available.wait(l_lock, [&] { return m_stop || ( m_job_generation != l_last_generation ); });
+
+                    if ( m_stop ) {
+                        return;
+                    }
+
+                    l_last_generation = m_job_generation;
+
+                    /*
+                     * The job may already be completed by the other threads.
+                     */
+                    VBLASThreadPoolJob * l_job = m_job;
+                    if ( l_job == NULL ) {
+                        continue;
+                    }
+
+                    m_nb_active_workers++;
+                    l_lock.unlock();
+
+                    mpfr_set_default_rounding_mode(l_job->rounding_mode);
+                    mpfr_set_default_prec(l_job->default_precision);
+                    processChunks(l_job);
+
+                    l_lock.lock();
+                    if ( --m_nb_active_workers == 0 ) {
+                        m_job_done.notify_all();
+                    }
+                }
+            }
+
+            void startWorkers(uint64_t a_nb_workers) {
+                m_stop = false;
+                for ( uint64_t l_index = 0 ; l_index < a_nb_workers; l_index++ ) {
+                    m_workers.push_back(std::thread(&VBLASThreadPool::workerLoop, this));
+                }
+            }
+
+            void stopWorkers() {
+                {
+                    std::lock_guard<std::mutex> l_lock(m_mutex);
+                    m_stop = true;
+                }
+                m_job_available.notify_all();
+
+                for ( size_t l_index = 0 ; l_index < m_workers.size(); l_index++ ) {
+                    m_workers[l_index].join();
+                }
+                m_workers.clear();
+            }
+
+        public:
+            VBLASThreadPool() :
+                m_job(NULL),
+                m_job_generation(0),
+                m_nb_active_workers(0),
+                m_stop(false)
+            {}
+
+            ~VBLASThreadPool() {
+                stopWorkers();
+            }
+
+            int start(uint64_t a_nb_threads) {
+                std::lock_guard<std::mutex> l_run_lock(m_run_mutex);
+                uint64_t l_nb_workers = ( a_nb_threads > 1 ) ? a_nb_threads - 1 : 0;
+
+                if ( m_workers.size() != l_nb_workers ) {
+                    stopWorkers();
+                    startWorkers(l_nb_workers);
+                }
+
+                return EXIT_SUCCESS;
+            }
+
+            void stop() {
+                std::lock_guard<std::mutex> l_run_lock(m_run_mutex);
+
+                stopWorkers();
+            }
+
+            void run(int64_t a_nb_items, int64_t a_nb_chunks, int64_t a_chunk_size, VBLASThreadPoolRoutine a_routine, void * a_args) {
+                VBLASThreadPoolJob l_job;
+                uint64_t l_nb_threads = VBLAS_getConfig()->nb_threads;
+                uint64_t l_nb_workers = ( l_nb_threads > 1 ) ? l_nb_threads - 1 : 0;
+
+                l_job.routine = a_routine;
+                l_job.args = a_args;
+                l_job.nb_items = a_nb_items;
+                l_job.nb_chunks = a_nb_chunks;
+                l_job.chunk_size = a_chunk_size;
+                l_job.next_chunk = 0;
+                l_job.rounding_mode = mpfr_get_default_rounding_mode();
+                l_job.default_precision = mpfr_get_default_prec();
+
+                std::unique_lock<std::mutex> l_run_lock(m_run_mutex, std::try_to_lock);
+
+                if ( ( a_nb_chunks <= 1 ) || ( l_nb_workers == 0 ) || ( ! l_run_lock.owns_lock() ) ) {
+                    /*
+                     * Same chunks than a parallel run, so the results do not depend on the way the job is executed.
+                     */
+                    processChunks(&l_job);
+                    return;
+                }
+
+                if ( m_workers.size() != l_nb_workers ) {
+                    stopWorkers();
+                    startWorkers(l_nb_workers);
+                }
+
+                {
+                    std::lock_guard<std::mutex> l_lock(m_mutex);
+                    m_job = &l_job;
+                    m_job_generation++;
+                }
+                m_job_available.notify_all();
+
+                processChunks(&l_job);
+
+                /*
+                 * All the chunks are taken: workers that did not start yet must not see the job anymore, the others
+                 * are waited for.
+                 */
+                std::unique_lock<std::mutex> l_lock(m_mutex);
+                m_job = NULL;
+                m_job_done.wait(l_lock, [&] { return m_nb_active_workers == 0; });
+            }
+    };
+
+    VBLASThreadPool & getThreadPool() {
+        static VBLASThreadPool l_thread_pool;
+
+        return l_thread_pool;
+    }
+}
+
+int VPFloatPackage::VBLAS::VBLASThreadPool_start(uint64_t a_nb_threads) {
+    return getThreadPool().start(a_nb_threads);
+}
+
+void VPFloatPackage::VBLAS::VBLASThreadPool_stop() {
+    getThreadPool().stop();
+}
+
+/*
+ * Number of chunks a job of a_nb_items items is split into when chunks hold at least a_min_items_per_chunk items.
+ */
+static int64_t getNbChunks(int64_t a_nb_items, int64_t a_min_items_per_chunk) {
+    int64_t l_nb_threads = (int64_t)VBLAS_getConfig()->nb_threads;
+    int64_t l_nb_chunks;
+
+    if ( a_min_items_per_chunk < 1 ) {
+        a_min_items_per_chunk = 1;
+    }
+
+    l_nb_chunks = a_nb_items / a_min_items_per_chunk;
+
+    if ( l_nb_chunks > l_nb_threads ) {
+        l_nb_chunks = l_nb_threads;
+    }
+
+    return ( l_nb_chunks > 1 ) ? l_nb_chunks : 1;
+}
+
+void VPFloatPackage::VBLAS::VBLASThreadPool_run(int64_t a_nb_items, int64_t a_min_items_per_chunk, VBLASThreadPoolRoutine a_routine, void * a_args) {
+    if ( a_nb_items <= 0 ) {
+        return;
+    }
+
+    getThreadPool().run(a_nb_items, getNbChunks(a_nb_items, a_min_items_per_chunk), 0, a_routine, a_args);
+}
+
+int64_t VPFloatPackage::VBLAS::VBLASReduction_nbBlocks(int64_t a_nb_items) {
+    if ( a_nb_items <= VBLAS_REDUCTION_BLOCK_SIZE ) {
+        return 1;
+    }
+
+    return ( a_nb_items + VBLAS_REDUCTION_BLOCK_SIZE - 1 ) / VBLAS_REDUCTION_BLOCK_SIZE;
+}
+
+void VPFloatPackage::VBLAS::VBLASReduction_run(int64_t a_nb_items, VBLASThreadPoolRoutine a_routine, void * a_args) {
+    if ( a_nb_items <= 0 ) {
+        return;
+    }
+
+    getThreadPool().run(a_nb_items, VBLASReduction_nbBlocks(a_nb_items), VBLAS_REDUCTION_BLOCK_SIZE, a_routine, a_args);
+}
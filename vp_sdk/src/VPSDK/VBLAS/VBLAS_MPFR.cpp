@@ -22,42 +22,179 @@
 #include "VPSDK/VBLAS.hpp"
 #include "VPSDK/VPFloat.hpp"
 #include "VPSDK/VMath.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VBLASThreadPool.hpp"
 #include <mpfr.h>
+#include <algorithm>
 #include <math.h>
 #include <stdio.h>
 #include "Matrix/matrix.h"
 #include "Matrix/BCSR.h"
 #include "Matrix/CSR.h"
 #include "Matrix/DENSE.h"
+#include "Matrix/SELL.h"
 using namespace VPFloatPackage;
 
 /*****************************************************************************************************************
 *  Matrix-vector multiplication
 *
 *  y = (alpha * A * x) + (beta * y)
+*
+*  Rows are split in chunks of at least VBLASConfig::nb_rows_per_thread rows processed by the VBLAS thread pool.
+*
+*  Transposed products (trans != 'N') on CSR, BCSR and SELL matrices scatter each row of A into the columns of y.
+*  The rows of A are split in a fixed number of parts (see vgemvdScatterNbParts), which only depends on the size of
+*  A: each part scatters its rows into its own partial y, then the partials are summed in increasing part order.
+*  Every y[j] sums the rows of each part in the storage order (increasing order for CSR and BCSR), so the result does
+*  not depend on the number of threads. With a single part, it is the one of the product by an explicitly transposed
+*  matrix.
+*
+*  Half stored symmetric CSR matrices (see CSR_IS_SYMMETRIC_HALF) use each stored value for its row and, off the
+*  diagonal, for its column: the stored rows are scattered the same way, each stored value being read once. With a
+*  single part every y[i] sums its values in increasing column order, so the result is the one of the full storage
+*  product.
+*
+*  SELL matrices are processed by chunks of rows. Each row is accumulated over its own length in the order of the
+*  source CSR row, so padding values are never read and the results are the ones of the CSR kernel.
 ****************************************************************************************************************/
-void vgemvdBCSR(int precision, char trans, int m, int n,
-                double alpha,
-                const dmatBCSR_t a_bcsr,
-                int lda,
-                const VPFloatArray & x,
-                const VPFloat & beta,
-                VPFloatArray & y, 
-                VPFloatArray & acc,
-                int start_row_number) {
+struct VgemvdJob {
+    const void * a;
+    int m;
+    int n;
+    int lda;
+    char trans;
+    double alpha;
+    const VPFloatArray * x;
+    const VPFloat * beta;
+    VPFloatArray * y;
+    VPFloatArray * acc;
+    int start_row_number;
+    int k;                  // vectors of X and Y (vgemmd)
+    int nb_parts;           // partial y of the scatter kernels, stored one after the other in acc
+};
+
+/*
+ * Number of parts of the scatter kernels for a_nb_rows rows: one part per VGEMVD_SCATTER_ROWS_PER_PART rows, at most
+ * VGEMVD_SCATTER_MAX_PARTS. Each part holds a partial y, so small matrices are processed by a single part, in the
+ * sequential order.
+ */
+#define VGEMVD_SCATTER_ROWS_PER_PART 4096
+#define VGEMVD_SCATTER_MAX_PARTS 8
+
+static int vgemvdScatterNbParts(int64_t a_nb_rows) {
+    return (int)std::max((int64_t)1, std::min((int64_t)VGEMVD_SCATTER_MAX_PARTS, a_nb_rows / VGEMVD_SCATTER_ROWS_PER_PART));
+}
+
+/*
+ * Rows [a_start_row, a_end_row[ of part a_part out of a_nb_parts, and the partial y of the part (set to zero).
+ */
+static mpfr_t * vgemvdScatterPart(VgemvdJob * a_job, int a_nb_rows, int64_t a_part, int64_t & a_start_row, int64_t & a_end_row) {
+    int l_len = a_job->y->nbElements();
+    mpfr_t * l_partial = (mpfr_t *)a_job->acc->getData() + a_part * l_len;
+
+    a_start_row = a_part * a_nb_rows / a_job->nb_parts;
+    a_end_row = ( a_part + 1 ) * a_nb_rows / a_job->nb_parts;
+
+    for ( int j = 0; j < l_len; j++ ) {
+        mpfr_set_zero(l_partial[j], 1);
+    }
+
+    return l_partial;
+}
+
+/*
+ * CSR product kernel. The inner loop works on the MPFR numbers of x and of the accumulator: no VPFloat view is built
+ * per element, and the matrix value is loaded in a 53 bits MPFR number allocated once per chunk. Row pointers and
+ * column indices are relative to dmatCSR_t::base_index, which is applied once per row and per element.
+ */
+static void vgemvdCSRRows(void * a_args, int64_t a_chunk_index, int64_t a_start_row, int64_t a_end_row) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    dmatCSR_t l_csr = (dmatCSR_t)l_job->a;
+    VPFloatArray & y = *(l_job->y);
+    VPFloat res(VPFloatComputingEnvironment::get_temporary_var_environment().es,
+                VPFloatComputingEnvironment::get_temporary_var_environment().bis,
+                VPFloatComputingEnvironment::get_temporary_var_environment().stride);
+    mpfr_ptr l_acc = *((mpfr_t *)res.getData());
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    const int * l_ptr = l_csr->ptr;
+    const int * l_ind = l_csr->ind;
+    const double * l_val = l_csr->val;
+    int l_base = l_csr->base_index;
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ij, 53);
+    int i, k, l_row_end;
+
+    // i est l'indice de ligne
+    for (i=a_start_row; i<a_end_row; i++) {
+        mpfr_set_zero(l_acc, 1);
+
+        l_row_end = l_ptr[i+1] - l_base;
+        for (k=l_ptr[i]-l_base; k<l_row_end; k++) {
+            mpfr_set_d(l_a_ij, l_val[k], MPFR_RNDN);
+            mpfr_fma(l_acc, l_x[l_ind[k] - l_base], l_a_ij, l_acc, l_rounding_mode);
+        }
+
+        y[i] *= *(l_job->beta);
+        y[i].fma(res, l_job->alpha);
+    }
+}
+
+/*
+ * Half stored symmetric CSR product kernel (A = A^T, so trans does not matter), one part of the rows per item. Each
+ * stored a_ij is accumulated in y[i] and, off the diagonal, in y[j]. The implied values of row i are the stored values
+ * of column i: they come from the preceding rows for an upper triangle and from the following ones for a lower one, so
+ * the partial y[i] sums its values in increasing column order.
+ */
+static void vgemvdCSRSymmetricParts(void * a_args, int64_t a_chunk_index, int64_t a_start_part, int64_t a_end_part) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    dmatCSR_t l_csr = (dmatCSR_t)l_job->a;
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    const int * l_ptr = l_csr->ptr;
+    const int * l_ind = l_csr->ind;
+    const double * l_val = l_csr->val;
+    int l_base = l_csr->base_index;
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ij, 53);
+    int64_t l_start_row, l_end_row;
+
+    for (int64_t l_part = a_start_part; l_part < a_end_part; l_part++) {
+        mpfr_t * l_partial = vgemvdScatterPart(l_job, l_job->m, l_part, l_start_row, l_end_row);
+
+        for (int64_t i = l_start_row; i < l_end_row; i++) {
+            int l_row_end = l_ptr[i+1] - l_base;
+
+            for (int k = l_ptr[i] - l_base; k < l_row_end; k++) {
+                int j = l_ind[k] - l_base;
+
+                mpfr_set_d(l_a_ij, l_val[k], MPFR_RNDN);
+                mpfr_fma(l_partial[i], l_x[j], l_a_ij, l_partial[i], l_rounding_mode);
+
+                // a_ji = a_ij
+                if ( j != i ) {
+                    mpfr_fma(l_partial[j], l_x[i], l_a_ij, l_partial[j], l_rounding_mode);
+                }
+            }
+        }
+    }
+}
+
+static void vgemvdBCSRBlockRows(void * a_args, int64_t a_chunk_index, int64_t a_start_block_row, int64_t a_end_block_row) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    dmatBCSR_t a_bcsr = (dmatBCSR_t)l_job->a;
+    const VPFloatArray & x = *(l_job->x);
+    VPFloatArray & acc = *(l_job->acc);
     int l_nb_elements_per_block = a_bcsr->row_block_size * a_bcsr->col_block_size;
-    int l_block_index = 0;
-    int l_block_val_index = 0;
 
     // Processing of row of blocks
-    for ( int l_row_block = 0 ; l_row_block < a_bcsr->num_block_rows; l_row_block++ ) {
-        
-        int l_real_start_row_index = l_row_block * a_bcsr->row_block_size + start_row_number;
+    for ( int l_row_block = a_start_block_row ; l_row_block < a_end_block_row; l_row_block++ ) {
+
+        int l_real_start_row_index = l_row_block * a_bcsr->row_block_size + l_job->start_row_number;
 
         // Processing a block
         for (int l_block = a_bcsr->bptr[l_row_block]; l_block < a_bcsr->bptr[l_row_block+1]; l_block++) {
 
-            int l_real_start_col_index = a_bcsr->bind[l_block_index];
+            int l_real_start_col_index = a_bcsr->bind[l_block];
+            int l_block_val_index = l_block * l_nb_elements_per_block;
 
             // Process each block line
             for ( int l_row_in_block = 0; l_row_in_block < a_bcsr->row_block_size; l_row_in_block++ ) {
@@ -70,17 +207,315 @@ void vgemvdBCSR(int precision, char trans, int m, int n,
                     int l_element_in_block_offset = l_row_in_block * a_bcsr->col_block_size + l_col_in_block;
 
                     int l_real_col_index = l_real_start_col_index + l_col_in_block;
-                    
-                    acc[l_real_row_index] += x[l_real_col_index] * a_bcsr->bval[l_block_val_index + l_element_in_block_offset];
+
+                    // Padding columns of the last blocks
+                    if ( l_real_col_index >= l_job->n ) {
+                        break;
+                    }
+
+                    acc[l_real_row_index].fma(x[l_real_col_index], a_bcsr->bval[l_block_val_index + l_element_in_block_offset]);
                 }
 
             }
+        }
+    }
+}
+
+/*
+ * Transposed product kernels (trans != 'N') of CSR, BCSR and SELL matrices, one part of the rows of A per item: each
+ * entry a_ij of the rows of the part is accumulated in the partial y[j] of the part.
+ */
+static void vgemvdCSRTransposedParts(void * a_args, int64_t a_chunk_index, int64_t a_start_part, int64_t a_end_part) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    dmatCSR_t l_csr = (dmatCSR_t)l_job->a;
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    const int * l_ptr = l_csr->ptr;
+    const int * l_ind = l_csr->ind;
+    const double * l_val = l_csr->val;
+    int l_base = l_csr->base_index;
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ij, 53);
+    int64_t l_start_row, l_end_row;
 
-            l_block_val_index += l_nb_elements_per_block;
-            l_block_index++;
+    for (int64_t l_part = a_start_part; l_part < a_end_part; l_part++) {
+        mpfr_t * l_partial = vgemvdScatterPart(l_job, l_job->m, l_part, l_start_row, l_end_row);
 
+        for (int64_t i = l_start_row; i < l_end_row; i++) {
+            int l_row_end = l_ptr[i+1] - l_base;
+
+            for (int k = l_ptr[i] - l_base; k < l_row_end; k++) {
+                int j = l_ind[k] - l_base;
+
+                mpfr_set_d(l_a_ij, l_val[k], MPFR_RNDN);
+                mpfr_fma(l_partial[j], l_x[i], l_a_ij, l_partial[j], l_rounding_mode);
+            }
         }
     }
+}
+
+/*
+ * A block row belongs to the part holding its first row. The leftover rows are stored in a chained BCSR matrix.
+ */
+static void vgemvdBCSRTransposedParts(void * a_args, int64_t a_chunk_index, int64_t a_start_part, int64_t a_end_part) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ij, 53);
+    int64_t l_start_row, l_end_row;
+
+    for (int64_t l_part = a_start_part; l_part < a_end_part; l_part++) {
+        mpfr_t * l_partial = vgemvdScatterPart(l_job, l_job->m, l_part, l_start_row, l_end_row);
+        int l_start_row_number = 0;
+
+        for ( dmatBCSR_t l_bcsr = (dmatBCSR_t)l_job->a; l_bcsr != NULL; l_bcsr = ( l_bcsr->num_rows_leftover > 0 ) ? l_bcsr->leftover : NULL ) {
+            int l_nb_elements_per_block = l_bcsr->row_block_size * l_bcsr->col_block_size;
+
+            for ( int l_row_block = 0 ; l_row_block < l_bcsr->num_block_rows; l_row_block++ ) {
+                int l_real_start_row_index = l_row_block * l_bcsr->row_block_size + l_start_row_number;
+
+                if ( l_real_start_row_index < l_start_row || l_real_start_row_index >= l_end_row ) {
+                    continue;
+                }
+
+                for ( int l_block = l_bcsr->bptr[l_row_block]; l_block < l_bcsr->bptr[l_row_block+1]; l_block++ ) {
+                    int l_real_start_col_index = l_bcsr->bind[l_block];
+                    int l_block_val_index = l_block * l_nb_elements_per_block;
+
+                    for ( int l_row_in_block = 0; l_row_in_block < l_bcsr->row_block_size; l_row_in_block++ ) {
+                        for ( int l_col_in_block = 0; l_col_in_block < l_bcsr->col_block_size; l_col_in_block++ ) {
+                            int l_real_col_index = l_real_start_col_index + l_col_in_block;
+
+                            // Padding columns of the last blocks
+                            if ( l_real_col_index >= l_job->n ) {
+                                continue;
+                            }
+
+                            mpfr_set_d(l_a_ij, l_bcsr->bval[l_block_val_index + l_row_in_block * l_bcsr->col_block_size + l_col_in_block], MPFR_RNDN);
+                            mpfr_fma(l_partial[l_real_col_index], l_x[l_real_start_row_index + l_row_in_block], l_a_ij, l_partial[l_real_col_index], l_rounding_mode);
+                        }
+                    }
+                }
+            }
+
+            l_start_row_number += l_bcsr->num_block_rows * l_bcsr->row_block_size;
+        }
+    }
+}
+
+/*
+ * Parts are ranges of sorted rows of the SELL matrix.
+ */
+static void vgemvdSELLTransposedParts(void * a_args, int64_t a_chunk_index, int64_t a_start_part, int64_t a_end_part) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    dmatSELL_t l_sell = (dmatSELL_t)l_job->a;
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    int l_chunk_size = l_sell->chunk_size;
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ij, 53);
+    int64_t l_start_row, l_end_row;
+
+    for (int64_t l_part = a_start_part; l_part < a_end_part; l_part++) {
+        mpfr_t * l_partial = vgemvdScatterPart(l_job, l_sell->num_chunks * l_chunk_size, l_part, l_start_row, l_end_row);
+
+        for (int64_t l_sorted_row = l_start_row; l_sorted_row < l_end_row; l_sorted_row++) {
+            int l_row = l_sell->perm[l_sorted_row];
+
+            // Empty rows completing the last chunk
+            if ( l_row < 0 ) {
+                continue;
+            }
+
+            // Values of a row are chunk_size apart
+            int l_offset = l_sell->chunk_ptr[l_sorted_row / l_chunk_size] + ( l_sorted_row % l_chunk_size );
+
+            for (int k = 0; k < l_sell->row_len[l_sorted_row]; k++) {
+                int j = l_sell->ind[l_offset + k * l_chunk_size];
+
+                mpfr_set_d(l_a_ij, l_sell->val[l_offset + k * l_chunk_size], MPFR_RNDN);
+                mpfr_fma(l_partial[j], l_x[l_row], l_a_ij, l_partial[j], l_rounding_mode);
+            }
+        }
+    }
+}
+
+static void vgemvdSELLChunks(void * a_args, int64_t a_chunk_index, int64_t a_start_chunk, int64_t a_end_chunk) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    dmatSELL_t l_sell = (dmatSELL_t)l_job->a;
+    VPFloatArray & y = *(l_job->y);
+    VPFloat res(VPFloatComputingEnvironment::get_temporary_var_environment().es,
+                VPFloatComputingEnvironment::get_temporary_var_environment().bis,
+                VPFloatComputingEnvironment::get_temporary_var_environment().stride);
+    mpfr_ptr l_acc = *((mpfr_t *)res.getData());
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    int l_chunk_size = l_sell->chunk_size;
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ij, 53);
+
+    for (int l_chunk = a_start_chunk; l_chunk < a_end_chunk; l_chunk++) {
+        for (int l_row_in_chunk = 0; l_row_in_chunk < l_chunk_size; l_row_in_chunk++) {
+            int l_sorted_row = l_chunk * l_chunk_size + l_row_in_chunk;
+            int l_row = l_sell->perm[l_sorted_row];
+
+            // Empty rows completing the last chunk
+            if ( l_row < 0 ) {
+                continue;
+            }
+
+            // Values of a row are chunk_size apart
+            const int * l_ind = l_sell->ind + l_sell->chunk_ptr[l_chunk] + l_row_in_chunk;
+            const double * l_val = l_sell->val + l_sell->chunk_ptr[l_chunk] + l_row_in_chunk;
+            int l_row_len = l_sell->row_len[l_sorted_row];
+
+            mpfr_set_zero(l_acc, 1);
+
+            for (int k = 0; k < l_row_len; k++) {
+                mpfr_set_d(l_a_ij, l_val[k * l_chunk_size], MPFR_RNDN);
+                mpfr_fma(l_acc, l_x[l_ind[k * l_chunk_size]], l_a_ij, l_acc, l_rounding_mode);
+            }
+
+            y[l_row] *= *(l_job->beta);
+            y[l_row].fma(res, l_job->alpha);
+        }
+    }
+}
+
+/*
+ * y = alpha * acc + beta * y. The partial y of the scatter kernels are first summed into the first one, in increasing
+ * part order.
+ */
+static void vgemvdAccumulatorRows(void * a_args, int64_t a_chunk_index, int64_t a_start_row, int64_t a_end_row) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    VPFloatArray & y = *(l_job->y);
+    VPFloatArray & acc = *(l_job->acc);
+    mpfr_t * l_acc = (mpfr_t *)acc.getData();
+    int l_len = y.nbElements();
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+
+    for (int l_row_index = a_start_row ; l_row_index < a_end_row; l_row_index++){
+        for (int l_part = 1; l_part < l_job->nb_parts; l_part++) {
+            mpfr_add(l_acc[l_row_index], l_acc[l_row_index], l_acc[l_part * l_len + l_row_index], l_rounding_mode);
+        }
+
+        y[l_row_index] *= *(l_job->beta);
+        y[l_row_index].fma(acc[l_row_index], l_job->alpha);
+    }
+}
+
+/*
+ * DENSE product kernels. The matrix is processed by tiles of VGEMVD_DENSE_ROW_PANEL rows and VGEMVD_DENSE_COL_TILE
+ * columns: each MPFR number of x is loaded once per row panel and reused for all its rows, and the tile of a row
+ * read from A is contiguous. Tiles are a whole number of cache lines, and rows are read with the lda stride, so
+ * with the odd number of cache lines of ComputeOptimizedLDA the rows of a panel do not compete for the same cache
+ * sets. Each y element accumulates its products in increasing order of A columns ('N') or rows ('T'), in a
+ * temporary variable: the results do not depend on the tiling nor on the number of threads.
+ */
+#define VGEMVD_DENSE_ROW_PANEL 4
+#define VGEMVD_DENSE_COL_TILE 256
+
+static void vgemvdDENSERows(void * a_args, int64_t a_chunk_index, int64_t a_start_row, int64_t a_end_row) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    const double * l_dense = (const double *)l_job->a;
+    VPFloatArray & y = *(l_job->y);
+    vpfloat_evp_t l_env = VPFloatComputingEnvironment::get_temporary_var_environment();
+    VPFloatArray acc(l_env.es, l_env.bis, l_env.stride, a_end_row - a_start_row);
+    mpfr_t * l_acc = (mpfr_t *)acc.getData();
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    int64_t l_lda = l_job->lda;
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ik, 53);
+    int i, k, l_row, l_panel_end, l_tile_start, l_tile_end;
+
+    for (i=a_start_row; i<a_end_row; i++) {
+        mpfr_set_zero(l_acc[i - a_start_row], 1);
+    }
+
+    for (l_tile_start=0; l_tile_start<l_job->n; l_tile_start+=VGEMVD_DENSE_COL_TILE) {
+        l_tile_end = std::min(l_job->n, l_tile_start + VGEMVD_DENSE_COL_TILE);
+
+        for (i=a_start_row; i<a_end_row; i+=VGEMVD_DENSE_ROW_PANEL) {
+            l_panel_end = std::min((int)a_end_row, i + VGEMVD_DENSE_ROW_PANEL);
+
+            for (k=l_tile_start; k<l_tile_end; k++) {
+                mpfr_srcptr l_x_k = l_x[k];
+
+                for (l_row=i; l_row<l_panel_end; l_row++) {
+                    mpfr_set_d(l_a_ik, l_dense[(l_row * l_lda) + k], MPFR_RNDN);
+                    mpfr_fma(l_acc[l_row - a_start_row], l_x_k, l_a_ik, l_acc[l_row - a_start_row], l_rounding_mode);
+                }
+            }
+        }
+    }
+
+    for (i=a_start_row; i<a_end_row; i++) {
+        y[i] *= *(l_job->beta);
+        y[i].fma(acc[i - a_start_row], l_job->alpha);
+    }
+}
+
+/*
+ * y = alpha * A^T * x + beta * y : x has m elements, y has n elements. Each thread owns a range of columns of A and
+ * sweeps all the rows of A for each tile of columns, accumulating into the matching panel of y.
+ */
+static void vgemvdDENSETransposedColumns(void * a_args, int64_t a_chunk_index, int64_t a_start_col, int64_t a_end_col) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    const double * l_dense = (const double *)l_job->a;
+    VPFloatArray & y = *(l_job->y);
+    vpfloat_evp_t l_env = VPFloatComputingEnvironment::get_temporary_var_environment();
+    VPFloatArray acc(l_env.es, l_env.bis, l_env.stride, VGEMVD_DENSE_COL_TILE);
+    mpfr_t * l_acc = (mpfr_t *)acc.getData();
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    int64_t l_lda = l_job->lda;
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ij, 53);
+    int i, j, l_row, l_panel_end, l_tile_start, l_tile_end;
+
+    for (l_tile_start=a_start_col; l_tile_start<a_end_col; l_tile_start+=VGEMVD_DENSE_COL_TILE) {
+        l_tile_end = std::min((int)a_end_col, l_tile_start + VGEMVD_DENSE_COL_TILE);
+
+        for (j=l_tile_start; j<l_tile_end; j++) {
+            mpfr_set_zero(l_acc[j - l_tile_start], 1);
+        }
+
+        for (i=0; i<l_job->m; i+=VGEMVD_DENSE_ROW_PANEL) {
+            l_panel_end = std::min(l_job->m, i + VGEMVD_DENSE_ROW_PANEL);
+
+            for (l_row=i; l_row<l_panel_end; l_row++) {
+                mpfr_srcptr l_x_i = l_x[l_row];
+                const double * l_row_values = l_dense + (l_row * l_lda);
+
+                for (j=l_tile_start; j<l_tile_end; j++) {
+                    mpfr_set_d(l_a_ij, l_row_values[j], MPFR_RNDN);
+                    mpfr_fma(l_acc[j - l_tile_start], l_x_i, l_a_ij, l_acc[j - l_tile_start], l_rounding_mode);
+                }
+            }
+        }
+
+        for (j=l_tile_start; j<l_tile_end; j++) {
+            y[j] *= *(l_job->beta);
+            y[j].fma(acc[j - l_tile_start], l_job->alpha);
+        }
+    }
+}
+
+void vgemvdBCSR(int precision, char trans, int m, int n,
+                double alpha,
+                const dmatBCSR_t a_bcsr,
+                int lda,
+                const VPFloatArray & x,
+                const VPFloat & beta,
+                VPFloatArray & y, 
+                VPFloatArray & acc,
+                int start_row_number) {
+    VgemvdJob l_job;
+    int64_t l_min_block_rows_per_chunk = VBLAS::VBLAS_getConfig()->nb_rows_per_thread / a_bcsr->row_block_size;
+
+    l_job.a = a_bcsr;
+    l_job.n = n;
+    l_job.x = &x;
+    l_job.acc = &acc;
+    l_job.start_row_number = start_row_number;
+
+    VBLAS::VBLASThreadPool_run(a_bcsr->num_block_rows, l_min_block_rows_per_chunk, vgemvdBCSRBlockRows, &l_job);
 
     if ( a_bcsr->num_rows_leftover > 0 ) {
         vgemvdBCSR( precision, trans, m, n,
@@ -95,46 +530,68 @@ void vgemvdBCSR(int precision, char trans, int m, int n,
     }
 }
 
+/*
+ * Runs a scatter kernel over the a_nb_rows rows of A, then y = alpha * (sum of the partial y) + beta * y. The partial
+ * y have the precision of y.
+ */
+static void vgemvdScatter(VgemvdJob & a_job, int64_t a_nb_rows, VBLAS::VBLASThreadPoolRoutine a_kernel) {
+    VPFloatArray & y = *(a_job.y);
+    vpfloat_evp_t y_env = y.getEnvironment();
+
+    a_job.nb_parts = vgemvdScatterNbParts(a_nb_rows);
+
+    VPFloatArray l_acc(y_env.es, y_env.bis, y_env.stride, a_job.nb_parts * y.nbElements());
+
+    a_job.acc = &l_acc;
+
+    VBLAS::VBLASThreadPool_run(a_job.nb_parts, 1, a_kernel, &a_job);
+    VBLAS::VBLASThreadPool_run(y.nbElements(), VBLAS::VBLAS_getConfig()->nb_rows_per_thread, vgemvdAccumulatorRows, &a_job);
+}
+
 void VBLAS::vgemvd( int precision, char trans, int m, int n,
                     double alpha,
                     const matrix_t a,
                     const VPFloatArray & x,
                     const VPFloat & beta,
                     VPFloatArray & y) {
+    VgemvdJob l_job;
+    int64_t l_min_rows_per_chunk = VBLAS_getConfig()->nb_rows_per_thread;
 
     if ( a->type_value == COMPLEX_VALUE ) {
         std::cout << __func__ << " : Matrix with complex values not supported." << std::endl;
     }
 
+    l_job.m = m;
+    l_job.n = n;
+    l_job.lda = a->lda;
+    l_job.trans = trans;
+    l_job.alpha = alpha;
+    l_job.x = &x;
+    l_job.beta = &beta;
+    l_job.y = &y;
+    l_job.acc = NULL;
+    l_job.start_row_number = 0;
+    l_job.nb_parts = 1;
+
     switch(a->type_matrix) {
 
         case CSR: {
-            if ( trans != 'N' ) {
-                std::cout << __FUNCTION__ << " trans=N not supported on CSR matrix in MPFR implementation." << std::endl;
-                return;
-            }
-
-            VPFloat res(VPFloatComputingEnvironment::get_temporary_var_environment().es,
-                        VPFloatComputingEnvironment::get_temporary_var_environment().bis,
-                        VPFloatComputingEnvironment::get_temporary_var_environment().stride);
-            int j, i,k;
-
             dmatCSR_t l_csr = (dmatCSR_t)a->matrix->repr;
 
-            // i est l'indice de ligne
-            for (i=0; i<m; i++) {
-                res = 0.0;
-
-                // k est l'indice de colonne
-                for (k=(l_csr->ptr[i])-1; k<(l_csr->ptr[i+1])-1; k++) {
-                    // k est l'indice de ligne
-                    j = (l_csr->ind[k])-1; // tjrs le decalage magique
+            l_job.a = l_csr;
 
-                    res +=  x[j] * l_csr->val[k];
-                }
+            if ( CSR_IS_SYMMETRIC_HALF(l_csr) ) {
+                vgemvdScatter(l_job, m, vgemvdCSRSymmetricParts);
+                return;
+            }
 
-                y[i] = res * alpha + beta * y[i];
+            if ( trans != 'N' ) {
+                // y = alpha * A^T * x + beta * y : x has m elements, y has n elements
+                vgemvdScatter(l_job, m, vgemvdCSRTransposedParts);
+                return;
             }
+
+            VBLASThreadPool_run(m, l_min_rows_per_chunk, vgemvdCSRRows, &l_job);
         }; break;
 
         case BCSR: {
@@ -142,10 +599,12 @@ void VBLAS::vgemvd( int precision, char trans, int m, int n,
             vpfloat_evp_t y_env = y.getEnvironment();
 
             if ( trans != 'N' ) {
-                std::cout << __FUNCTION__ << " trans=N not supported on BCSR matrix in MPFR implementation." << std::endl;
+                // y = alpha * A^T * x + beta * y : x has m elements, y has n elements
+                l_job.a = l_bcsr;
+                vgemvdScatter(l_job, m, vgemvdBCSRTransposedParts);
                 return;
             }
-            
+
 
             VPFloatArray l_acc(y_env.es, y_env.bis, y_env.stride, y.nbElements());
 
@@ -162,30 +621,34 @@ void VBLAS::vgemvd( int precision, char trans, int m, int n,
                         y, 
                         l_acc, 0);
 
-            for (int l_row_index = 0 ; l_row_index < m; l_row_index++){
-                y[l_row_index] =  y[l_row_index] * beta + l_acc[l_row_index] * alpha;
-            }
+            l_job.acc = &l_acc;
+
+            VBLASThreadPool_run(m, l_min_rows_per_chunk, vgemvdAccumulatorRows, &l_job);
         }; break;
             
+        case SELL: {
+            dmatSELL_t l_sell = (dmatSELL_t)a->matrix->repr;
+
+            l_job.a = l_sell;
+
+            if ( trans != 'N' ) {
+                // y = alpha * A^T * x + beta * y : x has m elements, y has n elements
+                vgemvdScatter(l_job, l_sell->num_chunks * l_sell->chunk_size, vgemvdSELLTransposedParts);
+                return;
+            }
+
+            VBLASThreadPool_run(l_sell->num_chunks, l_min_rows_per_chunk / l_sell->chunk_size, vgemvdSELLChunks, &l_job);
+        }; break;
+
         case DENSE: {
-            int i,k;
-            double * l_dense = (double *)(((dmatDENSE_t)(a->matrix->repr))->val);
-            VPFloat res(VPFloatComputingEnvironment::get_temporary_var_environment().es,
-                        VPFloatComputingEnvironment::get_temporary_var_environment().bis,
-                        VPFloatComputingEnvironment::get_temporary_var_environment().stride);
-
-            for (i=0; i<m; i++) {
-                res=0.0;
-                for (k=0; k<n; k++) {
-                    if ( trans == 'N' ) {
-                        res += x[k] * l_dense[(i*a->lda)+k];
-                    } else {
-                        res += x[k] * l_dense[(k * a->lda) + i];
-                    }
-                }
-                y[i] = res * alpha + beta * y[i];
+            l_job.a = ((dmatDENSE_t)(a->matrix->repr))->val;
+
+            if ( trans != 'N' ) {
+                VBLASThreadPool_run(n, l_min_rows_per_chunk, vgemvdDENSETransposedColumns, &l_job);
+                return;
             }
 
+            VBLASThreadPool_run(m, l_min_rows_per_chunk, vgemvdDENSERows, &l_job);
         }; break;
         default: 
             std::cout << "Matrix type " << a->matrix->type_id << " not supported." << std::endl;
@@ -193,28 +656,220 @@ void VBLAS::vgemvd( int precision, char trans, int m, int n,
     };
 }
 
+/*****************************************************************************************************************
+*  Sparse matrix - multi-vector multiplication
+*
+*  Y = (alpha * A * X) + (beta * Y)
+*
+*  The CSR and BCSR kernels load each matrix value once and multiply it by the k vectors of X, so A is streamed once
+*  for the whole product. Each element of Y accumulates its products in the order of vgemvd, with the same
+*  operations: the result of each vector is the one of vgemvd.
+****************************************************************************************************************/
+static void vgemmdCSRRows(void * a_args, int64_t a_chunk_index, int64_t a_start_row, int64_t a_end_row) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    dmatCSR_t l_csr = (dmatCSR_t)l_job->a;
+    VPFloatArray & y = *(l_job->y);
+    VPFloatArray res(VPFloatComputingEnvironment::get_temporary_var_environment().es,
+                     VPFloatComputingEnvironment::get_temporary_var_environment().bis,
+                     VPFloatComputingEnvironment::get_temporary_var_environment().stride,
+                     l_job->k);
+    mpfr_t * l_acc = (mpfr_t *)res.getData();
+    const mpfr_t * l_x = (const mpfr_t *)l_job->x->getData();
+    const int * l_ptr = l_csr->ptr;
+    const int * l_ind = l_csr->ind;
+    const double * l_val = l_csr->val;
+    int l_base = l_csr->base_index;
+    int l_m = l_job->m;
+    int l_n = l_job->n;
+    mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+    MPFR_DECL_INIT(l_a_ij, 53);
+    int i, j, k, l_row_end;
+
+    for (i=a_start_row; i<a_end_row; i++) {
+        for (j=0; j<l_job->k; j++) {
+            mpfr_set_zero(l_acc[j], 1);
+        }
+
+        l_row_end = l_ptr[i+1] - l_base;
+        for (k=l_ptr[i]-l_base; k<l_row_end; k++) {
+            const mpfr_t * l_x_col = l_x + ( l_ind[k] - l_base );
+
+            mpfr_set_d(l_a_ij, l_val[k], MPFR_RNDN);
+            for (j=0; j<l_job->k; j++) {
+                mpfr_fma(l_acc[j], l_x_col[j * l_n], l_a_ij, l_acc[j], l_rounding_mode);
+            }
+        }
+
+        for (j=0; j<l_job->k; j++) {
+            y[j * l_m + i] *= *(l_job->beta);
+            y[j * l_m + i].fma(res[j], l_job->alpha);
+        }
+    }
+}
+
+static void vgemmdBCSRBlockRows(void * a_args, int64_t a_chunk_index, int64_t a_start_block_row, int64_t a_end_block_row) {
+    VgemvdJob * l_job = (VgemvdJob *)a_args;
+    dmatBCSR_t a_bcsr = (dmatBCSR_t)l_job->a;
+    const VPFloatArray & x = *(l_job->x);
+    VPFloatArray & acc = *(l_job->acc);
+    int l_nb_elements_per_block = a_bcsr->row_block_size * a_bcsr->col_block_size;
+    int l_m = l_job->m;
+    int l_n = l_job->n;
+
+    for ( int l_row_block = a_start_block_row ; l_row_block < a_end_block_row; l_row_block++ ) {
+
+        int l_real_start_row_index = l_row_block * a_bcsr->row_block_size + l_job->start_row_number;
+
+        for (int l_block = a_bcsr->bptr[l_row_block]; l_block < a_bcsr->bptr[l_row_block+1]; l_block++) {
+
+            int l_real_start_col_index = a_bcsr->bind[l_block];
+            const double * l_block_val = a_bcsr->bval + (int64_t)l_block * l_nb_elements_per_block;
+
+            for ( int l_row_in_block = 0; l_row_in_block < a_bcsr->row_block_size; l_row_in_block++ ) {
+
+                int l_real_row_index = l_real_start_row_index + l_row_in_block;
+
+                for ( int l_col_in_block = 0; l_col_in_block < a_bcsr->col_block_size; l_col_in_block++ ) {
+
+                    double l_a_ij = l_block_val[l_row_in_block * a_bcsr->col_block_size + l_col_in_block];
+                    int l_real_col_index = l_real_start_col_index + l_col_in_block;
+
+                    // Padding columns of the last blocks
+                    if ( l_real_col_index >= l_n ) {
+                        break;
+                    }
+
+                    for ( int j = 0; j < l_job->k; j++ ) {
+                        acc[j * l_m + l_real_row_index].fma(x[j * l_n + l_real_col_index], l_a_ij);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void vgemmdBCSR(const dmatBCSR_t a_bcsr, const VgemvdJob & a_job, int a_start_row_number) {
+    VgemvdJob l_job = a_job;
+    int64_t l_min_block_rows_per_chunk = VBLAS::VBLAS_getConfig()->nb_rows_per_thread / a_bcsr->row_block_size;
+
+    l_job.a = a_bcsr;
+    l_job.start_row_number = a_start_row_number;
+
+    VBLAS::VBLASThreadPool_run(a_bcsr->num_block_rows, l_min_block_rows_per_chunk, vgemmdBCSRBlockRows, &l_job);
+
+    if ( a_bcsr->num_rows_leftover > 0 ) {
+        vgemmdBCSR(a_bcsr->leftover, a_job, a_start_row_number + ( a_bcsr->num_block_rows * a_bcsr->row_block_size ));
+    }
+}
+
+void VBLAS::vgemmd( int precision, char trans, int m, int n, int k,
+                    double alpha,
+                    const matrix_t a,
+                    const VPFloatArray & x,
+                    const VPFloat & beta,
+                    VPFloatArray & y) {
+    VgemvdJob l_job;
+    int64_t l_min_rows_per_chunk = VBLAS_getConfig()->nb_rows_per_thread;
+
+    l_job.m = m;
+    l_job.n = n;
+    l_job.lda = a->lda;
+    l_job.trans = trans;
+    l_job.alpha = alpha;
+    l_job.x = &x;
+    l_job.beta = &beta;
+    l_job.y = &y;
+    l_job.acc = NULL;
+    l_job.start_row_number = 0;
+    l_job.k = k;
+    l_job.nb_parts = 1;
+
+    if ( ( a->type_value != COMPLEX_VALUE ) && ( trans == 'N' ) ) {
+        if ( ( a->type_matrix == CSR ) && ! CSR_IS_SYMMETRIC_HALF((dmatCSR_t)a->matrix->repr) ) {
+            l_job.a = a->matrix->repr;
+
+            VBLASThreadPool_run(m, l_min_rows_per_chunk, vgemmdCSRRows, &l_job);
+            return;
+        }
+
+        if ( a->type_matrix == BCSR ) {
+            vpfloat_evp_t y_env = y.getEnvironment();
+            VPFloatArray l_acc(y_env.es, y_env.bis, y_env.stride, m * k);
+
+            for ( int i = 0 ; i < m * k; i++ ) {
+                l_acc[i] = double(0.0);
+            }
+
+            l_job.acc = &l_acc;
+
+            vgemmdBCSR((dmatBCSR_t)a->matrix->repr, l_job, 0);
+
+            VBLASThreadPool_run(m * k, l_min_rows_per_chunk, vgemvdAccumulatorRows, &l_job);
+            return;
+        }
+    }
+
+    // One product per vector
+    int l_x_size = ( trans == 'N' ) ? n : m;
+    int l_y_size = ( trans == 'N' ) ? m : n;
+
+    for (int j=0; j<k; j++) {
+        VPFloatArray l_x_j(x, j * l_x_size, l_x_size);
+        VPFloatArray l_y_j(y, j * l_y_size, l_y_size);
+
+        vgemvd(precision, trans, m, n, alpha, a, l_x_j, beta, l_y_j);
+    }
+}
+
 /*****************************************************************************************************************
  *  Vector scaling - x = alpha*x
  ****************************************************************************************************************/
-void VBLAS::vscal( int precision, int n, const VPFloat & alpha, VPFloatArray & x) {
-    int i;
+struct VectorJob {
+    const VPFloat * alpha;
+    const VPFloatArray * x;
+    VPFloatArray * y;
+};
 
-    for (i=0; i<n; i++) {
-        x[i]=alpha * x[i]; 
+static void vscalChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    VectorJob * l_job = (VectorJob *)a_args;
+    VPFloatArray & x = *(l_job->y);
+
+    for (int i=a_start; i<a_end; i++) {
+        x[i] *= *(l_job->alpha);
     }
 }
 
+void VBLAS::vscal( int precision, int n, const VPFloat & alpha, VPFloatArray & x) {
+    VectorJob l_job;
+
+    l_job.alpha = &alpha;
+    l_job.y = &x;
+
+    VBLASThreadPool_run(n, VBLAS_getConfig()->nb_rows_per_thread, vscalChunk, &l_job);
+}
+
 /*****************************************************************************************************************
  *  Vector copy - y = x
  ****************************************************************************************************************/
-void VBLAS::vcopy( int n, const VPFloatArray & x, VPFloatArray & y) {
-    int i;
+static void vcopyChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    VectorJob * l_job = (VectorJob *)a_args;
+    const VPFloatArray & x = *(l_job->x);
+    VPFloatArray & y = *(l_job->y);
 
-    for (i=0; i<n; i++) {
+    for (int i=a_start; i<a_end; i++) {
         y[i]=x[i];
     }
 }
 
+void VBLAS::vcopy( int n, const VPFloatArray & x, VPFloatArray & y) {
+    VectorJob l_job;
+
+    l_job.x = &x;
+    l_job.y = &y;
+
+    VBLASThreadPool_run(n, VBLAS_getConfig()->nb_rows_per_thread, vcopyChunk, &l_job);
+}
+
 void VBLAS::vcopy_d_v( int n, const double * x, VPFloatArray & y) {
     int i;
 
@@ -251,13 +906,81 @@ void VBLAS::daxpy(int n, double alpha, const double *x, vpfloat_off_t x_inc, dou
     }
 }
 
+static void vaxpyChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    VectorJob * l_job = (VectorJob *)a_args;
+    const VPFloatArray & x = *(l_job->x);
+    VPFloatArray & y = *(l_job->y);
+
+    for (int i=a_start; i<a_end; i++) {
+        y[i].fma(*(l_job->alpha), x[i]);
+    }
+}
+
 void VBLAS::vaxpy( int precision, int n, const VPFloat & alpha, const VPFloatArray & x, VPFloatArray & y) {
-    int i;
+    VectorJob l_job;
 
-    for (i=0; i<n; i++) {
-        y[i] = alpha * x[i]+y[i]; 
-    }    
+    l_job.alpha = &alpha;
+    l_job.x = &x;
+    l_job.y = &y;
 
+    VBLASThreadPool_run(n, VBLAS_getConfig()->nb_rows_per_thread, vaxpyChunk, &l_job);
+}
+
+/*****************************************************************************************************************
+ *  Vector addition with scaling of both vectors (AXPBY) - y = alpha*x + beta*y
+ ****************************************************************************************************************/
+struct VectorAxpbyJob {
+    const VPFloat * alpha;
+    const VPFloat * beta;
+    const VPFloatArray * x;
+    VPFloatArray * y;
+};
+
+static void vaxpbyChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    VectorAxpbyJob * l_job = (VectorAxpbyJob *)a_args;
+    const VPFloatArray & x = *(l_job->x);
+    VPFloatArray & y = *(l_job->y);
+
+    for (int i=a_start; i<a_end; i++) {
+        y[i] *= *(l_job->beta);
+        y[i].fma(*(l_job->alpha), x[i]);
+    }
+}
+
+void VBLAS::vaxpby( int precision, int n, const VPFloat & alpha, const VPFloatArray & x, const VPFloat & beta, VPFloatArray & y) {
+    VectorAxpbyJob l_job;
+
+    l_job.alpha = &alpha;
+    l_job.beta = &beta;
+    l_job.x = &x;
+    l_job.y = &y;
+
+    VBLASThreadPool_run(n, VBLAS_getConfig()->nb_rows_per_thread, vaxpbyChunk, &l_job);
+}
+
+/*****************************************************************************************************************
+ *  Vector addition with scaling of the result (XPAY) - y = x + alpha*y
+ ****************************************************************************************************************/
+static void vxpayChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    VectorJob * l_job = (VectorJob *)a_args;
+    const VPFloatArray & x = *(l_job->x);
+    VPFloatArray & y = *(l_job->y);
+
+    for (int i=a_start; i<a_end; i++) {
+        VPFloat l_y = y[i];
+
+        VPFloatOperation::fma(l_y, *(l_job->alpha), l_y, x[i]);
+    }
+}
+
+void VBLAS::vxpay( int precision, int n, const VPFloatArray & x, const VPFloat & alpha, VPFloatArray & y) {
+    VectorJob l_job;
+
+    l_job.alpha = &alpha;
+    l_job.x = &x;
+    l_job.y = &y;
+
+    VBLASThreadPool_run(n, VBLAS_getConfig()->nb_rows_per_thread, vxpayChunk, &l_job);
 }
 
 /*****************************************************************************************************************
@@ -285,12 +1008,475 @@ double VBLAS::ddot(int n, const double *x, vpfloat_off_t x_inc, const double *y,
     return(dtemp);
 }
 
-void VBLAS::vdot( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, VPFloat & res) {
+struct DotJob {
+    const VPFloatArray * x;
+    const VPFloatArray * y;
+    VPFloatArray * partials;
+};
+
+static void vdotChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    DotJob * l_job = (DotJob *)a_args;
+    const VPFloatArray & x = *(l_job->x);
+    const VPFloatArray & y = *(l_job->y);
+    VPFloat l_partial = (*(l_job->partials))[a_chunk_index];
+
+    l_partial = 0.0;
+    for (int i=a_start; i<a_end; i++) {
+        l_partial.fma(y[i], x[i]);
+    }
+}
+
+/*
+ * Exact dot product.
+ *
+ * A product x[i]*y[i] is exact with (precision of x + precision of y) bits: it is a multiple of 2^(e - px - py) smaller
+ * than 2^e, e being the sum of the exponents of x[i] and y[i]. With emin and emax the smallest and largest e, the sum
+ * of the n products is a multiple of 2^(emin - px - py) smaller than n * 2^emax: an accumulator of
+ * emax - emin + px + py + log2(n) bits holds every partial sum without rounding. Only the final copy to res rounds.
+ *
+ * Above VDOT_EXACT_MAX_ACCUMULATOR_PRECISION bits, each fma would move a large accumulator: the exact products are
+ * stored and mpfr_sum rounds their sum once, its cost depending on the precision of the products and not on the
+ * exponent range.
+ */
+#define VDOT_EXACT_MAX_ACCUMULATOR_PRECISION 16384
+
+struct ExactDotJob {
+    const mpfr_t * x;
+    const mpfr_t * y;
+    mpfr_exp_t * block_emin;
+    mpfr_exp_t * block_emax;
+    bool * block_has_regular_product;
+    bool * block_has_special_value;
+    mpfr_t * accumulators;
+    mpfr_prec_t accumulator_precision;
+    mpfr_t * products;
+    mpfr_ptr * product_pointers;
+    mpfr_prec_t product_precision;
+};
+
+static void vdotExactRangeBlock(void * a_args, int64_t a_block_index, int64_t a_start, int64_t a_end) {
+    ExactDotJob * l_job = (ExactDotJob *)a_args;
+    mpfr_exp_t l_emin = 0;
+    mpfr_exp_t l_emax = 0;
+    bool l_has_regular_product = false;
+    bool l_has_special_value = false;
+
+    for (int64_t i=a_start; i<a_end; i++) {
+        if ( mpfr_regular_p(l_job->x[i]) && mpfr_regular_p(l_job->y[i]) ) {
+            mpfr_exp_t l_exponent = mpfr_get_exp(l_job->x[i]) + mpfr_get_exp(l_job->y[i]);
+
+            if ( ( ! l_has_regular_product ) || ( l_exponent < l_emin ) ) {
+                l_emin = l_exponent;
+            }
+            if ( ( ! l_has_regular_product ) || ( l_exponent > l_emax ) ) {
+                l_emax = l_exponent;
+            }
+            l_has_regular_product = true;
+        } else if ( ( ! mpfr_number_p(l_job->x[i]) ) || ( ! mpfr_number_p(l_job->y[i]) ) ) {
+            l_has_special_value = true;
+        }
+    }
+
+    l_job->block_emin[a_block_index] = l_emin;
+    l_job->block_emax[a_block_index] = l_emax;
+    l_job->block_has_regular_product[a_block_index] = l_has_regular_product;
+    l_job->block_has_special_value[a_block_index] = l_has_special_value;
+}
+
+static void vdotExactBlock(void * a_args, int64_t a_block_index, int64_t a_start, int64_t a_end) {
+    ExactDotJob * l_job = (ExactDotJob *)a_args;
+    mpfr_ptr l_accumulator = l_job->accumulators[a_block_index];
+
+    mpfr_init2(l_accumulator, l_job->accumulator_precision);
+    mpfr_set_zero(l_accumulator, 1);
+
+    for (int64_t i=a_start; i<a_end; i++) {
+        mpfr_fma(l_accumulator, l_job->x[i], l_job->y[i], l_accumulator, MPFR_RNDN);
+    }
+}
+
+static void vdotExactProductsBlock(void * a_args, int64_t a_block_index, int64_t a_start, int64_t a_end) {
+    ExactDotJob * l_job = (ExactDotJob *)a_args;
+
+    for (int64_t i=a_start; i<a_end; i++) {
+        mpfr_init2(l_job->products[i], l_job->product_precision);
+        mpfr_mul(l_job->products[i], l_job->x[i], l_job->y[i], MPFR_RNDN);
+        l_job->product_pointers[i] = l_job->products[i];
+    }
+}
+
+static void vdotExact(int precision, int n, const VPFloatArray & x, const VPFloatArray & y, VPFloat & res) {
+    int64_t l_nb_blocks = VBLAS::VBLASReduction_nbBlocks(n);
+    ExactDotJob l_job;
+    mpfr_exp_t l_emin = 0;
+    mpfr_exp_t l_emax = 0;
+    bool l_has_regular_product = false;
+    bool l_has_special_value = false;
+
+    l_job.x = (const mpfr_t *)x.getData();
+    l_job.y = (const mpfr_t *)y.getData();
+    l_job.block_emin = (mpfr_exp_t *)malloc(l_nb_blocks * sizeof(mpfr_exp_t));
+    l_job.block_emax = (mpfr_exp_t *)malloc(l_nb_blocks * sizeof(mpfr_exp_t));
+    l_job.block_has_regular_product = (bool *)malloc(l_nb_blocks * sizeof(bool));
+    l_job.block_has_special_value = (bool *)malloc(l_nb_blocks * sizeof(bool));
+
+    VBLAS::VBLASReduction_run(n, vdotExactRangeBlock, &l_job);
+
+    for (int64_t l_block = 0; l_block < l_nb_blocks; l_block++) {
+        if ( l_job.block_has_regular_product[l_block] ) {
+            if ( ( ! l_has_regular_product ) || ( l_job.block_emin[l_block] < l_emin ) ) {
+                l_emin = l_job.block_emin[l_block];
+            }
+            if ( ( ! l_has_regular_product ) || ( l_job.block_emax[l_block] > l_emax ) ) {
+                l_emax = l_job.block_emax[l_block];
+            }
+            l_has_regular_product = true;
+        }
+        l_has_special_value |= l_job.block_has_special_value[l_block];
+    }
+
+    free(l_job.block_emin);
+    free(l_job.block_emax);
+    free(l_job.block_has_regular_product);
+    free(l_job.block_has_special_value);
+
+    if ( l_has_special_value ) {
+        /*
+         * NaN and infinities: the rounded dot product gives the same result.
+         */
+        vdot(precision, n, x, y, res, VBLAS::VBLAS_DOT_ROUNDED);
+        return;
+    }
+
+    if ( ! l_has_regular_product ) {
+        res = 0.0;
+        return;
+    }
+
+    mpfr_prec_t l_log2_n = 1;
+    while ( ( ((int64_t)1) << l_log2_n ) < n ) {
+        l_log2_n++;
+    }
+
+    l_job.product_precision = mpfr_get_prec(l_job.x[0]) + mpfr_get_prec(l_job.y[0]);
+
+    if ( ( l_emax - l_emin ) > VDOT_EXACT_MAX_ACCUMULATOR_PRECISION - l_job.product_precision - l_log2_n - 1 ) {
+        l_job.products = (mpfr_t *)malloc(n * sizeof(mpfr_t));
+        l_job.product_pointers = (mpfr_ptr *)malloc(n * sizeof(mpfr_ptr));
+
+        VBLAS::VBLASReduction_run(n, vdotExactProductsBlock, &l_job);
+
+        mpfr_sum(*((mpfr_t *)res.getData()), l_job.product_pointers, n, mpfr_get_default_rounding_mode());
+
+        for (int i=0; i<n; i++) {
+            mpfr_clear(l_job.products[i]);
+        }
+        free(l_job.products);
+        free(l_job.product_pointers);
+        return;
+    }
+
+    l_job.accumulator_precision = ( l_emax - l_emin ) + l_job.product_precision + l_log2_n + 1;
+    l_job.accumulators = (mpfr_t *)malloc(l_nb_blocks * sizeof(mpfr_t));
+
+    VBLAS::VBLASReduction_run(n, vdotExactBlock, &l_job);
+
+    /*
+     * Additions are exact: the order of the blocks does not matter.
+     */
+    for (int64_t l_block = 1; l_block < l_nb_blocks; l_block++) {
+        mpfr_add(l_job.accumulators[0], l_job.accumulators[0], l_job.accumulators[l_block], MPFR_RNDN);
+        mpfr_clear(l_job.accumulators[l_block]);
+    }
+
+    mpfr_set(*((mpfr_t *)res.getData()), l_job.accumulators[0], mpfr_get_default_rounding_mode());
+
+    mpfr_clear(l_job.accumulators[0]);
+    free(l_job.accumulators);
+}
+
+void VBLAS::vdot( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, VPFloat & res, VBLASDotMode a_dot_mode) {
+    int64_t l_nb_blocks = VBLASReduction_nbBlocks(n);
     int i;
-    res = 0.0;
-    for (i=0; i<n; i++) {
-        res += y[i]*x[i];
+
+    if ( ( a_dot_mode == VBLAS_DOT_EXACT ) && ( n > 0 ) ) {
+        vdotExact(precision, n, x, y, res);
+        return;
+    }
+
+    if ( l_nb_blocks == 1 ) {
+        res = 0.0;
+        for (i=0; i<n; i++) {
+            res.fma(y[i], x[i]);
+        }
+        return;
+    }
+
+    /*
+     * One partial sum per reduction block, in the precision of res.
+     */
+    vpfloat_evp_t l_res_env = res.getEnvironment();
+    VPFloatArray l_partials(l_res_env.es, l_res_env.bis, l_res_env.stride, l_nb_blocks);
+    DotJob l_job;
+
+    l_job.x = &x;
+    l_job.y = &y;
+    l_job.partials = &l_partials;
+
+    VBLASReduction_run(n, vdotChunk, &l_job);
+    VBLASReduction_combine(l_partials, l_nb_blocks);
+
+    res = l_partials[0];
+}
+
+/*****************************************************************************************************************
+ *  AXPY fused with the dot product of the result - y = alpha*x + y, res = y * y
+ ****************************************************************************************************************/
+struct AxpyDotJob {
+    const VPFloat * alpha;
+    const VPFloatArray * x;
+    VPFloatArray * y;
+    VPFloatArray * partials;
+};
+
+static void vaxpyDotChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    AxpyDotJob * l_job = (AxpyDotJob *)a_args;
+    const VPFloatArray & x = *(l_job->x);
+    VPFloatArray & y = *(l_job->y);
+    VPFloat l_partial = (*(l_job->partials))[a_chunk_index];
+
+    l_partial = 0.0;
+    for (int i=a_start; i<a_end; i++) {
+        y[i].fma(*(l_job->alpha), x[i]);
+        l_partial.fma(y[i], y[i]);
+    }
+}
+
+void VBLAS::vaxpy_dot( int precision, int n, const VPFloat & alpha, const VPFloatArray & x, VPFloatArray & y, VPFloat & res, VBLASDotMode a_dot_mode) {
+    int64_t l_nb_blocks = VBLASReduction_nbBlocks(n);
+    int i;
+
+    if ( a_dot_mode == VBLAS_DOT_EXACT ) {
+        /*
+         * The exact dot product needs the exponent range of the updated vector before accumulating.
+         */
+        vaxpy(precision, n, alpha, x, y);
+        vdot(precision, n, y, y, res, a_dot_mode);
+        return;
+    }
+
+    if ( l_nb_blocks == 1 ) {
+        res = 0.0;
+        for (i=0; i<n; i++) {
+            y[i].fma(alpha, x[i]);
+            res.fma(y[i], y[i]);
+        }
+        return;
+    }
+
+    /*
+     * Same blocks and combination tree than vdot: the result is the one of vaxpy followed by vdot.
+     */
+    vpfloat_evp_t l_res_env = res.getEnvironment();
+    VPFloatArray l_partials(l_res_env.es, l_res_env.bis, l_res_env.stride, l_nb_blocks);
+    AxpyDotJob l_job;
+
+    l_job.alpha = &alpha;
+    l_job.x = &x;
+    l_job.y = &y;
+    l_job.partials = &l_partials;
+
+    VBLASReduction_run(n, vaxpyDotChunk, &l_job);
+    VBLASReduction_combine(l_partials, l_nb_blocks);
+
+    res = l_partials[0];
+}
+
+/*****************************************************************************************************************
+ *  Two dot products sharing a vector - res_y = x * y, res_z = x * z
+ ****************************************************************************************************************/
+struct Dot2Job {
+    const VPFloatArray * x;
+    const VPFloatArray * y;
+    const VPFloatArray * z;
+    VPFloatArray * partials_y;
+    VPFloatArray * partials_z;
+};
+
+static void vdot2Chunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    Dot2Job * l_job = (Dot2Job *)a_args;
+    const VPFloatArray & x = *(l_job->x);
+    const VPFloatArray & y = *(l_job->y);
+    const VPFloatArray & z = *(l_job->z);
+    VPFloat l_partial_y = (*(l_job->partials_y))[a_chunk_index];
+    VPFloat l_partial_z = (*(l_job->partials_z))[a_chunk_index];
+
+    l_partial_y = 0.0;
+    l_partial_z = 0.0;
+    for (int i=a_start; i<a_end; i++) {
+        l_partial_y.fma(y[i], x[i]);
+        l_partial_z.fma(z[i], x[i]);
+    }
+}
+
+void VBLAS::vdot2( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, const VPFloatArray & z, VPFloat & res_y, VPFloat & res_z, VBLASDotMode a_dot_mode) {
+    int64_t l_nb_blocks = VBLASReduction_nbBlocks(n);
+    int i;
+
+    if ( a_dot_mode == VBLAS_DOT_EXACT ) {
+        vdot(precision, n, x, y, res_y, a_dot_mode);
+        vdot(precision, n, x, z, res_z, a_dot_mode);
+        return;
+    }
+
+    if ( l_nb_blocks == 1 ) {
+        res_y = 0.0;
+        res_z = 0.0;
+        for (i=0; i<n; i++) {
+            res_y.fma(y[i], x[i]);
+            res_z.fma(z[i], x[i]);
+        }
+        return;
+    }
+
+    /*
+     * Same blocks and combination tree than vdot.
+     */
+    vpfloat_evp_t l_res_y_env = res_y.getEnvironment();
+    vpfloat_evp_t l_res_z_env = res_z.getEnvironment();
+    VPFloatArray l_partials_y(l_res_y_env.es, l_res_y_env.bis, l_res_y_env.stride, l_nb_blocks);
+    VPFloatArray l_partials_z(l_res_z_env.es, l_res_z_env.bis, l_res_z_env.stride, l_nb_blocks);
+    Dot2Job l_job;
+
+    l_job.x = &x;
+    l_job.y = &y;
+    l_job.z = &z;
+    l_job.partials_y = &l_partials_y;
+    l_job.partials_z = &l_partials_z;
+
+    VBLASReduction_run(n, vdot2Chunk, &l_job);
+    VBLASReduction_combine(l_partials_y, l_nb_blocks);
+    VBLASReduction_combine(l_partials_z, l_nb_blocks);
+
+    res_y = l_partials_y[0];
+    res_z = l_partials_z[0];
+}
+
+/*****************************************************************************************************************
+ *  Block of k vectors - res = v^T x, y = y + v alpha
+ ****************************************************************************************************************/
+struct BlockJob {
+    int n;
+    int k;
+    const VPFloatArray * alpha;
+    const VPFloatArray * v;
+    const VPFloatArray * x;
+    VPFloatArray * y;
+    VPFloatArray * partials;    // k partial results per reduction block, partials[block * k + j]
+};
+
+static void vdotBlockChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    BlockJob * l_job = (BlockJob *)a_args;
+    const VPFloatArray & v = *(l_job->v);
+    const VPFloatArray & x = *(l_job->x);
+
+    for (int j=0; j<l_job->k; j++) {
+        VPFloat l_partial = (*(l_job->partials))[a_chunk_index * l_job->k + j];
+        int64_t l_offset = (int64_t)j * l_job->n;
+
+        l_partial = 0.0;
+        for (int i=a_start; i<a_end; i++) {
+            l_partial.fma(x[i], v[l_offset + i]);
+        }
+    }
+}
+
+/*
+ * Partial results of one vector of the block, with the interface VBLASReduction_combine expects.
+ */
+struct BlockPartials {
+    const VPFloatArray * partials;
+    int k;
+    int j;
+
+    VPFloat operator[](int64_t a_block) const {
+        return (*partials)[a_block * k + j];
+    }
+};
+
+void VBLAS::vdot_block( int precision, int n, int k, const VPFloatArray & v, const VPFloatArray & x, VPFloatArray & res, VBLASDotMode a_dot_mode) {
+    int64_t l_nb_blocks = VBLASReduction_nbBlocks(n);
+
+    if ( a_dot_mode == VBLAS_DOT_EXACT ) {
+        for (int j=0; j<k; j++) {
+            VPFloatArray l_v_j(v, j * n, n);
+            VPFloat l_res_j = res[j];
+
+            vdot(precision, n, l_v_j, x, l_res_j, a_dot_mode);
+        }
+        return;
+    }
+
+    if ( l_nb_blocks == 1 ) {
+        for (int j=0; j<k; j++) {
+            VPFloat l_res_j = res[j];
+
+            l_res_j = 0.0;
+            for (int i=0; i<n; i++) {
+                l_res_j.fma(x[i], v[j * n + i]);
+            }
+        }
+        return;
     }
+
+    /*
+     * Same blocks and combination tree than vdot, for each vector of the block.
+     */
+    vpfloat_evp_t l_res_env = res.getEnvironment();
+    VPFloatArray l_partials(l_res_env.es, l_res_env.bis, l_res_env.stride, l_nb_blocks * k);
+    BlockJob l_job;
+
+    l_job.n = n;
+    l_job.k = k;
+    l_job.v = &v;
+    l_job.x = &x;
+    l_job.partials = &l_partials;
+
+    VBLASReduction_run(n, vdotBlockChunk, &l_job);
+
+    for (int j=0; j<k; j++) {
+        BlockPartials l_partials_j = { &l_partials, k, j };
+
+        VBLASReduction_combine(l_partials_j, l_nb_blocks);
+        res[j] = l_partials_j[0];
+    }
+}
+
+static void vaxpyBlockChunk(void * a_args, int64_t a_chunk_index, int64_t a_start, int64_t a_end) {
+    BlockJob * l_job = (BlockJob *)a_args;
+    const VPFloatArray & alpha = *(l_job->alpha);
+    const VPFloatArray & v = *(l_job->v);
+    VPFloatArray & y = *(l_job->y);
+
+    for (int i=a_start; i<a_end; i++) {
+        VPFloat l_y = y[i];
+
+        for (int j=0; j<l_job->k; j++) {
+            l_y.fma(alpha[j], v[(int64_t)j * l_job->n + i]);
+        }
+    }
+}
+
+void VBLAS::vaxpy_block( int precision, int n, int k, const VPFloatArray & alpha, const VPFloatArray & v, VPFloatArray & y) {
+    BlockJob l_job;
+
+    l_job.n = n;
+    l_job.k = k;
+    l_job.alpha = &alpha;
+    l_job.v = &v;
+    l_job.y = &y;
+
+    VBLASThreadPool_run(n, VBLAS_getConfig()->nb_rows_per_thread, vaxpyBlockChunk, &l_job);
 }
 
 void VBLAS::vzero(int precision, int n, VPFloatArray & x) {
@@ -312,8 +1498,8 @@ double VBLAS::dnrm2 (int n, const double *x, int x_inc) {
     return sqrt(VBLAS::ddot(n, x, x_inc, x, x_inc));
 }
 
-void VBLAS::vnrm2 (int precision, int n, const VPFloatArray& x, VPFloat & res) {
-    vdot(precision, n, x, x, res);
+void VBLAS::vnrm2 (int precision, int n, const VPFloatArray& x, VPFloat & res, VBLASDotMode a_dot_mode) {
+    vdot(precision, n, x, x, res, a_dot_mode);
     const VPFloat & l_const_res = res;
     res = VMath::vsqrt(l_const_res);
 }
\ No newline at end of file
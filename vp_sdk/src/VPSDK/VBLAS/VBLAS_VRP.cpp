@@ -82,8 +82,10 @@ void VBLAS::vgemvd( int precision, char trans, int m, int n,
     switch(a->type_matrix) {
     case CSR:
     case BCSR:
+    case SELL:
 
-        if ( trans != 'N' ) {
+        // A half stored symmetric matrix is its own transposed
+        if ( trans != 'N' && ! ( a->type_matrix == CSR && CSR_IS_SYMMETRIC_HALF((dmatCSR_t)a->matrix->repr) ) ) {
             std::cout << __FUNCTION__ << " trans=N not supported on CSR matrix in VRP implementation." << std::endl;
             return;
         }
@@ -138,6 +140,31 @@ void VBLAS::vgemvd( int precision, char trans, int m, int n,
 
 }
 
+/*****************************************************************************************************************
+*  Sparse matrix - multi-vector multiplication
+*
+*  Y = (alpha * A * X) + (beta * Y)
+*
+*  The vectors are processed one by one with the VRP kernels.
+****************************************************************************************************************/
+void VBLAS::vgemmd( int precision, char trans, int m, int n, int k,
+                    double alpha,
+                    const matrix_t a,
+                    const VPFloatArray & x,
+                    const VPFloat & beta,
+                    VPFloatArray & y) {
+    int l_x_size = ( trans == 'N' ) ? n : m;
+    int l_y_size = ( trans == 'N' ) ? m : n;
+
+    for (int j=0; j<k; j++) {
+        VPFloatArray l_x_j(x, j * l_x_size, l_x_size);
+        VPFloatArray l_y_j(y, j * l_y_size, l_y_size);
+
+        vgemvd(precision, trans, m, n, alpha, a, l_x_j, beta, l_y_j);
+    }
+
+}
+
 /*****************************************************************************************************************
  *  Vector scaling - x = alpha*x
  ****************************************************************************************************************/
@@ -258,6 +285,31 @@ void VBLAS::vaxpy( int precision, int n, const VPFloat & alpha, const VPFloatArr
 #endif // PERF_DEBUG
 }
 
+/*****************************************************************************************************************
+ *  Vector addition with scaling of both vectors (AXPBY) - y = alpha*x + beta*y
+ *  vblas has no fused kernel: the operation is done with vscal and vaxpy.
+ ****************************************************************************************************************/
+void VBLAS::vaxpby( int precision, int n, const VPFloat & alpha, const VPFloatArray & x, const VPFloat & beta, VPFloatArray & y) {
+
+    vscal(precision, n, beta, y);
+
+    vaxpy(precision, n, alpha, x, y);
+
+}
+
+/*****************************************************************************************************************
+ *  Vector addition with scaling of the result (XPAY) - y = x + alpha*y
+ *  vblas has no fused kernel: the operation is done with vscal and vaxpy.
+ ****************************************************************************************************************/
+void VBLAS::vxpay( int precision, int n, const VPFloatArray & x, const VPFloat & alpha, VPFloatArray & y) {
+    VPFloat l_one(1.0);
+
+    vscal(precision, n, alpha, y);
+
+    vaxpy(precision, n, l_one, x, y);
+
+}
+
 /*****************************************************************************************************************
  *  Scalar vector-vector multiplication (dot product) - x * y
  ****************************************************************************************************************/
@@ -285,7 +337,14 @@ double VBLAS::ddot(int n, const double *x, vpfloat_off_t x_inc, const double *y,
     return double(l_result);
 }
 
-void VBLAS::vdot( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, VPFloat & res) {
+void VBLAS::vdot( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, VPFloat & res, VBLASDotMode a_dot_mode) {
+    static bool l_exact_dot_warning_done = false;
+
+    if ( ( a_dot_mode == VBLAS_DOT_EXACT ) && ( ! l_exact_dot_warning_done ) ) {
+        std::cout << "WARNING : exact dot product is not available on VRP, a rounded dot product is computed" << std::endl;
+        l_exact_dot_warning_done = true;
+    }
+
 #ifdef PERF_DEBUG
     clock_t t0, t1;
     uint64_t instr0, instr1;
@@ -311,6 +370,50 @@ void VBLAS::vdot( int precision, int n, const VPFloatArray & x, const VPFloatArr
 #endif // PERF_DEBUG    
 }
 
+/*****************************************************************************************************************
+ *  AXPY fused with the dot product of the result - y = alpha*x + y, res = y * y
+ *  vblas has no fused kernel: the operation is done with vaxpy and vdot.
+ ****************************************************************************************************************/
+void VBLAS::vaxpy_dot( int precision, int n, const VPFloat & alpha, const VPFloatArray & x, VPFloatArray & y, VPFloat & res, VBLASDotMode a_dot_mode) {
+
+    vaxpy(precision, n, alpha, x, y);
+
+    vdot(precision, n, y, y, res, a_dot_mode);
+
+}
+
+void VBLAS::vdot2( int precision, int n, const VPFloatArray & x, const VPFloatArray & y, const VPFloatArray & z, VPFloat & res_y, VPFloat & res_z, VBLASDotMode a_dot_mode) {
+
+    vdot(precision, n, x, y, res_y, a_dot_mode);
+
+    vdot(precision, n, x, z, res_z, a_dot_mode);
+
+}
+
+/*
+ * The vectors of the block are processed one by one with the VRP kernels.
+ */
+void VBLAS::vdot_block( int precision, int n, int k, const VPFloatArray & v, const VPFloatArray & x, VPFloatArray & res, VBLASDotMode a_dot_mode) {
+
+    for (int j=0; j<k; j++) {
+        VPFloatArray l_v_j(v, j * n, n);
+        VPFloat l_res_j = res[j];
+
+        vdot(precision, n, l_v_j, x, l_res_j, a_dot_mode);
+    }
+
+}
+
+void VBLAS::vaxpy_block( int precision, int n, int k, const VPFloatArray & alpha, const VPFloatArray & v, VPFloatArray & y) {
+
+    for (int j=0; j<k; j++) {
+        VPFloatArray l_v_j(v, j * n, n);
+
+        vaxpy(precision, n, alpha[j], l_v_j, y);
+    }
+
+}
+
 void VBLAS::vzero(int precision, int n, VPFloatArray & x) {
 
     memset(x.getData(), 0, n*VPFLOAT_SIZEOF(x.getEnvironment()));
@@ -332,9 +435,9 @@ double VBLAS::dnrm2 (int n, const double *x, int x_inc) {
 
 }
 
-void VBLAS::vnrm2 (int precision, int n, const VPFloatArray& x, VPFloat & res) {
+void VBLAS::vnrm2 (int precision, int n, const VPFloatArray& x, VPFloat & res, VBLASDotMode a_dot_mode) {
 
-    vdot(precision, n, x, x, res);
+    vdot(precision, n, x, x, res, a_dot_mode);
 
     vsqrt(precision, res.getData(), res.getEnvironment(), res.getData(), res.getEnvironment());
 
@@ -21,6 +21,7 @@
 
 #include "VPSDK/VPComplex.hpp"
 #include <cstring>
+#include <utility>
 
 using namespace VPFloatPackage;
 
@@ -48,6 +49,26 @@ VPComplexArray::VPComplexArray(VPComplexArray * a_other) :
 	this->m_release_m_data_on_destruction = false;
 }
 
+VPComplexArray::VPComplexArray(VPComplexArray && a_other) :
+	m_environment(a_other.m_environment),
+	m_data(a_other.m_data),
+	m_release_m_data_on_destruction(a_other.m_release_m_data_on_destruction),
+	m_nb_elements(a_other.m_nb_elements)
+{
+	a_other.m_data = NULL;
+	a_other.m_release_m_data_on_destruction = false;
+	a_other.m_nb_elements = 0;
+}
+
+VPComplexArray & VPComplexArray::operator=(VPComplexArray && a_other) {
+	std::swap(this->m_environment, a_other.m_environment);
+	std::swap(this->m_data, a_other.m_data);
+	std::swap(this->m_release_m_data_on_destruction, a_other.m_release_m_data_on_destruction);
+	std::swap(this->m_nb_elements, a_other.m_nb_elements);
+
+	return *this;
+}
+
 VPComplexArray::~VPComplexArray() {
 	if ( this->m_release_m_data_on_destruction ) {
 		free(this->m_data);
@@ -20,6 +20,7 @@
  **/
 
 #include "VPSDK/VPComplex.hpp"
+#include <utility>
 
 namespace VPFloatPackage {
 
@@ -32,6 +33,38 @@ namespace VPFloatPackage {
         this->m_release_m_data_on_destruction = a_release_memory_on_destruction;
     }
 
+    VPComplex::VPComplex(VPComplex && a_other) :
+        VPFloat(static_cast<VPFloat &&>(a_other)),
+        m_environment(a_other.m_environment),
+        m_data(a_other.m_data),
+        m_release_m_data_on_destruction(a_other.m_release_m_data_on_destruction)
+    {
+        a_other.m_data = NULL;
+        a_other.m_release_m_data_on_destruction = false;
+    }
+
+    VPComplex& VPComplex::operator = (VPComplex &&a_other) {
+        bool l_exchange_memory = ( this->m_data == NULL );
+
+        if ( ( this->m_release_m_data_on_destruction )
+          && ( a_other.m_release_m_data_on_destruction )
+          && ( this->m_environment.es == a_other.m_environment.es )
+          && ( this->m_environment.bis == a_other.m_environment.bis )
+          && ( this->m_environment.stride == a_other.m_environment.stride ) ) {
+            l_exchange_memory = true;
+        }
+
+        if ( ! l_exchange_memory ) {
+            return *this = static_cast<const VPComplex &>(a_other);
+        }
+
+        std::swap(this->m_environment, a_other.m_environment);
+        std::swap(this->m_data, a_other.m_data);
+        std::swap(this->m_release_m_data_on_destruction, a_other.m_release_m_data_on_destruction);
+
+        return *this;
+    }
+
     VPComplex::~VPComplex() {
         if ( this->m_release_m_data_on_destruction ) {
             free(this->m_data);
@@ -59,4 +92,39 @@ namespace VPFloatPackage {
         VPComplex l_result(a_lhs); l_result /= a_rhs; return l_result;
     }
 
-}
\ No newline at end of file
+    VPComplex operator+ (VPComplex&& a_lhs, const VPComplex& a_rhs) {
+        if ( ! a_lhs.m_release_m_data_on_destruction ) {
+            return static_cast<const VPComplex &>(a_lhs) + a_rhs;
+        }
+        a_lhs += a_rhs; return std::move(a_lhs);
+    }
+
+    VPComplex operator- (VPComplex&& a_lhs, const VPComplex& a_rhs) {
+        if ( ! a_lhs.m_release_m_data_on_destruction ) {
+            return static_cast<const VPComplex &>(a_lhs) - a_rhs;
+        }
+        a_lhs -= a_rhs; return std::move(a_lhs);
+    }
+
+    VPComplex operator* (VPComplex&& a_lhs, const VPComplex& a_rhs) {
+        if ( ! a_lhs.m_release_m_data_on_destruction ) {
+            return static_cast<const VPComplex &>(a_lhs) * a_rhs;
+        }
+        a_lhs *= a_rhs; return std::move(a_lhs);
+    }
+
+    VPComplex operator* (VPComplex&& a_lhs, const VPFloat& a_rhs) {
+        if ( ! a_lhs.m_release_m_data_on_destruction ) {
+            return static_cast<const VPComplex &>(a_lhs) * a_rhs;
+        }
+        a_lhs.real(a_lhs.real()* a_rhs); a_lhs.imag(a_lhs.imag()* a_rhs); return std::move(a_lhs);
+    }
+
+    VPComplex operator/ (VPComplex&& a_lhs, const VPComplex& a_rhs) {
+        if ( ! a_lhs.m_release_m_data_on_destruction ) {
+            return static_cast<const VPComplex &>(a_lhs) / a_rhs;
+        }
+        a_lhs /= a_rhs; return std::move(a_lhs);
+    }
+
+}
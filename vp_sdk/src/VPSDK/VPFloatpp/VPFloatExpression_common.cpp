@@ -0,0 +1,68 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : August, 2023
+ * Description   : Scratch registers used to evaluate VPFloat expression templates.
+ **/
+
+#include "VPSDK/VPFloatExpression.hpp"
+#include <stddef.h>
+
+namespace VPFloatPackage {
+
+    /*
+     * Storage of the scratch registers. Registers are released at program exit.
+     */
+    class VPFloatScratchRegisterStorage {
+        public:
+            VPFloatScratchRegisterStorage() {
+                for ( int l_index = 0; l_index < VPFloatScratchRegisters::NB_REGISTERS; l_index++ ) {
+                    this->m_registers[l_index] = NULL;
+                }
+            }
+
+            ~VPFloatScratchRegisterStorage() {
+                for ( int l_index = 0; l_index < VPFloatScratchRegisters::NB_REGISTERS; l_index++ ) {
+                    delete this->m_registers[l_index];
+                }
+            }
+
+            VPFloat * m_registers[VPFloatScratchRegisters::NB_REGISTERS];
+    };
+
+    VPFloat & VPFloatScratchRegisters::get(int a_index) {
+        static VPFloatScratchRegisterStorage l_storage;
+
+        vpfloat_evp_t l_environment = VPFloatComputingEnvironment::get_temporary_var_environment();
+        VPFloat * l_register = l_storage.m_registers[a_index];
+
+        /*
+         * Register is (re)allocated only when the temporary variable environment changed since its last use.
+         */
+        if ( ( l_register == NULL )
+          || ( l_register->getEnvironment().es != l_environment.es )
+          || ( l_register->getEnvironment().bis != l_environment.bis )
+          || ( l_register->getEnvironment().stride != l_environment.stride ) ) {
+            delete l_register;
+            l_register = new VPFloat(l_environment.es, l_environment.bis, l_environment.stride);
+            l_storage.m_registers[a_index] = l_register;
+        }
+
+        return *l_register;
+    }
+
+}
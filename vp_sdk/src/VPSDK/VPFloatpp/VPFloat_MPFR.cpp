@@ -33,15 +33,6 @@
 
 using namespace VPFloatPackage;
 
-/**
- * < when writing a vp number into a char array, following the notation "0b1.[significand]p[exponent in decimal]", 
- * max number of chars is 
- * 1 (sign) + 4 (0b1.) + P_CHUNK_LEN*P_CHUNK_MAX_COUNT (significand) + 2 (exponent symbol + its sign) + 18 (58-bits signed exponent in decimal) + 1 (end of string)
- **/
-const uint16_t MAX_MPFR_STRING_LEN = 26+P_CHUNK_LEN*P_CHUNK_MAX_COUNT;
-const uint16_t MPFR_STRING_EXPONENT_LEN = 20;
-
-
 /*******************************************************************************************************************
  * VPFloatComputingEnvironment
  ******************************************************************************************************************/
@@ -139,7 +130,7 @@ VPFloat::VPFloat( uint64_t a_mantissa, uint64_t a_exponent, bool a_sign, vpfloat
 	this->m_release_m_data_on_destruction = true;
 
 	mpfr_init2(*((mpfr_t *)(this->m_data)), this->m_environment.bis - this->m_environment.es - 1 + 1);
-	mpfr_set_d(*((mpfr_t *)(this->m_data)), 1.0, mpfr_get_default_rounding_mode());
+	mpfr_set_d(*((mpfr_t *)(this->m_data)), ( a_sign ? -1.0 : 1.0 ), mpfr_get_default_rounding_mode());
 	if ( mpfr_set_exp(*((mpfr_t *)(this->m_data)), a_exponent + 1) != 0 ) {
 		std::cout << "Fail setting exponent value in constructor." << std::endl;
 	}	
@@ -217,140 +208,138 @@ void VPFloat::exponent(const int64_t a_exponent)
 	}
 }
 
-uint64_t VPFloat::mantissaChunk(const uint16_t a_chunk_index) const {
-	mpfr_exp_t l_exponent = 0;
-	uint64_t l_chunk_value = 0x0000000000000000;
-	int l_bit_offset_for_chunk_end, l_bit_offset_for_chunk, l_max_offset;
-
-	/*
-	 * Use MPFR function to retrieve the string containing the 
-	 *  binary representation of the number
-	 */
-	char * l_str_buffer = mpfr_get_str(NULL, &l_exponent, 2, 0, (*(mpfr_t *)(this->m_data)), mpfr_get_default_rounding_mode());
-
-	if ( l_str_buffer == NULL ) {
-		std::cout << "Fail retrieving string representing VPFloat number." << std::endl;
-		return 0;
-	}
-
-	/*
-	 * Compute the offeset of the data representing the requested 
-	 * chunk (skip first bit to)
-	 */
-	int l_string_offset = 1; // Skip first bit
-
-	if ( l_str_buffer[0] == '-' ) {
-		l_string_offset++; // Skip sign bit
+/*
+ * The MPFR significand is stored most significant limb last, its most significant bit being the leading bit of
+ * the number. Bits of the significand are numbered from this leading bit (position 0).
+ * This function returns a_nb_bits bits (at most 64) of the significand of a_x starting at position a_first_bit,
+ * the first one being the most significant bit of the returned value. Positions before the leading bit or beyond
+ * the precision of a_x read as zeros.
+ */
+static uint64_t getSignificandBits(mpfr_srcptr a_x, mpfr_prec_t a_first_bit, int a_nb_bits) {
+	const mp_limb_t * l_limbs = (const mp_limb_t *)mpfr_custom_get_significand(a_x);
+	mpfr_prec_t l_precision = mpfr_get_prec(a_x);
+	mpfr_prec_t l_nb_limbs = ( l_precision + GMP_NUMB_BITS - 1 ) / GMP_NUMB_BITS;
+	uint64_t l_value = 0;
+	int l_bit = ( a_first_bit < 0 ) ? (int)std::min((mpfr_prec_t)a_nb_bits, -a_first_bit) : 0;
+
+	while ( ( l_bit < a_nb_bits ) && ( a_first_bit + l_bit < l_precision ) ) {
+		mpfr_prec_t l_position = a_first_bit + l_bit;
+		mpfr_prec_t l_limb_index = l_nb_limbs - 1 - l_position / GMP_NUMB_BITS;
+		int l_limb_offset = l_position % GMP_NUMB_BITS;
+		int l_nb_limb_bits = (int)std::min((mpfr_prec_t)std::min(GMP_NUMB_BITS - l_limb_offset, a_nb_bits - l_bit), l_precision - l_position);
+		uint64_t l_limb_bits = (uint64_t)( (mp_limb_t)( l_limbs[l_limb_index] << l_limb_offset ) >> ( GMP_NUMB_BITS - l_nb_limb_bits ) );
+
+		l_value |= l_limb_bits << ( a_nb_bits - l_bit - l_nb_limb_bits );
+		l_bit += l_nb_limb_bits;
 	}
 
-	l_bit_offset_for_chunk_end = l_string_offset + ( a_chunk_index + 1) * P_CHUNK_LEN;
-	l_bit_offset_for_chunk = l_string_offset + a_chunk_index * P_CHUNK_LEN;
-	l_max_offset = strlen(l_str_buffer);
-
-	/*
-	 * Loop in chunk string representation to build chunk numeric value
-	 */
-	for ( int l_current_offset = l_bit_offset_for_chunk; ( l_current_offset < l_bit_offset_for_chunk_end ) && ( l_current_offset <= l_max_offset ) ; l_current_offset++ ) {
-		int l_current_bit_index = l_bit_offset_for_chunk_end - l_current_offset - 1;
-		if ( l_str_buffer[ l_current_offset ] == '1' ) {
-			l_chunk_value = l_chunk_value | ( 1ULL << l_current_bit_index );
-		} else if ( l_str_buffer[ l_current_offset ] == '\0' ) { 
-			break;
-		}
+	return l_value;
+}
 
-		l_bit_offset_for_chunk++;
+/*
+ * This function writes the a_nb_bits lowest bits of a_bits (at most 64) in the significand of a_x starting at
+ * position a_first_bit (which must not be the leading bit). Bits beyond the precision of a_x are dropped: the
+ * function returns the number of bits written.
+ */
+static int setSignificandBits(mpfr_ptr a_x, mpfr_prec_t a_first_bit, int a_nb_bits, uint64_t a_bits) {
+	mp_limb_t * l_limbs = (mp_limb_t *)mpfr_custom_get_significand(a_x);
+	mpfr_prec_t l_precision = mpfr_get_prec(a_x);
+	mpfr_prec_t l_nb_limbs = ( l_precision + GMP_NUMB_BITS - 1 ) / GMP_NUMB_BITS;
+	int l_bit = 0;
+
+	while ( ( l_bit < a_nb_bits ) && ( a_first_bit + l_bit < l_precision ) ) {
+		mpfr_prec_t l_position = a_first_bit + l_bit;
+		mpfr_prec_t l_limb_index = l_nb_limbs - 1 - l_position / GMP_NUMB_BITS;
+		int l_limb_offset = l_position % GMP_NUMB_BITS;
+		int l_nb_limb_bits = (int)std::min((mpfr_prec_t)std::min(GMP_NUMB_BITS - l_limb_offset, a_nb_bits - l_bit), l_precision - l_position);
+		int l_shift = GMP_NUMB_BITS - l_limb_offset - l_nb_limb_bits;
+		mp_limb_t l_limb_bits = (mp_limb_t)( ( a_bits << ( 64 - a_nb_bits + l_bit ) ) >> ( 64 - l_nb_limb_bits ) );
+		mp_limb_t l_mask = ( ( l_nb_limb_bits == GMP_NUMB_BITS ) ? ~((mp_limb_t)0) : ( ( ((mp_limb_t)1) << l_nb_limb_bits ) - 1 ) ) << l_shift;
+
+		l_limbs[l_limb_index] = ( l_limbs[l_limb_index] & ~l_mask ) | ( ( l_limb_bits << l_shift ) & l_mask );
+		l_bit += l_nb_limb_bits;
 	}
 
-	
-	/*
-	 * Release initial string buffer used by mpfr_get_str.
-	 */
-	mpfr_free_str(l_str_buffer);
-
-	/*
-	 * Retrieve the uint64_t object with the nartive bitset function.
-	 */
-	return l_chunk_value;
+	return l_bit;
 }
 
-void VPFloat::mantissaChunk(const uint16_t a_chunk_index, const uint64_t a_chunk_value) {
-	
-	mpfr_exp_t l_exponent = 0;
-	char * l_current_str_value = (char *)malloc(sizeof(char) * MAX_MPFR_STRING_LEN);
-	char * l_new_str_value     = (char *)malloc(sizeof(char) * MAX_MPFR_STRING_LEN);
-	int l_string_offset = 4; // shift offset for "0b1." that will be prepend to the string
-	int l_bit_offset_for_chunk_end, l_bit_offset_for_chunk;
-	int l_initial_str_length = 0;
+/*
+ * Mantissa chunks are read and written directly in the limbs of the MPFR significand. The leading bit is implicit
+ * in the vpfloat memory format: chunk a_chunk_index holds the P_CHUNK_LEN bits following it.
+ */
+uint64_t VPFloat::mantissaChunk(const uint16_t a_chunk_index) const {
+	mpfr_srcptr l_x = *((mpfr_t *)(this->m_data));
 
 	/*
-	 * Use MPFR function to retrieve the string containing the 
-	 * binary representation of the number
+	 * Zero, infinite and NaN numbers have no significand
 	 */
-	if ( mpfr_get_str(l_current_str_value, &l_exponent, 2, 0, (*(mpfr_t *)(this->m_data)), mpfr_get_default_rounding_mode()) == NULL ) {
-		std::cout << "Fail retrieving string representing VPFloat number. Can't set matissa chunk " << a_chunk_index << std::endl;
-		return;	
+	if ( ! mpfr_regular_p(l_x) ) {
+		return 0;
 	}
 
- 	l_initial_str_length = strlen(l_current_str_value);
+	return getSignificandBits(l_x, 1 + (mpfr_prec_t)a_chunk_index * P_CHUNK_LEN, P_CHUNK_LEN);
+}
 
-	/*
-	 * Shift string offset since we need to consider the sign
-	 */
-	if( l_current_str_value[0] == '-' ) {
-		l_string_offset += 1;
-	}
+void VPFloat::mantissaChunk(const uint16_t a_chunk_index, const uint64_t a_chunk_value) {
+	mpfr_ptr l_x = *((mpfr_t *)(this->m_data));
+	mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
 
 	/*
-	 * Compute the offeset of the data representing the requested 
-	 * chunk (skip first bit to)
+	 * Zero, infinite and NaN numbers have no significand: they are replaced by 1.0 (with their sign)
+	 * before the chunk is set.
 	 */
-	l_bit_offset_for_chunk_end = l_string_offset + ( a_chunk_index + 1) * P_CHUNK_LEN;
-	l_bit_offset_for_chunk = l_string_offset + a_chunk_index * P_CHUNK_LEN;
+	if ( ! mpfr_regular_p(l_x) ) {
+		int l_negative = mpfr_signbit(l_x);
 
-	/*
-	 * Allocate a buffer large enough to receive additional chunk infirmations
-	 */
-	if( l_current_str_value[0] == '-' ) {
-		sprintf(l_new_str_value, "-0b1.%s", l_current_str_value + 1);
-	} else {
-		sprintf(l_new_str_value,  "0b1.%s", l_current_str_value + 1);
+		mpfr_set_ui(l_x, 1, l_rounding_mode);
+		mpfr_setsign(l_x, l_x, l_negative, l_rounding_mode);
 	}
 
-	/*
-	 * Release initial string buffer used by mpfr_get_str since data were copied to the
-	 * new buffer.
-	 */
-	mpfr_free_str(l_current_str_value);
+	mpfr_prec_t l_first_bit = 1 + (mpfr_prec_t)a_chunk_index * P_CHUNK_LEN;
+	int l_chunk_bit = setSignificandBits(l_x, l_first_bit, P_CHUNK_LEN, a_chunk_value);
 
 	/*
-	 * Replace desired chunk in intial string representation of the number.
+	 * Chunk bits beyond the precision of the number are rounded according the current rounding mode, the chunk
+	 * being partly or entirely beyond it. The bits between the precision and a chunk starting after it are zeros,
+	 * so the dropped bits then hold less than half an ulp.
 	 */
-	for ( int l_current_offset = l_bit_offset_for_chunk; l_current_offset < l_bit_offset_for_chunk_end; l_current_offset++ ) {
-		int l_current_bit_index = ( l_bit_offset_for_chunk_end - l_current_offset ) - 1;
-		uint64_t l_bit_value = ( a_chunk_value >> l_current_bit_index ) & 1ULL ;
-		if ( l_bit_value == 1 ) {
-			l_new_str_value[ l_current_offset ] = '1';
-		} else {
-			l_new_str_value[ l_current_offset ] = '0';
+	if ( l_chunk_bit < P_CHUNK_LEN ) {
+		uint64_t l_dropped_bits = a_chunk_value << l_chunk_bit;
+		uint64_t l_half_bit = 1ULL << ( P_CHUNK_LEN - 1 );
+		mpfr_prec_t l_precision = mpfr_get_prec(l_x);
+		bool l_half_ulp_dropped = ( l_first_bit + l_chunk_bit == l_precision );
+		bool l_negative = ( mpfr_signbit(l_x) != 0 );
+		bool l_round_away = false;
+
+		if ( l_dropped_bits != 0 ) {
+			switch ( l_rounding_mode ) {
+				case MPFR_RNDN:
+					/* Ties to even: the last kept bit is the last bit of the significand */
+					l_round_away = l_half_ulp_dropped && ( ( l_dropped_bits & l_half_bit ) != 0 )
+								&& ( ( ( l_dropped_bits & ~l_half_bit ) != 0 ) || ( getSignificandBits(l_x, l_precision - 1, 1) != 0 ) );
+					break;
+				case MPFR_RNDU:
+					l_round_away = ! l_negative;
+					break;
+				case MPFR_RNDD:
+					l_round_away = l_negative;
+					break;
+				case MPFR_RNDA:
+					l_round_away = true;
+					break;
+				default:
+					break;
+			}
 		}
-	}
-
-	/*
-	 * Append the exponent value at the end of the string
-	 */
-	sprintf(l_new_str_value + std::max(l_initial_str_length, l_bit_offset_for_chunk_end), "p%ld", l_exponent-1);
 
-	/*
-	 * Convert the string containing the binary representation of
-	 * the number into the MPFR number
-	 */
-	int l_rc = mpfr_set_str((*(mpfr_t *)(this->m_data)), l_new_str_value, 2, mpfr_get_default_rounding_mode());
-
-	if ( l_rc != 0 ) {
-		std::cout << "Fail setting VPFloat from its string representation." << std::endl;
+		if ( l_round_away ) {
+			if ( l_negative ) {
+				mpfr_nextbelow(l_x);
+			} else {
+				mpfr_nextabove(l_x);
+			}
+		}
 	}
-
-	free(l_new_str_value);
 }
 
 bool VPFloat::isNaN() const {
@@ -571,6 +560,38 @@ VPFloat & VPFloat::operator/=(double a_other) {
 	return *this;
 }
 
+VPFloat & VPFloat::fma(const VPFloat & a_x, const VPFloat & a_y) {
+	mpfr_fma(*((mpfr_t *)(this->m_data)), *((mpfr_t *)(a_x.m_data)), *((mpfr_t *)(a_y.m_data)), *((mpfr_t *)(this->m_data)), mpfr_get_default_rounding_mode());
+
+	return *this;
+}
+
+VPFloat & VPFloat::fma(const VPFloat & a_x, double a_y) {
+	/*
+	 * MPFR has no fma with a double operand. The double is loaded into a 53 bits
+	 * number allocated on the stack (exact conversion), so no heap allocation is done.
+	 */
+	MPFR_DECL_INIT(l_y, 53);
+	mpfr_set_d(l_y, a_y, MPFR_RNDN);
+	mpfr_fma(*((mpfr_t *)(this->m_data)), *((mpfr_t *)(a_x.m_data)), l_y, *((mpfr_t *)(this->m_data)), mpfr_get_default_rounding_mode());
+
+	return *this;
+}
+
+VPFloat & VPFloat::fms(const VPFloat & a_x, const VPFloat & a_y) {
+	VPFloatOperation::fnma(*this, a_x, a_y, *this);
+
+	return *this;
+}
+
+VPFloat & VPFloat::fms(const VPFloat & a_x, double a_y) {
+	MPFR_DECL_INIT(l_y, 53);
+	mpfr_set_d(l_y, -a_y, MPFR_RNDN);
+	mpfr_fma(*((mpfr_t *)(this->m_data)), *((mpfr_t *)(a_x.m_data)), l_y, *((mpfr_t *)(this->m_data)), mpfr_get_default_rounding_mode());
+
+	return *this;
+}
+
 VPFloat & VPFloat::operator=(const VPFloat & a_other) {
 	mpfr_set(*((mpfr_t *)(this->m_data)), *((mpfr_t *)(a_other.m_data)), mpfr_get_default_rounding_mode());
 	return *this;
@@ -589,64 +610,168 @@ VPFloat VPFloat::pow2(int n, vpfloat_es_t a_exponent_size, vpfloat_prec_t a_bis,
 	return l_result;
 }
 
+/*******************************************************************************************************************
+ * VPFloatOperation Class
+ ******************************************************************************************************************/
+void VPFloatOperation::set(VPFloat & a_result, const VPFloat & a_x) {
+	mpfr_set(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::set(VPFloat & a_result, double a_x) {
+	mpfr_set_d(*((mpfr_t *)(a_result.m_data)), a_x, mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::add(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y) {
+	mpfr_add(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), *((mpfr_t *)(a_y.m_data)), mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::sub(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y) {
+	mpfr_sub(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), *((mpfr_t *)(a_y.m_data)), mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::mul(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y) {
+	mpfr_mul(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), *((mpfr_t *)(a_y.m_data)), mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::div(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y) {
+	mpfr_div(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), *((mpfr_t *)(a_y.m_data)), mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::add(VPFloat & a_result, const VPFloat & a_x, double a_y) {
+	mpfr_add_d(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), a_y, mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::sub(VPFloat & a_result, const VPFloat & a_x, double a_y) {
+	mpfr_sub_d(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), a_y, mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::mul(VPFloat & a_result, const VPFloat & a_x, double a_y) {
+	mpfr_mul_d(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), a_y, mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::div(VPFloat & a_result, const VPFloat & a_x, double a_y) {
+	mpfr_div_d(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), a_y, mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::fma(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z) {
+	mpfr_fma(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), *((mpfr_t *)(a_y.m_data)), *((mpfr_t *)(a_z.m_data)), mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::fms(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z) {
+	mpfr_fms(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), *((mpfr_t *)(a_y.m_data)), *((mpfr_t *)(a_z.m_data)), mpfr_get_default_rounding_mode());
+}
+
+void VPFloatOperation::fnma(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z) {
+	/*
+	 * mpfr_fms computes a_x * a_y - a_z, so the sign is restored afterwards (exact operation).
+	 * Directed rounding modes are swapped since the result is negated.
+	 */
+	mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+
+	if ( l_rounding_mode == MPFR_RNDU ) {
+		l_rounding_mode = MPFR_RNDD;
+	} else if ( l_rounding_mode == MPFR_RNDD ) {
+		l_rounding_mode = MPFR_RNDU;
+	}
+
+	mpfr_fms(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), *((mpfr_t *)(a_y.m_data)), *((mpfr_t *)(a_z.m_data)), l_rounding_mode);
+
+	if ( mpfr_zero_p(*((mpfr_t *)(a_result.m_data))) ) {
+		/* An exact zero difference is +0, except when rounding toward -infinity */
+		mpfr_set_zero(*((mpfr_t *)(a_result.m_data)), ( mpfr_get_default_rounding_mode() == MPFR_RNDD ) ? -1 : 1);
+	} else {
+		mpfr_neg(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_result.m_data)), mpfr_get_default_rounding_mode());
+	}
+}
+
+void VPFloatOperation::neg(VPFloat & a_result, const VPFloat & a_x) {
+	mpfr_neg(*((mpfr_t *)(a_result.m_data)), *((mpfr_t *)(a_x.m_data)), mpfr_get_default_rounding_mode());
+}
+
 /*******************************************************************************************************************
  * VPFloatArray Class
  ******************************************************************************************************************/
+
+/*
+ * Alignment of the limb arena of a VPFloatArray (cache line size).
+ */
+const size_t VPFLOAT_ARRAY_ARENA_ALIGNMENT = 64;
+
+/*
+ * Allocate the memory of an array of a_nb_elements MPFR numbers of precision a_precision in a single block:
+ *
+ *   | mpfr_t[0] ... mpfr_t[n-1] | padding | limbs[0] | limbs[1] | ... | limbs[n-1] |
+ *
+ * The mpfr_t headers are kept at the beginning of the block so that m_data is still an array of mpfr_t. Limbs
+ * of the elements are stored contiguously in an aligned arena and attached to the headers through the MPFR
+ * custom interface. All elements are initialized to +0. An allocation failure aborts.
+ * Numbers built this way must not be released with mpfr_clear: the whole block is released by a single free.
+ */
+static void * allocateArena(int a_nb_elements, mpfr_prec_t a_precision) {
+	size_t l_headers_size = ( ( sizeof(mpfr_t) * a_nb_elements + VPFLOAT_ARRAY_ARENA_ALIGNMENT - 1 ) / VPFLOAT_ARRAY_ARENA_ALIGNMENT ) * VPFLOAT_ARRAY_ARENA_ALIGNMENT;
+	size_t l_limbs_size = mpfr_custom_get_size(a_precision);
+	void * l_block = NULL;
+
+	/*
+	 * Fatal, as when mpfr_init2 allocated the limbs of each element: GMP then reported the failure and aborted.
+	 */
+	if ( posix_memalign(&l_block, VPFLOAT_ARRAY_ARENA_ALIGNMENT, l_headers_size + l_limbs_size * a_nb_elements) != 0 ) {
+		std::cerr << "Fail allocating memory for VPFloatArray of " << a_nb_elements << " elements." << std::endl;
+		abort();
+	}
+
+	char * l_limbs = (char *)l_block + l_headers_size;
+
+	for (int l_index = 0 ; l_index < a_nb_elements; l_index++) {
+		void * l_element_limbs = l_limbs + l_index * l_limbs_size;
+		mpfr_custom_init(l_element_limbs, a_precision);
+		mpfr_custom_init_set(((mpfr_t *)l_block)[l_index], MPFR_ZERO_KIND, 0, a_precision, l_element_limbs);
+	}
+
+	return l_block;
+}
+
 VPFloatArray::VPFloatArray(vpfloat_es_t a_exponent_size, vpfloat_prec_t a_bis, vpfloat_off_t a_stride, int a_nb_elements) :
-	VPFloat(a_exponent_size, a_bis, a_stride),
+	VPFloat(NULL, a_exponent_size, a_bis, a_stride),
 	m_nb_elements(a_nb_elements)
 {   
-	int l_index = 0;
-	// Release m_data buffer allocated by VPFloat since we overwrite it to store our array
-	mpfr_clear(*((mpfr_t *)this->m_data));
-	free(this->m_data);
-	this->m_data = malloc(sizeof(mpfr_t) * this->m_nb_elements);
-	for (l_index = 0 ; l_index < a_nb_elements; l_index++) {
-		mpfr_init2(((mpfr_t *)this->m_data)[l_index], a_bis - a_exponent_size - 1 + 1);
-		mpfr_set_d(((mpfr_t *)this->m_data)[l_index], 0.0, mpfr_get_default_rounding_mode());
-		mpfr_set_exp(((mpfr_t *)this->m_data)[l_index], (mpfr_exp_t)0);
-	}
-
+	this->m_data = allocateArena(a_nb_elements, a_bis - a_exponent_size - 1 + 1);
 	this->m_release_m_data_on_destruction = true;
 }
 
 VPFloatArray::VPFloatArray(VPFloatArray & a_other):
-	VPFloat(a_other.m_environment.es, a_other.m_environment.bis, a_other.m_environment.stride),
+	VPFloat(a_other.m_data, a_other.m_environment.es, a_other.m_environment.bis, a_other.m_environment.stride),
 	m_nb_elements(a_other.m_nb_elements)
 {
-	// Release m_data buffer allocated by VPFloat since we overwrite it to store our array
-	mpfr_clear(*((mpfr_t *)this->m_data));
-	free(this->m_data);
-	this->m_data = a_other.m_data;
-
-	this->m_release_m_data_on_destruction = false;
 }
 
 VPFloatArray::VPFloatArray(VPFloatArray * a_other):
-	VPFloat(a_other->m_environment.es, a_other->m_environment.bis, a_other->m_environment.stride),
+	VPFloat(a_other->m_data, a_other->m_environment.es, a_other->m_environment.bis, a_other->m_environment.stride),
 	m_nb_elements(a_other->m_nb_elements)
 {
-	// Release m_data buffer allocated by VPFloat since we overwrite it to store our array
-	mpfr_clear(*((mpfr_t *)this->m_data));
-	free(this->m_data);
-	this->m_data = a_other->m_data;
+}
+
+VPFloatArray::VPFloatArray(VPFloatArray & a_other, int a_first_element, int a_nb_elements):
+	VPFloat(a_other + a_first_element, a_other.m_environment.es, a_other.m_environment.bis, a_other.m_environment.stride),
+	m_nb_elements(a_nb_elements)
+{
+}
 
-	this->m_release_m_data_on_destruction = false;
+VPFloatArray::VPFloatArray(const VPFloatArray & a_other, int a_first_element, int a_nb_elements):
+	VPFloat(a_other + a_first_element, a_other.m_environment.es, a_other.m_environment.bis, a_other.m_environment.stride),
+	m_nb_elements(a_nb_elements)
+{
 }
 
 
 VPFloatArray::VPFloatArray(double * a_other, int a_nb_elements):
-	VPFloat(VPFLOAT_EVP_DOUBLE.es, VPFLOAT_EVP_DOUBLE.bis, VPFLOAT_EVP_DOUBLE.stride),
+	VPFloat(NULL, VPFLOAT_EVP_DOUBLE.es, VPFLOAT_EVP_DOUBLE.bis, VPFLOAT_EVP_DOUBLE.stride),
 	m_nb_elements(a_nb_elements)
 {
 	int l_index = 0;
 
-	// Release m_data buffer allocated by VPFloat since we overwrite it to store our array
-	mpfr_clear(*((mpfr_t *)this->m_data));
-	free(this->m_data);
-	this->m_data = malloc(sizeof(mpfr_t) * this->m_nb_elements);
+	this->m_data = allocateArena(a_nb_elements, VPFLOAT_EVP_DOUBLE.bis - VPFLOAT_EVP_DOUBLE.es - 1 + 1);
 	for (l_index = 0 ; l_index < a_nb_elements; l_index++) {
-		mpfr_init2(((mpfr_t *)this->m_data)[l_index], VPFLOAT_EVP_DOUBLE.bis - VPFLOAT_EVP_DOUBLE.es - 1 + 1);
 		mpfr_set_d(((mpfr_t *)this->m_data)[l_index], a_other[l_index], mpfr_get_default_rounding_mode());
 	}
 
@@ -655,17 +780,13 @@ VPFloatArray::VPFloatArray(double * a_other, int a_nb_elements):
 
 
 VPFloatArray::VPFloatArray(float * a_other, int a_nb_elements):
-	VPFloat(VPFLOAT_EVP_FLOAT.es, VPFLOAT_EVP_FLOAT.bis, VPFLOAT_EVP_FLOAT.stride),
+	VPFloat(NULL, VPFLOAT_EVP_FLOAT.es, VPFLOAT_EVP_FLOAT.bis, VPFLOAT_EVP_FLOAT.stride),
 	m_nb_elements(a_nb_elements)
 {
 	int l_index = 0;
 
-	// Release m_data buffer allocated by VPFloat since we overwrite it to store our array
-	mpfr_clear(*((mpfr_t *)this->m_data));
-	free(this->m_data);
-	this->m_data = malloc(sizeof(mpfr_t) * this->m_nb_elements);
+	this->m_data = allocateArena(a_nb_elements, VPFLOAT_EVP_FLOAT.bis - VPFLOAT_EVP_FLOAT.es - 1 + 1);
 	for (l_index = 0 ; l_index < a_nb_elements; l_index++) {
-		mpfr_init2(((mpfr_t *)this->m_data)[l_index], VPFLOAT_EVP_FLOAT.bis - VPFLOAT_EVP_FLOAT.es - 1 + 1);
 		mpfr_set_d(((mpfr_t *)this->m_data)[l_index], a_other[l_index], mpfr_get_default_rounding_mode());
 	}
 
@@ -674,11 +795,11 @@ VPFloatArray::VPFloatArray(float * a_other, int a_nb_elements):
 
 VPFloatArray::~VPFloatArray()
 {
+	/*
+	 * Elements were built with the MPFR custom interface (see allocateArena):
+	 * headers and limbs are released at once.
+	 */
 	if ( this->m_release_m_data_on_destruction ) {
-		int l_index = 0;
-		for (l_index = 0 ; l_index < this->m_nb_elements; l_index++) {
-			mpfr_clear(((mpfr_t *)this->m_data)[l_index]);
-		}
 		free(this->m_data);
 		this->m_data = NULL;
 	}
@@ -702,6 +823,296 @@ void VPFloatArray::printAsVector(char * a_label) const {
 	}
 }
 
+/*******************************************************************************************************************
+ * VRP memory format codec
+ * A vpfloat number is stored in memory as a bis bits little endian integer holding, from the most significant bit:
+ * the sign, the exponent biased by 2^(es-1)-1 on es bits and the bis-es-1 bits following the implicit leading bit
+ * of the significand (IEEE 754 interchange format generalized to es < 64 and bis <= BISMAX, see
+ * isPackedEnvironment). Numbers are padded to VPFLOAT_SIZEOF(environment) bytes.
+ ******************************************************************************************************************/
+#define VRP_PACKED_WORDS ( ( BISMAX + 63 ) / 64 )
+
+/*
+ * Returns true when numbers of a_environment fit in VRP_PACKED_WORDS words, with an exponent held by a 64 bits
+ * integer and at least one significand bit.
+ */
+static bool isPackedEnvironment(vpfloat_evp_t a_environment) {
+	return ( a_environment.es >= 1 ) && ( a_environment.es < 64 ) &&
+	       ( a_environment.bis >= a_environment.es + 2 ) && ( a_environment.bis <= BISMAX );
+}
+
+static uint64_t getPackedBits(const uint64_t * a_words, int a_first_bit, int a_nb_bits) {
+	int l_word = a_first_bit / 64;
+	int l_offset = a_first_bit % 64;
+	uint64_t l_bits = a_words[l_word] >> l_offset;
+
+	if ( ( l_offset != 0 ) && ( l_offset + a_nb_bits > 64 ) ) {
+		l_bits |= a_words[l_word + 1] << ( 64 - l_offset );
+	}
+
+	return ( a_nb_bits == 64 ) ? l_bits : ( l_bits & VPFLOAT_MASK(a_nb_bits) );
+}
+
+static void setPackedBits(uint64_t * a_words, int a_first_bit, int a_nb_bits, uint64_t a_bits) {
+	int l_word = a_first_bit / 64;
+	int l_offset = a_first_bit % 64;
+
+	if ( a_nb_bits < 64 ) {
+		a_bits &= VPFLOAT_MASK(a_nb_bits);
+	}
+
+	a_words[l_word] |= a_bits << l_offset;
+
+	if ( ( l_offset != 0 ) && ( l_offset + a_nb_bits > 64 ) ) {
+		a_words[l_word + 1] |= a_bits >> ( 64 - l_offset );
+	}
+}
+
+/*
+ * Returns true when a number rounded according a_rounding_mode moves away from zero.
+ * Used for results out of the range of the memory format, a_nearest_away being the decision for round to nearest.
+ */
+static bool isRoundedAway(mpfr_rnd_t a_rounding_mode, bool a_negative, bool a_nearest_away) {
+	switch ( a_rounding_mode ) {
+		case MPFR_RNDN:
+			return a_nearest_away;
+		case MPFR_RNDU:
+			return ! a_negative;
+		case MPFR_RNDD:
+			return a_negative;
+		case MPFR_RNDA:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Store a_x in a_bytes with the VRP memory format of a_environment. a_tmp is a scratch number whose precision
+ * is changed by the function.
+ */
+static void packVPFloat(mpfr_srcptr a_x, mpfr_ptr a_tmp, vpfloat_evp_t a_environment, uint8_t * a_bytes) {
+	uint64_t l_words[VRP_PACKED_WORDS] = { 0 };
+	mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+	int l_fraction_bits = a_environment.bis - a_environment.es - 1;
+	mpfr_exp_t l_bias = ( ((mpfr_exp_t)1) << ( a_environment.es - 1 ) ) - 1;
+	mpfr_exp_t l_emin = 1 - l_bias;
+	uint64_t l_max_biased_exponent = VPFLOAT_MASK(a_environment.es);
+	uint64_t l_biased_exponent = 0;
+	bool l_negative = ( mpfr_signbit(a_x) != 0 );
+
+	if ( mpfr_nan_p(a_x) ) {
+		l_biased_exponent = l_max_biased_exponent;
+		setPackedBits(l_words, l_fraction_bits - 1, 1, 1);
+	} else if ( mpfr_inf_p(a_x) ) {
+		l_biased_exponent = l_max_biased_exponent;
+	} else if ( ! mpfr_zero_p(a_x) ) {
+		mpfr_exp_t l_exponent = mpfr_get_exp(a_x) - 1;
+		mpfr_prec_t l_precision = l_fraction_bits + 1;
+		bool l_is_zero = false;
+
+		/*
+		 * Subnormal numbers lose the significand bits below 2^(emin - fraction bits)
+		 */
+		if ( l_exponent < l_emin ) {
+			l_precision -= l_emin - l_exponent;
+		}
+
+		if ( l_precision >= 1 ) {
+			mpfr_set_prec(a_tmp, l_precision);
+			mpfr_set(a_tmp, a_x, l_rounding_mode);
+		} else {
+			/*
+			 * Below half the smallest subnormal number (a tie only for a power of 2)
+			 */
+			mpfr_set_prec(a_tmp, 1);
+			mpfr_set(a_tmp, a_x, MPFR_RNDZ);
+			l_is_zero = ! isRoundedAway(l_rounding_mode, l_negative, ( l_precision == 0 ) && ( mpfr_cmpabs(a_x, a_tmp) > 0 ));
+			mpfr_set_ui_2exp(a_tmp, 1, l_emin - l_fraction_bits, l_rounding_mode);
+		}
+
+		l_exponent = mpfr_get_exp(a_tmp) - 1;
+
+		if ( l_is_zero ) {
+			l_biased_exponent = 0;
+		} else if ( l_exponent > l_bias ) {
+			/*
+			 * Overflow: infinity or the largest finite number
+			 */
+			if ( isRoundedAway(l_rounding_mode, l_negative, true) ) {
+				l_biased_exponent = l_max_biased_exponent;
+			} else {
+				l_biased_exponent = l_max_biased_exponent - 1;
+				for ( int l_bit = 0; l_bit < l_fraction_bits; l_bit += 64 ) {
+					setPackedBits(l_words, l_bit, std::min(64, l_fraction_bits - l_bit), ~0ULL);
+				}
+			}
+		} else {
+			int l_shift = ( l_exponent < l_emin ) ? (int)( l_emin - l_exponent ) : 0;
+
+			l_biased_exponent = ( l_shift != 0 ) ? 0 : (uint64_t)( l_exponent + l_bias );
+			for ( int l_bit = 0; l_bit < l_fraction_bits; l_bit += 64 ) {
+				int l_nb_bits = std::min(64, l_fraction_bits - l_bit);
+				setPackedBits(l_words, l_fraction_bits - l_bit - l_nb_bits, l_nb_bits, getSignificandBits(a_tmp, l_bit + 1 - l_shift, l_nb_bits));
+			}
+		}
+	}
+
+	setPackedBits(l_words, l_fraction_bits, a_environment.es, l_biased_exponent);
+	setPackedBits(l_words, a_environment.bis - 1, 1, l_negative ? 1 : 0);
+
+	for ( int l_byte = 0; l_byte < BYS(a_environment.bis); l_byte++ ) {
+		a_bytes[l_byte] = (uint8_t)( l_words[l_byte / 8] >> ( 8 * ( l_byte % 8 ) ) );
+	}
+}
+
+/*
+ * Load a_x from a_bytes stored with the VRP memory format of a_environment. a_tmp is a scratch number with a
+ * precision of bis - es bits.
+ */
+static void unpackVPFloat(const uint8_t * a_bytes, vpfloat_evp_t a_environment, mpfr_ptr a_tmp, mpfr_ptr a_x) {
+	uint64_t l_words[VRP_PACKED_WORDS] = { 0 };
+	mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+	int l_fraction_bits = a_environment.bis - a_environment.es - 1;
+	mpfr_exp_t l_bias = ( ((mpfr_exp_t)1) << ( a_environment.es - 1 ) ) - 1;
+	mpfr_exp_t l_emin = 1 - l_bias;
+	bool l_is_zero_fraction = true;
+
+	for ( int l_byte = 0; l_byte < BYS(a_environment.bis); l_byte++ ) {
+		l_words[l_byte / 8] |= ((uint64_t)a_bytes[l_byte]) << ( 8 * ( l_byte % 8 ) );
+	}
+
+	bool l_negative = ( getPackedBits(l_words, a_environment.bis - 1, 1) != 0 );
+	uint64_t l_biased_exponent = getPackedBits(l_words, l_fraction_bits, a_environment.es);
+
+	for ( int l_bit = 0; ( l_bit < l_fraction_bits ) && l_is_zero_fraction; l_bit += 64 ) {
+		int l_nb_bits = std::min(64, l_fraction_bits - l_bit);
+		l_is_zero_fraction = ( getPackedBits(l_words, l_fraction_bits - l_bit - l_nb_bits, l_nb_bits) == 0 );
+	}
+
+	if ( l_biased_exponent == VPFLOAT_MASK(a_environment.es) ) {
+		if ( l_is_zero_fraction ) {
+			mpfr_set_inf(a_x, l_negative ? -1 : 1);
+		} else {
+			mpfr_set_nan(a_x);
+		}
+		return;
+	}
+
+	if ( ( l_biased_exponent == 0 ) && l_is_zero_fraction ) {
+		mpfr_set_zero(a_x, l_negative ? -1 : 1);
+		return;
+	}
+
+	mpfr_set_ui_2exp(a_tmp, 1, ( l_biased_exponent == 0 ) ? 0 : (mpfr_exp_t)l_biased_exponent - l_bias, l_rounding_mode);
+
+	for ( int l_bit = 0; l_bit < l_fraction_bits; l_bit += 64 ) {
+		int l_nb_bits = std::min(64, l_fraction_bits - l_bit);
+		setSignificandBits(a_tmp, 1 + l_bit, l_nb_bits, getPackedBits(l_words, l_fraction_bits - l_bit - l_nb_bits, l_nb_bits));
+	}
+
+	if ( l_biased_exponent == 0 ) {
+		/*
+		 * Subnormal number: 0.fraction * 2^emin (exact operations)
+		 */
+		mpfr_sub_ui(a_tmp, a_tmp, 1, l_rounding_mode);
+		mpfr_mul_2si(a_tmp, a_tmp, l_emin, l_rounding_mode);
+	}
+
+	if ( l_negative ) {
+		mpfr_neg(a_tmp, a_tmp, l_rounding_mode);
+	}
+
+	mpfr_set(a_x, a_tmp, l_rounding_mode);
+}
+
+int VPFloatArray::pack(void * a_buffer, vpfloat_evp_t a_environment) const {
+	mpfr_t * l_elements = (mpfr_t *)this->m_data;
+	uint8_t * l_buffer = (uint8_t *)a_buffer;
+	size_t l_element_size = VPFLOAT_SIZEOF(a_environment);
+	mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+
+	if ( ! isPackedEnvironment(a_environment) ) {
+		std::cout << __FUNCTION__ << " : invalid environment (es " << a_environment.es << ", bis " << a_environment.bis << ")" << std::endl;
+		return -1;
+	}
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	/*
+	 * Native conversions for IEEE double and float layouts
+	 */
+	if ( VPFLOAT_IS_DOUBLE(a_environment) ) {
+		for ( int l_index = 0; l_index < this->m_nb_elements; l_index++ ) {
+			double l_value = mpfr_get_d(l_elements[l_index], l_rounding_mode);
+			memcpy(l_buffer + l_index * l_element_size, &l_value, sizeof(double));
+		}
+		return 0;
+	}
+
+	if ( VPFLOAT_IS_FLOAT(a_environment) ) {
+		for ( int l_index = 0; l_index < this->m_nb_elements; l_index++ ) {
+			float l_value = mpfr_get_flt(l_elements[l_index], l_rounding_mode);
+			memcpy(l_buffer + l_index * l_element_size, &l_value, sizeof(float));
+		}
+		return 0;
+	}
+#endif
+
+	mpfr_t l_tmp;
+	mpfr_init2(l_tmp, a_environment.bis - a_environment.es);
+
+	for ( int l_index = 0; l_index < this->m_nb_elements; l_index++ ) {
+		packVPFloat(l_elements[l_index], l_tmp, a_environment, l_buffer + l_index * l_element_size);
+	}
+
+	mpfr_clear(l_tmp);
+
+	return 0;
+}
+
+int VPFloatArray::unpack(const void * a_buffer, vpfloat_evp_t a_environment) {
+	mpfr_t * l_elements = (mpfr_t *)this->m_data;
+	const uint8_t * l_buffer = (const uint8_t *)a_buffer;
+	size_t l_element_size = VPFLOAT_SIZEOF(a_environment);
+	mpfr_rnd_t l_rounding_mode = mpfr_get_default_rounding_mode();
+
+	if ( ! isPackedEnvironment(a_environment) ) {
+		std::cout << __FUNCTION__ << " : invalid environment (es " << a_environment.es << ", bis " << a_environment.bis << ")" << std::endl;
+		return -1;
+	}
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	if ( VPFLOAT_IS_DOUBLE(a_environment) ) {
+		for ( int l_index = 0; l_index < this->m_nb_elements; l_index++ ) {
+			double l_value;
+			memcpy(&l_value, l_buffer + l_index * l_element_size, sizeof(double));
+			mpfr_set_d(l_elements[l_index], l_value, l_rounding_mode);
+		}
+		return 0;
+	}
+
+	if ( VPFLOAT_IS_FLOAT(a_environment) ) {
+		for ( int l_index = 0; l_index < this->m_nb_elements; l_index++ ) {
+			float l_value;
+			memcpy(&l_value, l_buffer + l_index * l_element_size, sizeof(float));
+			mpfr_set_flt(l_elements[l_index], l_value, l_rounding_mode);
+		}
+		return 0;
+	}
+#endif
+
+	mpfr_t l_tmp;
+	mpfr_init2(l_tmp, a_environment.bis - a_environment.es);
+
+	for ( int l_index = 0; l_index < this->m_nb_elements; l_index++ ) {
+		unpackVPFloat(l_buffer + l_index * l_element_size, a_environment, l_tmp, l_elements[l_index]);
+	}
+
+	mpfr_clear(l_tmp);
+
+	return 0;
+}
+
 /*******************************************************************************************************************
  * VPFloatComputingEnvironment Class
  ******************************************************************************************************************/
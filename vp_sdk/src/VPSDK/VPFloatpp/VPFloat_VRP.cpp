@@ -29,6 +29,7 @@
 #include <cstddef>
 #include "VRPSDK/vmath.h"
 #include "VRPSDK/vutils.h"
+#include "VRPSDK/vblas.h"
 
 using namespace VPFloatPackage;
 
@@ -484,6 +485,50 @@ VPFloat & VPFloat::operator/=(double a_other) {
 	return *this;
 }
 
+VPFloat & VPFloat::fma(const VPFloat & a_x, const VPFloat & a_y) {
+	VPFloat l_product = a_x * a_y;
+
+	::vadd( VPFloatComputingEnvironment::get_precision(),
+			this->m_data, this->m_environment,
+			l_product.m_data, l_product.m_environment,
+			this->m_data, this->m_environment);
+
+	return *this;
+}
+
+VPFloat & VPFloat::fma(const VPFloat & a_x, double a_y) {
+	VPFloat l_product = a_x * a_y;
+
+	::vadd( VPFloatComputingEnvironment::get_precision(),
+			this->m_data, this->m_environment,
+			l_product.m_data, l_product.m_environment,
+			this->m_data, this->m_environment);
+
+	return *this;
+}
+
+VPFloat & VPFloat::fms(const VPFloat & a_x, const VPFloat & a_y) {
+	VPFloat l_product = a_x * a_y;
+
+	::vsub( VPFloatComputingEnvironment::get_precision(),
+			this->m_data, this->m_environment,
+			l_product.m_data, l_product.m_environment,
+			this->m_data, this->m_environment);
+
+	return *this;
+}
+
+VPFloat & VPFloat::fms(const VPFloat & a_x, double a_y) {
+	VPFloat l_product = a_x * a_y;
+
+	::vsub( VPFloatComputingEnvironment::get_precision(),
+			this->m_data, this->m_environment,
+			l_product.m_data, l_product.m_environment,
+			this->m_data, this->m_environment);
+
+	return *this;
+}
+
 VPFloat & VPFloat::operator=(const VPFloat & a_other) {
 	vassign(a_other.m_data, a_other.m_environment, this->m_data, this->m_environment);
 	return *this;
@@ -502,6 +547,97 @@ VPFloat VPFloat::pow2(int n, vpfloat_es_t a_exponent_size, vpfloat_prec_t a_bis,
 	return l_result;
 }
 
+/*******************************************************************************************************************
+ * VPFloatOperation Class
+ ******************************************************************************************************************/
+void VPFloatOperation::set(VPFloat & a_result, const VPFloat & a_x) {
+	vassign(a_x.m_data, a_x.m_environment, a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::set(VPFloat & a_result, double a_x) {
+	vassign((void *)&a_x, VPFLOAT_EVP_DOUBLE, a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::add(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y) {
+	::vadd( VPFloatComputingEnvironment::get_precision(),
+			a_x.m_data, a_x.m_environment,
+			a_y.m_data, a_y.m_environment,
+			a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::sub(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y) {
+	::vsub( VPFloatComputingEnvironment::get_precision(),
+			a_x.m_data, a_x.m_environment,
+			a_y.m_data, a_y.m_environment,
+			a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::mul(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y) {
+	::vmul( VPFloatComputingEnvironment::get_precision(),
+			a_x.m_data, a_x.m_environment,
+			a_y.m_data, a_y.m_environment,
+			a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::div(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y) {
+	::vdiv( VPFloatComputingEnvironment::get_precision(),
+			a_x.m_data, a_x.m_environment,
+			a_y.m_data, a_y.m_environment,
+			a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::add(VPFloat & a_result, const VPFloat & a_x, double a_y) {
+	::vadd( VPFloatComputingEnvironment::get_precision(),
+			a_x.m_data, a_x.m_environment,
+			(void *)&a_y, VPFLOAT_EVP_DOUBLE,
+			a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::sub(VPFloat & a_result, const VPFloat & a_x, double a_y) {
+	::vsub( VPFloatComputingEnvironment::get_precision(),
+			a_x.m_data, a_x.m_environment,
+			(void *)&a_y, VPFLOAT_EVP_DOUBLE,
+			a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::mul(VPFloat & a_result, const VPFloat & a_x, double a_y) {
+	::vmul( VPFloatComputingEnvironment::get_precision(),
+			a_x.m_data, a_x.m_environment,
+			(void *)&a_y, VPFLOAT_EVP_DOUBLE,
+			a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::div(VPFloat & a_result, const VPFloat & a_x, double a_y) {
+	::vdiv( VPFloatComputingEnvironment::get_precision(),
+			a_x.m_data, a_x.m_environment,
+			(void *)&a_y, VPFLOAT_EVP_DOUBLE,
+			a_result.m_data, a_result.m_environment);
+}
+
+void VPFloatOperation::fma(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z) {
+	VPFloat l_product = a_x * a_y;
+
+	VPFloatOperation::add(a_result, l_product, a_z);
+}
+
+void VPFloatOperation::fms(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z) {
+	VPFloat l_product = a_x * a_y;
+
+	VPFloatOperation::sub(a_result, l_product, a_z);
+}
+
+void VPFloatOperation::fnma(VPFloat & a_result, const VPFloat & a_x, const VPFloat & a_y, const VPFloat & a_z) {
+	VPFloat l_product = a_x * a_y;
+
+	VPFloatOperation::sub(a_result, a_z, l_product);
+}
+
+void VPFloatOperation::neg(VPFloat & a_result, const VPFloat & a_x) {
+	VPFloat l_zero(0.0);
+
+	VPFloatOperation::sub(a_result, l_zero, a_x);
+}
+
 /*******************************************************************************************************************
  * VPFloatArray Class
  ******************************************************************************************************************/
@@ -535,6 +671,18 @@ VPFloatArray::VPFloatArray(VPFloatArray * a_other):
 	this->m_release_m_data_on_destruction = false;
 }
 
+VPFloatArray::VPFloatArray(VPFloatArray & a_other, int a_first_element, int a_nb_elements):
+	VPFloat(a_other + a_first_element, a_other.m_environment.es, a_other.m_environment.bis, a_other.m_environment.stride),
+	m_nb_elements(a_nb_elements)
+{
+}
+
+VPFloatArray::VPFloatArray(const VPFloatArray & a_other, int a_first_element, int a_nb_elements):
+	VPFloat(a_other + a_first_element, a_other.m_environment.es, a_other.m_environment.bis, a_other.m_environment.stride),
+	m_nb_elements(a_nb_elements)
+{
+}
+
 VPFloatArray::VPFloatArray(double * a_other, int a_nb_elements):
 	VPFloat(VPFLOAT_EVP_DOUBLE.es, VPFLOAT_EVP_DOUBLE.bis, VPFLOAT_EVP_DOUBLE.stride)
 {
@@ -578,4 +726,20 @@ vpfloat_evp_t VPFloatComputingEnvironment::m_temporary_var_environment = VPFLOAT
 void VPFloatArray::printAsVector(char * a_label) const {
 	vprint_vector(a_label, this->m_nb_elements, this->m_data, this->m_environment);
 }
+
+/*
+ * VPFloatArray elements are already stored with the VRP memory format: numbers are converted by the VRP
+ * load/store instructions.
+ */
+int VPFloatArray::pack(void * a_buffer, vpfloat_evp_t a_environment) const {
+	::vcopy(this->m_nb_elements, this->m_data, this->m_environment, a_buffer, a_environment, 1);
+
+	return 0;
+}
+
+int VPFloatArray::unpack(const void * a_buffer, vpfloat_evp_t a_environment) {
+	::vcopy(this->m_nb_elements, a_buffer, a_environment, this->m_data, this->m_environment, 1);
+
+	return 0;
+}
         
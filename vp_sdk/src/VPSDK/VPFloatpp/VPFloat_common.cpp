@@ -0,0 +1,227 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : August, 2023
+ * Description   : Backend independent part of VPFloat: move operations and operators on expiring VPFloat.
+ **/
+
+#include "VPSDK/VPFloat.hpp"
+#include <stddef.h>
+#include <utility>
+
+namespace VPFloatPackage {
+
+    /*******************************************************************************************************************
+     * Move operations
+     ******************************************************************************************************************/
+    VPFloat::VPFloat(VPFloat && a_other) :
+        m_environment(a_other.m_environment),
+        m_data(a_other.m_data),
+        m_double_data(a_other.m_double_data),
+        m_float_data(a_other.m_float_data),
+        m_release_m_data_on_destruction(a_other.m_release_m_data_on_destruction)
+    {
+        a_other.m_data = NULL;
+        a_other.m_release_m_data_on_destruction = false;
+    }
+
+    VPFloat & VPFloat::operator=(VPFloat && a_other) {
+        bool l_exchange_memory = ( this->m_data == NULL );
+
+        if ( ( this->m_release_m_data_on_destruction )
+          && ( a_other.m_release_m_data_on_destruction )
+          && ( this->m_environment.es == a_other.m_environment.es )
+          && ( this->m_environment.bis == a_other.m_environment.bis )
+          && ( this->m_environment.stride == a_other.m_environment.stride ) ) {
+            l_exchange_memory = true;
+        }
+
+        if ( ! l_exchange_memory ) {
+            /*
+             * The current VPFloat refers to memory it does not own (or uses another environment): its memory
+             * has to be updated.
+             */
+            return *this = static_cast<const VPFloat &>(a_other);
+        }
+
+        /*
+         * Previous memory of the current VPFloat is released with a_other.
+         */
+        std::swap(this->m_environment, a_other.m_environment);
+        std::swap(this->m_data, a_other.m_data);
+        std::swap(this->m_double_data, a_other.m_double_data);
+        std::swap(this->m_float_data, a_other.m_float_data);
+        std::swap(this->m_release_m_data_on_destruction, a_other.m_release_m_data_on_destruction);
+
+        return *this;
+    }
+
+    bool VPFloat::isReusableAsTemporary() const {
+        vpfloat_evp_t l_tmp_var_environment = VPFloatComputingEnvironment::get_temporary_var_environment();
+
+        return ( this->m_release_m_data_on_destruction )
+            && ( this->m_data != NULL )
+            && ( this->m_environment.es == l_tmp_var_environment.es )
+            && ( this->m_environment.bis == l_tmp_var_environment.bis )
+            && ( this->m_environment.stride == l_tmp_var_environment.stride );
+    }
+
+    /*******************************************************************************************************************
+     * Operators on expiring VPFloat
+     ******************************************************************************************************************/
+    VPFloat operator+(VPFloat && a_lhs, const VPFloat & a_rhs) {
+        if ( ! a_lhs.isReusableAsTemporary() ) {
+            return static_cast<const VPFloat &>(a_lhs) + a_rhs;
+        }
+        VPFloatOperation::add(a_lhs, a_lhs, a_rhs);
+        return std::move(a_lhs);
+    }
+
+    VPFloat operator+(const VPFloat & a_lhs, VPFloat && a_rhs) {
+        if ( ! a_rhs.isReusableAsTemporary() ) {
+            return a_lhs + static_cast<const VPFloat &>(a_rhs);
+        }
+        VPFloatOperation::add(a_rhs, a_lhs, a_rhs);
+        return std::move(a_rhs);
+    }
+
+    VPFloat operator+(VPFloat && a_lhs, VPFloat && a_rhs) {
+        return std::move(a_lhs) + static_cast<const VPFloat &>(a_rhs);
+    }
+
+    VPFloat operator+(VPFloat && a_lhs, double a_rhs) {
+        if ( ! a_lhs.isReusableAsTemporary() ) {
+            return static_cast<const VPFloat &>(a_lhs) + a_rhs;
+        }
+        VPFloatOperation::add(a_lhs, a_lhs, a_rhs);
+        return std::move(a_lhs);
+    }
+
+    VPFloat operator-(VPFloat && a_lhs, const VPFloat & a_rhs) {
+        if ( ! a_lhs.isReusableAsTemporary() ) {
+            return static_cast<const VPFloat &>(a_lhs) - a_rhs;
+        }
+        VPFloatOperation::sub(a_lhs, a_lhs, a_rhs);
+        return std::move(a_lhs);
+    }
+
+    VPFloat operator-(const VPFloat & a_lhs, VPFloat && a_rhs) {
+        if ( ! a_rhs.isReusableAsTemporary() ) {
+            return a_lhs - static_cast<const VPFloat &>(a_rhs);
+        }
+        VPFloatOperation::sub(a_rhs, a_lhs, a_rhs);
+        return std::move(a_rhs);
+    }
+
+    VPFloat operator-(VPFloat && a_lhs, VPFloat && a_rhs) {
+        return std::move(a_lhs) - static_cast<const VPFloat &>(a_rhs);
+    }
+
+    VPFloat operator-(VPFloat && a_lhs, double a_rhs) {
+        if ( ! a_lhs.isReusableAsTemporary() ) {
+            return static_cast<const VPFloat &>(a_lhs) - a_rhs;
+        }
+        VPFloatOperation::sub(a_lhs, a_lhs, a_rhs);
+        return std::move(a_lhs);
+    }
+
+    VPFloat operator*(VPFloat && a_lhs, const VPFloat & a_rhs) {
+        if ( ! a_lhs.isReusableAsTemporary() ) {
+            return static_cast<const VPFloat &>(a_lhs) * a_rhs;
+        }
+        VPFloatOperation::mul(a_lhs, a_lhs, a_rhs);
+        return std::move(a_lhs);
+    }
+
+    VPFloat operator*(const VPFloat & a_lhs, VPFloat && a_rhs) {
+        if ( ! a_rhs.isReusableAsTemporary() ) {
+            return a_lhs * static_cast<const VPFloat &>(a_rhs);
+        }
+        VPFloatOperation::mul(a_rhs, a_lhs, a_rhs);
+        return std::move(a_rhs);
+    }
+
+    VPFloat operator*(VPFloat && a_lhs, VPFloat && a_rhs) {
+        return std::move(a_lhs) * static_cast<const VPFloat &>(a_rhs);
+    }
+
+    VPFloat operator*(VPFloat && a_lhs, double a_rhs) {
+        if ( ! a_lhs.isReusableAsTemporary() ) {
+            return static_cast<const VPFloat &>(a_lhs) * a_rhs;
+        }
+        VPFloatOperation::mul(a_lhs, a_lhs, a_rhs);
+        return std::move(a_lhs);
+    }
+
+    VPFloat operator/(VPFloat && a_lhs, const VPFloat & a_rhs) {
+        if ( ! a_lhs.isReusableAsTemporary() ) {
+            return static_cast<const VPFloat &>(a_lhs) / a_rhs;
+        }
+        VPFloatOperation::div(a_lhs, a_lhs, a_rhs);
+        return std::move(a_lhs);
+    }
+
+    VPFloat operator/(const VPFloat & a_lhs, VPFloat && a_rhs) {
+        if ( ! a_rhs.isReusableAsTemporary() ) {
+            return a_lhs / static_cast<const VPFloat &>(a_rhs);
+        }
+        VPFloatOperation::div(a_rhs, a_lhs, a_rhs);
+        return std::move(a_rhs);
+    }
+
+    VPFloat operator/(VPFloat && a_lhs, VPFloat && a_rhs) {
+        return std::move(a_lhs) / static_cast<const VPFloat &>(a_rhs);
+    }
+
+    VPFloat operator/(VPFloat && a_lhs, double a_rhs) {
+        if ( ! a_lhs.isReusableAsTemporary() ) {
+            return static_cast<const VPFloat &>(a_lhs) / a_rhs;
+        }
+        VPFloatOperation::div(a_lhs, a_lhs, a_rhs);
+        return std::move(a_lhs);
+    }
+
+    VPFloat operator-(VPFloat && a_rhs) {
+        if ( ( ! a_rhs.m_release_m_data_on_destruction ) || ( a_rhs.m_data == NULL ) ) {
+            return -static_cast<const VPFloat &>(a_rhs);
+        }
+        VPFloatOperation::neg(a_rhs, a_rhs);
+        return std::move(a_rhs);
+    }
+
+    /*******************************************************************************************************************
+     * VPFloatArray move operations
+     ******************************************************************************************************************/
+    VPFloatArray::VPFloatArray(VPFloatArray && a_other) :
+        VPFloat(std::move(a_other)),
+        m_nb_elements(a_other.m_nb_elements)
+    {
+        a_other.m_nb_elements = 0;
+    }
+
+    VPFloatArray & VPFloatArray::operator=(VPFloatArray && a_other) {
+        std::swap(this->m_environment, a_other.m_environment);
+        std::swap(this->m_data, a_other.m_data);
+        std::swap(this->m_double_data, a_other.m_double_data);
+        std::swap(this->m_float_data, a_other.m_float_data);
+        std::swap(this->m_release_m_data_on_destruction, a_other.m_release_m_data_on_destruction);
+        std::swap(this->m_nb_elements, a_other.m_nb_elements);
+
+        return *this;
+    }
+
+}
@@ -21,6 +21,8 @@
 
 #include "bicg_kernel.hpp"
 #include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSDK/VPFloatExpression.hpp"
 
 using namespace VPFloatPackage;
 /* 
@@ -41,15 +43,20 @@ int bicg_vp(int precision,
 	    int n,
 	    VPFloatArray & x,  // valeur de sortie et d'entree
 	    matrix_t A,
-	    matrix_t At,  // petite arnaque en attendant le support vgemv
+	    matrix_t At,  // transposee de A, ou NULL pour utiliser le produit transpose sur A
 	    VPFloatArray b,
 	    double tolerance,
       uint16_t exponent_size,
       int32_t stride_size)
 {
   short myBis=precision+exponent_size+1;
+  VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
   int nbiter;
 
+  // sans At, A^T est applique par un produit transpose sur A
+  matrix_t l_At = ( At != NULL ) ? At : A;
+  char l_At_trans = ( ( At != NULL ) == ( transpose == 0 ) ) ? 'N' : 'Y';
+
   VPFloatComputingEnvironment::set_precision(precision);
   VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
 
@@ -58,10 +65,10 @@ int bicg_vp(int precision,
   VPFloatArray p_k(exponent_size, myBis, stride_size, n );
   VPFloatArray pstar_k(exponent_size, myBis, stride_size, n );
   VPFloatArray Ap_k(exponent_size, myBis, stride_size, n );
-  VPFloatArray minus_alphaxAtpstar_k
-                   (exponent_size, myBis, stride_size, n );
+  VPFloatArray Atpstar_k(exponent_size, myBis, stride_size, n );
   VPFloatArray x_k (exponent_size, myBis, stride_size, n );
   VPFloat      alpha   (exponent_size, myBis, stride_size );
+  VPFloat      minus_alpha (exponent_size, myBis, stride_size );
   VPFloat      alpha_denom (exponent_size, myBis, stride_size );
   VPFloat      beta    (exponent_size, myBis, stride_size );
   VPFloat      rs      (exponent_size, myBis, stride_size );
@@ -88,7 +95,7 @@ int bicg_vp(int precision,
 
   rs_next = 0.0;
   // rxrstar = rk'*rstark
-  VBLAS::vdot(precision, n, r_k, rstar_k, rxrstar);
+  VBLAS::vdot(precision, n, r_k, rstar_k, rxrstar, l_dot_mode);
 
   for (nbiter = 0; nbiter < n*ITER_MAX; ++nbiter) {
     //std::cout<<"------ITER "<<nbiter<<" ----------\n";
@@ -105,10 +112,10 @@ int bicg_vp(int precision,
 		  Ap_k  /*Y*/);
 
     // alphadenom = pstar_k' * Ap_k
-    VBLAS::vdot(precision, n, pstar_k, Ap_k,  alpha_denom);
+    VBLAS::vdot(precision, n, pstar_k, Ap_k,  alpha_denom, l_dot_mode);
 
     // alpha = rs/alphadenom
-    alpha = rxrstar/alpha_denom;
+    alpha = vpexpr(rxrstar)/alpha_denom;
 #ifdef DBG
     std::cout << "iter "<<nbiter<<"alpha="<<(double)alpha<<"\n";
 #endif
@@ -117,11 +124,9 @@ int bicg_vp(int precision,
     VBLAS::vaxpy(precision, n, alpha, p_k,  x_k);
 	
     // r_k = r_k - alpha * Ap_k
-    VBLAS::vaxpy(precision, n, -alpha, Ap_k, r_k);
-
-    // rs_next (rs:r square)
-    //double rs_sqrt;
-    VBLAS::vdot(precision, n, r_k,  r_k, rs_next);
+    // rs_next (rs:r square), computed in the same sweep
+    VPFloatOperation::neg(minus_alpha, alpha);
+    VBLAS::vaxpy_dot(precision, n, minus_alpha, Ap_k, r_k, rs_next, l_dot_mode);
     
 #ifdef DBG
     {
@@ -142,27 +147,23 @@ int bicg_vp(int precision,
       }
       // rstar_k=rstar_k - alpha_k A^T pstar_k
       // en 2 etapes
-      VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y', n, n, 1.0, //-alpha, 
-		    At, pstar_k, // x
+      VBLAS::vgemvd(precision, l_At_trans, n, n, 1.0, //-alpha, 
+		    l_At, pstar_k, // x
 		    0.0, //CONST_0 /*beta*/,
-		    minus_alphaxAtpstar_k  /*Y*/);
-      VBLAS::vscal(precision, n, -alpha, minus_alphaxAtpstar_k);
+		    Atpstar_k  /*Y*/);
 
-      VBLAS::vaxpy(precision, n, 1.0 /*CONST_1*/, minus_alphaxAtpstar_k,  rstar_k);
+      VBLAS::vaxpy(precision, n, minus_alpha, Atpstar_k,  rstar_k);
       // reutilisons rs pour beta
       // rxrstar_next = rk'*rstark
-      VBLAS::vdot(precision, n, r_k, rstar_k, rxrstar_next);
+      VBLAS::vdot(precision, n, r_k, rstar_k, rxrstar_next, l_dot_mode);
 
-      beta= rxrstar_next/rxrstar;
+      beta= vpexpr(rxrstar_next)/rxrstar;
       
-      VBLAS::vscal(precision, n, beta, p_k);
-      // p_k = p_k + r_k
-      VBLAS::vaxpy(precision, n, 1.0 /*CONST_1*/, r_k,  p_k);
-
-      VBLAS::vscal(precision, n, beta, pstar_k);
+      // p_k = r_k + beta * p_k
+      VBLAS::vxpay(precision, n, r_k, beta, p_k);
 
-      // pstar_k = p_k + r_k
-      VBLAS::vaxpy(precision, n, 1.0 /*CONST_1*/, rstar_k,  pstar_k);
+      // pstar_k = rstar_k + beta * pstar_k
+      VBLAS::vxpay(precision, n, rstar_k, beta, pstar_k);
 
       // rs = rs_next
       rxrstar = rxrstar_next;
@@ -186,7 +187,7 @@ int bicg_vp(int precision,
 
     VBLAS::vaxpy(precision, n, -1.0, Ax_check,  Ax_minusB_check);
 
-    VBLAS::vdot(precision, n, Ax_minusB_check, Ax_minusB_check, norm_Ax_minusB_check);
+    VBLAS::vdot(precision, n, Ax_minusB_check, Ax_minusB_check, norm_Ax_minusB_check, l_dot_mode);
 
     std::cout << "||Ax-b|| : " << (double)norm_Ax_minusB_check << " - tolerance : " << tolerance << std::endl;
 
@@ -25,7 +25,9 @@
 #include <cstring>
 #include <time.h>
 #include "bicgstab_kernel.hpp"
+#include "../solver_permutation.hpp"
 #include "VRPOffload/vrp_offloading.hpp"
+#include "VPSDK/VBLAS.hpp"
 #include "VPSDK/VBLASConfig.hpp"
 
 using namespace VPFloatPackage::Offloading;
@@ -63,7 +65,13 @@ int bicgstab_with_vrp_offload(int precision, int transpose, int n, double * X, m
 
 namespace VPFloatPackage::Solver {
 
-    int bicgstab(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size) {
+    int bicgstab(int precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+        if ( permutation != NULL ) {
+            return solvePermuted(n, x, b, permutation, [&](double * a_x, double * a_b) {
+                return bicgstab(precision, transpose, n, a_x, A, At, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+            });
+        }
+
         char * l_vrp_offload = getenv(VRP_OFFLAD_ENVIRONMENT_VAR_NAME);
 
         if (l_vrp_offload != NULL && atoi(l_vrp_offload) != 0 ) {
@@ -87,12 +95,14 @@ namespace VPFloatPackage::Solver {
             int l_iteration_count =  bicgstab_vp(precision, transpose, n, Xv, A, At, Bv, tolerance, exponent_size, stride_size);
             clock_gettime(CLOCK_MONOTONIC, &l_timespec_stop);
 
+            copyBackSolution(n, Xv, x);
+
             l_solver_duration = ( ( ( l_timespec_stop.tv_sec - l_timespec_start.tv_sec ) * 1e9 ) + ( l_timespec_stop.tv_nsec - l_timespec_start.tv_nsec ) );
 
             std::cout << "solver duration             : " << l_solver_duration << "ns" << std::endl;
             std::cout << precision << " "<< l_iteration_count << std::endl;
 
-            if ( log_buffer_size >= 0 ) {
+            if ( log_buffer_size > 0 ) {
                 strncpy(log_buffer, strCout.str().c_str(), std::min(strCout.str().length(), log_buffer_size));
                 std::cout.rdbuf(cout_backup_buf);
             }
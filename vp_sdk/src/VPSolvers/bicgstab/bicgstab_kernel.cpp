@@ -22,7 +22,9 @@
 #include "bicgstab_kernel.hpp"
 #include "VPSDK/VPFloat.hpp"
 #include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
 #include "VPSDK/VMath.hpp" // for vsqrt
+#include "VPSDK/VPFloatExpression.hpp"
 
 using namespace VPFloatPackage;
 
@@ -35,13 +37,14 @@ int bicgstab_vp(          // Solves Ax = b where A is a non-symetric square matr
 	int n,                  // size of the matrix 
 	VPFloatArray& x,        // an initial guess for the system Ax = b
 	matrix_t A,             // A
-	matrix_t At,            // Transpose of A
+	matrix_t At,            // Transpose of A (unused, may be NULL)
 	VPFloatArray b,         // LHS
 	double tolerance,       // stoping criterion for the method. The method will stop if |r_k|^2 < tolerance^2 
 	uint16_t exponent_size, // size of the exponent of a VPFloat
 	int32_t stride_size)	    // mysterious variable which shall be 1
 {
 	short myBis=precision+exponent_size+1;
+	VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
   int nbiter;
 
   VPFloatComputingEnvironment::set_rounding_mode(VP_RNE);
@@ -57,9 +60,6 @@ int bicgstab_vp(          // Solves Ax = b where A is a non-symetric square matr
   VPFloatArray s_k(exponent_size, myBis, stride_size, n );
   VPFloatArray t_k(exponent_size, myBis, stride_size, n );
   
-  VPFloatArray tmp(exponent_size, myBis, stride_size, n );
-  VPFloatArray tmp2(exponent_size, myBis, stride_size, n );
-  
   VPFloat squaredNorm_rk(exponent_size, myBis, stride_size );
   VPFloat r0_dot_vk(exponent_size, myBis, stride_size );
   VPFloat tk_dot_sk(exponent_size, myBis, stride_size );
@@ -68,6 +68,8 @@ int bicgstab_vp(          // Solves Ax = b where A is a non-symetric square matr
   VPFloat rho(exponent_size, myBis, stride_size );
   VPFloat alpha(exponent_size, myBis, stride_size );
   VPFloat omega(exponent_size, myBis, stride_size );
+  VPFloat minus_alpha(exponent_size, myBis, stride_size );
+  VPFloat minus_omega(exponent_size, myBis, stride_size );
   
   VPFloat rhoOld(exponent_size, myBis, stride_size );
   VPFloat beta(exponent_size, myBis, stride_size );
@@ -82,47 +84,46 @@ int bicgstab_vp(          // Solves Ax = b where A is a non-symetric square matr
   rho = 1.;
   alpha = 1.;
   omega = 1.;
+  VBLAS::vdot(precision, n, r_k,  r_k, squaredNorm_rk, l_dot_mode);
 
   for (nbiter = 0; nbiter < n*ITER_MAX; ++nbiter) {
 		
-		VBLAS::vdot(precision, n, r_k,  r_k, squaredNorm_rk);
 		std::cout << "residus : " <<  double(squaredNorm_rk) << " - iter : " << nbiter << std::endl;
 		if ((double)squaredNorm_rk < (tolerance*tolerance)) { VBLAS::vcopy(n, x_k,  x); break; }
 		
 		rhoOld = rho;
-		VBLAS::vdot(precision, n, hat_r_0, r_k, rho);
+		VBLAS::vdot(precision, n, hat_r_0, r_k, rho, l_dot_mode);
 		
-		beta = (rho / rhoOld)*(alpha / omega);
+		beta = (vpexpr(rho) / rhoOld)*(vpexpr(alpha) / omega);
 		
 		/* p <- r + beta*(p - omega*v) */
-		VBLAS::vcopy(n, p_k, tmp);                    // tmp   = p
-		VBLAS::vcopy(n, r_k, tmp2);                   // tmp2  = r
-		VBLAS::vaxpy(precision, n, -omega, v_k, tmp); // tmp  -= omega*v  (tmp = p - omega*v)
-		VBLAS::vaxpy(precision, n,  beta, tmp, tmp2); // tmp2 += beta*tmp (tmp = r + beta*(p - omega*v))
-		VBLAS::vcopy(n, tmp2, p_k);
+		VPFloatOperation::neg(minus_omega, omega);
+		VBLAS::vaxpy(precision, n, minus_omega, v_k, p_k); // p -= omega*v
+		VBLAS::vxpay(precision, n, r_k, beta, p_k);        // p  = r + beta*p
 		/* v <- A*p */
 		VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y', n, n, 1.0, A, p_k, 0.0, v_k);
-		VBLAS::vdot(precision, n, hat_r_0, v_k, r0_dot_vk);
-		alpha = rho / r0_dot_vk;
-		/* s <- r - alpha*v */
+		VBLAS::vdot(precision, n, hat_r_0, v_k, r0_dot_vk, l_dot_mode);
+		alpha = vpexpr(rho) / r0_dot_vk;
+		/* s <- r - alpha*v, squaredNorm_rk <- (s,s) */
 		VBLAS::vcopy(n, r_k, s_k);
-		VBLAS::vaxpy(precision, n, -alpha, v_k, s_k);
+		VPFloatOperation::neg(minus_alpha, alpha);
+		VBLAS::vaxpy_dot(precision, n, minus_alpha, v_k, s_k, squaredNorm_rk, l_dot_mode);
 		
-		VBLAS::vdot(precision, n, s_k,  s_k, squaredNorm_rk);
 		if ((double)squaredNorm_rk < (tolerance*tolerance)) { VBLAS::vcopy(n, x_k,  x); break; }
 
 		/* t <- A*s */
 		VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y', n, n, 1.0, A, s_k, 0.0, t_k);
 		/* omega <- (t,s) / (t,t) */
-		VBLAS::vdot(precision, n, t_k, s_k, tk_dot_sk);
-		VBLAS::vdot(precision, n, t_k, t_k, squaredNorm_tk);
-		omega = tk_dot_sk / squaredNorm_tk;
+		VBLAS::vdot(precision, n, t_k, s_k, tk_dot_sk, l_dot_mode);
+		VBLAS::vdot(precision, n, t_k, t_k, squaredNorm_tk, l_dot_mode);
+		omega = vpexpr(tk_dot_sk) / squaredNorm_tk;
 		/* x <- x + alpha*p + omega*s */
 		VBLAS::vaxpy(precision, n,  alpha, p_k, x_k);
 		VBLAS::vaxpy(precision, n,  omega, s_k, x_k);
-		/* r <- s - omega*t */
+		/* r <- s - omega*t, squaredNorm_rk <- (r,r) for the next iteration */
 		VBLAS::vcopy(n, s_k, r_k);                    // r  = s
-		VBLAS::vaxpy(precision, n, -omega, t_k, r_k); // r -= omega*t
+		VPFloatOperation::neg(minus_omega, omega);
+		VBLAS::vaxpy_dot(precision, n, minus_omega, t_k, r_k, squaredNorm_rk, l_dot_mode); // r -= omega*t
 	}
   if (nbiter==(n*ITER_MAX)) // ca n'a pas converge
   {
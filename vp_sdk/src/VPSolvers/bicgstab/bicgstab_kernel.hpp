@@ -33,7 +33,7 @@ int bicgstab_vp(          // Solves Ax = b where A is a non-symetric square matr
 	int n,                  // size of the matrix 
 	VPFloatArray& x,        // an initial guess for the system Ax = b
 	matrix_t A,             // A
-	matrix_t At,            // Transpose of A
+	matrix_t At,            // Transpose of A (unused, may be NULL)
 	VPFloatArray b,         // LHS
 	double tolerance,       // stoping criterion for the method. The method will stop if |r_k|^2 < tolerance^2 
 	uint16_t exponent_size, // size of the exponent of a VPFloat
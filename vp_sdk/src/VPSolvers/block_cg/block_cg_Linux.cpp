@@ -0,0 +1,92 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+* 
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* 
+*     http://www.apache.org/licenses/LICENSE-2.0
+* 
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : 
+ **/
+
+#include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <cstring>
+#include <time.h>
+#include "block_cg_kernel.hpp"
+#include "../solver_permutation.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+
+/*
+ * Shared by cg_multi and block_cg. No VRP offload binary for the multiple right hand sides solvers: they always run
+ * on the host.
+ */
+static int block_cg_on_host(block_cg_kernel_t a_kernel, int precision, int transpose, int n, int k, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size) {
+    std::streambuf *cout_backup_buf;
+    std::ostringstream strCout;
+    if ( log_buffer_size > 0 ) {
+        printf("log_buf_size is %ld. Redirect cout to oStringStream.\n", log_buffer_size);
+        cout_backup_buf = std::cout.rdbuf();
+        std::cout.rdbuf( strCout.rdbuf() );
+    }
+
+    VPFloatArray Xv(x, n * k);
+    VPFloatArray Bv(b, n * k);
+
+    struct timespec l_timespec_start, l_timespec_stop;
+    uint64_t l_solver_duration;
+
+    clock_gettime(CLOCK_MONOTONIC, &l_timespec_start);
+    int l_iteration_count = a_kernel(precision, transpose, n, k, Xv, A, Bv, tolerance, exponent_size, stride_size);
+    clock_gettime(CLOCK_MONOTONIC, &l_timespec_stop);
+
+    copyBackSolution(n * k, Xv, x);
+
+    l_solver_duration = ( ( ( l_timespec_stop.tv_sec - l_timespec_start.tv_sec ) * 1e9 ) + ( l_timespec_stop.tv_nsec - l_timespec_start.tv_nsec ) );
+
+    std::cout << "solver duration             : " << l_solver_duration << "ns" << std::endl;
+    std::cout << precision << " " << l_iteration_count << std::endl;
+
+    if ( log_buffer_size > 0 ) {
+        strncpy(log_buffer, strCout.str().c_str(), std::min(strCout.str().length(), log_buffer_size));
+        std::cout.rdbuf(cout_backup_buf);
+    }
+
+    return l_iteration_count;
+}
+
+namespace VPFloatPackage::Solver {
+
+    int cg_multi(int precision, int transpose, int n, int k, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+        if ( permutation != NULL ) {
+            return solvePermutedBlock(n, k, x, b, permutation, [&](double * a_x, double * a_b) {
+                return cg_multi(precision, transpose, n, k, a_x, A, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+            });
+        }
+
+        return block_cg_on_host(cg_multi_vp, precision, transpose, n, k, x, A, b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size);
+    }
+
+    int block_cg(int precision, int transpose, int n, int k, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+        if ( permutation != NULL ) {
+            return solvePermutedBlock(n, k, x, b, permutation, [&](double * a_x, double * a_b) {
+                return block_cg(precision, transpose, n, k, a_x, A, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+            });
+        }
+
+        return block_cg_on_host(block_cg_vp, precision, transpose, n, k, x, A, b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size);
+    }
+
+}
@@ -0,0 +1,440 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+* 
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* 
+*     http://www.apache.org/licenses/LICENSE-2.0
+* 
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : CG for multiple right hand sides. X and B hold k vectors of n elements stored contiguously,
+ *                 vector j being x[j*n .. (j+1)*n[, so the matrix products of the k solves are a single vgemmd
+ *                 call streaming A once for all the vectors.
+ *
+ *                 cg_multi_vp runs k independent CG recurrences: each vector follows the operations of cg_vp and
+ *                 stops at its own convergence, its iterates are the ones of a cg_vp solve.
+ *
+ *                 block_cg_vp is the block CG of O'Leary ("The block conjugate gradient algorithm and related
+ *                 methods", 1980): the search space of each vector holds the directions of all the vectors, which
+ *                 usually saves iterations when the right hand sides are related. It is run in the breakdown free
+ *                 form of Ji and Li ("A breakdown-free block conjugate gradient method", 2017): the directions are
+ *                 orthonormalized at each iteration and the dependent ones are dropped, so zero, duplicated or
+ *                 linearly dependent right hand sides, and vectors converging before the others, only reduce the
+ *                 number s <= k of directions instead of making P' A P singular. The s x s systems of each
+ *                 iteration are solved by Gaussian elimination with partial pivoting.
+ **/
+
+#include <algorithm>
+#include <math.h>
+#include <vector>
+#include "block_cg_kernel.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSDK/VPFloatExpression.hpp"
+#include "VPSDK/VMath.hpp" // for vsqrt
+
+// package de support VPFloat
+using namespace VPFloatPackage;
+
+// ITER_MAX: on abandonne après n*ITER_MAX iterations
+#define ITER_MAX 5
+
+#define BLOCK_CG_REORTHOGONALIZATION_RATIO 0.7071067811865476
+
+/*
+ * ----------------------------------
+ * ----multiple right hand sides CG -
+ */
+int cg_multi_vp(int precision,
+    int transpose,
+    int n,
+    int k,
+    VPFloatArray & x,  // valeur de sortie
+    matrix_t A,
+    VPFloatArray & b,
+    double tolerance,
+    uint16_t exponent_size,
+    int32_t stride_size)
+{
+  short myBis = precision + exponent_size + 1;
+  VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
+  std::vector<bool> l_converged(k, false);
+  int l_nb_converged = 0;
+  int l_max_iter = 0;
+  int nbiter;
+
+  VPFloatComputingEnvironment::set_precision(myBis);
+  VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
+
+  VPFloatArray R(exponent_size, myBis, stride_size, n * k );
+  VPFloatArray P(exponent_size, myBis, stride_size, n * k );
+  VPFloatArray AP(exponent_size, myBis, stride_size, n * k );
+  VPFloatArray X(exponent_size, myBis, stride_size, n * k );
+  VPFloatArray rs(exponent_size, myBis, stride_size, k );
+  VPFloatArray rs_next(exponent_size, myBis, stride_size, k );
+  VPFloat      alpha   (exponent_size, myBis, stride_size );
+  VPFloat      minus_alpha (exponent_size, myBis, stride_size );
+  VPFloat      beta    (exponent_size, myBis, stride_size );
+  VPFloat      zero    (exponent_size, myBis, stride_size );
+
+  zero = 0.0;
+
+  /* R <- B, P <- B, X = {0} */
+  VBLAS::vcopy(n * k, b, R);
+  VBLAS::vcopy(n * k, b, P);
+  VBLAS::vzero(precision, n * k, X);
+  VBLAS::vzero(precision, n * k, AP);
+  VBLAS::vzero(precision, k, rs_next);
+
+  for (int j = 0; j < k; j++) {
+    VPFloatArray r_j(R, j * n, n);
+    VPFloat rs_j = rs[j];
+
+    VBLAS::vdot(precision, n, r_j, r_j, rs_j, l_dot_mode);
+
+    // b_j = 0: x_j = 0, its recurrence would divide 0 by 0
+    if ( double(rs_j) == 0.0 ) {
+      VPFloatArray x_out(x, j * n, n);
+
+      VBLAS::vzero(precision, n, x_out);
+      l_converged[j] = true;
+      l_nb_converged++;
+    }
+  }
+
+  if ( l_nb_converged == k ) {
+    return 1;
+  }
+
+  for (nbiter = 0; nbiter < n*ITER_MAX; ++nbiter) {
+    double l_max_rs = 0.0;
+
+    for (int j = 0; j < k; j++) {
+      if ( ! l_converged[j] ) {
+        l_max_rs = std::max(l_max_rs, double(rs_next[j]));
+      }
+    }
+    std::cout << "residus : " << l_max_rs << " - iter : " << nbiter << std::endl;
+
+    // AP = A * P, the directions of the converged vectors do not change any more
+    VBLAS::vgemmd(precision, transpose == 0 ? 'N' : 'Y', n, n, k, 1.0, A, P, zero, AP);
+
+    for (int j = 0; j < k; j++) {
+      if ( l_converged[j] ) {
+        continue;
+      }
+
+      VPFloatArray p_j(P, j * n, n);
+      VPFloatArray ap_j(AP, j * n, n);
+      VPFloatArray r_j(R, j * n, n);
+      VPFloatArray x_j(X, j * n, n);
+      VPFloat rs_j = rs[j];
+      VPFloat rs_next_j = rs_next[j];
+
+      // alpha = rs / (p_j' * Ap_j)
+      VBLAS::vdot(precision, n, p_j, ap_j, alpha, l_dot_mode);
+      alpha = vpexpr(rs_j)/alpha;
+
+      // x_j = x_j + alpha*p_j, r_j = r_j - alpha*Ap_j, rs_next = r_j' * r_j
+      VBLAS::vaxpy(precision, n, alpha, p_j, x_j);
+      VPFloatOperation::neg(minus_alpha, alpha);
+      VBLAS::vaxpy_dot(precision, n, minus_alpha, ap_j, r_j, rs_next_j, l_dot_mode);
+
+      if ((double)rs_next_j < (tolerance*tolerance)) {
+        VPFloatArray x_out(x, j * n, n);
+
+        VBLAS::vcopy(n, x_j, x_out);
+        l_converged[j] = true;
+        l_nb_converged++;
+        l_max_iter = nbiter;
+        continue;
+      }
+
+      // p_j = r_j + p_j * (rs_next/rs)
+      beta = vpexpr(rs_next_j)/rs_j;
+      VBLAS::vxpay(precision, n, r_j, beta, p_j);
+      rs_j = rs_next_j;
+    }
+
+    if ( l_nb_converged == k ) {
+      break;
+    }
+  }
+
+  if ( l_nb_converged < k ) {
+    // ca n'a pas converge
+    return -1;
+  }
+
+  // iterations of the slowest vector
+  return (l_max_iter + 1);
+}
+
+/*
+ * ----------------------------------
+ * ----block CG ---------------------
+ */
+
+/* res = V^T W, V and W holding s and k vectors of n elements, res being a s x k matrix stored by columns */
+static void blockDot(int precision, int n, int s, int k, VPFloatArray & V, VPFloatArray & W, VPFloatArray & res, VBLAS::VBLASDotMode a_dot_mode)
+{
+  for (int j = 0; j < k; j++) {
+    VPFloatArray w_j(W, j * n, n);
+    VPFloatArray res_j(res, j * s, s);
+
+    VBLAS::vdot_block(precision, n, s, V, w_j, res_j, a_dot_mode);
+  }
+}
+
+/* Y = Y + V C, V and Y holding s and k vectors, C being a s x k matrix stored by columns */
+static void blockUpdate(int precision, int n, int s, int k, VPFloatArray & C, VPFloatArray & V, VPFloatArray & Y)
+{
+  for (int j = 0; j < k; j++) {
+    VPFloatArray c_j(C, j * s, s);
+    VPFloatArray y_j(Y, j * n, n);
+
+    VBLAS::vaxpy_block(precision, n, s, c_j, V, y_j);
+  }
+}
+
+/*
+ * Solves a M = B by Gaussian elimination with partial pivoting, a being a s x s matrix and B a s x k matrix, both
+ * stored by columns. a is overwritten by its factorization and B by M. Returns false when a is singular.
+ */
+static bool solveSmallSystem(int s, int k, VPFloatArray & a, VPFloatArray & B)
+{
+  vpfloat_evp_t l_env = a.getEnvironment();
+  VPFloat factor(l_env.es, l_env.bis, l_env.stride);
+  VPFloat tmp(l_env.es, l_env.bis, l_env.stride);
+
+  for (int c = 0; c < s; c++) {
+    int l_pivot = c;
+
+    for (int i = c + 1; i < s; i++) {
+      if ( fabs(double(a[i + c * s])) > fabs(double(a[l_pivot + c * s])) ) {
+        l_pivot = i;
+      }
+    }
+
+    if ( double(a[l_pivot + c * s]) == 0.0 ) {
+      return false;
+    }
+
+    if ( l_pivot != c ) {
+      for (int l = c; l < s; l++) {
+        tmp = a[c + l * s];
+        a[c + l * s] = a[l_pivot + l * s];
+        a[l_pivot + l * s] = tmp;
+      }
+      for (int l = 0; l < k; l++) {
+        tmp = B[c + l * s];
+        B[c + l * s] = B[l_pivot + l * s];
+        B[l_pivot + l * s] = tmp;
+      }
+    }
+
+    for (int i = c + 1; i < s; i++) {
+      factor = vpexpr(a[i + c * s])/a[c + c * s];
+
+      for (int l = c + 1; l < s; l++) {
+        a[i + l * s] = vpexpr(a[i + l * s]) - vpexpr(factor)*a[c + l * s];
+      }
+      for (int l = 0; l < k; l++) {
+        B[i + l * s] = vpexpr(B[i + l * s]) - vpexpr(factor)*B[c + l * s];
+      }
+    }
+  }
+
+  for (int l = 0; l < k; l++) {
+    for (int i = s - 1; i >= 0; i--) {
+      tmp = B[i + l * s];
+      for (int c = i + 1; c < s; c++) {
+        tmp = vpexpr(tmp) - vpexpr(a[i + c * s])*B[c + l * s];
+      }
+      B[i + l * s] = vpexpr(tmp)/a[i + i * s];
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Orthonormalizes the k vectors of T into P with classical Gram-Schmidt, with the second pass of gmres_vp when the
+ * first one cancels most of a vector. A vector whose norm drops below a_deflation_ratio times its norm before the
+ * projection depends on the vectors already kept and is dropped. T is overwritten, the number of vectors kept in P
+ * is returned. The norms are compared squared, the square root is only taken for the vectors kept (vsqrt does not
+ * take 0).
+ */
+static int orthonormalizeBlock(int precision, int n, int k, VPFloatArray & T, VPFloatArray & P, VPFloatArray & h, VPFloatArray & minus_h, double a_deflation_ratio, VBLAS::VBLASDotMode a_dot_mode)
+{
+  vpfloat_evp_t l_env = T.getEnvironment();
+  VPFloat one(l_env.es, l_env.bis, l_env.stride);
+  VPFloat norm2(l_env.es, l_env.bis, l_env.stride);
+  VPFloat tmp(l_env.es, l_env.bis, l_env.stride);
+  int s = 0;
+
+  one = 1.0;
+
+  for (int j = 0; j < k; j++) {
+    VPFloatArray t_j(T, j * n, n);
+
+    VBLAS::vdot(precision, n, t_j, t_j, norm2, a_dot_mode);
+
+    double l_initial_norm = sqrt(double(norm2));
+    double l_norm = l_initial_norm;
+
+    for (int l_pass = 0; ( l_pass < 2 ) && ( s > 0 ); l_pass++) {
+      double l_previous_norm = l_norm;
+
+      VBLAS::vdot_block(precision, n, s, P, t_j, h, a_dot_mode);
+      for (int i = 0; i < s; i++) {
+        minus_h[i] = -vpexpr(h[i]);
+      }
+      VBLAS::vaxpy_block(precision, n, s, minus_h, P, t_j);
+      VBLAS::vdot(precision, n, t_j, t_j, norm2, a_dot_mode);
+      l_norm = sqrt(double(norm2));
+
+      if ( l_norm >= BLOCK_CG_REORTHOGONALIZATION_RATIO * l_previous_norm ) {
+        break;
+      }
+    }
+
+    // zero or linearly dependent vector
+    if ( ( double(norm2) == 0.0 ) || ( l_norm <= a_deflation_ratio * l_initial_norm ) ) {
+      continue;
+    }
+
+    VPFloatArray p_s(P, s * n, n);
+
+    tmp = VMath::vsqrt(norm2);
+    tmp = vpexpr(one)/tmp;
+    VBLAS::vzero(precision, n, p_s);
+    VBLAS::vaxpy(precision, n, tmp, t_j, p_s);
+    s++;
+  }
+
+  return s;
+}
+
+int block_cg_vp(int precision,
+    int transpose,
+    int n,
+    int k,
+    VPFloatArray & x,  // valeur de sortie
+    matrix_t A,
+    VPFloatArray & b,
+    double tolerance,
+    uint16_t exponent_size,
+    int32_t stride_size)
+{
+  short myBis = precision + exponent_size + 1;
+  VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
+  double l_deflation_ratio = ldexp(1.0, -precision / 2);
+  bool l_converged = false;
+  int s = 0;
+  int nbiter;
+
+  VPFloatComputingEnvironment::set_precision(myBis);
+  VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
+
+  VPFloatArray R(exponent_size, myBis, stride_size, n * k );
+  VPFloatArray P(exponent_size, myBis, stride_size, n * k );        // s orthonormal directions
+  VPFloatArray Q(exponent_size, myBis, stride_size, n * k );        // A P
+  VPFloatArray T(exponent_size, myBis, stride_size, n * k );        // next directions before orthonormalization
+  VPFloatArray X(exponent_size, myBis, stride_size, n * k );
+  VPFloatArray gamma(exponent_size, myBis, stride_size, k * k );    // P^T A P
+  VPFloatArray gamma_factor(exponent_size, myBis, stride_size, k * k );
+  VPFloatArray alpha(exponent_size, myBis, stride_size, k * k );    // s x k
+  VPFloatArray minus_alpha(exponent_size, myBis, stride_size, k * k );
+  VPFloatArray beta(exponent_size, myBis, stride_size, k * k );     // s x k
+  VPFloatArray h(exponent_size, myBis, stride_size, k );
+  VPFloatArray minus_h(exponent_size, myBis, stride_size, k );
+  VPFloat      rs      (exponent_size, myBis, stride_size );
+  VPFloat      zero    (exponent_size, myBis, stride_size );
+
+  zero = 0.0;
+
+  /* R <- B, T <- B, X = {0} */
+  VBLAS::vcopy(n * k, b, R);
+  VBLAS::vcopy(n * k, b, T);
+  VBLAS::vzero(precision, n * k, X);
+  VBLAS::vzero(precision, n * k, Q);
+
+  for (nbiter = 0; nbiter < n*ITER_MAX; ++nbiter) {
+    // P = orth(T): the zero and dependent vectors are deflated, P keeps s <= k directions
+    s = orthonormalizeBlock(precision, n, k, T, P, h, minus_h, l_deflation_ratio, l_dot_mode);
+
+    // T = R + P beta is orthogonal to the previous directions, so it is only zero when R is
+    if ( s == 0 ) {
+      l_converged = true;
+      VBLAS::vcopy(n * k, X, x);
+      break;
+    }
+
+    // Q = A * P, gamma = P' * Q
+    VBLAS::vgemmd(precision, transpose == 0 ? 'N' : 'Y', n, n, s, 1.0, A, P, zero, Q);
+    blockDot(precision, n, s, s, P, Q, gamma, l_dot_mode);
+
+    // gamma alpha = P' R
+    blockDot(precision, n, s, k, P, R, alpha, l_dot_mode);
+    VBLAS::vcopy(s * s, gamma, gamma_factor);
+    if ( ! solveSmallSystem(s, k, gamma_factor, alpha) ) {
+      std::cout << "block CG breakdown : singular P' A P - iter : " << nbiter << std::endl;
+      return -1;
+    }
+
+    // X = X + P alpha, R = R - Q alpha
+    blockUpdate(precision, n, s, k, alpha, P, X);
+    for (int i = 0; i < s * k; i++) {
+      minus_alpha[i] = -vpexpr(alpha[i]);
+    }
+    blockUpdate(precision, n, s, k, minus_alpha, Q, R);
+
+    double l_max_rs = 0.0;
+
+    l_converged = true;
+    for (int j = 0; j < k; j++) {
+      VPFloatArray r_j(R, j * n, n);
+
+      VBLAS::vdot(precision, n, r_j, r_j, rs, l_dot_mode);
+      l_max_rs = std::max(l_max_rs, double(rs));
+      l_converged = l_converged && ( double(rs) < (tolerance*tolerance) );
+    }
+    std::cout << "residus : " << l_max_rs << " - iter : " << nbiter << std::endl;
+
+    if ( l_converged ) {
+      VBLAS::vcopy(n * k, X, x);
+      break;
+    }
+
+    // gamma beta = -Q' R, T = R + P beta
+    blockDot(precision, n, s, k, Q, R, beta, l_dot_mode);
+    for (int i = 0; i < s * k; i++) {
+      beta[i] = -vpexpr(beta[i]);
+    }
+    VBLAS::vcopy(s * s, gamma, gamma_factor);
+    if ( ! solveSmallSystem(s, k, gamma_factor, beta) ) {
+      std::cout << "block CG breakdown : singular P' A P - iter : " << nbiter << std::endl;
+      return -1;
+    }
+
+    VBLAS::vcopy(n * k, R, T);
+    blockUpdate(precision, n, s, k, beta, P, T);
+  }
+
+  if ( ! l_converged ) {
+    // ca n'a pas converge
+    return -1;
+  }
+
+  return (nbiter + 1);
+}
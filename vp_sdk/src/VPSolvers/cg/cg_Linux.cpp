@@ -25,7 +25,9 @@
 #include <cstring>
 #include <time.h>
 #include "cg_kernel.hpp"
+#include "../solver_permutation.hpp"
 #include "VRPOffload/vrp_offloading.hpp"
+#include "VPSDK/VBLAS.hpp"
 #include "VPSDK/VBLASConfig.hpp"
 
 using namespace VPFloatPackage::Offloading;
@@ -62,7 +64,13 @@ int cg_with_vrp_offload(int precision, int transpose, int n, double * X, matrix_
 
 namespace VPFloatPackage::Solver {
 
-    int cg(int precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size) {
+    int cg(int precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+        if ( permutation != NULL ) {
+            return solvePermuted(n, x, b, permutation, [&](double * a_x, double * a_b) {
+                return cg(precision, transpose, n, a_x, A, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+            });
+        }
+
         char * l_vrp_offload = getenv(VRP_OFFLAD_ENVIRONMENT_VAR_NAME);
 
         if (l_vrp_offload != NULL && atoi(l_vrp_offload) != 0 ) {
@@ -88,6 +96,8 @@ namespace VPFloatPackage::Solver {
             int l_iteration_count = cg_vp(precision, transpose, n, Xv, A, Bv, tolerance, exponent_size, stride_size);
             clock_gettime(CLOCK_MONOTONIC, &l_timespec_stop);
 
+            copyBackSolution(n, Xv, x);
+
             l_solver_duration = ( ( ( l_timespec_stop.tv_sec - l_timespec_start.tv_sec ) * 1e9 ) + ( l_timespec_stop.tv_nsec - l_timespec_start.tv_nsec ) );
 
             std::cout << "solver duration             : " << l_solver_duration << "ns" << std::endl;
@@ -102,4 +112,45 @@ namespace VPFloatPackage::Solver {
         }
     }
 
+    int cg_adaptive(int precision, int initial_precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+        if ( permutation != NULL ) {
+            return solvePermuted(n, x, b, permutation, [&](double * a_x, double * a_b) {
+                return cg_adaptive(precision, initial_precision, transpose, n, a_x, A, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+            });
+        }
+
+        // No VRP offload binary for the adaptive CG: it always runs on the host
+        std::streambuf *cout_backup_buf;
+        std::ostringstream strCout;
+        if ( log_buffer_size > 0 ) {
+            printf("log_buf_size is %ld. Redirect cout to oStringStream.\n", log_buffer_size);
+            cout_backup_buf = std::cout.rdbuf();
+            std::cout.rdbuf( strCout.rdbuf() );
+        }
+
+        VPFloatArray Xv(x, n);
+        VPFloatArray Bv(b, n);
+
+        struct timespec l_timespec_start, l_timespec_stop;
+        uint64_t l_solver_duration;
+
+        clock_gettime(CLOCK_MONOTONIC, &l_timespec_start);
+        int l_iteration_count = cg_adaptive_vp(precision, initial_precision, transpose, n, Xv, A, Bv, tolerance, exponent_size, stride_size);
+        clock_gettime(CLOCK_MONOTONIC, &l_timespec_stop);
+
+        copyBackSolution(n, Xv, x);
+
+        l_solver_duration = ( ( ( l_timespec_stop.tv_sec - l_timespec_start.tv_sec ) * 1e9 ) + ( l_timespec_stop.tv_nsec - l_timespec_start.tv_nsec ) );
+
+        std::cout << "solver duration             : " << l_solver_duration << "ns" << std::endl;
+        std::cout << precision << " " << l_iteration_count << std::endl;
+
+        if ( log_buffer_size > 0 ) {
+            strncpy(log_buffer, strCout.str().c_str(), std::min(strCout.str().length(), log_buffer_size));
+            std::cout.rdbuf(cout_backup_buf);
+        }
+
+        return l_iteration_count;
+    }
+
 }
@@ -20,6 +20,7 @@
  **/
 
 #include "cg_kernel.hpp"
+#include "../solver_permutation.hpp"
 #include "VRPSDK/perfcounters/cpu.h"
 #include "VRPSDK/vblas_perfmonitor.h"
 #include "VPSDK/VBLASConfig.hpp"
@@ -27,7 +28,13 @@
 
 namespace VPFloatPackage::Solver {
 
-	int cg(int precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size) {
+	int cg(int precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+		if ( permutation != NULL ) {
+			return solvePermuted(n, x, b, permutation, [&](double * a_x, double * a_b) {
+				return cg(precision, transpose, n, a_x, A, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+			});
+		}
+
 		int l_iteration_count;
 
 		VBLASPERFMONITOR_INITIALIZE;
@@ -68,4 +75,38 @@ namespace VPFloatPackage::Solver {
 		return l_iteration_count;
 	}
 
-}
\ No newline at end of file
+	int cg_adaptive(int precision, int initial_precision, int transpose, int n, double * x, matrix_t A, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+		if ( permutation != NULL ) {
+			return solvePermuted(n, x, b, permutation, [&](double * a_x, double * a_b) {
+				return cg_adaptive(precision, initial_precision, transpose, n, a_x, A, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+			});
+		}
+
+		int l_iteration_count;
+
+		VBLASPERFMONITOR_INITIALIZE;
+
+		VPFloatPackage::VBLAS::VBLAS_Init();
+
+		clock_t t0, t1;
+		uint64_t instr0, instr1;
+
+		VPFloatArray Xv(x, n);
+		VPFloatArray Bv(b, n);
+
+		instr0 = cpu_instructions();
+		t0 = clock();
+		l_iteration_count = cg_adaptive_vp(precision, initial_precision, transpose, n, Xv, A, Bv, tolerance, exponent_size, stride_size);
+		t1 = clock();
+		instr1 = cpu_instructions();
+
+		VPFloatPackage::VBLAS::VBLAS_Destroy();
+
+		VBLASPERFMONITOR_DISPLAY;
+
+		std::cout << "CG adaptive: instructions: " << instr1 - instr0 << " / elapsed_time=" << (((double)(t1-t0))/CORE_REFCLK) << std::endl;
+
+		return l_iteration_count;
+	}
+
+}
@@ -23,8 +23,12 @@
  * gestion de la structure crs 
  * == matrices creuses
  */
+#include <algorithm>
+#include <math.h>
 #include "cg_kernel.hpp"
 #include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSDK/VPFloatExpression.hpp"
 #include "VRPSDK/perfcounters/cpu.h"
 
 // package de support VPFloat
@@ -55,6 +59,7 @@ int cg_vp(int precision,
 {
 
   short myBis=precision+exponent_size+1;
+  VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
   int nbiter;
 
 
@@ -66,6 +71,7 @@ int cg_vp(int precision,
   VPFloatArray Ap_k(exponent_size, myBis, stride_size, n );
   VPFloatArray x_k(exponent_size, myBis, stride_size, n );
   VPFloat      alpha   (exponent_size, myBis, stride_size );
+  VPFloat      minus_alpha (exponent_size, myBis, stride_size );
   VPFloat      beta    (exponent_size, myBis, stride_size );
   VPFloat      rs      (exponent_size, myBis, stride_size );
   VPFloat      rs_next (exponent_size, myBis, stride_size );
@@ -83,7 +89,7 @@ int cg_vp(int precision,
   rs_next = 0.0;
  
   // rs = rk'*rk
-  VBLAS::vdot(precision, n, r_k, r_k, rs);
+  VBLAS::vdot(precision, n, r_k, r_k, rs, l_dot_mode);
   
   for (nbiter = 0; nbiter < n*ITER_MAX; ++nbiter) {
     std::cout << "residus : " <<  double(rs_next) << " - iter : " << nbiter << std::endl;
@@ -103,13 +109,13 @@ int cg_vp(int precision,
 #endif
     
     // alpha = Ap_k * p_k
-    VBLAS::vdot(precision, n, p_k, Ap_k,  alpha);
+    VBLAS::vdot(precision, n, p_k, Ap_k,  alpha, l_dot_mode);
 #ifdef DBG
     std::cout << "iter "<<nbiter<<" |p_k A p_k|="<<alpha.getdouble()<<"\n";
 #endif
 
     // alpha = rs/alpha
-    alpha = rs/alpha;
+    alpha = vpexpr(rs)/alpha;
 #ifdef DBG
     std::cout << "iter "<<nbiter<<" \nalpha="<<alpha.getdouble()<<"\n";
 #endif
@@ -127,14 +133,12 @@ int cg_vp(int precision,
     std::cout<<"alpha = "<< alpha <<" \n";
 #endif
 
-    VBLAS::vaxpy(precision, n, -alpha, Ap_k, r_k);
+    // rs_next = r_k' * r_k (rs:r square), computed in the same sweep
+    VPFloatOperation::neg(minus_alpha, alpha);
+    VBLAS::vaxpy_dot(precision, n, minus_alpha, Ap_k, r_k, rs_next, l_dot_mode);
 #ifdef DBG
     v_disp_matrix(r_k,"r_k = r_k-alpha*Ap_k",n,1);
 #endif
-
-    // rs_next (rs:r square)
-    //double rs_sqrt;
-    VBLAS::vdot(precision, n, r_k,  r_k, rs_next);
     
 #ifdef DBG
     {
@@ -151,14 +155,11 @@ int cg_vp(int precision,
 	VBLAS::vcopy(n, x_k,  x);
 	break;
       }
-      // p_k = p_k * (rs_next/rs)
+      // p_k = r_k + p_k * (rs_next/rs)
       // reutilisons rs pour beta
-      beta= rs_next/rs;
+      beta= vpexpr(rs_next)/rs;
       
-      VBLAS::vscal(precision, n, beta, p_k);
-
-      // p_k = p_k + r_k
-      VBLAS::vaxpy(precision, n, 1.0 /*CONST_1*/, r_k,  p_k);
+      VBLAS::vxpay(precision, n, r_k, beta, p_k);
 
       // rs = rs_next
       rs = rs_next;
@@ -170,3 +171,175 @@ int cg_vp(int precision,
   return (nbiter + 1);
 }
 
+/*
+ * ----------------------------------
+ * ----adaptive precision CG --------
+ *
+ * The solve starts at initial_precision and doubles the working precision, up to precision, when the current one
+ * is not enough. Every CG_ADAPTIVE_CHECK_INTERVAL iterations, and when the recursive residual r_k reaches the
+ * tolerance, the true residual b - A x_k is computed and the precision is raised when:
+ *  - r_k reached the tolerance but b - A x_k did not;
+ *  - the gap ||b - A x_k - r_k|| exceeds CG_ADAPTIVE_GAP_RATIO ||r_k||: r_k lost its accuracy;
+ *  - ||b - A x_k|| did not decrease for CG_ADAPTIVE_STAGNATION_CHECKS checks.
+ * x_k is then copied at the new precision, r_k is replaced by b - A x_k and CG restarts from p_k = r_k: the
+ * directions of the previous precision are not conjugate any more. Each check logs a
+ * "precision : <bits> - iter : <iteration>" trace line.
+ */
+#define CG_ADAPTIVE_CHECK_INTERVAL 10
+#define CG_ADAPTIVE_GAP_RATIO 0.1
+#define CG_ADAPTIVE_STAGNATION_CHECKS 3
+
+/* r = b - op(A) x */
+static void computeResidual(int precision, int transpose, int n, matrix_t A, VPFloatArray & x, VPFloatArray & b, VPFloatArray & r, VPFloat & one)
+{
+  VBLAS::vcopy(n, b, r);
+  VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y', n, n, -1.0, A, x, one, r);
+}
+
+/* Copy of an array at another bis */
+static void changeArrayPrecision(VPFloatArray & a, int n, uint16_t exponent_size, short bis, int32_t stride_size)
+{
+  VPFloatArray l_resized(exponent_size, bis, stride_size, n);
+
+  VBLAS::vcopy(n, a, l_resized);
+  a = std::move(l_resized);
+}
+
+int cg_adaptive_vp(int precision,
+    int initial_precision,
+    int transpose,
+    int n,
+    VPFloatArray & x,  // valeur de sortie
+    matrix_t A,
+    VPFloatArray & b,
+    double tolerance,
+    uint16_t exponent_size,
+    int32_t stride_size)
+{
+  if ( ( initial_precision < 1 ) || ( initial_precision > precision ) ) {
+    std::cout << __FUNCTION__ << " : invalid initial precision " << initial_precision << " (precision " << precision << ")." << std::endl;
+    return -1;
+  }
+
+  VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
+  int l_precision = initial_precision;
+  short myBis = l_precision + exponent_size + 1;
+  int nbiter = 0;
+  bool l_converged = false;
+  double l_best_true_norm = HUGE_VAL;
+  int l_nb_stagnating_checks = 0;
+
+  VPFloatComputingEnvironment::set_precision(myBis);
+  VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
+
+  VPFloatArray x_k(exponent_size, myBis, stride_size, n );
+
+  /* x_k = {0} */
+  VBLAS::vzero(l_precision, n, x_k);
+
+  // One pass per working precision
+  while ( ( nbiter < n*ITER_MAX ) && ! l_converged ) {
+    VPFloatComputingEnvironment::set_precision(myBis);
+    VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
+
+    VPFloatArray r_k(exponent_size, myBis, stride_size, n );
+    VPFloatArray p_k(exponent_size, myBis, stride_size, n );
+    VPFloatArray Ap_k(exponent_size, myBis, stride_size, n );
+    VPFloatArray r_true(exponent_size, myBis, stride_size, n );
+    VPFloat      alpha   (exponent_size, myBis, stride_size );
+    VPFloat      minus_alpha (exponent_size, myBis, stride_size );
+    VPFloat      beta    (exponent_size, myBis, stride_size );
+    VPFloat      rs      (exponent_size, myBis, stride_size );
+    VPFloat      rs_next (exponent_size, myBis, stride_size );
+    VPFloat      norm    (exponent_size, myBis, stride_size );
+    VPFloat      one     (exponent_size, myBis, stride_size );
+    VPFloat      minus_one (exponent_size, myBis, stride_size );
+    bool l_raise = false;
+
+    one = 1.0;
+    minus_one = -1.0;
+
+    // Residual replacement: r_k <- b - A x_k, p_k <- r_k
+    computeResidual(l_precision, transpose, n, A, x_k, b, r_k, one);
+    VBLAS::vcopy(n, r_k, p_k);
+    VBLAS::vdot(l_precision, n, r_k, r_k, rs, l_dot_mode);
+    rs_next = rs;
+
+    for (; nbiter < n*ITER_MAX; ++nbiter) {
+      std::cout << "residus : " <<  double(rs_next) << " - iter : " << nbiter << std::endl;
+
+      // Ap_k = A * p_k
+      VBLAS::vgemvd(l_precision, transpose == 0 ? 'N' : 'Y', n, n, 1.0, A, p_k, 0.0, Ap_k);
+
+      // alpha = rs / (p_k' * Ap_k)
+      VBLAS::vdot(l_precision, n, p_k, Ap_k, alpha, l_dot_mode);
+      alpha = vpexpr(rs)/alpha;
+
+      // x_k = x_k + alpha*p_k, r_k = r_k - alpha * Ap_k, rs_next = r_k' * r_k
+      VBLAS::vaxpy(l_precision, n, alpha, p_k, x_k);
+      VPFloatOperation::neg(minus_alpha, alpha);
+      VBLAS::vaxpy_dot(l_precision, n, minus_alpha, Ap_k, r_k, rs_next, l_dot_mode);
+
+      bool l_claimed = (double)rs_next < (tolerance*tolerance);
+
+      if ( l_claimed || ( ( nbiter + 1 ) % CG_ADAPTIVE_CHECK_INTERVAL ) == 0 ) {
+        double l_recursive_norm = sqrt((double)rs_next);
+
+        computeResidual(l_precision, transpose, n, A, x_k, b, r_true, one);
+        VBLAS::vnrm2(l_precision, n, r_true, norm, l_dot_mode);
+        double l_true_norm = double(norm);
+
+        // r_true <- (b - A x_k) - r_k
+        VBLAS::vaxpy(l_precision, n, minus_one, r_k, r_true);
+        VBLAS::vnrm2(l_precision, n, r_true, norm, l_dot_mode);
+        double l_gap = double(norm);
+
+        std::cout << "precision : " << l_precision << " - iter : " << nbiter << " - true residual : " << l_true_norm << " - gap : " << l_gap << std::endl;
+
+        if ( l_true_norm < tolerance ) {
+          l_converged = true;
+          break;
+        }
+
+        if ( l_true_norm < l_best_true_norm ) {
+          l_best_true_norm = l_true_norm;
+          l_nb_stagnating_checks = 0;
+        } else {
+          l_nb_stagnating_checks++;
+        }
+
+        bool l_lost_accuracy = l_claimed || ( l_gap > CG_ADAPTIVE_GAP_RATIO * l_recursive_norm ) || ( l_nb_stagnating_checks >= CG_ADAPTIVE_STAGNATION_CHECKS );
+
+        // At the highest precision, a wrong convergence only replaces the residual
+        if ( l_lost_accuracy && ( ( l_precision < precision ) || l_claimed ) ) {
+          l_raise = ( l_precision < precision );
+          ++nbiter;
+          break;
+        }
+      }
+
+      // p_k = r_k + p_k * (rs_next/rs)
+      beta = vpexpr(rs_next)/rs;
+      VBLAS::vxpay(l_precision, n, r_k, beta, p_k);
+      rs = rs_next;
+    }
+
+    if ( l_raise ) {
+      l_precision = std::min(2 * l_precision, precision);
+      myBis = l_precision + exponent_size + 1;
+      l_best_true_norm = HUGE_VAL;
+      l_nb_stagnating_checks = 0;
+
+      changeArrayPrecision(x_k, n, exponent_size, myBis, stride_size);
+    }
+  }
+
+  if ( ! l_converged ) {
+    // ca n'a pas converge
+    return -1;
+  }
+
+  VBLAS::vcopy(n, x_k, x);
+
+  return (nbiter + 1);
+}
@@ -28,5 +28,6 @@
 using namespace VPFloatPackage;
 
 int cg_vp(int precision, int transpose, int n, VPFloatArray & x, matrix_t A, VPFloatArray & b, double tolerance, uint16_t exponent_size, int32_t stride_size);
+int cg_adaptive_vp(int precision, int initial_precision, int transpose, int n, VPFloatArray & x, matrix_t A, VPFloatArray & b, double tolerance, uint16_t exponent_size, int32_t stride_size);
 
 #endif /*  __CG_KERNEL_HPP__ */
\ No newline at end of file
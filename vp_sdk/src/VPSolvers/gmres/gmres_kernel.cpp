@@ -0,0 +1,213 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+* 
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* 
+*     http://www.apache.org/licenses/LICENSE-2.0
+* 
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Restarted GMRES (Saad, "Iterative Methods for Sparse Linear Systems", algorithms 6.9 and 9.6).
+ *
+ *                 The Arnoldi basis v_0 .. v_m is stored as a single block of contiguous vectors. Each new vector
+ *                 is orthogonalized with classical Gram-Schmidt, done with the vdot_block and vaxpy_block kernels:
+ *                 one reduction and one update sweep per pass instead of one per basis vector. A second pass
+ *                 (reorthogonalization) is made when the first one cancels most of the vector, i.e. when its norm
+ *                 drops below GMRES_REORTHOGONALIZATION_RATIO times the norm before the pass (Daniel, Gragg, Kaufman
+ *                 and Stewart criterion).
+ *
+ *                 The least squares problem min ||beta e_1 - H y|| is solved with Givens rotations, which give the
+ *                 residual norm at each iteration. With a preconditioner, the preconditioned vectors z_j are kept
+ *                 (flexible GMRES) and the solution is updated with them.
+ **/
+
+#include <math.h>
+#include "gmres_kernel.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSDK/VPFloatExpression.hpp"
+#include "VPSDK/VMath.hpp" // for vsqrt
+
+// package de support VPFloat
+using namespace VPFloatPackage;
+
+// ITER_MAX: on abandonne après n*ITER_MAX iterations
+#define ITER_MAX 5
+
+#define GMRES_REORTHOGONALIZATION_RATIO 0.7071067811865476
+
+int gmres_vp(int precision,
+    int transpose,
+    int n,
+    VPFloatArray & x,  // valeur de sortie
+    matrix_t A,
+    matrix_t iM,
+    VPFloatArray & b,
+    double tolerance,
+    int restart,
+    uint16_t exponent_size,
+    int32_t stride_size)
+{
+  if ( restart < 1 ) {
+    std::cout << __FUNCTION__ << " : invalid restart " << restart << "." << std::endl;
+    return -1;
+  }
+
+  short myBis = precision + exponent_size + 1;
+  VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
+  char l_trans = transpose == 0 ? 'N' : 'Y';
+  int m = ( restart < n ) ? restart : n;  // the Krylov space can not grow beyond n vectors
+  int nbiter = 0;
+  bool l_converged = false;
+
+  VPFloatComputingEnvironment::set_precision(myBis);
+  VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
+
+  VPFloatArray x_k(exponent_size, myBis, stride_size, n );
+  VPFloatArray w_k(exponent_size, myBis, stride_size, n );
+  VPFloatArray V(exponent_size, myBis, stride_size, (m + 1) * n );                  // Arnoldi basis
+  VPFloatArray Z(exponent_size, myBis, stride_size, ( iM != NULL ) ? m * n : 0 );   // preconditioned basis (FGMRES)
+  VPFloatArray H(exponent_size, myBis, stride_size, (m + 1) * m );                  // Hessenberg matrix, by columns
+  VPFloatArray h_correction(exponent_size, myBis, stride_size, m + 1 );
+  VPFloatArray minus_h(exponent_size, myBis, stride_size, m + 1 );
+  VPFloatArray cs(exponent_size, myBis, stride_size, m );                           // Givens rotations
+  VPFloatArray sn(exponent_size, myBis, stride_size, m );
+  VPFloatArray g(exponent_size, myBis, stride_size, m + 1 );                        // rotated beta e_1
+  VPFloatArray y(exponent_size, myBis, stride_size, m );
+  VPFloat      one     (exponent_size, myBis, stride_size );
+  VPFloat      beta    (exponent_size, myBis, stride_size );
+  VPFloat      norm    (exponent_size, myBis, stride_size );
+  VPFloat      previous_norm(exponent_size, myBis, stride_size );
+  VPFloat      tmp     (exponent_size, myBis, stride_size );
+
+  one = 1.0;
+
+  /* x_k = {0} */
+  VBLAS::vzero(precision, n, x_k);
+
+  while ( nbiter < n*ITER_MAX ) {
+    // w_k = b - A x_k, beta = ||w_k||
+    VBLAS::vcopy(n, b, w_k);
+    VBLAS::vgemvd(precision, l_trans, n, n, -1.0, A, x_k, one, w_k);
+    VBLAS::vnrm2(precision, n, w_k, beta, l_dot_mode);
+
+    std::cout << "residus : " <<  double(beta) * double(beta) << " - iter : " << nbiter << std::endl;
+
+    if ( double(beta) < tolerance ) {
+      l_converged = true;
+      break;
+    }
+
+    // v_0 = w_k / beta, g = beta e_1
+    VPFloatArray v_0(V, 0, n);
+    tmp = vpexpr(one)/beta;
+    VBLAS::vzero(precision, n, v_0);
+    VBLAS::vaxpy(precision, n, tmp, w_k, v_0);
+    VBLAS::vzero(precision, m + 1, g);
+    g[0] = beta;
+
+    int j;
+
+    for (j = 0; ( j < m ) && ( nbiter < n*ITER_MAX ); j++, nbiter++) {
+      VPFloatArray v_j(V, j * n, n);
+      VPFloatArray v_next(V, (j + 1) * n, n);
+      VPFloatArray h_j(H, j * (m + 1), m + 1);
+
+      // w_k = A v_j, or A z_j with z_j = iM v_j
+      if ( iM != NULL ) {
+        VPFloatArray z_j(Z, j * n, n);
+
+        VBLAS::vgemvd(precision, l_trans, n, n, 1.0, iM, v_j, 0.0, z_j);
+        VBLAS::vgemvd(precision, l_trans, n, n, 1.0, A, z_j, 0.0, w_k);
+      } else {
+        VBLAS::vgemvd(precision, l_trans, n, n, 1.0, A, v_j, 0.0, w_k);
+      }
+
+      // Classical Gram-Schmidt: h_j = V^T w_k, w_k = w_k - V h_j
+      VBLAS::vnrm2(precision, n, w_k, previous_norm, l_dot_mode);
+      VBLAS::vdot_block(precision, n, j + 1, V, w_k, h_j, l_dot_mode);
+      for (int i = 0; i <= j; i++) {
+        minus_h[i] = -vpexpr(h_j[i]);
+      }
+      VBLAS::vaxpy_block(precision, n, j + 1, minus_h, V, w_k);
+      VBLAS::vnrm2(precision, n, w_k, norm, l_dot_mode);
+
+      // Second pass correcting h_j when w_k lost its orthogonality to V
+      if ( double(norm) < GMRES_REORTHOGONALIZATION_RATIO * double(previous_norm) ) {
+        VBLAS::vdot_block(precision, n, j + 1, V, w_k, h_correction, l_dot_mode);
+        for (int i = 0; i <= j; i++) {
+          h_j[i] += h_correction[i];
+          minus_h[i] = -vpexpr(h_correction[i]);
+        }
+        VBLAS::vaxpy_block(precision, n, j + 1, minus_h, V, w_k);
+        VBLAS::vnrm2(precision, n, w_k, norm, l_dot_mode);
+      }
+
+      // h_{j+1,j} = ||w_k||, v_{j+1} = w_k / h_{j+1,j}
+      h_j[j + 1] = norm;
+
+      VBLAS::vzero(precision, n, v_next);
+      if ( double(norm) != 0.0 ) {
+        tmp = vpexpr(one)/norm;
+        VBLAS::vaxpy(precision, n, tmp, w_k, v_next);
+      }
+
+      // Previous rotations applied to h_j
+      for (int i = 0; i < j; i++) {
+        tmp = vpexpr(cs[i])*h_j[i] + vpexpr(sn[i])*h_j[i + 1];
+        h_j[i + 1] = vpexpr(cs[i])*h_j[i + 1] - vpexpr(sn[i])*h_j[i];
+        h_j[i] = tmp;
+      }
+
+      // Rotation cancelling h_{j+1,j}
+      tmp = vpexpr(h_j[j])*h_j[j] + vpexpr(h_j[j + 1])*h_j[j + 1];
+      tmp = VMath::vsqrt(tmp);
+      cs[j] = vpexpr(h_j[j])/tmp;
+      sn[j] = vpexpr(h_j[j + 1])/tmp;
+      h_j[j] = tmp;
+      h_j[j + 1] = 0.0;
+
+      g[j + 1] = -(vpexpr(sn[j])*g[j]);
+      g[j] = vpexpr(cs[j])*g[j];
+
+      // |g_{j+1}| is the residual norm of the iteration
+      std::cout << "residus : " <<  double(g[j + 1]) * double(g[j + 1]) << " - iter : " << nbiter << std::endl;
+
+      if ( ( fabs(double(g[j + 1])) < tolerance ) || ( double(norm) == 0.0 ) ) {
+        j++;
+        nbiter++;
+        break;
+      }
+    }
+
+    // H y = g, H being upper triangular after the rotations
+    for (int i = j - 1; i >= 0; i--) {
+      tmp = g[i];
+      for (int l = i + 1; l < j; l++) {
+        tmp = vpexpr(tmp) - vpexpr(H[l * (m + 1) + i])*y[l];
+      }
+      y[i] = vpexpr(tmp)/H[i * (m + 1) + i];
+    }
+
+    // x_k = x_k + V y, or Z y
+    VBLAS::vaxpy_block(precision, n, j, y, ( iM != NULL ) ? Z : V, x_k);
+  }
+
+  if ( ! l_converged ) {
+    // ca n'a pas converge
+    return -1;
+  }
+
+  VBLAS::vcopy(n, x_k, x);
+
+  return (nbiter + 1);
+}
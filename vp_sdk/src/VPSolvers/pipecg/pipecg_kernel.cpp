@@ -0,0 +1,130 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+* 
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* 
+*     http://www.apache.org/licenses/LICENSE-2.0
+* 
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Pipelined CG (Ghysels and Vanroose, 2014).
+ *
+ *                 CG with a single reduction per iteration: gamma = r'r and delta = r'w, w = A r, are computed in
+ *                 one sweep, and do not depend on the product A w of the same iteration. The vectors
+ *                 s = A p and z = A s are updated by recurrences instead of being computed by products.
+ *
+ *                 The recurrences drift away from the products they replace: the attainable accuracy of the
+ *                 pipelined CG is lower than the one of CG at the same precision. A few more bits of precision
+ *                 recover it.
+ **/
+
+#include "pipecg_kernel.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSDK/VPFloatExpression.hpp"
+
+// package de support VPFloat
+using namespace VPFloatPackage;
+
+// ITER_MAX: on abandonne après n*ITER_MAX iterations
+#define ITER_MAX 5
+
+int pipecg_vp(int precision,
+    int transpose,
+    int n,
+    VPFloatArray & x,  // valeur de sortie
+    matrix_t A,
+    VPFloatArray & b,
+    double tolerance,
+    uint16_t exponent_size,
+    int32_t stride_size)
+{
+  short myBis = precision + exponent_size + 1;
+  VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
+  char l_trans = transpose == 0 ? 'N' : 'Y';
+  int nbiter;
+
+  VPFloatComputingEnvironment::set_precision(myBis);
+  VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
+
+  VPFloatArray x_k(exponent_size, myBis, stride_size, n );
+  VPFloatArray r_k(exponent_size, myBis, stride_size, n );
+  VPFloatArray p_k(exponent_size, myBis, stride_size, n );
+  VPFloatArray s_k(exponent_size, myBis, stride_size, n );    // A p_k
+  VPFloatArray w_k(exponent_size, myBis, stride_size, n );    // A r_k
+  VPFloatArray z_k(exponent_size, myBis, stride_size, n );    // A s_k
+  VPFloatArray Aw_k(exponent_size, myBis, stride_size, n );
+  VPFloat      alpha   (exponent_size, myBis, stride_size );
+  VPFloat      alpha_denom (exponent_size, myBis, stride_size );
+  VPFloat      minus_alpha (exponent_size, myBis, stride_size );
+  VPFloat      beta    (exponent_size, myBis, stride_size );
+  VPFloat      gamma   (exponent_size, myBis, stride_size );
+  VPFloat      gamma_previous (exponent_size, myBis, stride_size );
+  VPFloat      delta   (exponent_size, myBis, stride_size );
+
+  /* x_k = {0}, r_k <- b, w_k = A r_k */
+  VBLAS::vzero(precision, n, x_k);
+  VBLAS::vcopy(n, b, r_k);
+  VBLAS::vgemvd(precision, l_trans, n, n, 1.0, A, r_k, 0.0, w_k);
+
+  /* The first iteration has beta = 0: p_k, s_k and z_k are only scaled by 0 */
+  VBLAS::vzero(precision, n, p_k);
+  VBLAS::vzero(precision, n, s_k);
+  VBLAS::vzero(precision, n, z_k);
+  beta = 0.0;
+
+  for (nbiter = 0; nbiter < n*ITER_MAX; ++nbiter) {
+    // gamma = r_k' * r_k, delta = r_k' * w_k: the single reduction of the iteration
+    VBLAS::vdot2(precision, n, r_k, r_k, w_k, gamma, delta, l_dot_mode);
+
+    std::cout << "residus : " <<  double(gamma) << " - iter : " << nbiter << std::endl;
+
+    if ((double)gamma < (tolerance*tolerance)) {
+      VBLAS::vcopy(n, x_k, x);
+      break;
+    }
+
+    // Aw_k = A * w_k, independent of the reduction
+    VBLAS::vgemvd(precision, l_trans, n, n, 1.0, A, w_k, 0.0, Aw_k);
+
+    if ( nbiter == 0 ) {
+      // alpha = gamma / delta
+      alpha = vpexpr(gamma)/delta;
+    } else {
+      // beta = gamma / gamma_previous, alpha = gamma / (delta - beta * gamma / alpha)
+      beta = vpexpr(gamma)/gamma_previous;
+      alpha_denom = vpexpr(beta)*gamma;
+      alpha_denom = vpexpr(alpha_denom)/alpha;
+      alpha_denom = vpexpr(delta) - alpha_denom;
+      alpha = vpexpr(gamma)/alpha_denom;
+    }
+
+    // z_k = Aw_k + beta * z_k, s_k = w_k + beta * s_k, p_k = r_k + beta * p_k
+    VBLAS::vxpay(precision, n, Aw_k, beta, z_k);
+    VBLAS::vxpay(precision, n, w_k, beta, s_k);
+    VBLAS::vxpay(precision, n, r_k, beta, p_k);
+
+    // x_k = x_k + alpha * p_k, r_k = r_k - alpha * s_k, w_k = w_k - alpha * z_k
+    VPFloatOperation::neg(minus_alpha, alpha);
+    VBLAS::vaxpy(precision, n, alpha, p_k, x_k);
+    VBLAS::vaxpy(precision, n, minus_alpha, s_k, r_k);
+    VBLAS::vaxpy(precision, n, minus_alpha, z_k, w_k);
+
+    gamma_previous = gamma;
+  }
+
+  if (nbiter==(n*ITER_MAX))
+    // ca n'a pas converge
+    nbiter=-2;
+
+  return (nbiter + 1);
+}
@@ -21,6 +21,8 @@
 
 #include "precond_bicg_kernel.hpp"
 #include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSDK/VPFloatExpression.hpp"
 
 using namespace VPFloatPackage;
 /*
@@ -41,7 +43,7 @@ int precond_bicg_vp(int precision,
                     int n,
                     VPFloatArray &x, // valeur de sortie et d'entree
                     matrix_t A,
-                    matrix_t At, // petite arnaque en attendant le support vgemv
+                    matrix_t At, // transposee de A, ou NULL pour utiliser le produit transpose sur A
                     matrix_t iM,
                     VPFloatArray b,
                     double tolerance,
@@ -49,8 +51,13 @@ int precond_bicg_vp(int precision,
                     int32_t stride_size)
 {
   short myBis = precision + exponent_size + 1;
+  VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
   int nbiter;
 
+  // sans At, A^T est applique par un produit transpose sur A
+  matrix_t l_At = ( At != NULL ) ? At : A;
+  char l_At_trans = ( ( At != NULL ) == ( transpose == 0 ) ) ? 'N' : 'Y';
+
   VPFloatComputingEnvironment::set_precision(precision);
   VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
 
@@ -64,6 +71,7 @@ int precond_bicg_vp(int precision,
   VPFloatArray Atpstar_k(exponent_size, myBis, stride_size, n);
   VPFloatArray x_k(exponent_size, myBis, stride_size, n);
   VPFloat alpha(exponent_size, myBis, stride_size);
+  VPFloat minus_alpha(exponent_size, myBis, stride_size);
   VPFloat alpha_denom(exponent_size, myBis, stride_size);
   VPFloat beta(exponent_size, myBis, stride_size);
   VPFloat rs(exponent_size, myBis, stride_size);
@@ -106,7 +114,7 @@ int precond_bicg_vp(int precision,
 
   rs_next = 0.0;
   // rxrstar = rk'*rstark
-  VBLAS::vdot(precision, n, z_k, rstar_k, rxrstar);
+  VBLAS::vdot(precision, n, z_k, rstar_k, rxrstar, l_dot_mode);
 
   for (nbiter = 0; nbiter < n * ITER_MAX; ++nbiter)
   {
@@ -121,10 +129,10 @@ int precond_bicg_vp(int precision,
                   Ap_k /*Y*/);
 
     // alphadenom = pstar_k' * Ap_k
-    VBLAS::vdot(precision, n, pstar_k, Ap_k, alpha_denom);
+    VBLAS::vdot(precision, n, pstar_k, Ap_k, alpha_denom, l_dot_mode);
 
     // alpha = rs/alphadenom
-    alpha = rxrstar / alpha_denom;
+    alpha = vpexpr(rxrstar) / alpha_denom;
 #ifdef DBG
     std::cout << "iter " << nbiter << "alpha=" << (double)alpha << "\n";
 #endif
@@ -133,7 +141,9 @@ int precond_bicg_vp(int precision,
     VBLAS::vaxpy(precision, n, alpha, p_k, x_k);
 
     // r_k = r_k - alpha * Ap_k
-    VBLAS::vaxpy(precision, n, -alpha, Ap_k, r_k);
+    // rs_next (rs:r square), computed in the same sweep
+    VPFloatOperation::neg(minus_alpha, alpha);
+    VBLAS::vaxpy_dot(precision, n, minus_alpha, Ap_k, r_k, rs_next, l_dot_mode);
 
     /* z_k=iM * r_k */
     VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y',
@@ -145,10 +155,6 @@ int precond_bicg_vp(int precision,
                   0.0, // CONST_0 /*beta*/,
                   z_k /*Y*/);
 
-    // rs_next (rs:r square)
-    // double rs_sqrt;
-    VBLAS::vdot(precision, n, r_k, r_k, rs_next);
-
 #ifdef DBG
     {
       printf("\t(debug) rs_next = %f\n", (double)rs_next);
@@ -167,13 +173,13 @@ int precond_bicg_vp(int precision,
     }
     // rstar_k=rstar_k - alpha_k A^T pstar_k
     // en 2 etapes
-    VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y', n, n, 1.0, // CONST_1, //alpha
-                  At, pstar_k,                                           // x
+    VBLAS::vgemvd(precision, l_At_trans, n, n, 1.0, // CONST_1, //alpha
+                  l_At, pstar_k,                                           // x
                   0.0,                                              // CONST_0 /*beta*/,
                   Atpstar_k /*Y*/);
 
     // r_k = r_k - alpha * Ap_k
-    VBLAS::vaxpy(precision, n, -alpha, Atpstar_k, rstar_k);
+    VBLAS::vaxpy(precision, n, minus_alpha, Atpstar_k, rstar_k);
 
     VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y',
                   n,   // m
@@ -186,18 +192,15 @@ int precond_bicg_vp(int precision,
 
     // reutilisons rs pour beta
     // rxrstar_next = rk'*rstark
-    VBLAS::vdot(precision, n, z_k, rstar_k, rxrstar_next);
-
-    beta = rxrstar_next / rxrstar;
+    VBLAS::vdot(precision, n, z_k, rstar_k, rxrstar_next, l_dot_mode);
 
-    VBLAS::vscal(precision, n, beta, p_k);
-    // p_k = p_k + r_k
-    VBLAS::vaxpy(precision, n, 1.0 /*CONST_1*/, z_k, p_k);
+    beta = vpexpr(rxrstar_next) / rxrstar;
 
-    VBLAS::vscal(precision, n, beta, pstar_k);
+    // p_k = z_k + beta * p_k
+    VBLAS::vxpay(precision, n, z_k, beta, p_k);
 
-    // pstar_k = p_k + r_k
-    VBLAS::vaxpy(precision, n, 1.0 /*CONST_1*/, zstar_k, pstar_k);
+    // pstar_k = zstar_k + beta * pstar_k
+    VBLAS::vxpay(precision, n, zstar_k, beta, pstar_k);
 
     // rs = rs_next
     rxrstar = rxrstar_next;
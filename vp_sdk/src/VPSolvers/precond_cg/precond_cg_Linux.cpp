@@ -25,7 +25,9 @@
 #include <cstring>
 #include <time.h>
 #include "precond_cg_kernel.hpp"
+#include "../solver_permutation.hpp"
 #include "VRPOffload/vrp_offloading.hpp"
+#include "VPSDK/VBLAS.hpp"
 #include "VPSDK/VBLASConfig.hpp"
 
 using namespace VPFloatPackage::Offloading;
@@ -63,7 +65,13 @@ int precond_cg_with_vrp_offload(int precision, int transpose, int n, double * X,
 
 namespace VPFloatPackage::Solver {
 
-    int precond_cg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t iM, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size) {
+    int precond_cg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t iM, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+        if ( permutation != NULL ) {
+            return solvePermuted(n, x, b, permutation, [&](double * a_x, double * a_b) {
+                return precond_cg(precision, transpose, n, a_x, A, iM, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+            });
+        }
+
         char * l_vrp_offload = getenv(VRP_OFFLAD_ENVIRONMENT_VAR_NAME);
 
         if (l_vrp_offload != NULL && atoi(l_vrp_offload) != 0 ) {
@@ -89,6 +97,8 @@ namespace VPFloatPackage::Solver {
             int l_iteration_count = precond_cg_vp(precision, transpose, n, Xv, A, iM, Bv, tolerance, exponent_size, stride_size);
             clock_gettime(CLOCK_MONOTONIC, &l_timespec_stop);
 
+            copyBackSolution(n, Xv, x);
+
             l_solver_duration = ( ( ( l_timespec_stop.tv_sec - l_timespec_start.tv_sec ) * 1e9 ) + ( l_timespec_stop.tv_nsec - l_timespec_start.tv_nsec ) );
 
             std::cout << "solver duration             : " << l_solver_duration << "ns" << std::endl;
@@ -20,6 +20,7 @@
  **/
 
 #include "precond_cg_kernel.hpp"
+#include "../solver_permutation.hpp"
 #include "VRPSDK/perfcounters/cpu.h"
 #include "VRPSDK/vblas_perfmonitor.h"
 #include "VPSDK/VBLASConfig.hpp"
@@ -27,7 +28,13 @@
 
 namespace VPFloatPackage::Solver {
 
-	int precond_cg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t iM, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size) {
+	int precond_cg(int precision, int transpose, int n, double * x, matrix_t A, matrix_t iM, double * b, double tolerance, uint16_t exponent_size, int32_t stride_size, char * log_buffer, uint64_t log_buffer_size, const int * permutation) {
+		if ( permutation != NULL ) {
+			return solvePermuted(n, x, b, permutation, [&](double * a_x, double * a_b) {
+				return precond_cg(precision, transpose, n, a_x, A, iM, a_b, tolerance, exponent_size, stride_size, log_buffer, log_buffer_size, NULL);
+			});
+		}
+
 			int l_iteration_count;
 			
 			VBLASPERFMONITOR_INITIALIZE;
@@ -25,6 +25,8 @@
  */
 #include "precond_cg_kernel.hpp"
 #include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSDK/VPFloatExpression.hpp"
 #include <cmath>
 
 // package de support VPFloat
@@ -53,6 +55,7 @@ int precond_cg_vp(  int precision,
  */
 {
     short myBis=precision+exponent_size+1;
+    VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
 
     VPFloatComputingEnvironment::set_rounding_mode(VP_RNE);
     VPFloatComputingEnvironment::set_precision(precision);
@@ -66,6 +69,7 @@ int precond_cg_vp(  int precision,
     VPFloatArray Ap_j(exponent_size, myBis, stride_size, n );
     VPFloatArray x_j(exponent_size, myBis, stride_size, n );
     VPFloat      alpha_j (exponent_size, myBis, stride_size );
+    VPFloat      minus_alpha_j (exponent_size, myBis, stride_size );
     VPFloat      beta_j  (exponent_size, myBis, stride_size );
     VPFloat      r_jxz_j (exponent_size, myBis, stride_size );
     VPFloat      r_jxz_jnext (exponent_size, myBis, stride_size );
@@ -96,7 +100,7 @@ int precond_cg_vp(  int precision,
     VBLAS::vzero(precision, n, x_j);
     VBLAS::vzero(precision, n, Ap_j);
     //  rj_next = 0.0;
-    VBLAS::vdot(precision, n, r_j, z_j,  r_jxz_j);
+    VBLAS::vdot(precision, n, r_j, z_j,  r_jxz_j, l_dot_mode);
 
     for (nbiter = 0; nbiter < n*ITER_MAX; ++nbiter) {
         std::cout << "residus : " <<  double(r_jsq) << " - iter : " << nbiter << std::endl;
@@ -117,7 +121,7 @@ int precond_cg_vp(  int precision,
 
         // \alpha_j = (r-j,z_j) / (Ap_j,p_j)
         // d'abord Apjxpj = Ap_j * p_j
-        VBLAS::vdot(precision, n, p_j, Ap_j,  Apjxpj);
+        VBLAS::vdot(precision, n, p_j, Ap_j,  Apjxpj, l_dot_mode);
 
 #ifdef DBG
         std::cout << "iter "<<nbiter<<" |p_j A p_j|="<<(double)alpha<<"\n";
@@ -130,7 +134,7 @@ int precond_cg_vp(  int precision,
         
         // VPFloatComputingEnvironment::set_tempory_var_environment(VPFLOAT_EVP_MAX.es, VPFLOAT_EVP_MAX.bis, VPFLOAT_EVP_MAX.stride);
         // printf("r_jxz_j: %e - Apjxpj:%e\n", double(r_jxz_j), double(Apjxpj));
-        alpha_j = r_jxz_j/Apjxpj;
+        alpha_j = vpexpr(r_jxz_j)/Apjxpj;
         // printf("alpha_j: %e\n", double(alpha_j));
 
         // VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, myBis, 1);
@@ -152,12 +156,12 @@ int precond_cg_vp(  int precision,
         Ap_j.printAsVector("Ap_j:");
 #endif
         
-        VBLAS::vaxpy(precision, n, -alpha_j, Ap_j, r_j);
+        // calcul de r_jsq dans le meme passage
+        VPFloatOperation::neg(minus_alpha_j, alpha_j);
+        VBLAS::vaxpy_dot(precision, n, minus_alpha_j, Ap_j, r_j, r_jsq, l_dot_mode);
 #ifdef DBG
         v_disp_matrix(r_j,"r_j = r_j-alpha*Ap_j",n,1);
 #endif
-        // calcul de r_jsq
-        VBLAS::vdot(precision, n, r_j, r_j,  r_jsq);
 
         // printf("r_jsq: %e\n", double(r_jsq));
 
@@ -182,14 +186,12 @@ int precond_cg_vp(  int precision,
                         z_j  /*Y*/);
         // r_jxz_jnzext
         // r_jxz_j a encore la val precedente
-        VBLAS::vdot(precision, n, r_j, z_j,  r_jxz_jnext);
+        VBLAS::vdot(precision, n, r_j, z_j,  r_jxz_jnext, l_dot_mode);
 
-        beta_j= r_jxz_jnext/r_jxz_j;
+        beta_j= vpexpr(r_jxz_jnext)/r_jxz_j;
 
-        VBLAS::vscal(precision, n, beta_j, p_j);
-
-        // p_j = z_j + r_j
-        VBLAS::vaxpy(precision, n, 1.0 /*CONST_1*/, z_j,  p_j);
+        // p_j = z_j + beta_j * p_j
+        VBLAS::vxpay(precision, n, z_j, beta_j, p_j);
 
         // rs = rs_next
         r_jxz_j = r_jxz_jnext;
@@ -22,7 +22,9 @@
 #include "qmr_kernel.hpp"
 #include "VPSDK/VPFloat.hpp"
 #include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
 #include "VPSDK/VMath.hpp" // for vsqrt
+#include "VPSDK/VPFloatExpression.hpp"
 
 using namespace VPFloatPackage;
 
@@ -40,7 +42,7 @@ int qmr_vp(               // Solves Ax = b where A is a non-symetric square matr
 	int n,                  // size of the matrix 
 	VPFloatArray& x,        // an initial guess for the system Ax = b
 	matrix_t A,             // A
-	matrix_t At,            // Transpose of A
+	matrix_t At,            // Transpose of A, or NULL to apply A^T with transposed products on A
 	VPFloatArray b,         // LHS
 	double tolerance,       // stoping criterion for the method. The method will stop if |r_k|^2 < tolerance^2 
 	uint16_t exponent_size, // size of the exponent of a VPFloat
@@ -49,6 +51,11 @@ int qmr_vp(               // Solves Ax = b where A is a non-symetric square matr
 	//inline void norm(int precision, int n, VPFloatArray vec, VPFloat& res) { VBLAS::vdot(precision, n, vec,  vec, res); res = VMath::vsqrt(res); }
 	
 	short myBis=precision+exponent_size+1;
+	VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
+
+	// Without At, A^T is applied with a transposed product on A
+	matrix_t l_At = ( At != NULL ) ? At : A;
+	char l_At_trans = ( ( At != NULL ) == ( transpose == 0 ) ) ? 'N' : 'Y';
 
   VPFloatComputingEnvironment::set_rounding_mode(VP_RNE);
   VPFloatComputingEnvironment::set_precision(precision);
@@ -78,6 +85,7 @@ int qmr_vp(               // Solves Ax = b where A is a non-symetric square matr
   VPFloat c_k(exponent_size, myBis, stride_size );
   VPFloat mu_k(exponent_size, myBis, stride_size );
   VPFloat lambda_k(exponent_size, myBis, stride_size );
+  VPFloat minus_lambda_k(exponent_size, myBis, stride_size );
   VPFloat sigma_k(exponent_size, myBis, stride_size );
   VPFloat varTheta_k(exponent_size, myBis, stride_size );
   VPFloat eta_k(exponent_size, myBis, stride_size );
@@ -89,9 +97,11 @@ int qmr_vp(               // Solves Ax = b where A is a non-symetric square matr
   VPFloat varTheta_km1(exponent_size, myBis, stride_size );
   
   VPFloat ONE(exponent_size, myBis, stride_size ); ONE = 1;
+  VPFloat MINUS_ONE(exponent_size, myBis, stride_size ); MINUS_ONE = -1;
   VPFloat squaredNorm_rk(exponent_size, myBis, stride_size );
   
   VPFloat squaredNorm_q(exponent_size, myBis, stride_size );
+  VPFloat scale_k(exponent_size, myBis, stride_size ); // scaling factor given to vscal
 
   /* x_k = {0} (choice) */
   VBLAS::vzero(precision, n, x_k);
@@ -103,7 +113,7 @@ int qmr_vp(               // Solves Ax = b where A is a non-symetric square matr
   VBLAS::vcopy(n, r_k, tilde_w_k);
   /* beta_1  <- |tilde_v_0| */
   /* gamma_1 <- |tilde_w_0| = |tilde_v_0| = beta_1 */
-  VBLAS::vdot(precision, n, tilde_v_k, tilde_v_k, beta_k); beta_k = VMath::vsqrt(beta_k);
+  VBLAS::vdot(precision, n, tilde_v_k, tilde_v_k, beta_k, l_dot_mode); beta_k = VMath::vsqrt(beta_k);
   gamma_k = beta_k;
   /* p_0 <- q_0 <- d_0 <- s_0 <- {0} for the first iteration*/
   VBLAS::vzero(precision, n, p_k);
@@ -117,12 +127,12 @@ int qmr_vp(               // Solves Ax = b where A is a non-symetric square matr
   mu_k = 1;
   varTheta_k = 0;
   eta_k = -1;
+  VBLAS::vdot(precision, n, r_k,  r_k, squaredNorm_rk, l_dot_mode);
   
   for (nbiter = 0; nbiter < n*ITER_MAX; ++nbiter) {
 		c_km1 = c_k;
 		varTheta_km1 = varTheta_k;
 
-		VBLAS::vdot(precision, n, r_k,  r_k, squaredNorm_rk);
 		std::cout << "residus : " <<  double(squaredNorm_rk) << " - iter : " << nbiter << std::endl;
 		if ((double)squaredNorm_rk < (tolerance*tolerance)) { VBLAS::vcopy(n, x_k,  x); break; }
 		/* =========================== */
@@ -130,53 +140,54 @@ int qmr_vp(               // Solves Ax = b where A is a non-symetric square matr
 		/* =========================== */
 		VBLAS::vcopy(n, tilde_v_k, v_k);
 		VBLAS::vcopy(n, tilde_w_k, w_k);
-		VBLAS::vscal(precision, n, ONE / beta_k, v_k);
-		VBLAS::vscal(precision, n, ONE / gamma_k, w_k);
+		scale_k = vpexpr(ONE) / beta_k;
+		VBLAS::vscal(precision, n, scale_k, v_k);
+		scale_k = vpexpr(ONE) / gamma_k;
+		VBLAS::vscal(precision, n, scale_k, w_k);
 		/* sigma_k <- (w_k, v_k) */
-		VBLAS::vdot(precision, n, w_k, v_k, sigma_k);
+		VBLAS::vdot(precision, n, w_k, v_k, sigma_k, l_dot_mode);
 
 		/* p_k <- v_k - p_{k-1}*(gamma_k*sigma_k / mu_{k-1}) */
-		VBLAS::vscal(precision, n, -(gamma_k*sigma_k / mu_k), p_k); // here mu_k hasn't been updated yet, mu_k thus contains the value of mu_{k-1}
-		VBLAS::vaxpy(precision, n, ONE, v_k, p_k);
+		scale_k = -(vpexpr(gamma_k)*sigma_k / mu_k);
+		VBLAS::vxpay(precision, n, v_k, scale_k, p_k); // here mu_k hasn't been updated yet, mu_k thus contains the value of mu_{k-1}
 		/* q_k <- w_k - q_{k-1}*(beta_k*sigma_k / mu_{k-1})  */
-		VBLAS::vscal(precision, n, -(beta_k*sigma_k / mu_k), q_k); // here mu_k hasn't been updated yet, mu_k thus contains the value of mu_{k-1}
-		VBLAS::vaxpy(precision, n, ONE, w_k, q_k);
+		scale_k = -(vpexpr(beta_k)*sigma_k / mu_k);
+		VBLAS::vxpay(precision, n, w_k, scale_k, q_k); // here mu_k hasn't been updated yet, mu_k thus contains the value of mu_{k-1}
 		/* Compute Ap_k and At q_k */
 		VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y', n, n, ONE, A, p_k, 0.0, Ap_k);
-		VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'Y', n, n, ONE, At, q_k, 0.0, Atq_k);
+		VBLAS::vgemvd(precision, l_At_trans, n, n, ONE, l_At, q_k, 0.0, Atq_k);
 		/* mu_k <- (q_k, Ap_k) */
-		VBLAS::vdot(precision, n, q_k, Ap_k, mu_k);
+		VBLAS::vdot(precision, n, q_k, Ap_k, mu_k, l_dot_mode);
 		/* lambda_k <- mu_k / sigma_k */
 		lambda_k = mu_k / sigma_k;
 
 		/* tilde_v_{k+1} <- Ap_k - lambda_k v_k */
+		/* beta_{k+1} <- \| tilde_v_{k+1} \| */
+		VPFloatOperation::neg(minus_lambda_k, lambda_k);
 		VBLAS::vcopy(n, Ap_k, tilde_v_k);
-		VBLAS::vaxpy(precision, n, -lambda_k, v_k, tilde_v_k);
+		VBLAS::vaxpy_dot(precision, n, minus_lambda_k, v_k, tilde_v_k, beta_kp1, l_dot_mode); beta_kp1 = VMath::vsqrt(beta_kp1);
 		/* tilde_w_{k+1} <- At q_k - lambda_k w_k */
-		VBLAS::vcopy(n, Atq_k, tilde_w_k);
-		VBLAS::vaxpy(precision, n, -lambda_k, w_k, tilde_w_k);
-		/* beta_{k+1} <- \| tilde_v_{k+1} \| */
 		/* gamma_{k+1} <- \| tilde_w_{k+1} \| */
-		VBLAS::vdot(precision, n, tilde_v_k, tilde_v_k, beta_kp1); beta_kp1 = VMath::vsqrt(beta_kp1);
-		VBLAS::vdot(precision, n, tilde_w_k, tilde_w_k, gamma_kp1); gamma_kp1 = VMath::vsqrt(gamma_kp1);
+		VBLAS::vcopy(n, Atq_k, tilde_w_k);
+		VBLAS::vaxpy_dot(precision, n, minus_lambda_k, w_k, tilde_w_k, gamma_kp1, l_dot_mode); gamma_kp1 = VMath::vsqrt(gamma_kp1);
 
 		/* ====================== */
 		/* Quasi minimal residual */
 		/* ====================== */
-		varTheta_k = beta_kp1 / (c_km1*VPFloatPackage::abs(lambda_k));
+		varTheta_k = vpexpr(beta_kp1) / (vpexpr(c_km1)*VPFloatPackage::abs(lambda_k));
 
-		c_k = ONE / VMath::vsqrt(ONE + varTheta_k*varTheta_k);
-		eta_k *= -((beta_k*c_k*c_k) / (lambda_k*c_km1*c_km1));
+		c_k = vpexpr(varTheta_k)*varTheta_k + ONE;
+		c_k = vpexpr(ONE) / VMath::vsqrt(c_k);
+		eta_k = -((vpexpr(beta_k)*c_k*c_k) / (vpexpr(lambda_k)*c_km1*c_km1)) * eta_k;
 		/* d_k <- eta_k p_k + (varTheta_{k-1}*c_k)^2 d_{k-1} */
-		VBLAS::vscal(precision, n, (varTheta_km1*c_k)*(varTheta_km1*c_k), d_k);
-		VBLAS::vaxpy(precision, n, eta_k, p_k, d_k);
+		scale_k = (vpexpr(varTheta_km1)*c_k)*(vpexpr(varTheta_km1)*c_k);
+		VBLAS::vaxpby(precision, n, eta_k, p_k, scale_k, d_k);
 		/* s_k <- eta_k Ap_k + (varTheta_{k-1}*c_k)^2 s_{k-1} */
-		VBLAS::vscal(precision, n, (varTheta_km1*c_k)*(varTheta_km1*c_k), s_k);
-		VBLAS::vaxpy(precision, n, eta_k, Ap_k, s_k);
+		VBLAS::vaxpby(precision, n, eta_k, Ap_k, scale_k, s_k);
 		/* x_{k} <- x_{k-1} + d_k */
-		/* r_{k} <- r_{k-1} - s_k */
-		VBLAS::vaxpy(precision, n,  ONE, d_k, x_k);
-		VBLAS::vaxpy(precision, n, -ONE, s_k, r_k);
+		/* r_{k} <- r_{k-1} - s_k, squared norm for the next iteration */
+		VBLAS::vaxpy(precision, n, ONE, d_k, x_k);
+		VBLAS::vaxpy_dot(precision, n, MINUS_ONE, s_k, r_k, squaredNorm_rk, l_dot_mode);
 
 		/* ======================== */
 		/* Setup for next iteration */
@@ -0,0 +1,164 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Mixed precision iterative refinement: the corrections are solved at a low precision, the
+ *                 residuals and the solution are computed at the high precision.
+ **/
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <math.h>
+#include "VPSolvers.hpp"
+#include "../solver_permutation.hpp"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+
+using namespace VPFloatPackage;
+
+namespace VPFloatPackage::Solver {
+
+    /*
+     * Solves op(A) d = r at the inner precision, d being zero on input.
+     */
+    static int solveCorrection(refinement_solver_e a_inner_solver, int a_inner_precision, int transpose, int n, double * a_d, matrix_t A, matrix_t At, double * a_r, double a_inner_tolerance, uint16_t exponent_size, int32_t stride_size) {
+        switch ( a_inner_solver ) {
+            case REFINEMENT_CG:
+                return cg(a_inner_precision, transpose, n, a_d, A, a_r, a_inner_tolerance, exponent_size, stride_size);
+            case REFINEMENT_BICGSTAB:
+                return bicgstab(a_inner_precision, transpose, n, a_d, A, At, a_r, a_inner_tolerance, exponent_size, stride_size);
+            case REFINEMENT_QMR:
+                return qmr(a_inner_precision, transpose, n, a_d, A, At, a_r, a_inner_tolerance, exponent_size, stride_size);
+            default:
+                std::cout << __FUNCTION__ << " : unknown inner solver " << a_inner_solver << std::endl;
+                return -1;
+        }
+    }
+
+    int refine(refinement_solver_e inner_solver, int precision, int inner_precision, int transpose, int n, double * x, matrix_t A, matrix_t At, double * b, double tolerance, double inner_tolerance, int max_refinements, uint16_t exponent_size, int32_t stride_size, const int * permutation) {
+        if ( permutation != NULL ) {
+            return solvePermuted(n, x, b, permutation, [&](double * a_x, double * a_b) {
+                return refine(inner_solver, precision, inner_precision, transpose, n, a_x, A, At, a_b, tolerance, inner_tolerance, max_refinements, exponent_size, stride_size, NULL);
+            });
+        }
+
+        short l_bis = precision + exponent_size + 1;
+        VBLAS::VBLASDotMode l_dot_mode = VBLAS::VBLAS_getDotMode();
+
+        VPFloatArray l_x(exponent_size, l_bis, stride_size, n);
+        VPFloatArray l_best_x(exponent_size, l_bis, stride_size, n);
+        VPFloatArray l_b(exponent_size, l_bis, stride_size, n);
+        VPFloatArray l_r(exponent_size, l_bis, stride_size, n);
+        VPFloatArray l_d(exponent_size, l_bis, stride_size, n);
+        VPFloat l_one(exponent_size, l_bis, stride_size);
+        VPFloat l_norm(exponent_size, l_bis, stride_size);
+        VPFloat l_scale(exponent_size, l_bis, stride_size);
+
+        double * l_residual = (double *)malloc(sizeof(double) * n);
+        double * l_correction = (double *)malloc(sizeof(double) * n);
+
+        if ( l_residual == NULL || l_correction == NULL ) {
+            std::cout << __FUNCTION__ << " : fail allocating memory for the inner solver vectors." << std::endl;
+            free(l_residual);
+            free(l_correction);
+            return -1;
+        }
+
+        VPFloatComputingEnvironment::set_precision(l_bis);
+        VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, l_bis, 1);
+
+        // x holds the initial guess
+        VBLAS::vcopy_d_v(n, b, l_b);
+        VBLAS::vcopy_d_v(n, x, l_x);
+        VBLAS::vcopy(n, l_x, l_best_x);
+        l_one = 1.0;
+
+        int l_nb_inner_iterations = 0;
+        bool l_converged = false;
+        double l_previous_residual_norm = HUGE_VAL;
+
+        for ( int l_refinement = 0; l_refinement <= max_refinements; l_refinement++ ) {
+            // The inner solver changes the computing environment
+            VPFloatComputingEnvironment::set_precision(l_bis);
+            VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, l_bis, 1);
+
+            // r = b - op(A) x
+            VBLAS::vcopy(n, l_b, l_r);
+            VBLAS::vgemvd(precision, transpose == 0 ? 'N' : 'T', n, n, -1.0, A, l_x, l_one, l_r);
+            VBLAS::vnrm2(precision, n, l_r, l_norm, l_dot_mode);
+
+            double l_residual_norm = double(l_norm);
+
+            std::cout << "refinement residual : " << l_residual_norm << " - refinement : " << l_refinement << " - inner iterations : " << l_nb_inner_iterations << std::endl;
+
+            if ( l_residual_norm < tolerance ) {
+                l_converged = true;
+                break;
+            }
+
+            // Stagnation: the last correction did not reduce the residual, the solution before it is kept
+            if ( ! ( l_residual_norm < l_previous_residual_norm ) ) {
+                VBLAS::vcopy(n, l_best_x, l_x);
+                break;
+            }
+
+            if ( l_refinement == max_refinements ) {
+                break;
+            }
+            l_previous_residual_norm = l_residual_norm;
+            VBLAS::vcopy(n, l_x, l_best_x);
+
+            /*
+             * The correction system is scaled by a power of 2 to a right hand side of norm in [0.5, 1[: the inner
+             * tolerance is relative to the residual and the scaling is exact.
+             */
+            int l_exponent;
+
+            frexp(l_residual_norm, &l_exponent);
+
+            l_scale = ldexp(1.0, -l_exponent);
+            VBLAS::vscal(precision, n, l_scale, l_r);
+            VBLAS::vcopy_v_d(n, l_r, l_residual);
+            memset(l_correction, 0, sizeof(double) * n);
+
+            int l_rc = solveCorrection(inner_solver, inner_precision, transpose, n, l_correction, A, At, l_residual, inner_tolerance, exponent_size, stride_size);
+
+            if ( l_rc > 0 ) {
+                l_nb_inner_iterations += l_rc;
+            }
+
+            // x = x + d / scale
+            VPFloatComputingEnvironment::set_precision(l_bis);
+            VPFloatComputingEnvironment::set_tempory_var_environment(exponent_size, l_bis, 1);
+
+            l_scale = ldexp(1.0, l_exponent);
+            VBLAS::vcopy_d_v(n, l_correction, l_d);
+            VBLAS::vaxpy(precision, n, l_scale, l_d, l_x);
+        }
+
+        VBLAS::vcopy_v_d(n, l_x, x);
+
+        free(l_residual);
+        free(l_correction);
+
+        // Same convention as the solvers: -1 when the tolerance is not reached
+        return l_converged ? l_nb_inner_iterations : -1;
+    }
+
+}
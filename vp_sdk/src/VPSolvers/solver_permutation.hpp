@@ -0,0 +1,101 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Solves of reordered systems and copy of the solutions of the MPFR kernels.
+ **/
+
+#ifndef __SOLVER_PERMUTATION_HPP__
+#define __SOLVER_PERMUTATION_HPP__
+
+#include <stdlib.h>
+#include <iostream>
+#include "Matrix/matrix.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+
+/*
+ * Solves a reordered system P A P^T (P x) = P b: x and b are permuted, a_solve is called with the permuted vectors
+ * and the solution is permuted back in x.
+ */
+template <typename solve_t>
+int solvePermuted(int n, double * x, double * b, const int * permutation, solve_t a_solve) {
+    double * l_x = (double *)malloc(sizeof(double) * n);
+    double * l_b = (double *)malloc(sizeof(double) * n);
+
+    if ( l_x == NULL || l_b == NULL ) {
+        std::cout << "Fail allocating memory for permuted vectors." << std::endl;
+        free(l_x);
+        free(l_b);
+        return -1;
+    }
+
+    permuteVector(n, permutation, x, l_x);
+    permuteVector(n, permutation, b, l_b);
+
+    int l_rc = a_solve(l_x, l_b);
+
+    unpermuteVector(n, permutation, l_x, x);
+
+    free(l_x);
+    free(l_b);
+
+    return l_rc;
+}
+
+/*
+ * Same as solvePermuted for k right hand sides: x and b hold k vectors of n elements stored contiguously, each one
+ * being permuted.
+ */
+template <typename solve_t>
+int solvePermutedBlock(int n, int k, double * x, double * b, const int * permutation, solve_t a_solve) {
+    double * l_x = (double *)malloc(sizeof(double) * n * k);
+    double * l_b = (double *)malloc(sizeof(double) * n * k);
+
+    if ( l_x == NULL || l_b == NULL ) {
+        std::cout << "Fail allocating memory for permuted vectors." << std::endl;
+        free(l_x);
+        free(l_b);
+        return -1;
+    }
+
+    for ( int j = 0; j < k; j++ ) {
+        permuteVector(n, permutation, x + (size_t)j * n, l_x + (size_t)j * n);
+        permuteVector(n, permutation, b + (size_t)j * n, l_b + (size_t)j * n);
+    }
+
+    int l_rc = a_solve(l_x, l_b);
+
+    for ( int j = 0; j < k; j++ ) {
+        unpermuteVector(n, permutation, l_x + (size_t)j * n, x + (size_t)j * n);
+    }
+
+    free(l_x);
+    free(l_b);
+
+    return l_rc;
+}
+
+/*
+ * The solver kernels work on Xv, an MPFR copy of x: the a_nb_elements numbers of the solution (k solutions of n
+ * elements for the block solvers) are copied back in x.
+ */
+inline void copyBackSolution(int a_nb_elements, const VPFloatPackage::VPFloatArray & Xv, double * x) {
+    VPFloatPackage::VBLAS::vcopy_v_d(a_nb_elements, Xv, x);
+}
+
+#endif /* __SOLVER_PERMUTATION_HPP__ */
@@ -17,6 +17,11 @@
  * Authors       : Jerome Fereyre
  * Creation Date : August, 2023
  * Description   : 
+ *
+ *                 Layout: has_unit_diag_implicit, row_block_size, col_block_size, num_block_rows and num_block_cols
+ *                 on 64 bits, then the bptr and bind arrays, the size in bytes of bval and the bval array, each array
+ *                 starting on a cache line as in the CSR serializer. num_rows_leftover follows, then the leftover
+ *                 rows (or an empty pointer), mod_name and an empty mod_cached pointer.
  **/
 
 #include <stdlib.h>
@@ -27,91 +32,102 @@
 
 using namespace VPFloatPackage::Offloading;
 
-#define ALIGN_ADDRESS_64Bits(__offset) __offset = ( ( ( __offset / 8 ) + 1  ) * 8)
+/*
+ * Offset of the next a_alignment bytes aligned address.
+ */
+static uint64_t alignOffset(uint64_t a_offset, uint64_t a_alignment) {
+    return ( ( a_offset + a_alignment - 1 ) / a_alignment ) * a_alignment;
+}
 
-size_t VRP_Matrix_BCSR_serializer::getSizeBCSR(dmatBCSR_t a_bcsr, types_value_e a_type_value) {
-    size_t l_size = 0;
-    int l_total_nb_blocks = 0;
+/*
+ * Sizes in bytes of the bptr, bind and bval arrays.
+ */
+static void getArraySizes(dmatBCSR_t a_bcsr, types_value_e a_type_value, uint64_t * a_bptr_size, uint64_t * a_bind_size, uint64_t * a_bval_size) {
+    uint64_t l_total_nb_blocks = a_bcsr->bptr[a_bcsr->num_block_rows] - a_bcsr->bptr[0];
 
-    if ( a_bcsr != NULL ) {
-        // Add size for has_unit_diag_implicit field
-        l_size += sizeof(uint64_t);
+    *a_bptr_size = sizeof(int) * ( a_bcsr->num_block_rows + 1 );
+    *a_bind_size = sizeof(int) * l_total_nb_blocks;
+    *a_bval_size = sizeof(double) * l_total_nb_blocks * a_bcsr->row_block_size * a_bcsr->col_block_size;
 
-        // Add size for row_block_size, col_block_size, num_block_rows, num_block_cols fields
-        l_size += sizeof(uint64_t) * 4;
+    if ( a_type_value == COMPLEX_VALUE ) {
+        *a_bval_size *= 2;
+    }
+}
 
-        // Add size for bptr field
-        l_size += sizeof(int) * (a_bcsr->num_block_rows + 1);
-        if ( l_size / 8 ) {
-            l_size += ( ( (l_size / 8 ) + 1 ) * 8 ) - l_size;
-        }
+/**
+ * @brief Size of the serialized BCSR structure when it starts a_offset bytes after the start of the buffer.
+ * 
+ * @param a_bcsr 
+ * @param a_type_value 
+ * @param a_offset 
+ * @return size_t 
+ */
+size_t VRP_Matrix_BCSR_serializer::getSizeBCSR(dmatBCSR_t a_bcsr, types_value_e a_type_value, size_t a_offset) {
+    uint64_t l_offset = a_offset;
+    uint64_t l_bptr_size, l_bind_size, l_bval_size;
 
-        for ( int l_row_ptr = 0; l_row_ptr < a_bcsr->num_block_rows ; l_row_ptr++ ) {
-            l_total_nb_blocks += a_bcsr->bptr[l_row_ptr+1] - a_bcsr->bptr[l_row_ptr];
-        }
+    if ( a_bcsr == NULL ) {
+        return 0;
+    }
 
-        // Add size for bind field
-        l_size += sizeof(int) * l_total_nb_blocks;
-        if ( l_size / 8 ) {
-            l_size += ( ( (l_size / 8 ) + 1 ) * 8 ) - l_size;
-        }
+    getArraySizes(a_bcsr, a_type_value, &l_bptr_size, &l_bind_size, &l_bval_size);
 
-        // Add size for bval;
-        if ( a_type_value == COMPLEX_VALUE ) {
-            l_size += sizeof(double) * 2 * l_total_nb_blocks *  a_bcsr->row_block_size * a_bcsr->col_block_size;
-        } else {
-            l_size += sizeof(double) * l_total_nb_blocks *  a_bcsr->row_block_size * a_bcsr->col_block_size;
-        }
+    // has_unit_diag_implicit, row_block_size, col_block_size, num_block_rows, num_block_cols fields
+    l_offset += sizeof(uint64_t) * 5;
 
-        if ( l_size / 8 ) {
-            l_size += ( ( (l_size / 8 ) + 1 ) * 8 ) - l_size;
-        }
+    l_offset = alignOffset(l_offset, getAlignment()) + l_bptr_size;
+    l_offset = alignOffset(l_offset, getAlignment()) + l_bind_size;
 
-        // Add size for num_rows_leftover field
-        l_size += sizeof(uint64_t);
+    // bval size field, then bval
+    l_offset = alignOffset(l_offset, 8) + sizeof(uint64_t);
+    l_offset = alignOffset(l_offset, getAlignment()) + l_bval_size;
 
-        // Ignore size of mod_cached field since it is unused
-        if ( a_bcsr->num_rows_leftover == 0 ) {
-            l_size += sizeof(void *);
-        } else {
-            printf("Recursive size count engaged.\n");
-            l_size += getSizeBCSR((dmatBCSR_t)(a_bcsr->leftover), a_type_value);
-        }
+    // num_rows_leftover field
+    l_offset = alignOffset(l_offset, 8) + sizeof(uint64_t);
 
-        // Add size for mod_name field
-        l_size += ( strlen(a_bcsr->mod_name) + 1 )  * sizeof(char);
-        if ( l_size / 8 ) {
-            l_size += ( ( (l_size / 8 ) + 1 ) * 8 ) - l_size;
-        }
-        // Add size for mod_cached
-        l_size += sizeof(void *);
+    if ( a_bcsr->num_rows_leftover == 0 ) {
+        l_offset += sizeof(void *);
+    } else {
+        l_offset += getSizeBCSR(a_bcsr->leftover, a_type_value, l_offset);
     }
 
-    return l_size;
+    // mod_name and mod_cached fields
+    l_offset += strlen(a_bcsr->mod_name) + 1;
+    l_offset = alignOffset(l_offset, 8) + sizeof(void *);
+
+    return l_offset - a_offset;
 }
 
 
 /**
  * @brief 
  * 
- * @param a_repr 
+ * @param a_matrix 
+ * @param a_offset 
  * @return size_t 
  */
-size_t VRP_Matrix_BCSR_serializer::getSize(matrix_t a_matrix) {
+size_t VRP_Matrix_BCSR_serializer::getSize(matrix_t a_matrix, size_t a_offset) {
     dmatBCSR_t l_bcsr = (dmatBCSR_t)a_matrix->matrix->repr;
-    return getSizeBCSR(l_bcsr, a_matrix->type_value);
+    return getSizeBCSR(l_bcsr, a_matrix->type_value, a_offset);
+}
+
+size_t VRP_Matrix_BCSR_serializer::getAlignment() {
+    return 64;
 }
 
 /**
  * @brief 
  * 
  * @param a_bcsr 
- * @param a_address 
+ * @param a_type_value 
+ * @param a_free_address 
+ * @param a_buffer_start_address 
  */
-void VRP_Matrix_BCSR_serializer::flatenBCSR(dmatBCSR_t a_bcsr, types_value_e a_type_value, uint64_t * a_free_address) {
+void VRP_Matrix_BCSR_serializer::flatenBCSR(dmatBCSR_t a_bcsr, types_value_e a_type_value, uint64_t * a_free_address, uint64_t a_buffer_start_address) {
     uint64_t l_free_address = *a_free_address;
-    int l_total_nb_blocks = 0;
-    uint64_t l_bval_size = 0;
+    uint64_t l_bptr_size, l_bind_size, l_bval_size;
+
+    getArraySizes(a_bcsr, a_type_value, &l_bptr_size, &l_bind_size, &l_bval_size);
 
     memcpy((void *)l_free_address, &(a_bcsr->has_unit_diag_implicit), sizeof(int));
     l_free_address += sizeof(uint64_t);
@@ -128,43 +144,37 @@ void VRP_Matrix_BCSR_serializer::flatenBCSR(dmatBCSR_t a_bcsr, types_value_e a_t
     memcpy((void *)l_free_address, &(a_bcsr->num_block_cols), sizeof(int));
     l_free_address += sizeof(uint64_t);
 
-    for ( int l_row_ptr = 0; l_row_ptr < a_bcsr->num_block_rows ; l_row_ptr++ ) {
-        l_total_nb_blocks += a_bcsr->bptr[l_row_ptr+1] - a_bcsr->bptr[l_row_ptr];
-    }
+    // Align bptr and bind adresses on cache size
+    l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, getAlignment());
+    memcpy((void *)l_free_address, a_bcsr->bptr, l_bptr_size);
+    l_free_address += l_bptr_size;
 
-    memcpy((void *)l_free_address, a_bcsr->bptr, sizeof(int) * ( a_bcsr->num_block_rows + 1 ) );
-    l_free_address += sizeof(int) * ( a_bcsr->num_block_rows + 1 );
-    ALIGN_ADDRESS_64Bits(l_free_address);
+    l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, getAlignment());
+    memcpy((void *)l_free_address, a_bcsr->bind, l_bind_size);
+    l_free_address += l_bind_size;
 
-    memcpy((void *)l_free_address, a_bcsr->bind, sizeof(int) * l_total_nb_blocks );
-    l_free_address += sizeof(int) * l_total_nb_blocks;
-    ALIGN_ADDRESS_64Bits(l_free_address);
-
-    if ( a_type_value == COMPLEX_VALUE ) {
-        l_bval_size = sizeof(double) * 2 * ( l_total_nb_blocks * a_bcsr->row_block_size * a_bcsr->col_block_size );
-    } else {
-        l_bval_size = sizeof(double) * ( l_total_nb_blocks * a_bcsr->row_block_size * a_bcsr->col_block_size );
-    }
-    
+    l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, 8);
     memcpy((void *)l_free_address, &(l_bval_size), sizeof(uint64_t));
     l_free_address += sizeof(uint64_t);
 
+    // Align bval adress on cache size
+    l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, getAlignment());
     memcpy((void *)l_free_address, a_bcsr->bval, l_bval_size);
     l_free_address += l_bval_size;
-    ALIGN_ADDRESS_64Bits(l_free_address);
 
+    l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, 8);
     memcpy((void *)l_free_address, &(a_bcsr->num_rows_leftover), sizeof(int));
     l_free_address += sizeof(uint64_t);
 
     if ( a_bcsr->num_rows_leftover == 0 ) {
         l_free_address += sizeof(void *);
     } else {
-        flatenBCSR(a_bcsr->leftover, a_type_value, &l_free_address);
+        flatenBCSR(a_bcsr->leftover, a_type_value, &l_free_address, a_buffer_start_address);
     }
 
     strcpy((char *)l_free_address, a_bcsr->mod_name);
-    l_free_address += sizeof(char) * strlen(a_bcsr->mod_name) + 1;
-    ALIGN_ADDRESS_64Bits(l_free_address);
+    l_free_address += strlen(a_bcsr->mod_name) + 1;
+    l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, 8);
 
     l_free_address += sizeof(void *);
 
@@ -177,13 +187,14 @@ void VRP_Matrix_BCSR_serializer::flatenBCSR(dmatBCSR_t a_bcsr, types_value_e a_t
  * @brief 
  * 
  * @param a_matrix 
- * @param a_address 
+ * @param a_free_address 
+ * @param a_buffer_start_address 
  */
-void VRP_Matrix_BCSR_serializer::flaten(matrix_t a_matrix, uint64_t * a_free_address) {
+void VRP_Matrix_BCSR_serializer::flaten(matrix_t a_matrix, uint64_t * a_free_address, uint64_t a_buffer_start_address) {
     dmatBCSR_t l_bcsr = (dmatBCSR_t)a_matrix->matrix->repr;
     uint64_t l_free_address = *a_free_address;
 
-    flatenBCSR(l_bcsr, a_matrix->type_value, &l_free_address);
+    flatenBCSR(l_bcsr, a_matrix->type_value, &l_free_address, a_buffer_start_address);
 
     // Update the address provided by caller
     *a_free_address = l_free_address;
@@ -193,12 +204,13 @@ void VRP_Matrix_BCSR_serializer::flaten(matrix_t a_matrix, uint64_t * a_free_add
  * @brief 
  * 
  * @param a_address 
+ * @param a_buffer_start_address 
  * @return dmatBCSR_t 
  */
-dmatBCSR_t VRP_Matrix_BCSR_serializer::fromBuffer(uint64_t * a_address) {
+dmatBCSR_t VRP_Matrix_BCSR_serializer::fromBuffer(uint64_t * a_address, uint64_t a_buffer_start_address) {
     dmatBCSR_t l_bcsr  = (dmatBCSR_t) malloc(sizeof(_dmatBCSR_t));
     uint64_t l_next_address = *a_address;
-    int l_total_nb_blocks = 0;
+    uint64_t l_total_nb_blocks = 0;
     uint64_t l_bval_size = 0;
 
     if ( l_bcsr == NULL) {
@@ -221,38 +233,40 @@ dmatBCSR_t VRP_Matrix_BCSR_serializer::fromBuffer(uint64_t * a_address) {
     l_bcsr->num_block_cols = *(int *)l_next_address;
     l_next_address += sizeof(uint64_t);
 
+    l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, getAlignment());
     l_bcsr->bptr = (int*)l_next_address;
     l_next_address += sizeof(int) * ( l_bcsr->num_block_rows + 1 );
-    ALIGN_ADDRESS_64Bits(l_next_address);
 
-    for ( int l_row_ptr = 0; l_row_ptr < l_bcsr->num_block_rows ; l_row_ptr++ ) {
-        l_total_nb_blocks += l_bcsr->bptr[l_row_ptr+1] - l_bcsr->bptr[l_row_ptr];
-    }
+    l_total_nb_blocks = l_bcsr->bptr[l_bcsr->num_block_rows] - l_bcsr->bptr[0];
 
+    l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, getAlignment());
     l_bcsr->bind = (int*)l_next_address;
     l_next_address += sizeof(int) * l_total_nb_blocks;
-    ALIGN_ADDRESS_64Bits(l_next_address);
 
+    l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, 8);
     l_bval_size = *(uint64_t *)l_next_address;
     l_next_address += sizeof(uint64_t);
 
+    l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, getAlignment());
     l_bcsr->bval = (double *)l_next_address;
     l_next_address += l_bval_size;
-    ALIGN_ADDRESS_64Bits(l_next_address);
 
+    l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, 8);
     l_bcsr->num_rows_leftover = *(int*)l_next_address;
     l_next_address += sizeof(uint64_t);
 
     if ( l_bcsr->num_rows_leftover == 0 ) {
+        l_bcsr->leftover = NULL;
         l_next_address += sizeof(void *);
     } else {
-        l_bcsr->leftover = fromBuffer(&l_next_address);
+        l_bcsr->leftover = fromBuffer(&l_next_address, a_buffer_start_address);
     }
 
     l_bcsr->mod_name = (char *)l_next_address;
-    l_next_address += sizeof(char) * strlen(l_bcsr->mod_name) + 1;
-    ALIGN_ADDRESS_64Bits(l_next_address);
+    l_next_address += strlen(l_bcsr->mod_name) + 1;
+    l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, 8);
 
+    l_bcsr->mod_cached = NULL;
     l_next_address += sizeof(void *);
 
     // Update the address provided by caller
@@ -0,0 +1,233 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+* 
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* 
+*     http://www.apache.org/licenses/LICENSE-2.0
+* 
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Serialization of SELL-C-sigma matrices for VRP offloading.
+ *
+ *                 Layout: chunk_size, sort_window and num_chunks on 64 bits, then the chunk_ptr, row_len, perm, ind
+ *                 and val arrays. Each array is preceded by its size in bytes (64 bits aligned) and starts on a
+ *                 cache line, as in the CSR serializer.
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+#include "VRPOffload/vrp_Matrix_SELL_serializer.hpp"
+
+using namespace VPFloatPackage::Offloading;
+
+/*
+ * Offset of the next a_alignment bytes aligned address.
+ */
+static uint64_t alignOffset(uint64_t a_offset, uint64_t a_alignment) {
+    return ( ( a_offset + a_alignment - 1 ) / a_alignment ) * a_alignment;
+}
+
+/*
+ * Number of padded rows stored in a SELL matrix, i.e. number of elements of the row_len and perm arrays.
+ */
+static uint64_t getNbSortedRows(dmatSELL_t a_sell) {
+    return (uint64_t)a_sell->num_chunks * a_sell->chunk_size;
+}
+
+/*
+ * Sizes in bytes of the chunk_ptr, row_len, perm, ind and val arrays.
+ */
+static void getArraySizes(dmatSELL_t a_sell, uint64_t * a_sizes) {
+    uint64_t l_nb_values = a_sell->chunk_ptr[a_sell->num_chunks];
+
+    a_sizes[0] = sizeof(int) * ( a_sell->num_chunks + 1 );
+    a_sizes[1] = sizeof(int) * getNbSortedRows(a_sell);
+    a_sizes[2] = sizeof(int) * getNbSortedRows(a_sell);
+    a_sizes[3] = sizeof(int) * l_nb_values;
+    a_sizes[4] = sizeof(double) * l_nb_values;
+}
+
+#define SELL_SERIALIZER_NB_ARRAYS 5
+
+/**
+ * @brief Size of the serialized SELL structure when it starts a_offset bytes after the start of the buffer.
+ * 
+ * @param a_matrix 
+ * @param a_offset 
+ * @return size_t 
+ */
+size_t VRP_Matrix_SELL_serializer::getSize(matrix_t a_matrix, size_t a_offset) {
+    dmatSELL_t l_sell = (dmatSELL_t)a_matrix->matrix->repr;
+    uint64_t l_sizes[SELL_SERIALIZER_NB_ARRAYS];
+    uint64_t l_offset = a_offset;
+
+    if ( l_sell == NULL ) {
+        return 0;
+    }
+
+    getArraySizes(l_sell, l_sizes);
+
+    // chunk_size, sort_window and num_chunks fields
+    l_offset += sizeof(uint64_t) * 3;
+
+    for ( int l_array = 0; l_array < SELL_SERIALIZER_NB_ARRAYS; l_array++ ) {
+        l_offset = alignOffset(l_offset, 8) + sizeof(uint64_t);
+        l_offset = alignOffset(l_offset, getAlignment()) + l_sizes[l_array];
+    }
+
+    l_offset = alignOffset(l_offset, 8);
+
+    return l_offset - a_offset;
+}
+
+size_t VRP_Matrix_SELL_serializer::getAlignment() {
+    return 64;
+}
+
+/**
+ * @brief 
+ * 
+ * @param a_matrix 
+ * @param a_free_address 
+ * @param a_buffer_start_address 
+ */
+void VRP_Matrix_SELL_serializer::flaten(matrix_t a_matrix, uint64_t * a_free_address, uint64_t a_buffer_start_address) {
+    dmatSELL_t l_sell = (dmatSELL_t)a_matrix->matrix->repr;
+    uint64_t l_free_address = *a_free_address;
+    uint64_t l_sizes[SELL_SERIALIZER_NB_ARRAYS];
+    const void * l_arrays[SELL_SERIALIZER_NB_ARRAYS] = { l_sell->chunk_ptr, l_sell->row_len, l_sell->perm, l_sell->ind, l_sell->val };
+
+    getArraySizes(l_sell, l_sizes);
+
+    memcpy((void *)l_free_address, &(l_sell->chunk_size), sizeof(int));
+    l_free_address += sizeof(uint64_t);
+
+    memcpy((void *)l_free_address, &(l_sell->sort_window), sizeof(int));
+    l_free_address += sizeof(uint64_t);
+
+    memcpy((void *)l_free_address, &(l_sell->num_chunks), sizeof(int));
+    l_free_address += sizeof(uint64_t);
+
+    for ( int l_array = 0; l_array < SELL_SERIALIZER_NB_ARRAYS; l_array++ ) {
+        // Size of the array on 64 bits
+        l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, 8);
+
+        memcpy((void *)l_free_address, &(l_sizes[l_array]), sizeof(uint64_t));
+        l_free_address += sizeof(uint64_t);
+
+        // Values aligned on cache size
+        l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, getAlignment());
+
+        memcpy((void *)l_free_address, l_arrays[l_array], l_sizes[l_array]);
+        l_free_address += l_sizes[l_array];
+    }
+
+    l_free_address = a_buffer_start_address + alignOffset(l_free_address - a_buffer_start_address, 8);
+
+    // Update the address provided by caller
+    *a_free_address = l_free_address;
+}
+
+/**
+ * @brief The arrays of the returned structure point into the buffer.
+ * 
+ * @param a_address 
+ * @param a_buffer_start_address 
+ * @return dmatSELL_t 
+ */
+dmatSELL_t VRP_Matrix_SELL_serializer::fromBuffer(uint64_t * a_address, uint64_t a_buffer_start_address) {
+    dmatSELL_t l_sell = (dmatSELL_t) malloc(sizeof(_dmatSELL_t));
+    uint64_t l_next_address = *a_address;
+    void * l_arrays[SELL_SERIALIZER_NB_ARRAYS];
+
+    if ( l_sell == NULL) {
+        std::cout << "Fail allocating memory for dmatSELL_t structure." << std::endl;
+        return NULL;
+    }
+
+    l_sell->chunk_size = *(int *)l_next_address;
+    l_next_address += sizeof(uint64_t);
+
+    l_sell->sort_window = *(int *)l_next_address;
+    l_next_address += sizeof(uint64_t);
+
+    l_sell->num_chunks = *(int *)l_next_address;
+    l_next_address += sizeof(uint64_t);
+
+    for ( int l_array = 0; l_array < SELL_SERIALIZER_NB_ARRAYS; l_array++ ) {
+        l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, 8);
+
+        uint64_t l_size = *(uint64_t *)l_next_address;
+        l_next_address += sizeof(uint64_t);
+
+        l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, getAlignment());
+
+        l_arrays[l_array] = (void *)l_next_address;
+        l_next_address += l_size;
+    }
+
+    l_sell->chunk_ptr = (int *)l_arrays[0];
+    l_sell->row_len = (int *)l_arrays[1];
+    l_sell->perm = (int *)l_arrays[2];
+    l_sell->ind = (int *)l_arrays[3];
+    l_sell->val = (double *)l_arrays[4];
+
+    l_next_address = a_buffer_start_address + alignOffset(l_next_address - a_buffer_start_address, 8);
+
+    // Update the address provided by caller
+    *a_address = l_next_address;
+
+    return l_sell;
+}
+
+/**
+ * @brief 
+ * 
+ * @param a_matrix 
+ */
+void VRP_Matrix_SELL_serializer::print(matrix_t a_matrix) {
+    dmatSELL_t l_sell = (dmatSELL_t)a_matrix->matrix->repr;
+    if ( l_sell ==  NULL ) {
+        printf("NULL\n");
+        return;
+    }
+
+    std::cout << "chunk_size : " << l_sell->chunk_size << std::endl;
+    std::cout << "sort_window : " << l_sell->sort_window << std::endl;
+    std::cout << "num_chunks : " << l_sell->num_chunks << std::endl;
+
+    std::cout << "chunk_ptr : ";
+    for (int l_chunk = 0 ; l_chunk < l_sell->num_chunks + 1; l_chunk++) {
+        std::cout << l_sell->chunk_ptr[l_chunk] << " ";
+    }
+    std::cout << std::endl;
+
+    std::cout << "perm / row_len : ";
+    for (uint64_t l_sorted_row = 0 ; l_sorted_row < getNbSortedRows(l_sell); l_sorted_row++) {
+        std::cout << l_sell->perm[l_sorted_row] << "/" << l_sell->row_len[l_sorted_row] << " ";
+    }
+    std::cout << std::endl;
+
+    std::cout << "ind : ";
+    for (int l_ind_index = 0 ; l_ind_index < l_sell->chunk_ptr[l_sell->num_chunks]; l_ind_index++) {
+        std::cout << l_sell->ind[l_ind_index] << " ";
+    }
+    std::cout << std::endl;
+
+    std::cout << "val : ";
+    for (int l_val_index = 0 ; l_val_index < l_sell->chunk_ptr[l_sell->num_chunks]; l_val_index++) {
+        std::cout << l_sell->val[l_val_index] << " - ";
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,315 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Binary matrix files, memory mapped and used in place.
+ **/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "VRPOffload/vrp_Matrix_file.hpp"
+#include "VRPOffload/vrp_Matrix_serializer.hpp"
+#include "Matrix/BCSR.h"
+
+using namespace VPFloatPackage::Offloading;
+
+/*
+ * Serialized matrices of the mapped files, so offloading does not serialize them again.
+ */
+static std::map<matrix_t, std::pair<void *, size_t> > s_flat_matrices;
+static std::mutex s_flat_matrices_mutex;
+
+static uint64_t alignOffset(uint64_t a_offset, uint64_t a_alignment) {
+    return ( ( a_offset + a_alignment - 1 ) / a_alignment ) * a_alignment;
+}
+
+/*
+ * Maps a whole file, read only unless a_size is set: the file is then resized to a_size and mapped for writing.
+ */
+static void * mapFile(const char * a_file_path, size_t * a_size, bool a_write) {
+    struct stat l_file_status;
+    void * l_address;
+    int l_file_descriptor = a_write ? open(a_file_path, O_RDWR | O_CREAT | O_TRUNC, 0644) : open(a_file_path, O_RDONLY);
+
+    if ( l_file_descriptor < 0 ) {
+        return NULL;
+    }
+
+    if ( a_write ) {
+        if ( ftruncate(l_file_descriptor, *a_size) != 0 ) {
+            close(l_file_descriptor);
+            return NULL;
+        }
+    } else {
+        if ( fstat(l_file_descriptor, &l_file_status) != 0 ) {
+            close(l_file_descriptor);
+            return NULL;
+        }
+        *a_size = l_file_status.st_size;
+    }
+
+    if ( *a_size == 0 ) {
+        close(l_file_descriptor);
+        return NULL;
+    }
+
+    // Private writable mapping: code modifying the matrices in place does not modify the file
+    l_address = mmap(NULL, *a_size, PROT_READ | PROT_WRITE, a_write ? MAP_SHARED : MAP_PRIVATE, l_file_descriptor, 0);
+    close(l_file_descriptor);
+
+    return ( l_address == MAP_FAILED ) ? NULL : l_address;
+}
+
+/*
+ * Releases the structures allocated by VRP_Matrix_serializer::fromBuffer, the arrays being in the mapping.
+ */
+static void freeMatrixDescriptor(matrix_t a_matrix) {
+    if ( a_matrix->matrix != NULL ) {
+        if ( a_matrix->type_matrix == BCSR ) {
+            dmatBCSR_t l_bcsr = (dmatBCSR_t)a_matrix->matrix->repr;
+
+            while ( l_bcsr != NULL ) {
+                dmatBCSR_t l_leftover = ( l_bcsr->num_rows_leftover != 0 ) ? l_bcsr->leftover : NULL;
+
+                free(l_bcsr);
+                l_bcsr = l_leftover;
+            }
+        } else {
+            free(a_matrix->matrix->repr);
+        }
+        free(a_matrix->matrix);
+    }
+    free(a_matrix);
+}
+
+uint64_t VRP_Matrix_file::hashFile(const char * a_file_path) {
+    size_t l_size = 0;
+    const unsigned char * l_content = (const unsigned char *)mapFile(a_file_path, &l_size, false);
+    uint64_t l_hash = 14695981039346656037ULL;
+
+    if ( l_content == NULL ) {
+        return 0;
+    }
+
+    madvise((void *)l_content, l_size, MADV_SEQUENTIAL);
+
+    for ( size_t l_index = 0 ; l_index < l_size; l_index++ ) {
+        l_hash ^= l_content[l_index];
+        l_hash *= 1099511628211ULL;
+    }
+
+    munmap((void *)l_content, l_size);
+
+    // 0 is kept for errors
+    return ( l_hash == 0 ) ? 1 : l_hash;
+}
+
+std::string VRP_Matrix_file::getCachePath(const char * a_cache_directory, uint64_t a_source_hash, const char * a_variant) {
+    char l_hash[17];
+
+    snprintf(l_hash, sizeof(l_hash), "%016" PRIx64, a_source_hash);
+
+    return std::string(a_cache_directory) + "/" + l_hash + "-" + a_variant + ".vpm";
+}
+
+int VRP_Matrix_file::save(const char * a_file_path, uint64_t a_source_hash, matrix_t a_matrices[VRP_MATRIX_FILE_NB_ROLES]) {
+    std::string l_temporary_path = std::string(a_file_path) + ".tmp";
+    uint64_t l_nb_sections = 0;
+    uint64_t l_offsets[VRP_MATRIX_FILE_NB_ROLES];
+    uint64_t l_sizes[VRP_MATRIX_FILE_NB_ROLES];
+    size_t l_file_size;
+    char * l_address;
+    vrp_matrix_file_header_t * l_header;
+    vrp_matrix_file_section_t * l_sections;
+
+    for ( int l_role = 0 ; l_role < VRP_MATRIX_FILE_NB_ROLES; l_role++ ) {
+        if ( a_matrices[l_role] != NULL ) {
+            l_nb_sections++;
+        }
+    }
+
+    l_file_size = sizeof(vrp_matrix_file_header_t) + l_nb_sections * sizeof(vrp_matrix_file_section_t);
+
+    for ( int l_role = 0 ; l_role < VRP_MATRIX_FILE_NB_ROLES; l_role++ ) {
+        if ( a_matrices[l_role] != NULL ) {
+            l_offsets[l_role] = alignOffset(l_file_size, VRP_MATRIX_FILE_ALIGNMENT);
+            l_sizes[l_role] = VRP_Matrix_serializer::getSize(a_matrices[l_role]);
+            l_file_size = l_offsets[l_role] + l_sizes[l_role];
+        }
+    }
+
+    l_address = (char *)mapFile(l_temporary_path.c_str(), &l_file_size, true);
+
+    if ( l_address == NULL ) {
+        std::cout << "Fail creating matrix file " << l_temporary_path << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    l_header = (vrp_matrix_file_header_t *)l_address;
+    l_sections = (vrp_matrix_file_section_t *)(l_address + sizeof(vrp_matrix_file_header_t));
+
+    memcpy(l_header->magic, VRP_MATRIX_FILE_MAGIC, sizeof(l_header->magic));
+    l_header->version = VRP_MATRIX_FILE_VERSION;
+    l_header->source_hash = a_source_hash;
+    l_header->nb_sections = l_nb_sections;
+
+    for ( int l_role = 0 ; l_role < VRP_MATRIX_FILE_NB_ROLES; l_role++ ) {
+        if ( a_matrices[l_role] != NULL ) {
+            uint64_t l_free_address = (uint64_t)( l_address + l_offsets[l_role] );
+
+            l_sections->role = l_role;
+            l_sections->offset = l_offsets[l_role];
+            l_sections->size = l_sizes[l_role];
+            l_sections->type_matrix = a_matrices[l_role]->type_matrix;
+            l_sections->type_value = a_matrices[l_role]->type_value;
+            l_sections->m = a_matrices[l_role]->m;
+            l_sections->n = a_matrices[l_role]->n;
+            l_sections++;
+
+            VRP_Matrix_serializer::flaten(a_matrices[l_role], &l_free_address);
+        }
+    }
+
+    munmap(l_address, l_file_size);
+
+    if ( rename(l_temporary_path.c_str(), a_file_path) != 0 ) {
+        std::cout << "Fail renaming matrix file " << l_temporary_path << "." << std::endl;
+        unlink(l_temporary_path.c_str());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+vrp_matrix_file_t * VRP_Matrix_file::map(const char * a_file_path, uint64_t a_source_hash) {
+    vrp_matrix_file_t * l_file;
+    size_t l_size = 0;
+    void * l_address = mapFile(a_file_path, &l_size, false);
+
+    if ( l_address == NULL ) {
+        return NULL;
+    }
+
+    l_file = (vrp_matrix_file_t *)malloc(sizeof(vrp_matrix_file_t));
+
+    if ( l_file == NULL ) {
+        std::cout << "Fail allocating memory for vrp_matrix_file_t structure." << std::endl;
+        munmap(l_address, l_size);
+        return NULL;
+    }
+
+    l_file->address = l_address;
+    l_file->size = l_size;
+    l_file->header = (vrp_matrix_file_header_t *)l_address;
+    l_file->sections = (vrp_matrix_file_section_t *)((char *)l_address + sizeof(vrp_matrix_file_header_t));
+
+    for ( int l_role = 0 ; l_role < VRP_MATRIX_FILE_NB_ROLES; l_role++ ) {
+        l_file->matrices[l_role] = NULL;
+    }
+
+    /*
+     * Files of other versions, other sources or truncated are ignored.
+     */
+    bool l_valid = ( l_size >= sizeof(vrp_matrix_file_header_t) )
+                && ( memcmp(l_file->header->magic, VRP_MATRIX_FILE_MAGIC, sizeof(l_file->header->magic)) == 0 )
+                && ( l_file->header->version == VRP_MATRIX_FILE_VERSION )
+                && ( ( a_source_hash == 0 ) || ( l_file->header->source_hash == a_source_hash ) )
+                && ( l_file->header->nb_sections <= VRP_MATRIX_FILE_NB_ROLES )
+                && ( sizeof(vrp_matrix_file_header_t) + l_file->header->nb_sections * sizeof(vrp_matrix_file_section_t) <= l_size );
+
+    for ( uint64_t l_section = 0 ; l_valid && ( l_section < l_file->header->nb_sections ); l_section++ ) {
+        l_valid = ( l_file->sections[l_section].role < VRP_MATRIX_FILE_NB_ROLES )
+               && ( l_file->sections[l_section].offset % VRP_MATRIX_FILE_ALIGNMENT == 0 )
+               && ( l_file->sections[l_section].offset <= l_size )
+               && ( l_file->sections[l_section].size <= l_size - l_file->sections[l_section].offset );
+    }
+
+    if ( ! l_valid ) {
+        unmap(l_file);
+        return NULL;
+    }
+
+    return l_file;
+}
+
+matrix_t VRP_Matrix_file::getMatrix(vrp_matrix_file_t * a_file, vrp_matrix_file_role_e a_role) {
+    if ( a_file->matrices[a_role] != NULL ) {
+        return a_file->matrices[a_role];
+    }
+
+    for ( uint64_t l_section = 0 ; l_section < a_file->header->nb_sections; l_section++ ) {
+        if ( a_file->sections[l_section].role == (uint64_t)a_role ) {
+            void * l_flat_matrix = (char *)a_file->address + a_file->sections[l_section].offset;
+            uint64_t l_address = (uint64_t)l_flat_matrix;
+
+            a_file->matrices[a_role] = VRP_Matrix_serializer::fromBuffer(&l_address);
+
+            if ( a_file->matrices[a_role] != NULL ) {
+                std::lock_guard<std::mutex> l_lock(s_flat_matrices_mutex);
+                s_flat_matrices[a_file->matrices[a_role]] = std::make_pair(l_flat_matrix, (size_t)a_file->sections[l_section].size);
+            }
+
+            return a_file->matrices[a_role];
+        }
+    }
+
+    return NULL;
+}
+
+void * VRP_Matrix_file::getFlatMatrix(matrix_t a_matrix, size_t * a_size) {
+    std::lock_guard<std::mutex> l_lock(s_flat_matrices_mutex);
+    std::map<matrix_t, std::pair<void *, size_t> >::iterator l_flat_matrix = s_flat_matrices.find(a_matrix);
+
+    if ( l_flat_matrix == s_flat_matrices.end() ) {
+        return NULL;
+    }
+
+    *a_size = l_flat_matrix->second.second;
+
+    return l_flat_matrix->second.first;
+}
+
+void VRP_Matrix_file::unmap(vrp_matrix_file_t * a_file) {
+    if ( a_file == NULL ) {
+        return;
+    }
+
+    for ( int l_role = 0 ; l_role < VRP_MATRIX_FILE_NB_ROLES; l_role++ ) {
+        if ( a_file->matrices[l_role] != NULL ) {
+            {
+                std::lock_guard<std::mutex> l_lock(s_flat_matrices_mutex);
+                s_flat_matrices.erase(a_file->matrices[l_role]);
+            }
+            freeMatrixDescriptor(a_file->matrices[l_role]);
+        }
+    }
+
+    munmap(a_file->address, a_file->size);
+    free(a_file);
+}
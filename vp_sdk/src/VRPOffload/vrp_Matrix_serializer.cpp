@@ -27,6 +27,7 @@
 #include "VRPOffload/vrp_Matrix_CSR_serializer.hpp"
 #include "VRPOffload/vrp_Matrix_BCSR_serializer.hpp"
 #include "VRPOffload/vrp_Matrix_DENSE_serializer.hpp"
+#include "VRPOffload/vrp_Matrix_SELL_serializer.hpp"
 
 using namespace VPFloatPackage::Offloading;
 
@@ -53,7 +54,10 @@ size_t VRP_Matrix_serializer::getSize(matrix_t a_matrix) {
             l_size += VRP_Matrix_CSR_serializer::getSize(a_matrix, l_size);
             break;
         case BCSR:
-            l_size += VRP_Matrix_BCSR_serializer::getSize(a_matrix);
+            l_size += VRP_Matrix_BCSR_serializer::getSize(a_matrix, l_size);
+            break;
+        case SELL:
+            l_size += VRP_Matrix_SELL_serializer::getSize(a_matrix, l_size);
             break;
         default:
             std::cout << "Matrix type " << a_matrix->type_matrix << " not supported. Size is O" << std::endl;
@@ -71,6 +75,12 @@ size_t VRP_Matrix_serializer::getAlignment(matrix_t a_matrix) {
         case CSR:        
             return VRP_Matrix_CSR_serializer::getAlignment();
             break;            
+        case BCSR:
+            return VRP_Matrix_BCSR_serializer::getAlignment();
+            break;
+        case SELL:
+            return VRP_Matrix_SELL_serializer::getAlignment();
+            break;
         default:
             return 0;
             break;
@@ -113,7 +123,10 @@ void VRP_Matrix_serializer::flaten(matrix_t a_matrix, uint64_t * a_free_address)
             VRP_Matrix_CSR_serializer::flaten(a_matrix, &l_free_address, l_buffer_start_address );
             break;
         case BCSR:
-            VRP_Matrix_BCSR_serializer::flaten(a_matrix, &l_free_address);
+            VRP_Matrix_BCSR_serializer::flaten(a_matrix, &l_free_address, l_buffer_start_address );
+            break;
+        case SELL:
+            VRP_Matrix_SELL_serializer::flaten(a_matrix, &l_free_address, l_buffer_start_address );
             break;
         default:
             std::cout << "Matrix type " << a_matrix->type_matrix << " not supported. flaten is partial." << std::endl;
@@ -174,7 +187,10 @@ matrix_t VRP_Matrix_serializer::fromBuffer(uint64_t * a_address) {
             l_matrix->matrix->repr = (void *)VRP_Matrix_CSR_serializer::fromBuffer(&l_next_address, l_buffer_start_address);
             break;
         case BCSR:
-            l_matrix->matrix->repr = (void *)VRP_Matrix_BCSR_serializer::fromBuffer(&l_next_address);
+            l_matrix->matrix->repr = (void *)VRP_Matrix_BCSR_serializer::fromBuffer(&l_next_address, l_buffer_start_address);
+            break;
+        case SELL:
+            l_matrix->matrix->repr = (void *)VRP_Matrix_SELL_serializer::fromBuffer(&l_next_address, l_buffer_start_address);
             break;
         default:
             std::cout << "Matrix type " << l_matrix->type_matrix << " not supported. fromBuffer is partial." << std::endl;
@@ -230,6 +246,9 @@ void VRP_Matrix_serializer::print(matrix_t a_matrix) {
         case BCSR:
             VRP_Matrix_BCSR_serializer::print(a_matrix);
             break;
+        case SELL:
+            VRP_Matrix_SELL_serializer::print(a_matrix);
+            break;
         default:
             std::cout << "Matrix type : "<< a_matrix->type_matrix << " not supported." << std::endl;
     }
@@ -24,6 +24,7 @@
 #include <iostream>
 #include "VRPOffload/vrp_argument_array.hpp"
 #include "VRPOffload/vrp_Matrix_serializer.hpp"
+#include "VRPOffload/vrp_Matrix_file.hpp"
 #include "vrp_ioctl.h"
 
 using namespace VPFloatPackage::Offloading;
@@ -53,6 +54,15 @@ void VRPArgumentArray::addArgument(VRPArgument a_argument) {
 }
 
 void VRPArgumentArray::addArgument(matrix_t a_matrix_descr, vrp_argument_direction_t a_direction) {
+    size_t l_flat_matrix_size = 0;
+    void * l_flat_matrix = VRP_Matrix_file::getFlatMatrix(a_matrix_descr, &l_flat_matrix_size);
+
+    // Matrices of a mapped matrix file are already serialized: the mapping is transfered as is
+    if ( l_flat_matrix != NULL ) {
+        this->m_arguments.push_back(VRPArgument(l_flat_matrix_size, (uint64_t)l_flat_matrix, VRP_MATRIX_FILE_ALIGNMENT, a_direction));
+        return;
+    }
+
     this->m_arguments.push_back(
         VRPArgument(VRP_Matrix_serializer::getSize(a_matrix_descr), 
                     (uint64_t)VRP_Matrix_serializer::serialize(a_matrix_descr), 
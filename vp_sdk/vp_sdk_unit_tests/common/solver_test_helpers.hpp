@@ -0,0 +1,188 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Test matrices and helpers shared by the solver unit tests.
+ **/
+
+#ifndef __SOLVER_TEST_HELPERS_HPP__
+#define __SOLVER_TEST_HELPERS_HPP__
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <vector>
+
+#include "Matrix/matrix.h"
+#include "Matrix/CSR.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+
+/*
+ * 5 points Laplacian on a a_grid_size x a_grid_size grid plus a_shift on the diagonal, 0-based.
+ */
+inline matrix_t buildLaplacian(int a_grid_size, double a_shift = 0.0) {
+    int l_n = a_grid_size * a_grid_size;
+    int * l_row_ptr = (int *)malloc(sizeof(int) * ( l_n + 1 ));
+    int * l_col_ind = (int *)malloc(sizeof(int) * 5 * l_n);
+    double * l_val = (double *)malloc(sizeof(double) * 5 * l_n);
+    int l_nnz = 0;
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        int l_j = l_row % a_grid_size;
+
+        l_row_ptr[l_row] = l_nnz;
+        for ( int l_col : {l_row - a_grid_size, l_row - 1, l_row, l_row + 1, l_row + a_grid_size} ) {
+            if ( ( l_col < 0 ) || ( l_col >= l_n ) || ( ( l_col == l_row - 1 ) && ( l_j == 0 ) ) || ( ( l_col == l_row + 1 ) && ( l_j == a_grid_size - 1 ) ) ) {
+                continue;
+            }
+            l_col_ind[l_nnz] = l_col;
+            l_val[l_nnz] = ( l_col == l_row ) ? 4.0 + a_shift : -1.0;
+            l_nnz++;
+        }
+    }
+    l_row_ptr[l_n] = l_nnz;
+
+    return buildCSR(l_n, l_n, l_row_ptr, l_col_ind, l_val, 0);
+}
+
+/*
+ * Tridiagonal matrix (-1, a_diagonal, -1 + a_skew), 0-based: symmetric when a_skew is 0.
+ */
+inline matrix_t buildTridiagonal(int a_n, double a_diagonal, double a_skew = 0.0) {
+    int * l_row_ptr = (int *)malloc(sizeof(int) * ( a_n + 1 ));
+    int * l_col_ind = (int *)malloc(sizeof(int) * 3 * a_n);
+    double * l_val = (double *)malloc(sizeof(double) * 3 * a_n);
+    int l_nnz = 0;
+
+    for ( int l_row = 0; l_row < a_n; l_row++ ) {
+        l_row_ptr[l_row] = l_nnz;
+        for ( int l_col = l_row - 1; l_col <= l_row + 1; l_col++ ) {
+            if ( l_col < 0 || l_col >= a_n ) {
+                continue;
+            }
+            l_col_ind[l_nnz] = l_col;
+            l_val[l_nnz] = ( l_col == l_row ) ? a_diagonal : ( ( l_col > l_row ) ? -1.0 + a_skew : -1.0 );
+            l_nnz++;
+        }
+    }
+    l_row_ptr[a_n] = l_nnz;
+
+    return buildCSR(a_n, a_n, l_row_ptr, l_col_ind, l_val, 0);
+}
+
+/*
+ * Convection-diffusion on a a_grid_size x a_grid_size grid, 0-based: the 5 points Laplacian plus a_convection times
+ * the differences along both directions, upwind (backward) or centered. Centered differences give eigenvalues with
+ * large imaginary parts, on which BICGSTAB stagnates.
+ */
+inline matrix_t buildConvectionDiffusion(int a_grid_size, double a_convection, bool a_centered) {
+    int l_n = a_grid_size * a_grid_size;
+    int * l_row_ptr = (int *)malloc(sizeof(int) * ( l_n + 1 ));
+    int * l_col_ind = (int *)malloc(sizeof(int) * 5 * l_n);
+    double * l_val = (double *)malloc(sizeof(double) * 5 * l_n);
+    int l_nnz = 0;
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        int l_j = l_row % a_grid_size;
+
+        l_row_ptr[l_row] = l_nnz;
+        for ( int l_col : {l_row - a_grid_size, l_row - 1, l_row, l_row + 1, l_row + a_grid_size} ) {
+            if ( ( l_col < 0 ) || ( l_col >= l_n ) || ( ( l_col == l_row - 1 ) && ( l_j == 0 ) ) || ( ( l_col == l_row + 1 ) && ( l_j == a_grid_size - 1 ) ) ) {
+                continue;
+            }
+            l_col_ind[l_nnz] = l_col;
+            if ( l_col == l_row ) {
+                l_val[l_nnz] = a_centered ? 4.0 : 4.0 + 2.0 * a_convection;
+            } else if ( l_col < l_row ) {
+                l_val[l_nnz] = -1.0 - a_convection;
+            } else {
+                l_val[l_nnz] = a_centered ? -1.0 + a_convection : -1.0;
+            }
+            l_nnz++;
+        }
+    }
+    l_row_ptr[l_n] = l_nnz;
+
+    return buildCSR(l_n, l_n, l_row_ptr, l_col_ind, l_val, 0);
+}
+
+/*
+ * Inverse of the diagonal of a CSR matrix, 0-based.
+ */
+inline matrix_t buildJacobi(matrix_t a_matrix) {
+    dmatCSR_t l_csr = (dmatCSR_t)a_matrix->matrix->repr;
+    int l_base = l_csr->base_index;
+    int l_n = a_matrix->n;
+    int * l_row_ptr = (int *)malloc(sizeof(int) * ( l_n + 1 ));
+    int * l_col_ind = (int *)malloc(sizeof(int) * l_n);
+    double * l_val = (double *)malloc(sizeof(double) * l_n);
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        l_row_ptr[l_row] = l_row;
+        l_col_ind[l_row] = l_row;
+        l_val[l_row] = 1.0;
+        for ( int l_index = l_csr->ptr[l_row] - l_base; l_index < l_csr->ptr[l_row + 1] - l_base; l_index++ ) {
+            if ( l_csr->ind[l_index] - l_base == l_row ) {
+                l_val[l_row] = 1.0 / l_csr->val[l_index];
+            }
+        }
+    }
+    l_row_ptr[l_n] = l_n;
+
+    return buildCSR(l_n, l_n, l_row_ptr, l_col_ind, l_val, 0);
+}
+
+/*
+ * Seconds elapsed since a_start.
+ */
+inline double elapsed(struct timespec & a_start) {
+    struct timespec l_stop;
+
+    clock_gettime(CLOCK_MONOTONIC, &l_stop);
+
+    return ( l_stop.tv_sec - a_start.tv_sec ) + ( l_stop.tv_nsec - a_start.tv_nsec ) * 1e-9;
+}
+
+/*
+ * ||b - A x|| computed with 512 bits.
+ */
+inline double trueResidual(matrix_t a_matrix, const std::vector<double> & a_x, const std::vector<double> & a_b) {
+    using namespace VPFloatPackage;
+
+    int l_n = a_matrix->n;
+    uint16_t l_exponent_size = 11;
+    short l_bis = 512 + l_exponent_size + 1;
+
+    VPFloatComputingEnvironment::set_precision(l_bis);
+    VPFloatComputingEnvironment::set_tempory_var_environment(l_exponent_size, l_bis, 1);
+
+    VPFloatArray l_x(l_exponent_size, l_bis, 1, l_n);
+    VPFloatArray l_r(l_exponent_size, l_bis, 1, l_n);
+    VPFloat l_one(l_exponent_size, l_bis, 1);
+    VPFloat l_norm(l_exponent_size, l_bis, 1);
+
+    l_one = 1.0;
+    VBLAS::vcopy_d_v(l_n, a_x.data(), l_x);
+    VBLAS::vcopy_d_v(l_n, a_b.data(), l_r);
+    VBLAS::vgemvd(512, 'N', l_n, l_n, -1.0, a_matrix, l_x, l_one, l_r);
+    VBLAS::vnrm2(512, l_n, l_r, l_norm);
+
+    return double(l_norm);
+}
+
+#endif /* __SOLVER_TEST_HELPERS_HPP__ */
@@ -0,0 +1,140 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks that the adaptive precision CG gives the solution of the fixed precision CG, and reports
+ *                 both solve times.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Matrix/matrix.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSolvers.hpp"
+#include "OSKIHelper.hpp"
+#include "../common/solver_test_helpers.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * Solves A x = b with CG at a_precision, then with the adaptive CG starting at a_initial_precision, and compares the
+ * solutions.
+ */
+bool checkAdaptivePrecision(const char * a_name, int a_precision, int a_initial_precision, matrix_t a_matrix, double a_tolerance) {
+    int l_n = a_matrix->n;
+    uint16_t l_exponent_size = 11;
+    std::vector<double> l_b(l_n), l_x(l_n, 0.0), l_adaptive_x(l_n, 0.0);
+    struct timespec l_start;
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_b[i] = sin(0.37 * i) + 1.0 / 3.0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_rc = Solver::cg(a_precision, 0, l_n, l_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+    double l_duration = elapsed(l_start);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_adaptive_rc = Solver::cg_adaptive(a_precision, a_initial_precision, 0, l_n, l_adaptive_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+    double l_adaptive_duration = elapsed(l_start);
+
+    printf("%-16s %4d bits : %5d iterations %8.3f s - adaptive from %d bits : %5d iterations %8.3f s\n", a_name, a_precision, l_rc, l_duration, a_initial_precision, l_adaptive_rc, l_adaptive_duration);
+
+    if ( l_rc < 0 || l_adaptive_rc < 0 ) {
+        std::cout << a_name << " : no convergence" << std::endl;
+        return true;
+    }
+
+    for ( int i = 0; i < l_n; i++ ) {
+        if ( fabs(l_x[i] - l_adaptive_x[i]) > 1e-12 * ( 1.0 + fabs(l_x[i]) ) ) {
+            std::cout << a_name << " : x[" << i << "] differs " << l_x[i] << " " << l_adaptive_x[i] << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+
+    /*
+     * Well conditioned: a few iterations per precision, the tolerance is reached far below the maximum precision.
+     */
+    l_diff_detected |= checkAdaptivePrecision("tridiagonal", 1024, 64, buildTridiagonal(1000, 2.5), 1e-60);
+
+    /*
+     * Ill conditioned: the low precisions stagnate and are raised up to the maximum precision.
+     */
+    l_diff_detected |= checkAdaptivePrecision("ill tridiagonal", 256, 32, buildTridiagonal(400, 2.0 + 1e-5), 1e-30);
+
+    /*
+     * An initial precision outside of [1, precision] is rejected.
+     */
+    matrix_t l_small_matrix = buildTridiagonal(10, 2.5);
+
+    for ( int l_initial_precision : {0, -32, 512} ) {
+        std::vector<double> l_b(10, 1.0), l_x(10, 0.0);
+        int l_rc = Solver::cg_adaptive(256, l_initial_precision, 0, 10, l_x.data(), l_small_matrix, l_b.data(), 1e-30, 11);
+
+        if ( l_rc >= 0 ) {
+            std::cout << "initial precision " << l_initial_precision << " : unexpected return " << l_rc << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    /*
+     * Matrices of the matrix repository.
+     */
+    const char * l_matrix_repo_path = getenv("MATRIX_REPO_PATH");
+
+    if ( l_matrix_repo_path != NULL ) {
+        for ( const char * l_matrix_name : {"bcsstk01.mtx"} ) {
+            std::string l_matrix_file_path = std::string(l_matrix_repo_path) + "/" + l_matrix_name;
+
+            oski_matrix_wrapper_t l_oski_matrix = OSKIHelper::loadFromFile((char *)l_matrix_file_path.c_str());
+
+            if ( l_oski_matrix.oski_matrix.real_matrix == NULL ) {
+                std::cout << "Fail loading " << l_matrix_file_path << std::endl;
+                l_diff_detected = true;
+                continue;
+            }
+
+            l_diff_detected |= checkAdaptivePrecision(l_matrix_name, 256, 32, OSKIHelper::toMatrix(l_oski_matrix), 1e-20);
+        }
+    }
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
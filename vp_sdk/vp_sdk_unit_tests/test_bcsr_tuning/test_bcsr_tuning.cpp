@@ -0,0 +1,211 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks the BCSR fill estimate and the block shape chosen by the BCSR autotuning on a known matrix,
+ *                 and the BCSR products when the number of columns is not a multiple of the block size.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <iostream>
+
+#include "Matrix/matrix.h"
+#include "Matrix/BCSR.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "OSKIHelper.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * 6 x 7 matrix made of a 2x2 block at (0, 0), a 2x2 block at (2, 2) and a 2x3 block at (4, 4), a_ij = 1 + i + j.
+ * 14 non zero values.
+ */
+#define TEST_M 6
+#define TEST_N 7
+#define TEST_NNZ 14
+
+static int s_row_ptr[TEST_M + 1] = {1,3,5,7,9,12,15};
+static int s_col_ind[TEST_NNZ] = {1,2,1,2,3,4,3,4,5,6,7,5,6,7};
+static double s_val[TEST_NNZ] = {1,2,2,3,5,6,6,7,9,10,11,10,11,12};
+
+bool checkFill(oski_matrix_wrapper_t a_matrix, int a_block_row_size, int a_block_col_size, double a_expected_fill) {
+    double l_fill = OSKIHelper::estimateBCSRFill(a_matrix, a_block_row_size, a_block_col_size, 1.0);
+
+    if ( l_fill != a_expected_fill ) {
+        std::cout << "fill " << a_block_row_size << "x" << a_block_col_size << " : " << l_fill << " instead of " << a_expected_fill << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+bool checkTuning(const char * a_name, oski_matrix_wrapper_t a_matrix, const bcsr_profile_t & a_profile, int a_expected_block_row_size, int a_expected_block_col_size, double a_expected_cost) {
+    int l_block_row_size, l_block_col_size;
+    double l_cost = OSKIHelper::tuneBCSR(a_matrix, a_profile, &l_block_row_size, &l_block_col_size, 1.0);
+
+    printf("%-16s : %dx%d, cost %f\n", a_name, l_block_row_size, l_block_col_size, l_cost);
+
+    if ( ( l_block_row_size != a_expected_block_row_size ) || ( l_block_col_size != a_expected_block_col_size ) || ( fabs(l_cost - a_expected_cost) > 1e-15 ) ) {
+        std::cout << a_name << " : " << l_block_row_size << "x" << l_block_col_size << " (cost " << l_cost << ") instead of "
+                  << a_expected_block_row_size << "x" << a_expected_block_col_size << " (cost " << a_expected_cost << ")" << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * y = alpha * A * X + beta * y for the k vectors of X, a_x holding k * TEST_N values followed by a NaN: the NaN
+ * is only read past the end of the last vector, by a product using the padding column of the last block column.
+ */
+bool checkProduct(const char * a_name, matrix_t a_matrix, int a_k) {
+    double l_alpha = 2.0;
+    VPFloat l_beta(3.0);
+    VPFloatArray l_x(11, 128, 1, a_k * TEST_N + 1);
+    VPFloatArray l_y(11, 128, 1, a_k * TEST_M);
+    double l_expected_y[2 * TEST_M];
+    bool l_diff_detected = false;
+
+    for ( int i = 0; i < a_k * TEST_N; i++ ) {
+        l_x[i] = double(1 + i % 5);
+    }
+    l_x[a_k * TEST_N] = nan("");
+
+    for ( int i = 0; i < a_k * TEST_M; i++ ) {
+        l_y[i] = double(i);
+        l_expected_y[i] = double(l_beta) * double(i);
+    }
+
+    for ( int j = 0; j < a_k; j++ ) {
+        for ( int i = 0; i < TEST_M; i++ ) {
+            for ( int k = s_row_ptr[i] - 1; k < s_row_ptr[i+1] - 1; k++ ) {
+                l_expected_y[j * TEST_M + i] += l_alpha * s_val[k] * double(l_x[j * TEST_N + s_col_ind[k] - 1]);
+            }
+        }
+    }
+
+    if ( a_k == 1 ) {
+        VBLAS::vgemvd(128, 'N', TEST_M, TEST_N, l_alpha, a_matrix, l_x, l_beta, l_y);
+    } else {
+        VBLAS::vgemmd(128, 'N', TEST_M, TEST_N, a_k, l_alpha, a_matrix, l_x, l_beta, l_y);
+    }
+
+    for ( int i = 0; i < a_k * TEST_M; i++ ) {
+        if ( double(l_y[i]) != l_expected_y[i] ) {
+            std::cout << a_name << " : y[" << i << "] " << double(l_y[i]) << " instead of " << l_expected_y[i] << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    return l_diff_detected;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+
+    VPFloatComputingEnvironment::set_precision(128);
+    VPFloatComputingEnvironment::set_tempory_var_environment(11, 128, 1);
+
+    oski_matrix_wrapper_t l_matrix = OSKIHelper::buildCSR(TEST_M, TEST_N, s_row_ptr, s_col_ind, s_val, 1);
+
+    /*
+     * Stored values (blocks times r * c) per non zero value, the last block row and column being padded
+     */
+    l_diff_detected |= checkFill(l_matrix, 1, 1, 1.0);
+    l_diff_detected |= checkFill(l_matrix, 2, 1, 1.0);
+    l_diff_detected |= checkFill(l_matrix, 1, 2, 16.0 / 14.0);
+    l_diff_detected |= checkFill(l_matrix, 2, 2, 16.0 / 14.0);
+    l_diff_detected |= checkFill(l_matrix, 3, 2, 30.0 / 14.0);
+    l_diff_detected |= checkFill(l_matrix, 3, 3, 45.0 / 14.0);
+
+    /*
+     * Shapes up to 2x2: the cost of a shape is its fill times its cost per value
+     */
+    bcsr_profile_t l_profile;
+
+    l_profile.max_block_row_size = 2;
+    l_profile.max_block_col_size = 2;
+
+    // Larger blocks are cheaper per value: 2x2 despite its fill
+    for ( int r = 0; r < 2; r++ ) {
+        for ( int c = 0; c < 2; c++ ) {
+            l_profile.cost_per_value[r][c] = 1.0 / double( ( r + 1 ) * ( c + 1 ) );
+        }
+    }
+    l_diff_detected |= checkTuning("block cost", l_matrix, l_profile, 2, 2, 16.0 / 14.0 / 4.0);
+
+    // The fill of 2x2 outweighs its lower cost per value: 2x1 has no fill
+    l_profile.cost_per_value[1][1] = 0.5;
+    l_diff_detected |= checkTuning("fill cost", l_matrix, l_profile, 2, 1, 0.5);
+
+    // Same cost per value: 1x1 and 2x1 have no fill, the smallest shape is kept
+    for ( int r = 0; r < 2; r++ ) {
+        for ( int c = 0; c < 2; c++ ) {
+            l_profile.cost_per_value[r][c] = 1.0;
+        }
+    }
+    l_diff_detected |= checkTuning("same cost", l_matrix, l_profile, 1, 1, 1.0);
+
+    /*
+     * 2x2 BCSR storage of the matrix: 7 columns, so the last block column (columns 6 and 7) is padded with zeros
+     */
+    int l_bptr[] = {0,1,2,4};
+    int l_bind[] = {0,2,4,6};
+    double l_bval[] = {1,2,2,3, 5,6,6,7, 9,10,10,11, 11,0,12,0};
+
+    _dmatBCSR_t l_bcsr = {0};
+    l_bcsr.row_block_size = 2;
+    l_bcsr.col_block_size = 2;
+    l_bcsr.num_block_rows = 3;
+    l_bcsr.num_block_cols = 4;
+    l_bcsr.bptr = l_bptr;
+    l_bcsr.bind = l_bind;
+    l_bcsr.bval = l_bval;
+
+    _oski_mat_t l_bcsr_repr;
+    l_bcsr_repr.type_id = BCSR;
+    l_bcsr_repr.repr = &l_bcsr;
+
+    _matrix_t l_bcsr_matrix;
+    l_bcsr_matrix.m = TEST_M;
+    l_bcsr_matrix.n = TEST_N;
+    l_bcsr_matrix.base_index = 0;
+    l_bcsr_matrix.lda = 0;
+    l_bcsr_matrix.format = MATRIX_ROW_MAJOR;
+    l_bcsr_matrix.type_matrix = BCSR;
+    l_bcsr_matrix.type_value = REAL_VALUE;
+    l_bcsr_matrix.matrix = &l_bcsr_repr;
+
+    l_diff_detected |= checkProduct("BCSR vgemvd", &l_bcsr_matrix, 1);
+    l_diff_detected |= checkProduct("BCSR vgemmd", &l_bcsr_matrix, 2);
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
@@ -0,0 +1,236 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks that vgemmd gives the results of vgemvd for each vector, that cg_multi gives the solutions of
+ *                 k cg solves and that block_cg converges to them, and reports the solve times.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include <iostream>
+#include <vector>
+
+#include "Matrix/matrix.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSolvers.hpp"
+#include "OSKIHelper.hpp"
+#include "../common/solver_test_helpers.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * Returns true when both numbers have the same bits in their first a_nb_chunks mantissa chunks and the same value
+ * when converted to double.
+ */
+bool sameBits(const VPFloat & a_lhs, const VPFloat & a_rhs, int a_nb_chunks) {
+    if ( double(a_lhs) != double(a_rhs) ) {
+        return false;
+    }
+
+    for ( int l_chunk = 0 ; l_chunk < a_nb_chunks; l_chunk++ ) {
+        if ( a_lhs.mantissaChunk(l_chunk) != a_rhs.mantissaChunk(l_chunk) ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Y = 2 A X + 0.5 Y with vgemmd, and with vgemvd for each vector: the results must be the same.
+ */
+bool checkVgemmd(const char * a_name, int a_precision, char a_trans, matrix_t a_matrix, int a_k) {
+    int l_n = a_matrix->n;
+    short l_exponent_size = 11;
+    short l_bis = a_precision + l_exponent_size + 1;
+
+    VPFloatComputingEnvironment::set_precision(l_bis);
+    VPFloatComputingEnvironment::set_tempory_var_environment(l_exponent_size, l_bis, 1);
+
+    VPFloatArray l_x(l_exponent_size, l_bis, 1, l_n * a_k);
+    VPFloatArray l_y(l_exponent_size, l_bis, 1, l_n * a_k);
+    VPFloatArray l_y_ref(l_exponent_size, l_bis, 1, l_n * a_k);
+    VPFloat l_beta(l_exponent_size, l_bis, 1);
+
+    l_beta = 0.5;
+    for ( int i = 0; i < l_n * a_k; i++ ) {
+        l_x[i] = sin(0.37 * i) + 1.0 / 3.0;
+        l_y[i] = cos(0.11 * i);
+        l_y_ref[i] = cos(0.11 * i);
+    }
+
+    VBLAS::vgemmd(a_precision, a_trans, l_n, l_n, a_k, 2.0, a_matrix, l_x, l_beta, l_y);
+
+    for ( int j = 0; j < a_k; j++ ) {
+        VPFloatArray l_x_j(l_x, j * l_n, l_n);
+        VPFloatArray l_y_j(l_y_ref, j * l_n, l_n);
+
+        VBLAS::vgemvd(a_precision, a_trans, l_n, l_n, 2.0, a_matrix, l_x_j, l_beta, l_y_j);
+    }
+
+    for ( int i = 0; i < l_n * a_k; i++ ) {
+        if ( ! sameBits(l_y[i], l_y_ref[i], a_precision / 64) ) {
+            std::cout << a_name << " : vgemmd y[" << i << "] differs " << double(l_y_ref[i]) << " " << double(l_y[i]) << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Solves A X = B for a_k right hand sides with a_k cg calls, with cg_multi and with block_cg. The solutions of cg and
+ * cg_multi must be the same, block_cg must give them up to the tolerance.
+ */
+bool checkBlockCG(const char * a_name, int a_precision, matrix_t a_matrix, int a_k, double a_tolerance) {
+    int l_n = a_matrix->n;
+    uint16_t l_exponent_size = 11;
+    std::vector<double> l_b(l_n * a_k), l_x(l_n * a_k, 0.0), l_multi_x(l_n * a_k, 0.0), l_block_x(l_n * a_k, 0.0);
+    struct timespec l_start;
+    int l_rc = 0;
+
+    for ( int i = 0; i < l_n * a_k; i++ ) {
+        l_b[i] = sin(0.37 * i) + 1.0 / 3.0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    for ( int j = 0; j < a_k; j++ ) {
+        int l_rc_j = Solver::cg(a_precision, 0, l_n, l_x.data() + j * l_n, a_matrix, l_b.data() + j * l_n, a_tolerance, l_exponent_size);
+
+        l_rc = ( l_rc < 0 || l_rc_j < 0 ) ? -1 : std::max(l_rc, l_rc_j);
+    }
+    double l_duration = elapsed(l_start);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_multi_rc = Solver::cg_multi(a_precision, 0, l_n, a_k, l_multi_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+    double l_multi_duration = elapsed(l_start);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_block_rc = Solver::block_cg(a_precision, 0, l_n, a_k, l_block_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+    double l_block_duration = elapsed(l_start);
+
+    printf("%-16s %4d bits k=%d : %d x CG %5d iterations %8.3f s - CG_MULTI %5d iterations %8.3f s - BLOCK_CG %5d iterations %8.3f s\n",
+        a_name, a_precision, a_k,
+        a_k, l_rc, l_duration,
+        l_multi_rc, l_multi_duration,
+        l_block_rc, l_block_duration);
+
+    if ( l_rc < 0 || l_multi_rc < 0 || l_block_rc < 0 ) {
+        std::cout << a_name << " : no convergence" << std::endl;
+        return true;
+    }
+
+    if ( l_multi_rc != l_rc ) {
+        std::cout << a_name << " : CG_MULTI iterations differ " << l_rc << " " << l_multi_rc << std::endl;
+        return true;
+    }
+
+    for ( int i = 0; i < l_n * a_k; i++ ) {
+        if ( l_x[i] != l_multi_x[i] ) {
+            std::cout << a_name << " : CG_MULTI x[" << i << "] differs " << l_x[i] << " " << l_multi_x[i] << std::endl;
+            return true;
+        }
+        if ( fabs(l_x[i] - l_block_x[i]) > 1e-12 * ( 1.0 + fabs(l_x[i]) ) ) {
+            std::cout << a_name << " : BLOCK_CG x[" << i << "] differs " << l_x[i] << " " << l_block_x[i] << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Solves A X = B with cg_multi and block_cg, B holding b_0, b_0 again, 0, 2 b_0 and b_4: the deflation of the block
+ * CG drops the dependent directions, the solutions must be x_0, x_0, 0, 2 x_0 and x_4.
+ */
+bool checkDegenerateBlockCG(const char * a_name, int a_precision, matrix_t a_matrix, double a_tolerance) {
+    int l_n = a_matrix->n;
+    int l_k = 5;
+    uint16_t l_exponent_size = 11;
+    std::vector<double> l_b(l_n * l_k), l_x(l_n * 2, 0.0), l_multi_x(l_n * l_k, 0.0), l_block_x(l_n * l_k, 0.0);
+    double l_scales[] = {1.0, 1.0, 0.0, 2.0};
+
+    for ( int i = 0; i < l_n; i++ ) {
+        for ( int j = 0; j < 4; j++ ) {
+            l_b[i + j * l_n] = l_scales[j] * ( sin(0.37 * i) + 1.0 / 3.0 );
+        }
+        l_b[i + 4 * l_n] = cos(0.11 * i);
+    }
+
+    int l_rc = Solver::cg(a_precision, 0, l_n, l_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+    l_rc = std::min(l_rc, Solver::cg(a_precision, 0, l_n, l_x.data() + l_n, a_matrix, l_b.data() + 4 * l_n, a_tolerance, l_exponent_size));
+
+    int l_multi_rc = Solver::cg_multi(a_precision, 0, l_n, l_k, l_multi_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+    int l_block_rc = Solver::block_cg(a_precision, 0, l_n, l_k, l_block_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+
+    printf("%-16s %4d bits k=%d : CG_MULTI %5d iterations - BLOCK_CG %5d iterations\n", a_name, a_precision, l_k, l_multi_rc, l_block_rc);
+
+    if ( l_rc < 0 || l_multi_rc < 0 || l_block_rc < 0 ) {
+        std::cout << a_name << " : no convergence" << std::endl;
+        return true;
+    }
+
+    for ( int i = 0; i < l_n; i++ ) {
+        double l_expected_x[] = {l_x[i], l_x[i], 0.0, 2.0 * l_x[i], l_x[i + l_n]};
+
+        for ( int j = 0; j < l_k; j++ ) {
+            if ( fabs(l_expected_x[j] - l_multi_x[i + j * l_n]) > 1e-12 * ( 1.0 + fabs(l_expected_x[j]) ) ) {
+                std::cout << a_name << " : CG_MULTI x[" << i + j * l_n << "] differs " << l_expected_x[j] << " " << l_multi_x[i + j * l_n] << std::endl;
+                return true;
+            }
+            if ( fabs(l_expected_x[j] - l_block_x[i + j * l_n]) > 1e-12 * ( 1.0 + fabs(l_expected_x[j]) ) ) {
+                std::cout << a_name << " : BLOCK_CG x[" << i + j * l_n << "] differs " << l_expected_x[j] << " " << l_block_x[i + j * l_n] << std::endl;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+
+    matrix_t l_matrix = buildLaplacian(12, 0.01);
+    matrix_t l_bcsr_matrix = OSKIHelper::toBCSR(OSKIHelper::fromCSRMatrix(l_matrix), 3, 3);
+
+    l_diff_detected |= checkVgemmd("CSR", 256, 'N', l_matrix, 4);
+    l_diff_detected |= checkVgemmd("CSR transposed", 256, 'T', l_matrix, 4);
+    l_diff_detected |= checkVgemmd("BCSR", 256, 'N', l_bcsr_matrix, 4);
+
+    l_diff_detected |= checkBlockCG("laplacian", 256, l_matrix, 1, 1e-30);
+    l_diff_detected |= checkBlockCG("laplacian", 256, l_matrix, 8, 1e-30);
+    l_diff_detected |= checkBlockCG("laplacian BCSR", 256, l_bcsr_matrix, 8, 1e-30);
+    l_diff_detected |= checkDegenerateBlockCG("laplacian", 256, l_matrix, 1e-30);
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
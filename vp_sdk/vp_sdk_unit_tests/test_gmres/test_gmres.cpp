@@ -0,0 +1,177 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks GMRES(m) and FGMRES on nonsymmetric systems against BICGSTAB, including systems on which
+ *                 BICGSTAB breaks down, and reports the number of matrix-vector products of each solver.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Matrix/matrix.h"
+#include "Matrix/CSR.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSolvers.hpp"
+#include "OSKIHelper.hpp"
+#include "../common/solver_test_helpers.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * Returns true when a_x differs from a_reference_x.
+ */
+bool compareSolutions(const char * a_name, const char * a_solver_name, const std::vector<double> & a_reference_x, const std::vector<double> & a_x) {
+    for ( size_t i = 0; i < a_x.size(); i++ ) {
+        if ( fabs(a_reference_x[i] - a_x[i]) > 1e-12 * ( 1.0 + fabs(a_reference_x[i]) ) ) {
+            std::cout << a_name << " : " << a_solver_name << " x[" << i << "] differs " << a_reference_x[i] << " " << a_x[i] << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Solves A x = b with BICGSTAB, GMRES(a_restart) and FGMRES(a_restart) preconditioned by Jacobi. The GMRES solutions
+ * are checked with their residual, and compared to the BICGSTAB one when BICGSTAB converges. BICGSTAB makes two
+ * matrix-vector products per iteration, GMRES one, FGMRES one plus one with the preconditioner.
+ */
+bool checkGMRES(const char * a_name, int a_precision, matrix_t a_matrix, int a_restart, double a_tolerance) {
+    int l_n = a_matrix->n;
+    uint16_t l_exponent_size = 11;
+    std::vector<double> l_b(l_n), l_x(l_n, 0.0), l_gmres_x(l_n, 0.0), l_fgmres_x(l_n, 0.0);
+    matrix_t l_jacobi = buildJacobi(a_matrix);
+    struct timespec l_start;
+    bool l_diff_detected = false;
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_b[i] = sin(0.37 * i) + 1.0 / 3.0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_rc = Solver::bicgstab(a_precision, 0, l_n, l_x.data(), a_matrix, NULL, l_b.data(), a_tolerance, l_exponent_size);
+    double l_duration = elapsed(l_start);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_gmres_rc = Solver::gmres(a_precision, 0, l_n, l_gmres_x.data(), a_matrix, l_b.data(), a_tolerance, a_restart, l_exponent_size);
+    double l_gmres_duration = elapsed(l_start);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_fgmres_rc = Solver::fgmres(a_precision, 0, l_n, l_fgmres_x.data(), a_matrix, l_jacobi, l_b.data(), a_tolerance, a_restart, l_exponent_size);
+    double l_fgmres_duration = elapsed(l_start);
+
+    printf("%-16s %4d bits : BICGSTAB %5d SpMV %8.3f s - GMRES(%d) %5d SpMV %8.3f s - FGMRES(%d) %5d SpMV %8.3f s\n",
+        a_name, a_precision,
+        ( l_rc < 0 ) ? l_rc : 2 * l_rc, l_duration,
+        a_restart, l_gmres_rc, l_gmres_duration,
+        a_restart, l_fgmres_rc, l_fgmres_duration);
+
+    if ( l_gmres_rc < 0 || l_fgmres_rc < 0 ) {
+        std::cout << a_name << " : no convergence" << std::endl;
+        return true;
+    }
+
+    /*
+     * The residual of the double solution is bounded by the rounding of x to doubles.
+     */
+    double l_gmres_residual = trueResidual(a_matrix, l_gmres_x, l_b);
+    double l_fgmres_residual = trueResidual(a_matrix, l_fgmres_x, l_b);
+
+    if ( l_gmres_residual > 1e-10 || l_fgmres_residual > 1e-10 ) {
+        std::cout << a_name << " : residual too large " << l_gmres_residual << " " << l_fgmres_residual << std::endl;
+        return true;
+    }
+
+    if ( l_rc >= 0 ) {
+        l_diff_detected |= compareSolutions(a_name, "GMRES", l_x, l_gmres_x);
+        l_diff_detected |= compareSolutions(a_name, "FGMRES", l_x, l_fgmres_x);
+    }
+
+    return l_diff_detected;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+
+    l_diff_detected |= checkGMRES("upwind 1", 256, buildConvectionDiffusion(16, 1.0, false), 30, 1e-30);
+    l_diff_detected |= checkGMRES("upwind 1", 256, buildConvectionDiffusion(16, 1.0, false), 10, 1e-30);
+
+    /*
+     * BICGSTAB breaks down on strong centered convection, GMRES converges.
+     */
+    l_diff_detected |= checkGMRES("centered 10", 256, buildConvectionDiffusion(16, 10.0, true), 30, 1e-30);
+
+    /*
+     * A restart above n is reduced to n, a restart below 1 is rejected.
+     */
+    matrix_t l_small_matrix = buildConvectionDiffusion(4, 1.0, false);
+    int l_small_n = l_small_matrix->n;
+
+    for ( int l_restart : {100, 0, -3} ) {
+        std::vector<double> l_b(l_small_n, 1.0), l_x(l_small_n, 0.0);
+        int l_rc = Solver::gmres(256, 0, l_small_n, l_x.data(), l_small_matrix, l_b.data(), 1e-30, l_restart, 11);
+
+        if ( ( l_restart < 1 ) != ( l_rc < 0 ) ) {
+            std::cout << "GMRES(" << l_restart << ") : unexpected return " << l_rc << std::endl;
+            l_diff_detected = true;
+        } else if ( ( l_rc >= 0 ) && ( trueResidual(l_small_matrix, l_x, l_b) > 1e-10 ) ) {
+            std::cout << "GMRES(" << l_restart << ") : residual too large " << trueResidual(l_small_matrix, l_x, l_b) << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    /*
+     * Matrices of the matrix repository.
+     */
+    const char * l_matrix_repo_path = getenv("MATRIX_REPO_PATH");
+
+    if ( l_matrix_repo_path != NULL ) {
+        for ( const char * l_matrix_name : {"bcsstk01.mtx"} ) {
+            std::string l_matrix_file_path = std::string(l_matrix_repo_path) + "/" + l_matrix_name;
+
+            oski_matrix_wrapper_t l_oski_matrix = OSKIHelper::loadFromFile((char *)l_matrix_file_path.c_str());
+
+            if ( l_oski_matrix.oski_matrix.real_matrix == NULL ) {
+                std::cout << "Fail loading " << l_matrix_file_path << std::endl;
+                l_diff_detected = true;
+                continue;
+            }
+
+            l_diff_detected |= checkGMRES(l_matrix_name, 256, OSKIHelper::toMatrix(l_oski_matrix), 30, 1e-20);
+        }
+    }
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
@@ -0,0 +1,380 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Saves CSR, half stored symmetric CSR, BCSR and DENSE matrices in a binary matrix file, maps them
+ *                 back and compares them with the original ones. Checks that files of another source or with a
+ *                 corrupted header are refused, and that the BCSR serializer writes exactly the size it reports.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Matrix/matrix.h"
+#include "Matrix/CSR.h"
+#include "Matrix/BCSR.h"
+#include "Matrix/DENSE.h"
+#include "VRPOffload/vrp_Matrix_file.hpp"
+#include "VRPOffload/vrp_Matrix_serializer.hpp"
+
+using namespace VPFloatPackage::Offloading;
+
+#define TEST_SOURCE_HASH 0x0123456789abcdefULL
+
+/*
+ * 4 x 5 general matrix, 1-based
+ */
+static int s_row_ptr[] = {1,3,4,7,8};
+static int s_col_ind[] = {1,5,2,1,3,4,5};
+static double s_val[] = {1.5,-2,3,4,5.25,-6,7};
+
+/*
+ * 4 x 4 symmetric matrix stored by its lower triangle, 0-based
+ */
+static int s_half_row_ptr[] = {0,1,3,5,7};
+static int s_half_col_ind[] = {0,0,1,1,2,0,3};
+static double s_half_val[] = {4,-1,5,-2,6,0.5,7};
+
+/*
+ * 5 x 5 matrix in 2x2 blocks: two block rows of three block columns (the last one padded), the fifth row being a
+ * leftover BCSR of 1x2 blocks
+ */
+static int s_bptr[] = {0,2,3};
+static int s_bind[] = {0,4,2};
+static double s_bval[] = {1,2,3,4, 5,0,6,0, 7,8,9,10};
+static int s_leftover_bptr[] = {0,2};
+static int s_leftover_bind[] = {0,3};
+static double s_leftover_bval[] = {11,12, 13,14};
+static char s_mod_name[] = "bcsr_2x2";
+static char s_leftover_mod_name[] = "";
+
+/*
+ * 3 x 2 DENSE matrix, row major with a leading dimension of 3
+ */
+static double s_dense_val[] = {1,2,0, 3,4,0, 5,6,0};
+
+static matrix_t buildMatrix(int a_m, int a_n, int a_base_index, int a_lda, types_e a_type_matrix, void * a_repr) {
+    matrix_t l_matrix = (matrix_t)malloc(sizeof(_matrix_t));
+
+    l_matrix->m = a_m;
+    l_matrix->n = a_n;
+    l_matrix->base_index = a_base_index;
+    l_matrix->lda = a_lda;
+    l_matrix->format = MATRIX_ROW_MAJOR;
+    l_matrix->type_matrix = a_type_matrix;
+    l_matrix->type_value = REAL_VALUE;
+    l_matrix->matrix = (oski_mat_t)malloc(sizeof(_oski_mat_t));
+    l_matrix->matrix->type_id = a_type_matrix;
+    l_matrix->matrix->repr = a_repr;
+
+    return l_matrix;
+}
+
+static bool compareArrays(const char * a_name, const char * a_field, const void * a_mapped, const void * a_original, size_t a_size) {
+    if ( memcmp(a_mapped, a_original, a_size) != 0 ) {
+        std::cout << a_name << " : " << a_field << " differs" << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+static bool compareBCSR(const char * a_name, dmatBCSR_t a_mapped, dmatBCSR_t a_original) {
+    int l_nb_blocks = a_original->bptr[a_original->num_block_rows] - a_original->bptr[0];
+    bool l_diff_detected = false;
+
+    if ( ( a_mapped->row_block_size != a_original->row_block_size ) || ( a_mapped->col_block_size != a_original->col_block_size )
+      || ( a_mapped->num_block_rows != a_original->num_block_rows ) || ( a_mapped->num_block_cols != a_original->num_block_cols )
+      || ( a_mapped->num_rows_leftover != a_original->num_rows_leftover ) || ( strcmp(a_mapped->mod_name, a_original->mod_name) != 0 ) ) {
+        std::cout << a_name << " : BCSR fields differ" << std::endl;
+        return true;
+    }
+
+    l_diff_detected |= compareArrays(a_name, "bptr", a_mapped->bptr, a_original->bptr, sizeof(int) * ( a_original->num_block_rows + 1 ));
+    l_diff_detected |= compareArrays(a_name, "bind", a_mapped->bind, a_original->bind, sizeof(int) * l_nb_blocks);
+    l_diff_detected |= compareArrays(a_name, "bval", a_mapped->bval, a_original->bval,
+                                     sizeof(double) * l_nb_blocks * a_original->row_block_size * a_original->col_block_size);
+
+    if ( a_original->num_rows_leftover != 0 ) {
+        l_diff_detected |= compareBCSR(a_name, a_mapped->leftover, a_original->leftover);
+    }
+
+    return l_diff_detected;
+}
+
+/*
+ * Compares a mapped matrix with the one it was saved from, and the serialized matrix kept for offloading.
+ */
+static bool compareMatrix(const char * a_name, matrix_t a_mapped, matrix_t a_original) {
+    bool l_diff_detected = false;
+    size_t l_flat_size = 0;
+
+    if ( a_mapped == NULL ) {
+        std::cout << a_name << " : matrix not found" << std::endl;
+        return true;
+    }
+
+    if ( ( a_mapped->m != a_original->m ) || ( a_mapped->n != a_original->n ) || ( a_mapped->base_index != a_original->base_index )
+      || ( a_mapped->lda != a_original->lda ) || ( a_mapped->format != a_original->format )
+      || ( a_mapped->type_matrix != a_original->type_matrix ) || ( a_mapped->type_value != a_original->type_value )
+      || ( a_mapped->matrix->type_id != a_original->matrix->type_id ) ) {
+        std::cout << a_name << " : matrix fields differ" << std::endl;
+        return true;
+    }
+
+    if ( ( VRP_Matrix_file::getFlatMatrix(a_mapped, &l_flat_size) == NULL ) || ( l_flat_size != VRP_Matrix_serializer::getSize(a_original) ) ) {
+        std::cout << a_name << " : serialized matrix of " << l_flat_size << " bytes instead of " << VRP_Matrix_serializer::getSize(a_original) << std::endl;
+        l_diff_detected = true;
+    }
+
+    if ( a_original->type_matrix == CSR ) {
+        dmatCSR_t l_mapped = (dmatCSR_t)a_mapped->matrix->repr;
+        dmatCSR_t l_original = (dmatCSR_t)a_original->matrix->repr;
+        int l_nnz = l_original->ptr[a_original->m] - l_original->base_index;
+
+        if ( ( l_mapped->base_index != l_original->base_index ) || ( l_mapped->stored.is_upper != l_original->stored.is_upper )
+          || ( l_mapped->stored.is_lower != l_original->stored.is_lower ) ) {
+            std::cout << a_name << " : CSR fields differ" << std::endl;
+            return true;
+        }
+
+        l_diff_detected |= compareArrays(a_name, "ptr", l_mapped->ptr, l_original->ptr, sizeof(int) * ( a_original->m + 1 ));
+        l_diff_detected |= compareArrays(a_name, "ind", l_mapped->ind, l_original->ind, sizeof(int) * l_nnz);
+        l_diff_detected |= compareArrays(a_name, "val", l_mapped->val, l_original->val, sizeof(double) * l_nnz);
+    } else if ( a_original->type_matrix == BCSR ) {
+        l_diff_detected |= compareBCSR(a_name, (dmatBCSR_t)a_mapped->matrix->repr, (dmatBCSR_t)a_original->matrix->repr);
+    } else if ( a_original->type_matrix == DENSE ) {
+        dmatDENSE_t l_mapped = (dmatDENSE_t)a_mapped->matrix->repr;
+        dmatDENSE_t l_original = (dmatDENSE_t)a_original->matrix->repr;
+
+        if ( l_mapped->lead_dim != l_original->lead_dim ) {
+            std::cout << a_name << " : DENSE fields differ" << std::endl;
+            return true;
+        }
+
+        l_diff_detected |= compareArrays(a_name, "val", l_mapped->val, l_original->val, sizeof(double) * a_original->m * a_original->lda);
+    }
+
+    return l_diff_detected;
+}
+
+/*
+ * Writes a copy of a_file_path with a_size bytes at a_offset replaced by a_bytes (a_size bytes kept at most when
+ * a_bytes is NULL), and checks the copy is refused.
+ */
+static bool checkCorruptedFile(const char * a_name, const std::string & a_file_path, size_t a_offset, const void * a_bytes, size_t a_size) {
+    std::string l_corrupted_path = a_file_path + ".corrupted";
+    std::vector<char> l_content;
+    FILE * l_file = fopen(a_file_path.c_str(), "rb");
+    char l_buffer[4096];
+    size_t l_read;
+
+    while ( ( l_read = fread(l_buffer, 1, sizeof(l_buffer), l_file) ) > 0 ) {
+        l_content.insert(l_content.end(), l_buffer, l_buffer + l_read);
+    }
+    fclose(l_file);
+
+    if ( a_bytes != NULL ) {
+        memcpy(l_content.data() + a_offset, a_bytes, a_size);
+    } else {
+        l_content.resize(a_size);
+    }
+
+    l_file = fopen(l_corrupted_path.c_str(), "wb");
+    fwrite(l_content.data(), 1, l_content.size(), l_file);
+    fclose(l_file);
+
+    vrp_matrix_file_t * l_mapped_file = VRP_Matrix_file::map(l_corrupted_path.c_str(), 0);
+
+    unlink(l_corrupted_path.c_str());
+
+    if ( l_mapped_file != NULL ) {
+        std::cout << a_name << " : corrupted file accepted" << std::endl;
+        VRP_Matrix_file::unmap(l_mapped_file);
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Serializes a matrix in a buffer of the size reported by getSize followed by guard bytes, and checks the
+ * serialization ends at the reported size.
+ */
+static bool checkSerializedSize(const char * a_name, matrix_t a_matrix) {
+    size_t l_size = VRP_Matrix_serializer::getSize(a_matrix);
+    size_t l_guard_size = 256;
+    unsigned char * l_buffer = (unsigned char *)aligned_alloc(64, ( ( l_size + l_guard_size + 63 ) / 64 ) * 64);
+    uint64_t l_free_address = (uint64_t)l_buffer;
+    bool l_diff_detected = false;
+
+    memset(l_buffer, 0xA5, l_size + l_guard_size);
+
+    VRP_Matrix_serializer::flaten(a_matrix, &l_free_address);
+
+    if ( l_free_address - (uint64_t)l_buffer != l_size ) {
+        std::cout << a_name << " : " << l_free_address - (uint64_t)l_buffer << " bytes serialized instead of " << l_size << std::endl;
+        l_diff_detected = true;
+    }
+
+    for ( size_t l_index = l_size; l_index < l_size + l_guard_size; l_index++ ) {
+        if ( l_buffer[l_index] != 0xA5 ) {
+            std::cout << a_name << " : byte " << l_index << " written past the end of the buffer" << std::endl;
+            l_diff_detected = true;
+            break;
+        }
+    }
+
+    free(l_buffer);
+
+    return l_diff_detected;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+    char l_directory[] = "/tmp/test_matrix_file_XXXXXX";
+
+    if ( mkdtemp(l_directory) == NULL ) {
+        std::cout << "Can not create a temporary directory" << std::endl;
+        exit(1);
+    }
+
+    /*
+     * Matrices of the files
+     */
+    matrix_t l_csr = buildCSR(4, 5, s_row_ptr, s_col_ind, s_val, 1);
+    matrix_t l_half_csr = buildSymmetricCSR(4, s_half_row_ptr, s_half_col_ind, s_half_val, 0, 'L');
+
+    _dmatBCSR_t l_leftover = {0};
+    l_leftover.row_block_size = 1;
+    l_leftover.col_block_size = 2;
+    l_leftover.num_block_rows = 1;
+    l_leftover.num_block_cols = 3;
+    l_leftover.bptr = s_leftover_bptr;
+    l_leftover.bind = s_leftover_bind;
+    l_leftover.bval = s_leftover_bval;
+    l_leftover.mod_name = s_leftover_mod_name;
+
+    _dmatBCSR_t l_bcsr_repr = {0};
+    l_bcsr_repr.row_block_size = 2;
+    l_bcsr_repr.col_block_size = 2;
+    l_bcsr_repr.num_block_rows = 2;
+    l_bcsr_repr.num_block_cols = 3;
+    l_bcsr_repr.bptr = s_bptr;
+    l_bcsr_repr.bind = s_bind;
+    l_bcsr_repr.bval = s_bval;
+    l_bcsr_repr.num_rows_leftover = 1;
+    l_bcsr_repr.leftover = &l_leftover;
+    l_bcsr_repr.mod_name = s_mod_name;
+
+    matrix_t l_bcsr = buildMatrix(5, 5, 0, 0, BCSR, &l_bcsr_repr);
+
+    _dmatDENSE_t l_dense_repr = {3, s_dense_val};
+    matrix_t l_dense = buildMatrix(3, 2, 0, 3, DENSE, &l_dense_repr);
+
+    /*
+     * The BCSR serializer writes the size field of the values: getSize accounts for it
+     */
+    l_diff_detected |= checkSerializedSize("BCSR size", l_bcsr);
+    l_diff_detected |= checkSerializedSize("CSR size", l_csr);
+    l_diff_detected |= checkSerializedSize("DENSE size", l_dense);
+
+    /*
+     * Save and map back: A and A^T in CSR, the preconditioners in BCSR and DENSE
+     */
+    std::string l_file_path = std::string(l_directory) + "/matrices.vpm";
+    std::string l_half_file_path = std::string(l_directory) + "/half.vpm";
+    matrix_t l_matrices[VRP_MATRIX_FILE_NB_ROLES] = { l_csr, l_csr, l_bcsr, l_dense };
+    matrix_t l_half_matrices[VRP_MATRIX_FILE_NB_ROLES] = { l_half_csr, NULL, NULL, NULL };
+
+    if ( ( VRP_Matrix_file::save(l_file_path.c_str(), TEST_SOURCE_HASH, l_matrices) != EXIT_SUCCESS )
+      || ( VRP_Matrix_file::save(l_half_file_path.c_str(), TEST_SOURCE_HASH, l_half_matrices) != EXIT_SUCCESS ) ) {
+        std::cout << "Fail saving the matrix files" << std::endl;
+        exit(1);
+    }
+
+    vrp_matrix_file_t * l_mapped_file = VRP_Matrix_file::map(l_file_path.c_str(), TEST_SOURCE_HASH);
+
+    if ( l_mapped_file == NULL ) {
+        std::cout << "Fail mapping " << l_file_path << std::endl;
+        l_diff_detected = true;
+    } else {
+        l_diff_detected |= compareMatrix("CSR", VRP_Matrix_file::getMatrix(l_mapped_file, VRP_MATRIX_FILE_A), l_csr);
+        l_diff_detected |= compareMatrix("CSR transposed", VRP_Matrix_file::getMatrix(l_mapped_file, VRP_MATRIX_FILE_A_TRANSPOSED), l_csr);
+        l_diff_detected |= compareMatrix("BCSR", VRP_Matrix_file::getMatrix(l_mapped_file, VRP_MATRIX_FILE_PRECONDITIONER), l_bcsr);
+        l_diff_detected |= compareMatrix("DENSE", VRP_Matrix_file::getMatrix(l_mapped_file, VRP_MATRIX_FILE_PRECONDITIONER_TRANSPOSED), l_dense);
+        VRP_Matrix_file::unmap(l_mapped_file);
+    }
+
+    l_mapped_file = VRP_Matrix_file::map(l_half_file_path.c_str(), 0);
+
+    if ( l_mapped_file == NULL ) {
+        std::cout << "Fail mapping " << l_half_file_path << std::endl;
+        l_diff_detected = true;
+    } else {
+        l_diff_detected |= compareMatrix("CSR half", VRP_Matrix_file::getMatrix(l_mapped_file, VRP_MATRIX_FILE_A), l_half_csr);
+
+        if ( VRP_Matrix_file::getMatrix(l_mapped_file, VRP_MATRIX_FILE_PRECONDITIONER) != NULL ) {
+            std::cout << "CSR half : unexpected preconditioner" << std::endl;
+            l_diff_detected = true;
+        }
+        VRP_Matrix_file::unmap(l_mapped_file);
+    }
+
+    /*
+     * Files built from another source or with a corrupted header are refused
+     */
+    l_mapped_file = VRP_Matrix_file::map(l_file_path.c_str(), TEST_SOURCE_HASH + 1);
+
+    if ( l_mapped_file != NULL ) {
+        std::cout << "stale source hash : file accepted" << std::endl;
+        VRP_Matrix_file::unmap(l_mapped_file);
+        l_diff_detected = true;
+    }
+
+    uint64_t l_bad_version = VRP_MATRIX_FILE_VERSION + 1;
+    uint64_t l_bad_nb_sections = VRP_MATRIX_FILE_NB_ROLES + 1;
+    uint64_t l_bad_offset = VRP_MATRIX_FILE_ALIGNMENT + 8;
+    uint64_t l_bad_size = 1ULL << 40;
+
+    l_diff_detected |= checkCorruptedFile("magic", l_file_path, 0, "VPMATRIZ", 8);
+    l_diff_detected |= checkCorruptedFile("version", l_file_path, offsetof(vrp_matrix_file_header_t, version), &l_bad_version, sizeof(uint64_t));
+    l_diff_detected |= checkCorruptedFile("nb_sections", l_file_path, offsetof(vrp_matrix_file_header_t, nb_sections), &l_bad_nb_sections, sizeof(uint64_t));
+    l_diff_detected |= checkCorruptedFile("section offset", l_file_path, sizeof(vrp_matrix_file_header_t) + offsetof(vrp_matrix_file_section_t, offset), &l_bad_offset, sizeof(uint64_t));
+    l_diff_detected |= checkCorruptedFile("section size", l_file_path, sizeof(vrp_matrix_file_header_t) + offsetof(vrp_matrix_file_section_t, size), &l_bad_size, sizeof(uint64_t));
+    l_diff_detected |= checkCorruptedFile("truncated header", l_file_path, 0, NULL, sizeof(vrp_matrix_file_header_t) / 2);
+    l_diff_detected |= checkCorruptedFile("truncated sections", l_file_path, 0, NULL, sizeof(vrp_matrix_file_header_t) + sizeof(vrp_matrix_file_section_t));
+
+    unlink(l_file_path.c_str());
+    unlink(l_half_file_path.c_str());
+    rmdir(l_directory);
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
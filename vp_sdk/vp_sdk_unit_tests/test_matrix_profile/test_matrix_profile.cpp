@@ -0,0 +1,313 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks the structure analysis of small matrices with a known bandwidth, symmetry, row length
+ *                 spread and block fill, the recommended format on each side of the thresholds and the JSON profile.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Matrix/matrix.h"
+#include "Matrix/matrix_profile.h"
+
+/*
+ * 4 x 4 symmetric matrix, 8 non zero values, strictly diagonally dominant:
+ *
+ *   4 -1  .  .
+ *  -1  4  . -1
+ *   .  .  4  .
+ *   . -1  .  4
+ */
+static int s_row_ptr[] = {0,2,5,6,8};
+static int s_col_ind[] = {0,1,0,1,3,2,1,3};
+static double s_val[] = {4,-1,-1,4,-1,4,-1,4};
+
+// Same matrix stored by its lower triangle
+static int s_half_row_ptr[] = {0,1,3,4,6};
+static int s_half_col_ind[] = {0,0,1,2,1,3};
+static double s_half_val[] = {4,-1,4,4,-1,4};
+
+// Same structure, a_31 = -5: not numerically symmetric and row 3 not dominant
+static double s_unsymmetric_val[] = {4,-1,-1,4,-1,4,-5,4};
+
+// a_13 removed: not structurally symmetric
+static int s_unstructured_row_ptr[] = {0,2,4,5,7};
+static int s_unstructured_col_ind[] = {0,1,0,1,2,1,3};
+static double s_unstructured_val[] = {4,-1,-1,4,4,-1,4};
+
+/*
+ * CSR arrays of generated matrices
+ */
+typedef struct test_matrix {
+    std::vector<int> row_ptr;
+    std::vector<int> col_ind;
+    std::vector<double> val;
+} test_matrix_t;
+
+static matrix_t buildTestMatrix(test_matrix_t & a_arrays, int a_n) {
+    return buildCSR(a_n, a_n, a_arrays.row_ptr.data(), a_arrays.col_ind.data(), a_arrays.val.data(), 0);
+}
+
+static void addRow(test_matrix_t & a_arrays, const std::vector<int> & a_cols) {
+    if ( a_arrays.row_ptr.empty() ) {
+        a_arrays.row_ptr.push_back(0);
+    }
+
+    for ( int l_col : a_cols ) {
+        a_arrays.col_ind.push_back(l_col);
+        a_arrays.val.push_back(1.0 + l_col);
+    }
+    a_arrays.row_ptr.push_back((int)a_arrays.col_ind.size());
+}
+
+static bool checkValue(const char * a_name, const char * a_field, double a_value, double a_expected) {
+    if ( fabs(a_value - a_expected) > 1e-12 * ( 1.0 + fabs(a_expected) ) ) {
+        std::cout << a_name << " : " << a_field << " " << a_value << " instead of " << a_expected << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+static bool checkFormat(const char * a_name, const matrix_profile_t & a_profile, types_e a_expected_format) {
+    if ( a_profile.recommended_format != a_expected_format ) {
+        std::cout << a_name << " : recommended format " << a_profile.recommended_format << " instead of " << a_expected_format << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Checks the JSON profile holds each of a_expected_lines and has balanced braces and brackets.
+ */
+static bool checkJSON(const char * a_name, const matrix_profile_t & a_profile, const std::vector<std::string> & a_expected_lines) {
+    char * l_buffer = NULL;
+    size_t l_size = 0;
+    FILE * l_stream = open_memstream(&l_buffer, &l_size);
+    bool l_diff_detected = false;
+    int l_depth = 0;
+
+    writeMatrixProfileJSON(&a_profile, l_stream);
+    fclose(l_stream);
+
+    std::string l_json(l_buffer, l_size);
+    free(l_buffer);
+
+    for ( const std::string & l_line : a_expected_lines ) {
+        if ( l_json.find(l_line) == std::string::npos ) {
+            std::cout << a_name << " : JSON misses " << l_line << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    for ( char l_char : l_json ) {
+        l_depth += ( l_char == '{' || l_char == '[' ) ? 1 : ( l_char == '}' || l_char == ']' ) ? -1 : 0;
+        if ( l_depth < 0 ) {
+            break;
+        }
+    }
+
+    if ( l_depth != 0 || l_json.empty() || l_json[0] != '{' ) {
+        std::cout << a_name << " : unbalanced JSON" << std::endl << l_json;
+        l_diff_detected = true;
+    }
+
+    return l_diff_detected;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+    matrix_profile_t l_profile;
+
+    /*
+     * Small symmetric matrix: 50% dense, so DENSE is recommended
+     */
+    matrix_t l_matrix = buildCSR(4, 4, s_row_ptr, s_col_ind, s_val, 0);
+
+    if ( analyzeMatrix(l_matrix, sizeof(double), &l_profile) != 0 ) {
+        std::cout << "small : analysis failed" << std::endl;
+        exit(1);
+    }
+
+    l_diff_detected |= checkValue("small", "nnz", l_profile.nnz, 8);
+    l_diff_detected |= checkValue("small", "min row length", l_profile.min_row_length, 1);
+    l_diff_detected |= checkValue("small", "max row length", l_profile.max_row_length, 3);
+    l_diff_detected |= checkValue("small", "mean row length", l_profile.mean_row_length, 2.0);
+    l_diff_detected |= checkValue("small", "row length stddev", l_profile.row_length_stddev, sqrt(0.5));
+    l_diff_detected |= checkValue("small", "histogram [1, 2)", l_profile.row_length_histogram[1], 1);
+    l_diff_detected |= checkValue("small", "histogram [2, 4)", l_profile.row_length_histogram[2], 3);
+    l_diff_detected |= checkValue("small", "bandwidth", l_profile.bandwidth, 2);
+    l_diff_detected |= checkValue("small", "profile", l_profile.profile, 3);
+    l_diff_detected |= checkValue("small", "strictly dominant rows", l_profile.nb_strictly_dominant_rows, 4);
+    l_diff_detected |= checkValue("small", "diagonally dominant", l_profile.is_diagonally_dominant, 1);
+    l_diff_detected |= checkValue("small", "structurally symmetric", l_profile.is_structurally_symmetric, 1);
+    l_diff_detected |= checkValue("small", "numerically symmetric", l_profile.is_numerically_symmetric, 1);
+    l_diff_detected |= checkValue("small", "1x1 fill", l_profile.bcsr_fill[0][0], 1.0);
+    l_diff_detected |= checkValue("small", "1x2 fill", l_profile.bcsr_fill[0][1], 12.0 / 8.0);
+    l_diff_detected |= checkValue("small", "2x2 fill", l_profile.bcsr_fill[1][1], 16.0 / 8.0);
+    l_diff_detected |= checkValue("small", "4x4 fill", l_profile.bcsr_fill[3][3], 16.0 / 8.0);
+    l_diff_detected |= checkValue("small", "SELL fill", l_profile.sell_fill, 24.0 / 8.0);
+    l_diff_detected |= checkFormat("small", l_profile, DENSE);
+
+    l_diff_detected |= checkJSON("small", l_profile, {
+        "\"m\": 4,", "\"nnz\": 8,", "\"symmetric_half\": false,", "\"mean\": 2,", "{\"min\": 1, \"count\": 1}, {\"min\": 2, \"count\": 3}",
+        "\"bandwidth\": 2,", "\"profile\": 3,", "\"dominant\": true", "\"structural\": true,", "\"numerical\": true",
+        "\"bcsr_fill\": [[1.0000, 1.5000,", "\"sell_fill\": 3.0000,", "\"x_element_size\": 8,", "\"format\": \"DENSE\"\n" });
+
+    /*
+     * Same matrix stored by its lower triangle: analyzed as a whole, only CSR handles it
+     */
+    matrix_t l_half_matrix = buildSymmetricCSR(4, s_half_row_ptr, s_half_col_ind, s_half_val, 0, 'L');
+
+    analyzeMatrix(l_half_matrix, sizeof(double), &l_profile);
+
+    l_diff_detected |= checkValue("half", "nnz", l_profile.nnz, 8);
+    l_diff_detected |= checkValue("half", "symmetric half", l_profile.symmetric_half, 1);
+    l_diff_detected |= checkValue("half", "row length stddev", l_profile.row_length_stddev, sqrt(0.5));
+    l_diff_detected |= checkValue("half", "bandwidth", l_profile.bandwidth, 2);
+    l_diff_detected |= checkValue("half", "profile", l_profile.profile, 3);
+    l_diff_detected |= checkValue("half", "numerically symmetric", l_profile.is_numerically_symmetric, 1);
+    l_diff_detected |= checkFormat("half", l_profile, CSR);
+    l_diff_detected |= checkJSON("half", l_profile, { "\"symmetric_half\": true,", "\"format\": \"CSR\"\n" });
+
+    /*
+     * Symmetry and dominance lost
+     */
+    matrix_t l_unsymmetric_matrix = buildCSR(4, 4, s_row_ptr, s_col_ind, s_unsymmetric_val, 0);
+
+    analyzeMatrix(l_unsymmetric_matrix, sizeof(double), &l_profile);
+
+    l_diff_detected |= checkValue("unsymmetric", "structurally symmetric", l_profile.is_structurally_symmetric, 1);
+    l_diff_detected |= checkValue("unsymmetric", "numerically symmetric", l_profile.is_numerically_symmetric, 0);
+    l_diff_detected |= checkValue("unsymmetric", "weakly dominant rows", l_profile.nb_weakly_dominant_rows, 3);
+    l_diff_detected |= checkValue("unsymmetric", "diagonally dominant", l_profile.is_diagonally_dominant, 0);
+
+    matrix_t l_unstructured_matrix = buildCSR(4, 4, s_unstructured_row_ptr, s_unstructured_col_ind, s_unstructured_val, 0);
+
+    analyzeMatrix(l_unstructured_matrix, sizeof(double), &l_profile);
+
+    l_diff_detected |= checkValue("unstructured", "structurally symmetric", l_profile.is_structurally_symmetric, 0);
+    l_diff_detected |= checkValue("unstructured", "numerically symmetric", l_profile.is_numerically_symmetric, 0);
+    l_diff_detected |= checkValue("unstructured", "bandwidth", l_profile.bandwidth, 2);
+    l_diff_detected |= checkJSON("unstructured", l_profile, { "\"structural\": false,", "\"numerical\": false" });
+
+    /*
+     * 64 x 64 block diagonal matrix of dense 4x4 blocks: 6% dense, no fill in 4x4 blocks, BCSR 4x4 is recommended
+     */
+    test_matrix_t l_block_arrays;
+
+    for ( int l_row = 0; l_row < 64; l_row++ ) {
+        int l_first_col = ( l_row / 4 ) * 4;
+
+        addRow(l_block_arrays, {l_first_col, l_first_col + 1, l_first_col + 2, l_first_col + 3});
+    }
+
+    matrix_t l_block_matrix = buildTestMatrix(l_block_arrays, 64);
+
+    analyzeMatrix(l_block_matrix, sizeof(double), &l_profile);
+
+    l_diff_detected |= checkValue("block", "bandwidth", l_profile.bandwidth, 3);
+    l_diff_detected |= checkValue("block", "row length stddev", l_profile.row_length_stddev, 0.0);
+    l_diff_detected |= checkValue("block", "4x4 fill", l_profile.bcsr_fill[3][3], 1.0);
+    l_diff_detected |= checkValue("block", "2x2 fill", l_profile.bcsr_fill[1][1], 1.0);
+    l_diff_detected |= checkValue("block", "1x8 fill", l_profile.bcsr_fill[0][7], 2.0);
+    l_diff_detected |= checkValue("block", "8x8 fill", l_profile.bcsr_fill[7][7], 2.0);
+    l_diff_detected |= checkFormat("block", l_profile, BCSR);
+
+    if ( l_profile.recommended_block_row_size != 4 || l_profile.recommended_block_col_size != 4 ) {
+        std::cout << "block : " << l_profile.recommended_block_row_size << "x" << l_profile.recommended_block_col_size << " blocks instead of 4x4" << std::endl;
+        l_diff_detected = true;
+    }
+    l_diff_detected |= checkJSON("block", l_profile, { "\"format\": \"BCSR\",\n    \"block_row_size\": 4,\n    \"block_col_size\": 4\n" });
+
+    /*
+     * 1024 x 1024 matrix of 3 scattered values per row: no block structure and no padding, SELL is recommended
+     */
+    test_matrix_t l_scattered_arrays;
+
+    for ( int l_row = 0; l_row < 1024; l_row++ ) {
+        addRow(l_scattered_arrays, {( l_row * 37 + 11 ) % 1024, l_row, ( l_row * 101 + 500 ) % 1024});
+    }
+
+    matrix_t l_scattered_matrix = buildTestMatrix(l_scattered_arrays, 1024);
+
+    analyzeMatrix(l_scattered_matrix, sizeof(double), &l_profile);
+
+    l_diff_detected |= checkValue("scattered", "row length stddev", l_profile.row_length_stddev, 0.0);
+    l_diff_detected |= checkValue("scattered", "SELL fill", l_profile.sell_fill, 1.0);
+    l_diff_detected |= checkFormat("scattered", l_profile, SELL);
+    l_diff_detected |= checkJSON("scattered", l_profile, { "\"format\": \"SELL\",\n    \"chunk_size\": 8,\n    \"sort_window\": 256\n" });
+
+    /*
+     * 512 x 512 matrix whose SELL sort windows hold rows of 128, 64, ..., 2 scattered values, the other rows only
+     * holding their diagonal value: sorting leaves a chunk of 8 rows as wide as 128 values per window, CSR is
+     * recommended
+     */
+    test_matrix_t l_spread_arrays;
+
+    for ( int l_row = 0; l_row < 512; l_row++ ) {
+        int l_window_row = l_row % MATRIX_PROFILE_SELL_SORT_WINDOW;
+        int l_length = ( l_window_row < 7 ) ? ( 128 >> l_window_row ) : 1;
+        std::vector<int> l_cols;
+
+        for ( int k = 0; k < l_length; k++ ) {
+            l_cols.push_back(( l_row + k * 113 ) % 512);
+        }
+        addRow(l_spread_arrays, l_cols);
+    }
+
+    matrix_t l_spread_matrix = buildTestMatrix(l_spread_arrays, 512);
+
+    analyzeMatrix(l_spread_matrix, sizeof(double), &l_profile);
+
+    // Per window: 254 values in the long rows and 249 rows of 1 value, 8 x 128 + 31 x 8 values stored in SELL
+    double l_mean = 503.0 / 256.0;
+
+    l_diff_detected |= checkValue("spread", "mean row length", l_profile.mean_row_length, l_mean);
+    l_diff_detected |= checkValue("spread", "row length stddev", l_profile.row_length_stddev, sqrt(22093.0 / 256.0 - l_mean * l_mean));
+    l_diff_detected |= checkValue("spread", "max row length", l_profile.max_row_length, 128);
+    l_diff_detected |= checkValue("spread", "histogram [1, 2)", l_profile.row_length_histogram[1], 498);
+    l_diff_detected |= checkValue("spread", "histogram [128, 256)", l_profile.row_length_histogram[8], 2);
+    l_diff_detected |= checkValue("spread", "SELL fill", l_profile.sell_fill, 1272.0 / 503.0);
+    l_diff_detected |= checkFormat("spread", l_profile, CSR);
+    l_diff_detected |= checkJSON("spread", l_profile, { "{\"min\": 128, \"count\": 2}", "\"format\": \"CSR\"\n" });
+
+    /*
+     * Only real CSR matrices are analyzed
+     */
+    if ( analyzeMatrix(NULL, sizeof(double), &l_profile) == 0 ) {
+        std::cout << "NULL matrix : analysis did not fail" << std::endl;
+        l_diff_detected = true;
+    }
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
@@ -0,0 +1,245 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Parses small MTX files and checks the CSR built by MTXParser (1-based ROW_PTR and COL_IND, VAL).
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "MTXUtil/MTXParser.hpp"
+
+static std::string s_directory;
+
+static std::string writeFile(const char * a_name, const std::string & a_content) {
+    std::string l_path = s_directory + "/" + a_name + ".mtx";
+    FILE * l_file = fopen(l_path.c_str(), "wb");
+
+    fwrite(a_content.data(), 1, a_content.size(), l_file);
+    fclose(l_file);
+
+    return l_path;
+}
+
+/*
+ * Parses a_content and compares the CSR with the expected one, a_val holding 2 values per cell for complex matrices.
+ */
+bool checkParsing(const char * a_name, const std::string & a_content, bool a_symmetric_half,
+                  int a_m, int a_n, bool a_complex, bool a_expected_half,
+                  const std::vector<int> & a_row_ptr, const std::vector<int> & a_col_ind, const std::vector<double> & a_val) {
+    std::string l_path = writeFile(a_name, a_content);
+    crs_t * l_crs = MTXParser::parseFileToCRS(l_path, a_symmetric_half);
+    int l_nb_values_per_cell = a_complex ? 2 : 1;
+    bool l_diff_detected = false;
+
+    unlink(l_path.c_str());
+
+    if ( l_crs == NULL ) {
+        std::cout << a_name << " : parsing failed" << std::endl;
+        return true;
+    }
+
+    if ( ( l_crs->M != a_m ) || ( l_crs->N != a_n ) || ( l_crs->NZNUM != (int)a_col_ind.size() )
+      || ( ( l_crs->VALUE_TYPE == COMPLEX ) != a_complex ) || ( ( l_crs->SYMMETRIC_HALF != 0 ) != a_expected_half ) ) {
+        std::cout << a_name << " : " << l_crs->M << " x " << l_crs->N << " matrix with " << l_crs->NZNUM << " non-zeros (complex " << ( l_crs->VALUE_TYPE == COMPLEX )
+                  << ", half " << l_crs->SYMMETRIC_HALF << ") instead of " << a_m << " x " << a_n << " with " << a_col_ind.size() << std::endl;
+        crsFree(l_crs);
+        return true;
+    }
+
+    for ( int i = 0; i <= a_m; i++ ) {
+        if ( l_crs->ROW_PTR[i] != a_row_ptr[i] ) {
+            std::cout << a_name << " : ROW_PTR[" << i << "] " << l_crs->ROW_PTR[i] << " instead of " << a_row_ptr[i] << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    for ( size_t k = 0; k < a_col_ind.size(); k++ ) {
+        if ( l_crs->COL_IND[k] != a_col_ind[k] ) {
+            std::cout << a_name << " : COL_IND[" << k << "] " << l_crs->COL_IND[k] << " instead of " << a_col_ind[k] << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    for ( size_t k = 0; k < a_val.size(); k++ ) {
+        if ( l_crs->VAL[k] != a_val[k] ) {
+            std::cout << a_name << " : VAL[" << k << "] " << l_crs->VAL[k] << " instead of " << a_val[k] << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    if ( a_val.size() != a_col_ind.size() * l_nb_values_per_cell ) {
+        std::cout << a_name << " : bad expected values" << std::endl;
+        l_diff_detected = true;
+    }
+
+    crsFree(l_crs);
+
+    return l_diff_detected;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+    char l_directory[] = "/tmp/test_mtx_parser_XXXXXX";
+
+    if ( mkdtemp(l_directory) == NULL ) {
+        std::cout << "Can not create a temporary directory" << std::endl;
+        exit(1);
+    }
+    s_directory = l_directory;
+
+    /*
+     * General real matrix: 3 x 4 with 5 non-zeros
+     */
+    std::vector<int> l_general_row_ptr = {1,3,4,6};
+    std::vector<int> l_general_col_ind = {1,4,2,1,3};
+    std::vector<double> l_general_val = {1.5,-2,30,4,0.5};
+    std::string l_general_header = "%%MatrixMarket matrix coordinate real general\n% comment\n3 4 5\n";
+
+    l_diff_detected |= checkParsing("general",
+        l_general_header + "1 1 1.5\n1 4 -2\n2 2 3e1\n3 1 4\n3 3 .5\n",
+        false, 3, 4, false, false, l_general_row_ptr, l_general_col_ind, l_general_val);
+
+    // Entries in any order: columns are sorted inside each row
+    l_diff_detected |= checkParsing("out_of_order",
+        l_general_header + "3 3 .5\n1 4 -2\n3 1 4\n\n2 2 3e1\n1 1 1.5\n",
+        false, 3, 4, false, false, l_general_row_ptr, l_general_col_ind, l_general_val);
+
+    // A cell given several times keeps its first value
+    l_diff_detected |= checkParsing("duplicate",
+        "%%MatrixMarket matrix coordinate real general\n3 4 7\n1 4 -2\n1 1 1.5\n2 2 3e1\n1 4 7\n3 1 4\n3 3 .5\n2 2 8\n",
+        false, 3, 4, false, false, l_general_row_ptr, l_general_col_ind, l_general_val);
+
+    // CRLF line endings, blanks around the values and no new line at the end of the file
+    l_diff_detected |= checkParsing("crlf",
+        "%%MatrixMarket matrix coordinate real general\r\n% comment\r\n3 4 5\r\n1 1 1.5\r\n1\t4 -2 \r\n2 2 3e1\r\n3 1 4\r\n3 3 .5",
+        false, 3, 4, false, false, l_general_row_ptr, l_general_col_ind, l_general_val);
+
+    /*
+     * Symmetric real matrix given by its lower triangle, or by its upper one
+     */
+    std::string l_symmetric_header = "%%MatrixMarket matrix coordinate real symmetric\n3 3 5\n";
+    std::string l_lower_entries = "1 1 4\n2 1 -1\n2 2 5\n3 2 -2\n3 3 6\n";
+    std::string l_upper_entries = "1 1 4\n1 2 -1\n2 2 5\n2 3 -2\n3 3 6\n";
+
+    l_diff_detected |= checkParsing("symmetric_full", l_symmetric_header + l_lower_entries,
+        false, 3, 3, false, false, {1,3,6,8}, {1,2,1,2,3,2,3}, {4,-1,-1,5,-2,-2,6});
+
+    l_diff_detected |= checkParsing("symmetric_half", l_symmetric_header + l_lower_entries,
+        true, 3, 3, false, true, {1,2,4,6}, {1,1,2,2,3}, {4,-1,5,-2,6});
+
+    l_diff_detected |= checkParsing("symmetric_half_upper", l_symmetric_header + l_upper_entries,
+        true, 3, 3, false, true, {1,2,4,6}, {1,1,2,2,3}, {4,-1,5,-2,6});
+
+    /*
+     * Complex matrix: 2 values per cell
+     */
+    l_diff_detected |= checkParsing("complex",
+        "%%MatrixMarket matrix coordinate complex general\n2 2 3\n2 2 0 3\n1 1 1 -1\n2 1 2.5 0\n",
+        false, 2, 2, true, false, {1,2,4}, {1,1,2}, {1,-1,2.5,0,0,3});
+
+    // Complex symmetric matrices are expanded, even when the half storage is requested
+    l_diff_detected |= checkParsing("complex_symmetric",
+        "%%MatrixMarket matrix coordinate complex symmetric\n2 2 2\n1 1 1 -1\n2 1 2.5 0.5\n",
+        true, 2, 2, true, false, {1,3,4}, {1,2,1}, {1,-1,2.5,0.5,2.5,0.5});
+
+    /*
+     * Pattern matrix: unit values
+     */
+    l_diff_detected |= checkParsing("pattern",
+        "%%MatrixMarket matrix coordinate pattern general\n2 3 3\n1 3\n2 2\n2 1\n",
+        false, 2, 3, false, false, {1,2,4}, {3,1,2}, {1,1,1});
+
+    /*
+     * Array matrix: values in column major order, zeros included
+     */
+    l_diff_detected |= checkParsing("array",
+        "%%MatrixMarket matrix array real general\n2 3\n1\n2\n3\n0\n5\n6\n",
+        false, 2, 3, false, false, {1,4,7}, {1,2,3,1,2,3}, {1,3,5,2,0,6});
+
+    /*
+     * Large file, split in several chunks parsed in parallel on multi-core machines (at least 1 MB per chunk).
+     * Entries are written column by column, so the cells of a row come from all the chunks. The last line repeats
+     * the first cell with another value, which is ignored.
+     */
+    int l_large_n = 100000;
+    std::vector<int> l_large_row_ptr(l_large_n + 1), l_large_col_ind;
+    std::vector<double> l_large_val;
+    std::vector<std::vector<int> > l_rows_of_col(l_large_n + 1);
+    std::string l_large_content = "%%MatrixMarket matrix coordinate real general\n";
+    char l_line[128];
+
+    // Row r holds the distinct columns among r, 1 + 7r % n and 1 + (7r + n/2) % n, in increasing order
+    for ( int l_row = 1; l_row <= l_large_n; l_row++ ) {
+        std::set<int> l_cols = { l_row, 1 + ( 7 * l_row ) % l_large_n, 1 + ( 7 * l_row + l_large_n / 2 ) % l_large_n };
+
+        l_large_row_ptr[l_row - 1] = (int)l_large_col_ind.size() + 1;
+        for ( int l_col : l_cols ) {
+            l_large_col_ind.push_back(l_col);
+            l_large_val.push_back(( l_row + 0.1 * l_col ) / 3.0);
+            l_rows_of_col[l_col].push_back(l_row);
+        }
+    }
+    l_large_row_ptr[l_large_n] = (int)l_large_col_ind.size() + 1;
+
+    snprintf(l_line, sizeof(l_line), "%d %d %d\n", l_large_n, l_large_n, (int)l_large_col_ind.size() + 1);
+    l_large_content += l_line;
+
+    for ( int l_col = 1; l_col <= l_large_n; l_col++ ) {
+        for ( int l_row : l_rows_of_col[l_col] ) {
+            snprintf(l_line, sizeof(l_line), "%d %d %.17g\n", l_row, l_col, ( l_row + 0.1 * l_col ) / 3.0);
+            l_large_content += l_line;
+        }
+    }
+    snprintf(l_line, sizeof(l_line), "%d %d %.17g\n", l_rows_of_col[1][0], 1, -1.0);
+    l_large_content += l_line;
+
+    l_diff_detected |= checkParsing("large", l_large_content,
+        false, l_large_n, l_large_n, false, false, l_large_row_ptr, l_large_col_ind, l_large_val);
+
+    /*
+     * A cell out of the matrix is an error
+     */
+    std::string l_path = writeFile("out_of_matrix", "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1.0\n");
+    crs_t * l_crs = MTXParser::parseFileToCRS(l_path);
+
+    unlink(l_path.c_str());
+
+    if ( l_crs != NULL ) {
+        std::cout << "out_of_matrix : parsing did not fail" << std::endl;
+        crsFree(l_crs);
+        l_diff_detected = true;
+    }
+
+    rmdir(l_directory);
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
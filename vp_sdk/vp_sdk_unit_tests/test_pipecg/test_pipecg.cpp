@@ -0,0 +1,131 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks that the pipelined CG gives the solution of CG, and reports the solve times and the true
+ *                 residuals of both solvers as the precision grows.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Matrix/matrix.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSolvers.hpp"
+#include "OSKIHelper.hpp"
+#include "../common/solver_test_helpers.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * Solves A x = b with CG and with the pipelined CG at a_precision, and compares the solutions when
+ * a_compare_solutions is set.
+ */
+bool checkPipelinedCG(const char * a_name, int a_precision, matrix_t a_matrix, double a_tolerance, bool a_compare_solutions) {
+    int l_n = a_matrix->n;
+    uint16_t l_exponent_size = 11;
+    std::vector<double> l_b(l_n), l_x(l_n, 0.0), l_pipelined_x(l_n, 0.0);
+    struct timespec l_start;
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_b[i] = sin(0.37 * i) + 1.0 / 3.0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_rc = Solver::cg(a_precision, 0, l_n, l_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+    double l_duration = elapsed(l_start);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_pipelined_rc = Solver::pipecg(a_precision, 0, l_n, l_pipelined_x.data(), a_matrix, l_b.data(), a_tolerance, l_exponent_size);
+    double l_pipelined_duration = elapsed(l_start);
+
+    double l_residual = trueResidual(a_matrix, l_x, l_b);
+    double l_pipelined_residual = trueResidual(a_matrix, l_pipelined_x, l_b);
+
+    printf("%-16s %4d bits : CG %5d iterations %8.3f s residual %.3e - PIPECG %5d iterations %8.3f s residual %.3e\n",
+        a_name, a_precision, l_rc, l_duration, l_residual, l_pipelined_rc, l_pipelined_duration, l_pipelined_residual);
+
+    if ( ! a_compare_solutions ) {
+        return false;
+    }
+
+    if ( l_rc < 0 || l_pipelined_rc < 0 ) {
+        std::cout << a_name << " : no convergence" << std::endl;
+        return true;
+    }
+
+    for ( int i = 0; i < l_n; i++ ) {
+        if ( fabs(l_x[i] - l_pipelined_x[i]) > 1e-12 * ( 1.0 + fabs(l_x[i]) ) ) {
+            std::cout << a_name << " : x[" << i << "] differs " << l_x[i] << " " << l_pipelined_x[i] << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+    matrix_t l_laplacian = buildLaplacian(32);
+
+    /*
+     * The residual gap of the pipelined CG grows at low precision, and vanishes with a few more bits.
+     */
+    checkPipelinedCG("laplacian", 53, l_laplacian, 1e-12, false);
+    l_diff_detected |= checkPipelinedCG("laplacian", 128, l_laplacian, 1e-20, true);
+    l_diff_detected |= checkPipelinedCG("laplacian", 256, l_laplacian, 1e-30, true);
+
+    /*
+     * Matrices of the matrix repository.
+     */
+    const char * l_matrix_repo_path = getenv("MATRIX_REPO_PATH");
+
+    if ( l_matrix_repo_path != NULL ) {
+        for ( const char * l_matrix_name : {"bcsstk01.mtx"} ) {
+            std::string l_matrix_file_path = std::string(l_matrix_repo_path) + "/" + l_matrix_name;
+
+            oski_matrix_wrapper_t l_oski_matrix = OSKIHelper::loadFromFile((char *)l_matrix_file_path.c_str());
+
+            if ( l_oski_matrix.oski_matrix.real_matrix == NULL ) {
+                std::cout << "Fail loading " << l_matrix_file_path << std::endl;
+                l_diff_detected = true;
+                continue;
+            }
+
+            l_diff_detected |= checkPipelinedCG(l_matrix_name, 256, OSKIHelper::toMatrix(l_oski_matrix), 1e-20, true);
+        }
+    }
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
@@ -0,0 +1,142 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks that the mixed precision iterative refinement gives the solution of the high precision
+ *                 solvers, and reports both solve times.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include <iostream>
+#include <vector>
+
+#include "Matrix/matrix.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSolvers.hpp"
+#include "../common/solver_test_helpers.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * Solves A x = b with a_solver at a_precision, then with its iterative refinement at 53 bits, and compares the
+ * solutions.
+ */
+bool checkRefinement(const char * a_name, Solver::refinement_solver_e a_solver, int a_precision, matrix_t a_matrix) {
+    int l_n = a_matrix->n;
+    uint16_t l_exponent_size = 11;
+    std::vector<double> l_b(l_n), l_x(l_n, 0.0), l_refined_x(l_n, 0.0);
+    struct timespec l_start;
+    int l_rc = 0;
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_b[i] = sin(0.37 * i) + 1.0 / 3.0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    switch ( a_solver ) {
+        case Solver::REFINEMENT_CG:
+            l_rc = Solver::cg(a_precision, 0, l_n, l_x.data(), a_matrix, l_b.data(), 1e-30, l_exponent_size);
+            break;
+        case Solver::REFINEMENT_BICGSTAB:
+            l_rc = Solver::bicgstab(a_precision, 0, l_n, l_x.data(), a_matrix, NULL, l_b.data(), 1e-30, l_exponent_size);
+            break;
+        case Solver::REFINEMENT_QMR:
+            l_rc = Solver::qmr(a_precision, 0, l_n, l_x.data(), a_matrix, NULL, l_b.data(), 1e-30, l_exponent_size);
+            break;
+    }
+    double l_duration = elapsed(l_start);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+    int l_refined_rc = Solver::refine(a_solver, a_precision, 53, 0, l_n, l_refined_x.data(), a_matrix, NULL, l_b.data(), 1e-30, 1e-8, 50, l_exponent_size);
+    double l_refined_duration = elapsed(l_start);
+
+    printf("%-10s %4d bits : %5d iterations %8.3f s - refined at 53 bits : %5d iterations %8.3f s\n", a_name, a_precision, l_rc, l_duration, l_refined_rc, l_refined_duration);
+
+    if ( l_rc < 0 || l_refined_rc < 0 ) {
+        std::cout << a_name << " : no convergence" << std::endl;
+        return true;
+    }
+
+    for ( int i = 0; i < l_n; i++ ) {
+        if ( fabs(l_x[i] - l_refined_x[i]) > 1e-14 * fabs(l_x[i]) ) {
+            std::cout << a_name << " : x[" << i << "] differs " << l_x[i] << " " << l_refined_x[i] << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Refines the CG solution of A x = b with a tolerance of 0: the refinement stops when the residual does not decrease
+ * any more and keeps the solution with the smallest residual, which must be the one of CG at a_precision.
+ */
+bool checkStagnation(const char * a_name, int a_precision, matrix_t a_matrix) {
+    int l_n = a_matrix->n;
+    uint16_t l_exponent_size = 11;
+    std::vector<double> l_b(l_n), l_x(l_n, 0.0), l_refined_x(l_n, 0.0);
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_b[i] = sin(0.37 * i) + 1.0 / 3.0;
+    }
+
+    int l_rc = Solver::cg(a_precision, 0, l_n, l_x.data(), a_matrix, l_b.data(), 1e-30, l_exponent_size);
+    int l_refined_rc = Solver::refine(Solver::REFINEMENT_CG, a_precision, 53, 0, l_n, l_refined_x.data(), a_matrix, NULL, l_b.data(), 0.0, 1e-8, 50, l_exponent_size);
+
+    if ( l_rc < 0 || l_refined_rc >= 0 ) {
+        std::cout << a_name << " : unexpected returns " << l_rc << " " << l_refined_rc << std::endl;
+        return true;
+    }
+
+    for ( int i = 0; i < l_n; i++ ) {
+        if ( fabs(l_x[i] - l_refined_x[i]) > 1e-14 * fabs(l_x[i]) ) {
+            std::cout << a_name << " : x[" << i << "] differs " << l_x[i] << " " << l_refined_x[i] << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    bool l_diff_detected = false;
+
+    matrix_t l_spd_matrix = buildTridiagonal(200, 2.0 + 1e-4, 0.0);
+    matrix_t l_matrix = buildTridiagonal(200, 2.0 + 1e-3, 0.3);
+
+    l_diff_detected |= checkRefinement("CG", Solver::REFINEMENT_CG, 256, l_spd_matrix);
+    l_diff_detected |= checkRefinement("BICGSTAB", Solver::REFINEMENT_BICGSTAB, 256, l_matrix);
+    l_diff_detected |= checkRefinement("QMR", Solver::REFINEMENT_QMR, 256, l_matrix);
+    l_diff_detected |= checkStagnation("CG stagnation", 256, l_spd_matrix);
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
@@ -0,0 +1,301 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks the RCM and partition reorderings and the reordered solves, and reports the SpMV time
+ *                 before and after reordering.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "Matrix/matrix.h"
+#include "Matrix/CSR.h"
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+#include "VPSolvers.hpp"
+#include "OSKIHelper.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * 5 points Laplacian on a a_grid_size x a_grid_size grid, with the unknowns numbered in a random order (1-based).
+ */
+matrix_t buildShuffledLaplacian(int a_grid_size) {
+    int l_n = a_grid_size * a_grid_size;
+    std::vector<int> l_shuffle(l_n);
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_shuffle[i] = i;
+    }
+
+    srand(17);
+    for ( int i = l_n - 1; i > 0; i-- ) {
+        std::swap(l_shuffle[i], l_shuffle[rand() % ( i + 1 )]);
+    }
+
+    std::vector<int> l_node(l_n);
+    for ( int i = 0; i < l_n; i++ ) {
+        l_node[l_shuffle[i]] = i;
+    }
+
+    int * l_row_ptr = (int *)malloc(sizeof(int) * ( l_n + 1 ));
+    int * l_col_ind = (int *)malloc(sizeof(int) * 5 * l_n);
+    double * l_val = (double *)malloc(sizeof(double) * 5 * l_n);
+    int l_nnz = 0;
+
+    for ( int l_row = 0; l_row < l_n; l_row++ ) {
+        int l_i = l_node[l_row] / a_grid_size;
+        int l_j = l_node[l_row] % a_grid_size;
+        std::vector<int> l_cols;
+
+        l_cols.push_back(l_row);
+        if ( l_i > 0 )                  l_cols.push_back(l_shuffle[l_node[l_row] - a_grid_size]);
+        if ( l_i < a_grid_size - 1 )    l_cols.push_back(l_shuffle[l_node[l_row] + a_grid_size]);
+        if ( l_j > 0 )                  l_cols.push_back(l_shuffle[l_node[l_row] - 1]);
+        if ( l_j < a_grid_size - 1 )    l_cols.push_back(l_shuffle[l_node[l_row] + 1]);
+
+        std::sort(l_cols.begin(), l_cols.end());
+
+        l_row_ptr[l_row] = l_nnz + 1;
+        for ( int l_col : l_cols ) {
+            l_col_ind[l_nnz] = l_col + 1;
+            l_val[l_nnz] = ( l_col == l_row ) ? 4.0 : -1.0;
+            l_nnz++;
+        }
+    }
+    l_row_ptr[l_n] = l_nnz + 1;
+
+    return buildCSR(l_n, l_n, l_row_ptr, l_col_ind, l_val, 1);
+}
+
+/*
+ * Mean duration in ns of a_nb_repetitions y = A x.
+ */
+uint64_t timeSpMV(int a_precision, matrix_t a_matrix, VPFloatArray & a_x, VPFloatArray & a_y, int a_nb_repetitions) {
+    struct timespec l_timespec_start, l_timespec_stop;
+    VPFloat l_beta(0.0);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_timespec_start);
+    for ( int l_repetition = 0; l_repetition < a_nb_repetitions; l_repetition++ ) {
+        VBLAS::vgemvd(a_precision, 'N', a_matrix->m, a_matrix->n, 1.0, a_matrix, a_x, l_beta, a_y);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &l_timespec_stop);
+
+    return ( ( ( l_timespec_stop.tv_sec - l_timespec_start.tv_sec ) * 1e9 ) + ( l_timespec_stop.tv_nsec - l_timespec_start.tv_nsec ) ) / a_nb_repetitions;
+}
+
+/*
+ * Checks a reordering of a matrix: the permutation, and P A P^T (P x) = P (A x). Reports the bandwidth, the SpMV
+ * times and the BCSR fill before and after reordering.
+ */
+bool checkReordering(const char * a_name, int a_precision, matrix_t a_matrix, int * a_permutation) {
+    int l_n = a_matrix->n;
+    bool l_diff_detected = false;
+
+    std::vector<int> l_seen(l_n, 0);
+    for ( int i = 0; i < l_n; i++ ) {
+        if ( a_permutation[i] < 0 || a_permutation[i] >= l_n || l_seen[a_permutation[i]]++ != 0 ) {
+            std::cout << a_name << " : invalid permutation" << std::endl;
+            return true;
+        }
+    }
+
+    matrix_t l_permuted_matrix = permuteCSR(a_matrix, a_permutation);
+
+    if ( l_permuted_matrix == NULL ) {
+        std::cout << a_name << " : permuteCSR failed" << std::endl;
+        return true;
+    }
+
+    double * l_x_val = (double *)malloc(sizeof(double) * l_n);
+    double * l_permuted_x_val = (double *)malloc(sizeof(double) * l_n);
+    double * l_y_val = (double *)malloc(sizeof(double) * l_n);
+    double * l_permuted_y_val = (double *)malloc(sizeof(double) * l_n);
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_x_val[i] = 1.0 / double(i + 1);
+    }
+    permuteVector(l_n, a_permutation, l_x_val, l_permuted_x_val);
+
+    VPFloatArray l_x(l_x_val, l_n);
+    VPFloatArray l_permuted_x(l_permuted_x_val, l_n);
+    VPFloatArray l_y(l_x_val, l_n);
+    VPFloatArray l_permuted_y(l_x_val, l_n);
+
+    uint64_t l_duration = timeSpMV(a_precision, a_matrix, l_x, l_y, 20);
+    uint64_t l_permuted_duration = timeSpMV(a_precision, l_permuted_matrix, l_permuted_x, l_permuted_y, 20);
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_y_val[i] = double(l_y[i]);
+        l_permuted_y_val[i] = double(l_permuted_y[i]);
+    }
+    unpermuteVector(l_n, a_permutation, l_permuted_y_val, l_x_val);
+
+    for ( int i = 0; i < l_n; i++ ) {
+        if ( fabs(l_x_val[i] - l_y_val[i]) > 1e-14 * fabs(l_y_val[i]) ) {
+            std::cout << a_name << " : y[" << i << "] differs " << l_x_val[i] << " " << l_y_val[i] << std::endl;
+            l_diff_detected = true;
+            break;
+        }
+    }
+
+    oski_matrix_wrapper_t l_oski_matrix = OSKIHelper::fromCSRMatrix(a_matrix);
+    oski_matrix_wrapper_t l_oski_permuted_matrix = OSKIHelper::fromCSRMatrix(l_permuted_matrix);
+
+    printf("%-16s n %7d - bandwidth %7d -> %7d - SpMV %10lu ns -> %10lu ns - BCSR 2x2 fill %.3f -> %.3f\n",
+        a_name,
+        l_n,
+        getCSRBandwidth(a_matrix),
+        getCSRBandwidth(l_permuted_matrix),
+        l_duration,
+        l_permuted_duration,
+        OSKIHelper::estimateBCSRFill(l_oski_matrix, 2, 2),
+        OSKIHelper::estimateBCSRFill(l_oski_permuted_matrix, 2, 2));
+
+    free(l_x_val);
+    free(l_permuted_x_val);
+    free(l_y_val);
+    free(l_permuted_y_val);
+
+    return l_diff_detected;
+}
+
+bool checkMatrix(const char * a_name, int a_precision, matrix_t a_matrix) {
+    bool l_diff_detected = false;
+    std::string l_name(a_name);
+
+    int * l_permutation = reorderRCM(a_matrix);
+    l_diff_detected |= ( l_permutation == NULL ) || checkReordering((l_name + " RCM").c_str(), a_precision, a_matrix, l_permutation);
+    free(l_permutation);
+
+    l_permutation = reorderPartition(a_matrix, 8);
+    l_diff_detected |= ( l_permutation == NULL ) || checkReordering((l_name + " PART8").c_str(), a_precision, a_matrix, l_permutation);
+    free(l_permutation);
+
+    return l_diff_detected;
+}
+
+int main(int argc, char *argv[])
+{
+    int l_precision = 256;
+    short l_exponent_size = 11;
+    short l_stride_size = 1;
+    short l_bis = l_precision + l_exponent_size + l_stride_size;
+    bool l_diff_detected = false;
+
+    VPFloatComputingEnvironment::set_precision(l_precision);
+    VPFloatComputingEnvironment::set_tempory_var_environment(l_exponent_size, l_bis, l_stride_size);
+
+    matrix_t l_laplacian = buildShuffledLaplacian(64);
+
+    l_diff_detected |= checkMatrix("laplacian", l_precision, l_laplacian);
+
+    /*
+     * RCM numbers a grid by anti diagonals: the bandwidth can not exceed twice the grid size.
+     */
+    int * l_permutation = reorderRCM(l_laplacian);
+    matrix_t l_reordered_laplacian = permuteCSR(l_laplacian, l_permutation);
+
+    if ( getCSRBandwidth(l_reordered_laplacian) > 2 * 64 ) {
+        std::cout << "RCM bandwidth too large : " << getCSRBandwidth(l_reordered_laplacian) << std::endl;
+        l_diff_detected = true;
+    }
+
+    /*
+     * More parts than vertices: the parts of 2 vertices split in 3 or more parts, and the single vertex parts, still
+     * give a valid permutation.
+     */
+    matrix_t l_small_laplacian = buildShuffledLaplacian(2);
+
+    for ( int l_nb_parts : {3, 6, 9} ) {
+        std::string l_name = "small PART" + std::to_string(l_nb_parts);
+
+        l_permutation = reorderPartition(l_small_laplacian, l_nb_parts);
+        l_diff_detected |= ( l_permutation == NULL ) || checkReordering(l_name.c_str(), l_precision, l_small_laplacian, l_permutation);
+        free(l_permutation);
+    }
+
+    l_permutation = reorderRCM(l_laplacian);
+
+    /*
+     * Solving the reordered system gives the solution of the original one.
+     */
+    int l_n = l_laplacian->n;
+    double * l_b = (double *)malloc(sizeof(double) * l_n);
+    double * l_x = (double *)calloc(l_n, sizeof(double));
+    double * l_reordered_x = (double *)calloc(l_n, sizeof(double));
+
+    for ( int i = 0; i < l_n; i++ ) {
+        l_b[i] = double(i % 7) - 3.0;
+    }
+
+    Solver::cg(l_precision, 0, l_n, l_x, l_laplacian, l_b, 1e-20, l_exponent_size, l_stride_size);
+    Solver::cg(l_precision, 0, l_n, l_reordered_x, l_reordered_laplacian, l_b, 1e-20, l_exponent_size, l_stride_size, NULL, 0, l_permutation);
+
+    for ( int i = 0; i < l_n; i++ ) {
+        if ( fabs(l_x[i] - l_reordered_x[i]) > 1e-12 * ( 1.0 + fabs(l_x[i]) ) ) {
+            std::cout << "reordered cg : x[" << i << "] differs " << l_x[i] << " " << l_reordered_x[i] << std::endl;
+            l_diff_detected = true;
+            break;
+        }
+    }
+
+    free(l_permutation);
+    free(l_b);
+    free(l_x);
+    free(l_reordered_x);
+
+    /*
+     * Matrices of the matrix repository.
+     */
+    const char * l_matrix_repo_path = getenv("MATRIX_REPO_PATH");
+
+    if ( l_matrix_repo_path != NULL ) {
+        for ( const char * l_matrix_name : {"bcsstk01.mtx"} ) {
+            std::string l_matrix_file_path = std::string(l_matrix_repo_path) + "/" + l_matrix_name;
+
+            oski_matrix_wrapper_t l_oski_matrix = OSKIHelper::loadFromFile((char *)l_matrix_file_path.c_str());
+
+            if ( l_oski_matrix.oski_matrix.real_matrix == NULL ) {
+                std::cout << "Fail loading " << l_matrix_file_path << std::endl;
+                l_diff_detected = true;
+                continue;
+            }
+
+            l_diff_detected |= checkMatrix(l_matrix_name, l_precision, OSKIHelper::toMatrix(l_oski_matrix));
+        }
+    }
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
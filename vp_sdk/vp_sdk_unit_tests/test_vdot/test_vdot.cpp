@@ -0,0 +1,201 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks that vdot, vnrm2, vcdotu and vcdotc results do not depend on the VBLAS configuration, and
+ *                 that the exact vdot rounds only once.
+ **/
+
+#include <stdio.h>
+#include <math.h>
+
+#include <iostream>
+
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VPComplex.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASComplex.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * Returns true when both numbers have the same bits in their first a_nb_chunks mantissa chunks and the same value
+ * when converted to double.
+ */
+bool sameBits(const VPFloat & a_lhs, const VPFloat & a_rhs, int a_nb_chunks) {
+    if ( double(a_lhs) != double(a_rhs) ) {
+        return false;
+    }
+
+    for ( int l_chunk = 0 ; l_chunk < a_nb_chunks; l_chunk++ ) {
+        if ( a_lhs.mantissaChunk(l_chunk) != a_rhs.mantissaChunk(l_chunk) ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    int l_n = 10007;
+    int l_precision = 64;
+    short l_exponent_size = 11;
+    short l_stride_size = 1;
+    short l_bis = l_precision + l_exponent_size + l_stride_size;
+    int l_nb_chunks = l_precision / 64;
+
+    uint64_t l_nb_threads[] = {1, 2, 3, 4, 8};
+    uint64_t l_nb_rows_per_thread[] = {1, 64, 4096};
+
+    VPFloatComputingEnvironment::set_precision(l_precision);
+    VPFloatComputingEnvironment::set_tempory_var_environment(l_exponent_size, l_bis, l_stride_size);
+
+    VPFloatArray l_x(l_exponent_size, l_bis, l_stride_size, l_n);
+    VPComplexArray l_cx(l_exponent_size, l_bis, l_stride_size, l_n);
+    VPComplexArray l_cy(l_exponent_size, l_bis, l_stride_size, l_n);
+
+    for (int i = 0 ; i < l_n; i++ ){
+        l_x[i] = 1.0 / double(i + 1) - 0.001 * double(i % 13);
+        l_cx[i].real(1.0 / double(i + 2));
+        l_cx[i].imag(-1.0 / double(i + 5));
+        l_cy[i].real(double(i % 7) - 3.0);
+        l_cy[i].imag(0.1 * double(i % 5));
+    }
+
+    VPFloat l_ref_dot(l_exponent_size, l_bis, l_stride_size);
+    VPFloat l_ref_nrm2(l_exponent_size, l_bis, l_stride_size);
+    VPComplex l_ref_dotu(l_exponent_size, l_bis, l_stride_size);
+    VPComplex l_ref_dotc(l_exponent_size, l_bis, l_stride_size);
+
+    bool l_diff_detected = false;
+    bool l_first_config = true;
+
+    for ( uint64_t l_threads : l_nb_threads ) {
+        for ( uint64_t l_rows : l_nb_rows_per_thread ) {
+            VBLAS::VBLAS_getConfig()->nb_threads = l_threads;
+            VBLAS::VBLAS_getConfig()->nb_rows_per_thread = l_rows;
+
+            VPFloat l_dot(l_exponent_size, l_bis, l_stride_size);
+            VPFloat l_nrm2(l_exponent_size, l_bis, l_stride_size);
+            VPComplex l_dotu(l_exponent_size, l_bis, l_stride_size);
+            VPComplex l_dotc(l_exponent_size, l_bis, l_stride_size);
+
+            VBLAS::vdot(l_precision, l_n, l_x, l_x, l_dot);
+            VBLAS::vnrm2(l_precision, l_n, l_x, l_nrm2);
+            VBLAS::vcdotu(l_precision, l_n, l_cx, l_cy, l_dotu);
+            VBLAS::vcdotc(l_precision, l_n, l_cx, l_cy, l_dotc);
+
+            if ( l_first_config ) {
+                l_ref_dot = l_dot;
+                l_ref_nrm2 = l_nrm2;
+                l_ref_dotu = l_dotu;
+                l_ref_dotc = l_dotc;
+                l_first_config = false;
+                continue;
+            }
+
+            if ( ( ! sameBits(l_dot, l_ref_dot, l_nb_chunks) )
+              || ( ! sameBits(l_nrm2, l_ref_nrm2, l_nb_chunks) )
+              || ( ! sameBits(l_dotu.real(), l_ref_dotu.real(), l_nb_chunks) )
+              || ( ! sameBits(l_dotu.imag(), l_ref_dotu.imag(), l_nb_chunks) )
+              || ( ! sameBits(l_dotc.real(), l_ref_dotc.real(), l_nb_chunks) )
+              || ( ! sameBits(l_dotc.imag(), l_ref_dotc.imag(), l_nb_chunks) ) ) {
+                std::cout << "nb_threads : " << l_threads << " - nb_rows_per_thread : " << l_rows << " : result differs" << std::endl;
+                l_diff_detected = true;
+            }
+        }
+    }
+
+    /*
+     * 2^100 + 1 - 2^100: the rounded dot product loses the 1, the exact one does not. The cancellation is spread over
+     * several reduction blocks.
+     */
+    VPFloatArray l_cancel(l_exponent_size, l_bis, l_stride_size, l_n);
+    VPFloatArray l_ones(l_exponent_size, l_bis, l_stride_size, l_n);
+
+    for (int i = 0 ; i < l_n; i++ ){
+        l_cancel[i] = 0.0;
+        l_ones[i] = 1.0;
+    }
+    l_cancel[0] = ldexp(1.0, 100);
+    l_cancel[l_n / 2] = 1.0;
+    l_cancel[l_n - 1] = -ldexp(1.0, 100);
+
+    for ( uint64_t l_threads : l_nb_threads ) {
+        VBLAS::VBLAS_getConfig()->nb_threads = l_threads;
+
+        VPFloat l_rounded(l_exponent_size, l_bis, l_stride_size);
+        VPFloat l_exact(l_exponent_size, l_bis, l_stride_size);
+
+        VBLAS::vdot(l_precision, l_n, l_cancel, l_ones, l_rounded);
+        VBLAS::vdot(l_precision, l_n, l_cancel, l_ones, l_exact, VBLAS::VBLAS_DOT_EXACT);
+
+        if ( ( double(l_rounded) != 0.0 ) || ( double(l_exact) != 1.0 ) ) {
+            std::cout << "nb_threads : " << l_threads << " - rounded : " << double(l_rounded) << " - exact : " << double(l_exact) << " : wrong exact dot product" << std::endl;
+            l_diff_detected = true;
+        }
+
+        /*
+         * Without cancellation, both dot products are close.
+         */
+        VBLAS::vdot(l_precision, l_n, l_x, l_x, l_exact, VBLAS::VBLAS_DOT_EXACT);
+
+        if ( fabs(double(l_exact) - double(l_ref_dot)) > 1e-12 * double(l_ref_dot) ) {
+            std::cout << "nb_threads : " << l_threads << " - exact : " << double(l_exact) << " - rounded : " << double(l_ref_dot) << " : exact dot product too far from the rounded one" << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    /*
+     * 2^32000 + 1 + 3 * 2^-40 - 2^32000: the exponent range is too wide for an accumulator, the exact products are
+     * summed by mpfr_sum and the result is still exact.
+     */
+    VPFloat l_huge(ldexp(1.0, 1000));
+
+    for (int i = 0 ; i < 5; i++ ){
+        l_huge = l_huge * l_huge;
+    }
+
+    l_cancel[0] = l_huge;
+    l_cancel[l_n / 3] = ldexp(3.0, -40);
+    l_cancel[l_n - 1] = -l_huge;
+
+    for ( uint64_t l_threads : l_nb_threads ) {
+        VBLAS::VBLAS_getConfig()->nb_threads = l_threads;
+
+        VPFloat l_exact(l_exponent_size, l_bis, l_stride_size);
+
+        VBLAS::vdot(l_precision, l_n, l_cancel, l_ones, l_exact, VBLAS::VBLAS_DOT_EXACT);
+
+        if ( double(l_exact) != 1.0 + ldexp(3.0, -40) ) {
+            std::cout << "nb_threads : " << l_threads << " - exact : " << double(l_exact) << " : wrong exact dot product on a wide exponent range" << std::endl;
+            l_diff_detected = true;
+        }
+    }
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_diff_detected ) {
+        std::cout << "ERROR : Difference detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
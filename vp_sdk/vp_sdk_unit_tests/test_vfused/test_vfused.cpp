@@ -0,0 +1,198 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Checks the fused vector kernels vaxpby, vxpay, vaxpy_dot, vdot2, vdot_block and vaxpy_block
+ *                 against the unfused sequences of vscal, vaxpy and vdot.
+ **/
+
+#include <stdio.h>
+#include <math.h>
+
+#include <iostream>
+
+#include "VPSDK/VPFloat.hpp"
+#include "VPSDK/VBLAS.hpp"
+#include "VPSDK/VBLASConfig.hpp"
+
+using namespace VPFloatPackage;
+
+/*
+ * Returns true when both numbers have the same bits in their first a_nb_chunks mantissa chunks and the same value
+ * when converted to double.
+ */
+bool sameBits(const VPFloat & a_lhs, const VPFloat & a_rhs, int a_nb_chunks) {
+    if ( double(a_lhs) != double(a_rhs) ) {
+        return false;
+    }
+
+    for ( int l_chunk = 0 ; l_chunk < a_nb_chunks; l_chunk++ ) {
+        if ( a_lhs.mantissaChunk(l_chunk) != a_rhs.mantissaChunk(l_chunk) ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Returns the number of elements differing between two arrays.
+ */
+int nbDiffs(int a_n, const VPFloatArray & a_lhs, const VPFloatArray & a_rhs, int a_nb_chunks) {
+    int l_nb_diffs = 0;
+
+    for ( int i = 0 ; i < a_n; i++ ) {
+        if ( ! sameBits(a_lhs[i], a_rhs[i], a_nb_chunks) ) {
+            l_nb_diffs++;
+        }
+    }
+
+    return l_nb_diffs;
+}
+
+int main(int argc, char *argv[])
+{
+    int l_precision = 128;
+    short l_exponent_size = 11;
+    short l_stride_size = 1;
+    short l_bis = l_precision + l_exponent_size + l_stride_size;
+    int l_nb_chunks = l_precision / 64;
+    int l_sizes[] = {100, 10007};
+    int l_nb_errors = 0;
+
+    VPFloatComputingEnvironment::set_precision(l_precision);
+    VPFloatComputingEnvironment::set_tempory_var_environment(l_exponent_size, l_bis, l_stride_size);
+
+    VBLAS::VBLAS_getConfig()->nb_threads = 4;
+
+    for ( int l_n : l_sizes ) {
+        VPFloatArray l_x(l_exponent_size, l_bis, l_stride_size, l_n);
+        VPFloatArray l_y(l_exponent_size, l_bis, l_stride_size, l_n);
+        VPFloatArray l_fused(l_exponent_size, l_bis, l_stride_size, l_n);
+        VPFloatArray l_unfused(l_exponent_size, l_bis, l_stride_size, l_n);
+
+        VPFloat l_alpha(l_exponent_size, l_bis, l_stride_size);
+        VPFloat l_beta(l_exponent_size, l_bis, l_stride_size);
+        VPFloat l_one(l_exponent_size, l_bis, l_stride_size);
+        VPFloat l_fused_dot(l_exponent_size, l_bis, l_stride_size);
+        VPFloat l_unfused_dot(l_exponent_size, l_bis, l_stride_size);
+        VPFloat l_fused_second_dot(l_exponent_size, l_bis, l_stride_size);
+        VPFloat l_unfused_second_dot(l_exponent_size, l_bis, l_stride_size);
+
+        l_alpha = -1.0 / 3.0;
+        l_beta = 2.0 / 7.0;
+        l_one = 1.0;
+
+        for (int i = 0 ; i < l_n; i++ ){
+            l_x[i] = 1.0 / double(i + 1);
+            l_y[i] = double(i % 11) - 5.0 + 1.0 / double(i + 3);
+        }
+
+        /* y = alpha*x + beta*y */
+        VBLAS::vcopy(l_n, l_y, l_fused);
+        VBLAS::vcopy(l_n, l_y, l_unfused);
+        VBLAS::vaxpby(l_precision, l_n, l_alpha, l_x, l_beta, l_fused);
+        VBLAS::vscal(l_precision, l_n, l_beta, l_unfused);
+        VBLAS::vaxpy(l_precision, l_n, l_alpha, l_x, l_unfused);
+
+        if ( nbDiffs(l_n, l_fused, l_unfused, l_nb_chunks) != 0 ) {
+            std::cout << "n : " << l_n << " : vaxpby differs from vscal + vaxpy" << std::endl;
+            l_nb_errors++;
+        }
+
+        /* y = x + beta*y, rounded once: compared to the double computation */
+        VBLAS::vcopy(l_n, l_y, l_fused);
+        VBLAS::vxpay(l_precision, l_n, l_x, l_beta, l_fused);
+
+        for (int i = 0 ; i < l_n; i++ ){
+            double l_expected = double(l_x[i]) + (2.0 / 7.0) * double(l_y[i]);
+
+            if ( fabs(double(l_fused[i]) - l_expected) > 1e-12 * ( fabs(l_expected) + 1.0 ) ) {
+                std::cout << "n : " << l_n << " - index : " << i << " : wrong vxpay result" << std::endl;
+                l_nb_errors++;
+                break;
+            }
+        }
+
+        /* y = alpha*x + y, res = y*y */
+        VBLAS::vcopy(l_n, l_y, l_fused);
+        VBLAS::vcopy(l_n, l_y, l_unfused);
+        VBLAS::vaxpy_dot(l_precision, l_n, l_alpha, l_x, l_fused, l_fused_dot);
+        VBLAS::vaxpy(l_precision, l_n, l_alpha, l_x, l_unfused);
+        VBLAS::vdot(l_precision, l_n, l_unfused, l_unfused, l_unfused_dot);
+
+        if ( ( nbDiffs(l_n, l_fused, l_unfused, l_nb_chunks) != 0 ) || ( ! sameBits(l_fused_dot, l_unfused_dot, l_nb_chunks) ) ) {
+            std::cout << "n : " << l_n << " : vaxpy_dot differs from vaxpy + vdot" << std::endl;
+            l_nb_errors++;
+        }
+
+        /* res_y = x*y, res_z = x*z, z being the result of vaxpy_dot */
+        VBLAS::vdot2(l_precision, l_n, l_x, l_y, l_fused, l_fused_dot, l_fused_second_dot);
+        VBLAS::vdot(l_precision, l_n, l_x, l_y, l_unfused_dot);
+        VBLAS::vdot(l_precision, l_n, l_x, l_fused, l_unfused_second_dot);
+
+        if ( ( ! sameBits(l_fused_dot, l_unfused_dot, l_nb_chunks) ) || ( ! sameBits(l_fused_second_dot, l_unfused_second_dot, l_nb_chunks) ) ) {
+            std::cout << "n : " << l_n << " : vdot2 differs from two vdot" << std::endl;
+            l_nb_errors++;
+        }
+
+        /* res = v^T x and y = y + v alpha, v being a block of k vectors */
+        int l_k = 5;
+        VPFloatArray l_block(l_exponent_size, l_bis, l_stride_size, l_k * l_n);
+        VPFloatArray l_block_alpha(l_exponent_size, l_bis, l_stride_size, l_k);
+        VPFloatArray l_block_dots(l_exponent_size, l_bis, l_stride_size, l_k);
+
+        for ( int i = 0 ; i < l_k * l_n; i++ ) {
+            l_block[i] = sin(0.1 * i) + 1.0 / double(i + 1);
+        }
+
+        VBLAS::vdot_block(l_precision, l_n, l_k, l_block, l_x, l_block_dots);
+        VBLAS::vcopy(l_n, l_y, l_fused);
+        VBLAS::vcopy(l_n, l_y, l_unfused);
+
+        for ( int j = 0 ; j < l_k; j++ ) {
+            VPFloatArray l_v_j(l_block, j * l_n, l_n);
+
+            VBLAS::vdot(l_precision, l_n, l_v_j, l_x, l_unfused_dot);
+
+            if ( ! sameBits(l_block_dots[j], l_unfused_dot, l_nb_chunks) ) {
+                std::cout << "n : " << l_n << " - vector : " << j << " : vdot_block differs from vdot" << std::endl;
+                l_nb_errors++;
+            }
+
+            l_block_alpha[j] = 1.0 / double(j + 2);
+            VBLAS::vaxpy(l_precision, l_n, l_block_alpha[j], l_v_j, l_unfused);
+        }
+
+        VBLAS::vaxpy_block(l_precision, l_n, l_k, l_block_alpha, l_block, l_fused);
+
+        if ( nbDiffs(l_n, l_fused, l_unfused, l_nb_chunks) != 0 ) {
+            std::cout << "n : " << l_n << " : vaxpy_block differs from vaxpy" << std::endl;
+            l_nb_errors++;
+        }
+    }
+
+    VBLAS::VBLAS_Destroy();
+
+    if ( l_nb_errors != 0 ) {
+        std::cout << "ERROR : " << l_nb_errors << " errors detected!" << std::endl;
+        exit(1);
+    } else {
+        std::cout << "SUCCESS" << std::endl;
+        exit(0);
+    }
+}
@@ -23,23 +23,25 @@
 
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 #include "Matrix/matrix.h"
+#include "Matrix/DENSE.h"
 #include "VPSDK/VPFloat.hpp"
 #include "VPSDK/VBLAS.hpp"
 #include "OSKIHelper.hpp"
 
-void vgemvd(int a_precision, const matrix_t a_matrix, const VPFloatPackage::VPFloatArray & a_x, double a_alpha, VPFloatPackage::VPFloat & a_beta, int a_n, double * a_y_val) {
+void vgemvd(int a_precision, char a_trans, const matrix_t a_matrix, const VPFloatPackage::VPFloatArray & a_x, double a_alpha, VPFloatPackage::VPFloat & a_beta, int a_n, double * a_y_val) {
     VPFloatPackage::VPFloatArray l_y(a_y_val, a_n);  
  
-    VPFloatPackage::VBLAS::vgemvd(a_precision, 'N', a_n, a_n, a_alpha, a_matrix, a_x, a_beta, l_y);
+    VPFloatPackage::VBLAS::vgemvd(a_precision, a_trans, a_n, a_n, a_alpha, a_matrix, a_x, a_beta, l_y);
 
     for (int i = 0 ; i < a_n; i++ ){
         a_y_val[i] = double(l_y[i]);
     }
 }
 
-void BCSRvgemvd(int a_precision, const matrix_t a_matrix, const VPFloatPackage::VPFloatArray & a_x, double a_alpha, VPFloatPackage::VPFloat & a_beta, int a_n, double * a_y_val) {
+void BCSRvgemvd(int a_precision, char a_trans, const matrix_t a_matrix, const VPFloatPackage::VPFloatArray & a_x, double a_alpha, VPFloatPackage::VPFloat & a_beta, int a_n, double * a_y_val) {
     VPFloatPackage::VPFloatArray l_y(a_y_val, a_n);  
 
     oski_matrix_wrapper_t l_oski_csr_matrix = VPFloatPackage::OSKIHelper::fromCSRMatrix(a_matrix);
@@ -51,11 +53,11 @@ void BCSRvgemvd(int a_precision, const matrix_t a_matrix, const VPFloatPackage::
         return;
     }
 
-    vgemvd(a_precision, l_bcsr_matrix, a_x, a_alpha, a_beta, a_n, a_y_val);
+    vgemvd(a_precision, a_trans, l_bcsr_matrix, a_x, a_alpha, a_beta, a_n, a_y_val);
 
 }
 
-void DENSEvgemvd(int a_precision, const matrix_t a_matrix, const VPFloatPackage::VPFloatArray & a_x, double a_alpha, VPFloatPackage::VPFloat & a_beta, int a_n, double * a_y_val) {
+void DENSEvgemvd(int a_precision, char a_trans, const matrix_t a_matrix, const VPFloatPackage::VPFloatArray & a_x, double a_alpha, VPFloatPackage::VPFloat & a_beta, int a_n, double * a_y_val) {
     VPFloatPackage::VPFloatArray l_y(a_y_val, a_n);  
 
     oski_matrix_wrapper_t l_oski_csr_matrix = VPFloatPackage::OSKIHelper::fromCSRMatrix(a_matrix);
@@ -67,7 +69,7 @@ void DENSEvgemvd(int a_precision, const matrix_t a_matrix, const VPFloatPackage:
         return;
     }
 
-    vgemvd(a_precision, l_dense_matrix, a_x, a_alpha, a_beta, a_n, a_y_val);
+    vgemvd(a_precision, a_trans, l_dense_matrix, a_x, a_alpha, a_beta, a_n, a_y_val);
 }
 
 int main(int argc, char *argv[])
@@ -82,6 +84,18 @@ int main(int argc, char *argv[])
     int l_col_ind[]={1,10,2,3,7,5,4,10,5,4,7,2,1,6,9,10};
     double l_val[]={10,220,20,40,90,60,70,210,80,120,110,100,200,160,180,190};
 
+    // same matrix with 0-based indices
+    int l_row_ptr_0[]={0,2,5,6,8,9,9,11,11,12,16};
+    int l_col_ind_0[]={0,9,1,2,6,4,3,9,4,3,6,1,0,5,8,9};
+
+    // symmetric matrix in full storage and stored as its lower triangle (0-based indices)
+    int l_sym_row_ptr[]={0,3,6,10,13,16,19,22,26,29,32};
+    int l_sym_col_ind[]={0,1,9,0,1,2,1,2,3,7,2,3,4,3,4,5,4,5,6,5,6,7,2,6,7,8,7,8,9,0,8,9};
+    double l_sym_val[]={10,-1,2,-1,11,-1,-1,12,-1,3,-1,13,-1,-1,14,-1,-1,15,-1,-1,16,-1,3,-1,17,-1,-1,18,-1,2,-1,19};
+    int l_sym_lower_row_ptr[]={0,1,3,5,7,9,11,13,16,18,21};
+    int l_sym_lower_col_ind[]={0,0,1,1,2,2,3,3,4,4,5,5,6,2,6,7,7,8,0,8,9};
+    double l_sym_lower_val[]={10,-1,11,-1,12,-1,13,-1,14,-1,15,-1,16,3,-1,17,-1,18,2,-1,19};
+
     double l_alpha = 10.0;
     VPFloatPackage::VPFloat l_beta(2.0);
     
@@ -94,6 +108,11 @@ int main(int argc, char *argv[])
     VPFloatPackage::VPFloatArray l_x(l_x_val, l_n);  
     matrix_t l_matrix = VPFloatPackage::OSKIHelper::toMatrix(VPFloatPackage::OSKIHelper::buildCSR(l_n, l_n, l_row_ptr, l_col_ind, l_val, 1), false);
     // matrix_t l_matrix = buildCSR(10, 10, l_row_ptr, l_col_ind, l_val, 1);
+    matrix_t l_matrix_0 = buildCSR(l_n, l_n, l_row_ptr_0, l_col_ind_0, l_val, 0);
+    // chunks of 4 rows (the last one padded) sorted over windows of 8 rows
+    matrix_t l_matrix_sell = buildSELL(l_matrix_0, 4, 8);
+    matrix_t l_matrix_sym = buildCSR(l_n, l_n, l_sym_row_ptr, l_sym_col_ind, l_sym_val, 0);
+    matrix_t l_matrix_sym_lower = buildSymmetricCSR(l_n, l_sym_lower_row_ptr, l_sym_lower_col_ind, l_sym_lower_val, 0, 'L');
 
     VPFloatPackage::VPFloatComputingEnvironment::set_precision(l_precision);
     VPFloatPackage::VPFloatComputingEnvironment::set_tempory_var_environment(l_exponent_size, l_bis, l_stride_size);
@@ -101,24 +120,202 @@ int main(int argc, char *argv[])
     double * l_y_csr_val = (double *)malloc(sizeof(double) * l_n);
     double * l_y_bcsr_val = (double *)malloc(sizeof(double) * l_n);
     double * l_y_dense_val = (double *)malloc(sizeof(double) * l_n);
+    double * l_y_csr_0_val = (double *)malloc(sizeof(double) * l_n);
+    double * l_y_sell_val = (double *)malloc(sizeof(double) * l_n);
+    double * l_y_sym_val = (double *)malloc(sizeof(double) * l_n);
+    double * l_y_sym_lower_val = (double *)malloc(sizeof(double) * l_n);
 
-    for (int i = 0 ; i < l_n; i++ ){
-        l_y_csr_val[i] = l_y_bcsr_val[i] = l_y_dense_val[i] = double(l_n - (i));
+    bool l_diff_detected = false;
+
+    // A * x then A^T * x
+    for ( char l_trans : {'N', 'T'} ) {
+        for (int i = 0 ; i < l_n; i++ ){
+            l_y_csr_val[i] = l_y_bcsr_val[i] = l_y_dense_val[i] = l_y_csr_0_val[i] = l_y_sell_val[i] = double(l_n - (i));
+        }
+
+        vgemvd(l_precision, l_trans, l_matrix, l_x, l_alpha, l_beta, l_n, l_y_csr_val);
+
+        vgemvd(l_precision, l_trans, l_matrix_0, l_x, l_alpha, l_beta, l_n, l_y_csr_0_val);
+
+        vgemvd(l_precision, l_trans, l_matrix_sell, l_x, l_alpha, l_beta, l_n, l_y_sell_val);
+
+        DENSEvgemvd(l_precision, l_trans, l_matrix, l_x, l_alpha, l_beta, l_n, l_y_dense_val);
+
+        BCSRvgemvd(l_precision, l_trans, l_matrix, l_x, l_alpha, l_beta, l_n, l_y_bcsr_val);
+
+        for (int i = 0 ; i < l_n; i++ ){
+            // std::cout  << "trans : " << l_trans << " - i : " << i << " - dense : " << std::setw(6) << l_y_dense_val[i] << " - csr : " << std::setw(6) << l_y_csr_val[i] << " - bcsr : " << std::setw(6) << l_y_bcsr_val[i] << std::endl;
+
+            if ( l_y_dense_val[i] != l_y_csr_val[i] || l_y_dense_val[i] != l_y_bcsr_val[i] || l_y_dense_val[i] != l_y_csr_0_val[i] || l_y_dense_val[i] != l_y_sell_val[i] ) {
+                l_diff_detected = true;
+            }
+        }
     }
 
-    vgemvd(l_precision, l_matrix, l_x, l_alpha, l_beta, l_n, l_y_csr_val);
+    // The half stored product sums the values of each row in the order of the full storage one
+    for ( char l_trans : {'N', 'T'} ) {
+        for (int i = 0 ; i < l_n; i++ ){
+            l_y_sym_val[i] = l_y_sym_lower_val[i] = double(l_n - (i));
+        }
 
-    DENSEvgemvd(l_precision, l_matrix, l_x, l_alpha, l_beta, l_n, l_y_dense_val);
+        vgemvd(l_precision, l_trans, l_matrix_sym, l_x, l_alpha, l_beta, l_n, l_y_sym_val);
 
-    BCSRvgemvd(l_precision, l_matrix, l_x, l_alpha, l_beta, l_n, l_y_bcsr_val);
+        vgemvd(l_precision, l_trans, l_matrix_sym_lower, l_x, l_alpha, l_beta, l_n, l_y_sym_lower_val);
 
-    bool l_diff_detected = false;
+        for (int i = 0 ; i < l_n; i++ ){
+            if ( l_y_sym_val[i] != l_y_sym_lower_val[i] ) {
+                l_diff_detected = true;
+            }
+        }
+    }
 
-    for (int i = 0 ; i < l_n; i++ ){
-        // std::cout  << "i : " << i << " - dense : " << std::setw(6) << l_y_dense_val[i] << " - csr : " << std::setw(6) << l_y_csr_val[i] << " - bcsr : " << std::setw(6) << l_y_bcsr_val[i] << std::endl;
+    // A^T * x on a 4 x 6 matrix (1-based indices): x has 4 elements and y 6 for every format, the DENSE kernel
+    // included. The values are small integers, so the products computed with doubles are exact.
+    int l_rect_m = 4;
+    int l_rect_n = 6;
+    int l_rect_row_ptr[]={1,4,6,9,11};
+    int l_rect_col_ind[]={1,4,6,2,5,1,3,6,4,5};
+    double l_rect_val[]={1,2,3,4,5,6,7,8,9,10};
+
+    matrix_t l_matrix_rect = buildCSR(l_rect_m, l_rect_n, l_rect_row_ptr, l_rect_col_ind, l_rect_val, 1);
+    matrix_t l_matrix_rect_dense = VPFloatPackage::OSKIHelper::toDense(VPFloatPackage::OSKIHelper::fromCSRMatrix(l_matrix_rect), false, 0);
+    VPFloatPackage::VPFloatArray l_rect_x(l_x_val, l_rect_m);
+
+    for ( matrix_t l_rect_matrix : {l_matrix_rect, l_matrix_rect_dense} ) {
+        double l_expected_y[] = {6,5,4,3,2,1};
+        VPFloatPackage::VPFloatArray l_rect_y(l_expected_y, l_rect_n);
+
+        VPFloatPackage::VBLAS::vgemvd(l_precision, 'T', l_rect_m, l_rect_n, l_alpha, l_rect_matrix, l_rect_x, l_beta, l_rect_y);
+
+        for (int j = 0 ; j < l_rect_n; j++ ){
+            l_expected_y[j] *= double(l_beta);
+        }
+        for (int i = 0 ; i < l_rect_m; i++ ){
+            for (int k = l_rect_row_ptr[i] - 1 ; k < l_rect_row_ptr[i+1] - 1; k++ ){
+                l_expected_y[l_rect_col_ind[k] - 1] += l_alpha * l_rect_val[k] * l_x_val[i];
+            }
+        }
+
+        for (int j = 0 ; j < l_rect_n; j++ ){
+            if ( double(l_rect_y[j]) != l_expected_y[j] ) {
+                std::cout << "A^T * x on the 4 x 6 matrix (type " << l_rect_matrix->type_matrix << ") differs at " << j << " : " << double(l_rect_y[j]) << " " << l_expected_y[j] << std::endl;
+                l_diff_detected = true;
+            }
+        }
+    }
+
+    // A^T * x and the half stored symmetric product on a matrix large enough to be scattered by several parts. Row i
+    // holds (i, i) and (i, (7 * i) % l_big_n) with small integer values, so the products computed with doubles are
+    // exact whatever the summation order. The entries are stored in the upper triangle only.
+    int l_big_n = 20000;
+    std::vector<int> l_big_row_ptr(1, 0), l_big_col_ind;
+    std::vector<double> l_big_val, l_big_x_val(l_big_n), l_big_y_val(l_big_n);
+
+    for (int i = 0 ; i < l_big_n; i++ ){
+        int l_col = ( 7 * i ) % l_big_n;
+
+        l_big_col_ind.push_back(i);
+        l_big_val.push_back(double(1 + i % 5));
+        if ( l_col > i ) {
+            l_big_col_ind.push_back(l_col);
+            l_big_val.push_back(double(1 + i % 3));
+        }
+        l_big_row_ptr.push_back(l_big_col_ind.size());
+        l_big_x_val[i] = double(1 + i % 11);
+        l_big_y_val[i] = double(i % 13);
+    }
+
+    matrix_t l_matrix_big = buildCSR(l_big_n, l_big_n, l_big_row_ptr.data(), l_big_col_ind.data(), l_big_val.data(), 0);
+    matrix_t l_matrix_big_sell = buildSELL(l_matrix_big, 4, 8);
+    VPFloatPackage::VPFloatArray l_big_x(l_big_x_val.data(), l_big_n);
+
+    for ( matrix_t l_big_matrix : {l_matrix_big, l_matrix_big_sell} ) {
+        VPFloatPackage::VPFloatArray l_big_y(l_big_y_val.data(), l_big_n);
+        std::vector<double> l_expected_y(l_big_y_val);
+
+        VPFloatPackage::VBLAS::vgemvd(l_precision, 'T', l_big_n, l_big_n, l_alpha, l_big_matrix, l_big_x, l_beta, l_big_y);
+
+        for (int j = 0 ; j < l_big_n; j++ ){
+            l_expected_y[j] *= double(l_beta);
+        }
+        for (int i = 0 ; i < l_big_n; i++ ){
+            for (int k = l_big_row_ptr[i] ; k < l_big_row_ptr[i+1]; k++ ){
+                l_expected_y[l_big_col_ind[k]] += l_alpha * l_big_val[k] * l_big_x_val[i];
+            }
+        }
+
+        for (int j = 0 ; j < l_big_n; j++ ){
+            if ( double(l_big_y[j]) != l_expected_y[j] ) {
+                std::cout << "A^T * x on the large matrix (type " << l_big_matrix->type_matrix << ") differs at " << j << " : " << double(l_big_y[j]) << " " << l_expected_y[j] << std::endl;
+                l_diff_detected = true;
+                break;
+            }
+        }
+    }
+
+    // A as the upper triangle of a half stored symmetric matrix
+    matrix_t l_matrix_big_sym = buildSymmetricCSR(l_big_n, l_big_row_ptr.data(), l_big_col_ind.data(), l_big_val.data(), 0, 'U');
+    VPFloatPackage::VPFloatArray l_big_y(l_big_y_val.data(), l_big_n);
+    std::vector<double> l_expected_y(l_big_y_val);
 
-        if ( l_y_dense_val[i] != l_y_csr_val[i] || l_y_dense_val[i] != l_y_bcsr_val[i] ) {
+    VPFloatPackage::VBLAS::vgemvd(l_precision, 'N', l_big_n, l_big_n, l_alpha, l_matrix_big_sym, l_big_x, l_beta, l_big_y);
+
+    for (int j = 0 ; j < l_big_n; j++ ){
+        l_expected_y[j] *= double(l_beta);
+    }
+    for (int i = 0 ; i < l_big_n; i++ ){
+        for (int k = l_big_row_ptr[i] ; k < l_big_row_ptr[i+1]; k++ ){
+            int j = l_big_col_ind[k];
+
+            l_expected_y[i] += l_alpha * l_big_val[k] * l_big_x_val[j];
+            if ( j != i ) {
+                l_expected_y[j] += l_alpha * l_big_val[k] * l_big_x_val[i];
+            }
+        }
+    }
+
+    for (int j = 0 ; j < l_big_n; j++ ){
+        if ( double(l_big_y[j]) != l_expected_y[j] ) {
+            std::cout << "Half stored product on the large matrix differs at " << j << " : " << double(l_big_y[j]) << " " << l_expected_y[j] << std::endl;
             l_diff_detected = true;
+            break;
+        }
+    }
+
+    // DENSE conversion of the half stored matrix, transposed or not: the implied triangle is filled. OSKI matrices
+    // are built from 1-based indices.
+    int l_sym_row_ptr_1[sizeof(l_sym_row_ptr) / sizeof(int)];
+    int l_sym_col_ind_1[sizeof(l_sym_col_ind) / sizeof(int)];
+    int l_sym_lower_row_ptr_1[sizeof(l_sym_lower_row_ptr) / sizeof(int)];
+    int l_sym_lower_col_ind_1[sizeof(l_sym_lower_col_ind) / sizeof(int)];
+
+    for (int i = 0 ; i <= l_n; i++ ){
+        l_sym_row_ptr_1[i] = l_sym_row_ptr[i] + 1;
+        l_sym_lower_row_ptr_1[i] = l_sym_lower_row_ptr[i] + 1;
+    }
+    for (size_t i = 0 ; i < sizeof(l_sym_col_ind) / sizeof(int); i++ ){
+        l_sym_col_ind_1[i] = l_sym_col_ind[i] + 1;
+    }
+    for (size_t i = 0 ; i < sizeof(l_sym_lower_col_ind) / sizeof(int); i++ ){
+        l_sym_lower_col_ind_1[i] = l_sym_lower_col_ind[i] + 1;
+    }
+
+    matrix_t l_matrix_sym_1 = buildCSR(l_n, l_n, l_sym_row_ptr_1, l_sym_col_ind_1, l_sym_val, 1);
+    matrix_t l_matrix_sym_lower_1 = buildSymmetricCSR(l_n, l_sym_lower_row_ptr_1, l_sym_lower_col_ind_1, l_sym_lower_val, 1, 'L');
+
+    for ( bool l_transpose : {false, true} ) {
+        matrix_t l_dense_sym = VPFloatPackage::OSKIHelper::toDense(VPFloatPackage::OSKIHelper::fromCSRMatrix(l_matrix_sym_1), l_transpose, 0);
+        matrix_t l_dense_sym_lower = VPFloatPackage::OSKIHelper::toDense(VPFloatPackage::OSKIHelper::fromCSRMatrix(l_matrix_sym_lower_1), l_transpose, 0);
+        double * l_dense_sym_val = ((dmatDENSE_t)l_dense_sym->matrix->repr)->val;
+        double * l_dense_sym_lower_val = ((dmatDENSE_t)l_dense_sym_lower->matrix->repr)->val;
+
+        for (int i = 0 ; i < l_n; i++ ){
+            for (int j = 0 ; j < l_n; j++ ){
+                if ( l_dense_sym_val[i * l_dense_sym->lda + j] != l_dense_sym_lower_val[i * l_dense_sym_lower->lda + j] ) {
+                    std::cout << "toDense (transpose " << l_transpose << ") of the half stored matrix differs at (" << i << ", " << j << ")" << std::endl;
+                    l_diff_detected = true;
+                }
+            }
         }
     }
 
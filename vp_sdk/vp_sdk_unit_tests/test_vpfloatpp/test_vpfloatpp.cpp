@@ -21,7 +21,9 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <utility>
 #include <VPSDK/VPFloat.hpp>
+#include <VPSDK/VPFloatExpression.hpp>
 
 #ifdef __riscv
 
@@ -97,6 +99,294 @@ int test_VPFloatArray() {
     return l_rc;
 }
 
+int test_VPFloatArray_fma() {
+    int  l_rc = EXIT_SUCCESS;
+
+    int l_precision=53;
+    int l_exponent_size=7;
+    int l_stride_size=1;
+    int l_bis = l_precision + l_exponent_size + 1;
+    int l_array_size = 10;
+
+    VPFloatPackage::VPFloatComputingEnvironment::set_precision(l_bis);
+    VPFloatPackage::VPFloatComputingEnvironment::set_rounding_mode(VPFloatPackage::VP_RNE);
+
+    VPFloatPackage::VPFloatArray l_x(l_exponent_size, l_bis, l_stride_size, l_array_size);
+    VPFloatPackage::VPFloatArray l_y(l_exponent_size, l_bis, l_stride_size, l_array_size);
+
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        l_x[l_index] = double(l_index);
+        l_y[l_index] = double(2 * l_index);
+    }
+
+    /* In place fused operations on array elements: y = y + x * 3 then y = y - x * x */
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        l_y[l_index].fma(l_x[l_index], 3.0);
+        l_y[l_index].fms(l_x[l_index], l_x[l_index]);
+    }
+
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        double l_expected = double( 5 * l_index - l_index * l_index );
+        if ( double(l_y[l_index]) != l_expected ) {
+            std::cout << "array element " << l_index << " has value " << double(l_y[l_index]) << " instead of " << l_expected << std::endl;
+            l_rc = EXIT_FAILURE;
+        }
+    }
+
+    /* Source array must be left unchanged */
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        if ( double(l_x[l_index]) != double(l_index) ) {
+            std::cout << "source array element " << l_index << " has value " << double(l_x[l_index]) << " instead of " << double(l_index) << std::endl;
+            l_rc = EXIT_FAILURE;
+        }
+    }
+
+    return l_rc;
+}
+
+int test_VPFloatExpression() {
+    int  l_rc = EXIT_SUCCESS;
+
+    int l_precision=53;
+    int l_exponent_size=7;
+    int l_stride_size=1;
+    int l_bis = l_precision + l_exponent_size + 1;
+    int l_array_size = 10;
+
+    VPFloatPackage::VPFloatComputingEnvironment::set_precision(l_bis);
+    VPFloatPackage::VPFloatComputingEnvironment::set_rounding_mode(VPFloatPackage::VP_RNE);
+    VPFloatPackage::VPFloatComputingEnvironment::set_tempory_var_environment(l_exponent_size, l_bis, l_stride_size);
+
+    VPFloatPackage::VPFloatArray l_y(l_exponent_size, l_bis, l_stride_size, l_array_size);
+    VPFloatPackage::VPFloat a(l_exponent_size, l_bis, l_stride_size);
+    VPFloatPackage::VPFloat b(l_exponent_size, l_bis, l_stride_size);
+    VPFloatPackage::VPFloat c(l_exponent_size, l_bis, l_stride_size);
+
+    a = 2.0;
+    b = 3.0;
+
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        l_y[l_index] = double(l_index);
+    }
+
+    /* Expressions evaluated directly into the array elements (y = y*a + b, then y = b - y*a) */
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        l_y[l_index] = VPFloatPackage::vpexpr(l_y[l_index]) * a + b;
+        l_y[l_index] = b - VPFloatPackage::vpexpr(l_y[l_index]) * a;
+    }
+
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        double l_expected = 3.0 - ( 2.0 * l_index + 3.0 ) * 2.0;
+        if ( double(l_y[l_index]) != l_expected ) {
+            std::cout << "array element " << l_index << " has value " << double(l_y[l_index]) << " instead of " << l_expected << std::endl;
+            l_rc = EXIT_FAILURE;
+        }
+    }
+
+    /* Nested expression using scratch registers */
+    c = -((VPFloatPackage::vpexpr(a) + b) * (VPFloatPackage::vpexpr(a) - b)) / 5.0 + 1.0;
+
+    if ( double(c) != 2.0 ) {
+        std::cout << "c variable has value " << double(c) << " instead of " << 2.0 << std::endl;
+        l_rc = EXIT_FAILURE;
+    }
+
+    return l_rc;
+}
+
+int test_VPFloat_move() {
+    int  l_rc = EXIT_SUCCESS;
+
+    int l_precision=53;
+    int l_exponent_size=7;
+    int l_stride_size=1;
+    int l_bis = l_precision + l_exponent_size + 1;
+    int l_array_size = 4;
+
+    VPFloatPackage::VPFloatComputingEnvironment::set_precision(l_bis);
+    VPFloatPackage::VPFloatComputingEnvironment::set_rounding_mode(VPFloatPackage::VP_RNE);
+    VPFloatPackage::VPFloatComputingEnvironment::set_tempory_var_environment(l_exponent_size, l_bis, l_stride_size);
+
+    VPFloatPackage::VPFloatArray l_x(l_exponent_size, l_bis, l_stride_size, l_array_size);
+    VPFloatPackage::VPFloat a(l_exponent_size, l_bis, l_stride_size);
+    VPFloatPackage::VPFloat b(l_exponent_size, l_bis, l_stride_size);
+
+    a = 2.0;
+    b = 3.0;
+
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        l_x[l_index] = double(l_index);
+    }
+
+    /* Chained operators reuse the memory of the intermediate results */
+    VPFloatPackage::VPFloat c = a * b + a / 4.0 - (b - a * a) * 2.0;
+
+    if ( double(c) != 8.5 ) {
+        std::cout << "c variable has value " << double(c) << " instead of " << 8.5 << std::endl;
+        l_rc = EXIT_FAILURE;
+    }
+
+    /* Expiring array elements must not be modified */
+    c = -(l_x[1] + l_x[2] * a);
+
+    if ( ( double(c) != -5.0 ) || ( double(l_x[1]) != 1.0 ) || ( double(l_x[2]) != 2.0 ) ) {
+        std::cout << "c variable has value " << double(c) << " instead of " << -5.0 << std::endl;
+        l_rc = EXIT_FAILURE;
+    }
+
+    /* Move assignment into an array element stores the value into the array */
+    l_x[3] = a * b;
+
+    if ( double(l_x[3]) != 6.0 ) {
+        std::cout << "array element 3 has value " << double(l_x[3]) << " instead of " << 6.0 << std::endl;
+        l_rc = EXIT_FAILURE;
+    }
+
+    /* Moved array takes over the elements */
+    VPFloatPackage::VPFloatArray l_y(std::move(l_x));
+
+    if ( ( l_y.nbElements() != l_array_size ) || ( l_x.nbElements() != 0 ) || ( double(l_y[3]) != 6.0 ) ) {
+        std::cout << "moved array has " << l_y.nbElements() << " elements instead of " << l_array_size << std::endl;
+        l_rc = EXIT_FAILURE;
+    }
+
+    return l_rc;
+}
+
+int test_VPFloat_mantissaChunk() {
+    int  l_rc = EXIT_SUCCESS;
+
+    int l_exponent_size=16;
+    int l_stride_size=1;
+    int l_bis = 200;
+    uint64_t l_chunks[3] = { 0x123456789abcdef0ULL, 0xfedcba9876543210ULL, 0x5555555555555555ULL };
+
+    VPFloatPackage::VPFloatComputingEnvironment::set_precision(l_bis);
+    VPFloatPackage::VPFloatComputingEnvironment::set_rounding_mode(VPFloatPackage::VP_RNE);
+
+    /* 183 bits of mantissa after the leading bit: the last chunk has 55 bits, its lowest bits are rounded */
+    VPFloatPackage::VPFloat a(l_chunks[0], 5, true, l_exponent_size, l_bis, l_stride_size);
+
+    a.mantissaChunk(1, l_chunks[1]);
+    a.mantissaChunk(2, l_chunks[2]);
+
+    if ( ( a.mantissaChunk(0) != l_chunks[0] ) || ( a.mantissaChunk(1) != l_chunks[1] ) ) {
+        std::cout << "mantissa chunks are " << std::hex << a.mantissaChunk(0) << " " << a.mantissaChunk(1) << std::dec << std::endl;
+        l_rc = EXIT_FAILURE;
+    }
+
+    if ( a.mantissaChunk(2) != 0x5555555555555600ULL ) {
+        std::cout << "mantissa chunk 2 is " << std::hex << a.mantissaChunk(2) << std::dec << std::endl;
+        l_rc = EXIT_FAILURE;
+    }
+
+    if ( ( a.exponent() != 5 ) || ( double(a) != -( 1.0 + double(l_chunks[0]) / 18446744073709551616.0 ) * 32.0 ) ) {
+        std::cout << "a variable has value " << double(a) << std::endl;
+        l_rc = EXIT_FAILURE;
+    }
+
+    /* 128 bits of mantissa after the leading bit: chunks 2 and 3 are entirely beyond the precision and rounded */
+    VPFloatPackage::VPFloat b(0, 0, false, l_exponent_size, l_exponent_size + 129, l_stride_size);
+    uint64_t l_rounded_chunks[5][3] = {
+        /* chunk index, chunk value, expected chunk 1 */
+        { 2, 0x8000000000000001ULL, 1 },    // above half an ulp
+        { 2, 0x8000000000000000ULL, 2 },    // half an ulp, odd last bit: rounded to even
+        { 2, 0x8000000000000000ULL, 2 },    // half an ulp, even last bit
+        { 3, 0xffffffffffffffffULL, 2 },    // below half an ulp
+        { 3, 0x0000000000000001ULL, 3 }     // below half an ulp, rounded up
+    };
+
+    for ( int i = 0; i < 5; i++ ) {
+        VPFloatPackage::VPFloatComputingEnvironment::set_rounding_mode(( i == 4 ) ? VPFloatPackage::VP_RUP : VPFloatPackage::VP_RNE);
+
+        b.mantissaChunk(l_rounded_chunks[i][0], l_rounded_chunks[i][1]);
+
+        if ( ( b.mantissaChunk(0) != 0 ) || ( b.mantissaChunk(1) != l_rounded_chunks[i][2] ) ) {
+            std::cout << "setting chunk " << l_rounded_chunks[i][0] << " to " << std::hex << l_rounded_chunks[i][1] << " gives chunks " << b.mantissaChunk(0) << " " << b.mantissaChunk(1) << std::dec << std::endl;
+            l_rc = EXIT_FAILURE;
+        }
+    }
+
+    VPFloatPackage::VPFloatComputingEnvironment::set_rounding_mode(VPFloatPackage::VP_RNE);
+
+    return l_rc;
+}
+
+int test_VPFloatArray_pack() {
+    int  l_rc = EXIT_SUCCESS;
+
+    int l_exponent_size=15;
+    int l_stride_size=1;
+    int l_bis = 128;
+    int l_array_size = 6;
+    double l_values[6] = { 0.0, -1.5, 3.0, 1.0e-300, -2.5e300, 1.0e-310 };
+    vpfloat_evp_t l_double_environment = VPFLOAT_EVP_DOUBLE;
+    vpfloat_evp_t l_packed_environment;
+
+    l_packed_environment.es = l_exponent_size;
+    l_packed_environment.bis = l_bis;
+    l_packed_environment.stride = l_stride_size;
+
+    VPFloatPackage::VPFloatComputingEnvironment::set_precision(l_bis);
+    VPFloatPackage::VPFloatComputingEnvironment::set_rounding_mode(VPFloatPackage::VP_RNE);
+
+    VPFloatPackage::VPFloatArray l_x(l_exponent_size, l_bis, l_stride_size, l_array_size);
+    VPFloatPackage::VPFloatArray l_y(l_exponent_size, l_bis, l_stride_size, l_array_size);
+
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        l_x[l_index] = l_values[l_index];
+    }
+
+    /* Value with more bits than a double */
+    l_x[2] /= 7.0;
+
+    /* Round trip through the VRP memory format keeps all the bits */
+    uint8_t * l_buffer = (uint8_t *)malloc(l_x.packedSize(l_packed_environment));
+
+    l_x.pack(l_buffer, l_packed_environment);
+    l_y.unpack(l_buffer, l_packed_environment);
+
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        if ( l_x[l_index] != l_y[l_index] ) {
+            std::cout << "array element " << l_index << " has value " << double(l_y[l_index]) << " instead of " << double(l_x[l_index]) << std::endl;
+            l_rc = EXIT_FAILURE;
+        }
+    }
+
+    free(l_buffer);
+
+    /* A double environment is the layout of a double array */
+    double l_doubles[6];
+
+    l_y.pack(l_doubles, l_double_environment);
+
+    for (int l_index = 0 ; l_index < l_array_size; l_index++ ) {
+        if ( l_doubles[l_index] != double(l_y[l_index]) ) {
+            std::cout << "double element " << l_index << " has value " << l_doubles[l_index] << " instead of " << double(l_y[l_index]) << std::endl;
+            l_rc = EXIT_FAILURE;
+        }
+    }
+
+    /* Environments outside of the VRP memory format are refused: more than BISMAX bits or 64 exponent bits */
+    vpfloat_evp_t l_invalid_environments[2] = { l_packed_environment, l_packed_environment };
+
+    l_invalid_environments[0].bis = BISMAX + 64;
+    l_invalid_environments[1].es = 64;
+
+    for ( vpfloat_evp_t l_invalid_environment : l_invalid_environments ) {
+        l_buffer = (uint8_t *)malloc(l_y.packedSize(l_invalid_environment));
+
+        if ( ( l_y.pack(l_buffer, l_invalid_environment) != -1 ) || ( l_y.unpack(l_buffer, l_invalid_environment) != -1 ) ) {
+            std::cout << "environment (es " << l_invalid_environment.es << ", bis " << l_invalid_environment.bis << ") is not refused" << std::endl;
+            l_rc = EXIT_FAILURE;
+        }
+
+        free(l_buffer);
+    }
+
+    return l_rc;
+}
+
 int main()
 {
     int l_rc = EXIT_SUCCESS;
@@ -110,5 +400,40 @@ int main()
         printf("Test VPFloatArray OK !\n");
     }
 
+    if (  test_VPFloatArray_fma() ) {
+        printf("Test VPFloatArray fma FAILED !\n");
+        l_rc = EXIT_FAILURE;
+    } else {
+        printf("Test VPFloatArray fma OK !\n");
+    }
+
+    if (  test_VPFloatExpression() ) {
+        printf("Test VPFloatExpression FAILED !\n");
+        l_rc = EXIT_FAILURE;
+    } else {
+        printf("Test VPFloatExpression OK !\n");
+    }
+
+    if (  test_VPFloat_move() ) {
+        printf("Test VPFloat move FAILED !\n");
+        l_rc = EXIT_FAILURE;
+    } else {
+        printf("Test VPFloat move OK !\n");
+    }
+
+    if (  test_VPFloat_mantissaChunk() ) {
+        printf("Test VPFloat mantissaChunk FAILED !\n");
+        l_rc = EXIT_FAILURE;
+    } else {
+        printf("Test VPFloat mantissaChunk OK !\n");
+    }
+
+    if (  test_VPFloatArray_pack() ) {
+        printf("Test VPFloatArray pack FAILED !\n");
+        l_rc = EXIT_FAILURE;
+    } else {
+        printf("Test VPFloatArray pack OK !\n");
+    }
+
     exit(l_rc);
 }
\ No newline at end of file
@@ -37,5 +37,16 @@ void CSR_dvusmv_NxM_alpha1_beta0(int precision, char trans, int m, int n,
                              void * y, int y_bytes,
                              char enable_prefetch);
 
+/*
+ * Product by a half stored symmetric matrix (see CSR_IS_SYMMETRIC_HALF): each stored value is used for its row and,
+ * off the diagonal, for its column. Called by CSR_dvusmv_NxM_handler.
+ */
+void CSR_dvusmv_symmetric_half(int precision, int m,
+                               const double alpha,
+                               const dmatCSR_t a,
+                               const void * x, int x_bytes,
+                               const double beta,
+                               void * y, int y_bytes);
+
 #endif /* _CSR_VUSMV_NXM_H_ */
 
@@ -23,6 +23,7 @@
 
 #include "VRPSDK/spvblas/vusmv/BCSR_vusmv_NxM.h"
 #include "VRPSDK/spvblas/vusmv/CSR_vusmv_NxM.h"
+#include "VRPSDK/spvblas/vusmv/SELL_vusmv_NxM.h"
 
 
 #endif /* _VUSMV_H_ */
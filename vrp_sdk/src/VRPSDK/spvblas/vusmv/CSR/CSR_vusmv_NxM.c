@@ -83,6 +83,17 @@ void CSR_dvusmv_NxM_handler(int precision, char trans, int m, int n,
                              char enable_prefetch)
 {
 
+    if ( CSR_IS_SYMMETRIC_HALF(a) ) {
+        CSR_dvusmv_symmetric_half(
+            precision, m,
+            alpha,
+            a,
+            x, x_bytes,
+            beta,
+            y, y_bytes);
+        return;
+    }
+
     if((alpha==1.0) && (beta==0.0)) {
         CSR_dvusmv_NxM_alpha1_beta0(
             precision, trans, m, n,
@@ -161,6 +172,83 @@ void CSR_dvusmv_NxM_handler(int precision, char trans, int m, int n,
     VBLASPERFMONITOR_FUNCTION_END;
 }
 
+void CSR_dvusmv_symmetric_half(int precision, int m,
+                               const double alpha,
+                               const dmatCSR_t a,
+                               const void * x, int x_bytes,
+                               const double beta,
+                               void * y, int y_bytes)
+{
+    VBLASPERFMONITOR_FUNCTION_BEGIN;
+
+    int l_row;
+    int l_col_offset;
+    int l_col;
+    uintptr_t l_x_ptr;
+    uintptr_t l_y_ptr;
+    uintptr_t l_val_ptr = (uintptr_t) a->val;
+
+    // Load alpha and beta values in P registers
+    pcvt_d_p(ALPHA_REG,	dtoraw(alpha));
+    pcvt_d_p(BETA_REG, 	dtoraw(beta));
+
+    // y *= beta, as values of the implied triangle are added to rows before they are processed
+    for ( l_row = 0; l_row < m; l_row++ ) {
+        l_y_ptr = ((uintptr_t) y) + l_row * y_bytes;
+
+        ple(Y_REG, l_y_ptr, 0, EVP1);
+        pmul(Y_REG, Y_REG, BETA_REG, EC0);
+        pse(Y_REG, l_y_ptr, 0, EVP1);
+    }
+
+    for ( l_row = 0; l_row < m; l_row++ ) {
+
+        // acc = 0;
+        pcvt_d_p(ROW_ACCU_REG, 0);
+
+        // X0 = alpha * x[l_row], added to the rows of the implied triangle
+        l_x_ptr = ((uintptr_t) x) + l_row * x_bytes;
+        ple(X0_REG, l_x_ptr, 0, EVP0);
+        pmul(X0_REG, X0_REG, ALPHA_REG, EC0);
+
+        for ( l_col_offset = ( a->ptr[l_row] - a->base_index ) ; l_col_offset < ( a->ptr[l_row+1] - a->base_index ) ; l_col_offset++ ) {
+
+           // Get real column index
+           l_col = a->ind[l_col_offset] - a->base_index;
+
+           // Load X[col] and A value in P registers
+           l_x_ptr = ((uintptr_t) x) + l_col * x_bytes;
+           ple(X_REG, l_x_ptr, 0, EVP0);
+           pld(A_REG, l_val_ptr, 0, EFP0);
+
+           // acc += x[l_col] * a->val[l_col_offset]
+           pmul(X_REG, X_REG, A_REG, EC0);
+           padd(ROW_ACCU_REG, ROW_ACCU_REG, X_REG, EC0);
+
+           if ( l_col != l_row ) {
+               // y[l_col] += a->val[l_col_offset] * alpha * x[l_row]
+               l_y_ptr = ((uintptr_t) y) + l_col * y_bytes;
+               ple(Y_REG, l_y_ptr, 0, EVP1);
+               pmul(A_REG, A_REG, X0_REG, EC0);
+               padd(Y_REG, Y_REG, A_REG, EC0);
+               pse(Y_REG, l_y_ptr, 0, EVP1);
+           }
+
+           l_val_ptr += sizeof(double);
+        }
+
+        // y[l_row] += acc * alpha
+        pmul(ROW_ACCU_REG, ROW_ACCU_REG, ALPHA_REG, EC0);
+
+        l_y_ptr = ((uintptr_t) y) + l_row * y_bytes;
+        ple(Y_REG, l_y_ptr, 0, EVP1);
+        padd(Y_REG, ROW_ACCU_REG, Y_REG, EC0);
+        pse(Y_REG, l_y_ptr, 0, EVP1);
+    }
+
+    VBLASPERFMONITOR_FUNCTION_END;
+}
+
 static inline __ALWAYS_INLINE__ void CSR_dvusmv_alpha1_beta0_unroll8(const uintptr_t x_ptr, int **ind_ptr, uintptr_t *val_ptr, int *elem, const int n, int x_bytes){
     int l_col_0, l_col_1, l_col_2, l_col_3,
         l_col_4, l_col_5, l_col_6, l_col_7;
@@ -0,0 +1,213 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+* 
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* 
+*     http://www.apache.org/licenses/LICENSE-2.0
+* 
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ *  @file        SELL_vusmv_NxM.c
+ *  @author      Jerome Fereyre
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <VRPSDK/spvblas.h>
+#include "VRPSDK/spvblas/vusmv/SELL_vusmv_NxM.h"
+#include "VRPSDK/asm/vpfloat.h"
+#include "VRPSDK/vutils.h"
+#include "VRPSDK/vblas_perfmonitor.h"
+
+#define ROW_ACCU_REG 	P31
+#define BETA_REG 	    P30
+#define ALPHA_REG 	    P29
+#define X_REG 		    P28
+#define Y_REG 		    P27
+#define A_REG 		    P26
+
+#define X0_REG          P0
+#define X1_REG          P1
+#define X2_REG          P2
+#define X3_REG          P3
+#define X4_REG          P4
+#define X5_REG          P5
+#define X6_REG          P6
+#define X7_REG          P7
+#define ACC0_REG          P8
+#define ACC1_REG          P9
+#define ACC2_REG         P10
+#define ACC3_REG         P11
+#define ACC4_REG         P12
+#define ACC5_REG         P13
+#define ACC6_REG         P14
+#define ACC7_REG         P15
+#define A0_REG          P16
+#define A1_REG          P17
+#define A2_REG          P18
+#define A3_REG          P19
+#define A4_REG          P20
+#define A5_REG          P21
+#define A6_REG          P22
+#define A7_REG          P23
+
+/*
+ * acc[R] += x[ind[R]] * val[R] for the row R of a chunk of 8 rows, l_ind_ptr and l_val_ptr pointing to the current
+ * column of the chunk.
+ */
+#define SELL_CHUNK8_ROW_STEP(R) \
+    ple(X ## R ## _REG, ((uintptr_t) x) + l_ind_ptr[R] * x_bytes, 0, EVP0); \
+    pld(A ## R ## _REG, l_val_ptr, R, EFP0); \
+    pmul(X ## R ## _REG, X ## R ## _REG, A ## R ## _REG, EC0); \
+    padd(ACC ## R ## _REG, ACC ## R ## _REG, X ## R ## _REG, EC0);
+
+/*
+ * y[perm[R]] = alpha * acc[R] + beta * y[perm[R]], padding rows of the last chunk being skipped.
+ */
+#define SELL_CHUNK8_ROW_STORE(R) \
+    l_row = a->perm[l_sorted_row + R]; \
+    if ( l_row >= 0 ) { \
+        pmul(ACC ## R ## _REG, ACC ## R ## _REG, ALPHA_REG, EC0); \
+        l_y_ptr = ((uintptr_t) y) + l_row * y_bytes; \
+        ple(Y_REG, l_y_ptr, 0, EVP1); \
+        pmul(Y_REG, Y_REG, BETA_REG, EC0); \
+        padd(Y_REG, ACC ## R ## _REG, Y_REG, EC0); \
+        pse(Y_REG, l_y_ptr, 0, EVP1); \
+    }
+
+/*
+ * Chunks of 8 rows: the 8 rows are processed together over the whole chunk width, one accumulator per row. Padding
+ * values are 0.0 with a valid column index, so they are processed as the other values.
+ */
+static void SELL_dvusmv_chunk8(const dmatSELL_t a, int a_chunk,
+                               const void * x, int x_bytes,
+                               void * y, int y_bytes)
+{
+    int l_sorted_row = a_chunk * 8;
+    int l_width = ( a->chunk_ptr[a_chunk + 1] - a->chunk_ptr[a_chunk] ) / 8;
+    const int * l_ind_ptr = a->ind + a->chunk_ptr[a_chunk];
+    uintptr_t l_val_ptr = (uintptr_t) (a->val + a->chunk_ptr[a_chunk]);
+    uintptr_t l_y_ptr;
+    int l_row;
+    int l_col;
+
+    pcvt_d_p(ACC0_REG, 0);
+    pcvt_d_p(ACC1_REG, 0);
+    pcvt_d_p(ACC2_REG, 0);
+    pcvt_d_p(ACC3_REG, 0);
+    pcvt_d_p(ACC4_REG, 0);
+    pcvt_d_p(ACC5_REG, 0);
+    pcvt_d_p(ACC6_REG, 0);
+    pcvt_d_p(ACC7_REG, 0);
+
+    for ( l_col = 0; l_col < l_width; l_col++ ) {
+        SELL_CHUNK8_ROW_STEP(0)
+        SELL_CHUNK8_ROW_STEP(1)
+        SELL_CHUNK8_ROW_STEP(2)
+        SELL_CHUNK8_ROW_STEP(3)
+        SELL_CHUNK8_ROW_STEP(4)
+        SELL_CHUNK8_ROW_STEP(5)
+        SELL_CHUNK8_ROW_STEP(6)
+        SELL_CHUNK8_ROW_STEP(7)
+
+        // Next column of the chunk
+        l_ind_ptr += 8;
+        l_val_ptr += 8 * sizeof(double);
+    }
+
+    SELL_CHUNK8_ROW_STORE(0)
+    SELL_CHUNK8_ROW_STORE(1)
+    SELL_CHUNK8_ROW_STORE(2)
+    SELL_CHUNK8_ROW_STORE(3)
+    SELL_CHUNK8_ROW_STORE(4)
+    SELL_CHUNK8_ROW_STORE(5)
+    SELL_CHUNK8_ROW_STORE(6)
+    SELL_CHUNK8_ROW_STORE(7)
+}
+
+void SELL_dvusmv_NxM_handler(int precision, char trans, int m, int n,
+                             const double alpha,
+                             const dmatSELL_t a,
+                             const void * x, int x_bytes,
+                             const double beta,
+                             void * y, int y_bytes,
+                             char enable_prefetch)
+{
+    VBLASPERFMONITOR_FUNCTION_BEGIN;
+
+    int l_chunk;
+    int l_row_in_chunk;
+    int l_sorted_row;
+    int l_row;
+    int l_col;
+    int l_offset;
+    uintptr_t l_x_ptr;
+    uintptr_t l_y_ptr;
+
+    // Load alpha and beta values in P registers
+    pcvt_d_p(ALPHA_REG,	dtoraw(alpha));
+    pcvt_d_p(BETA_REG, 	dtoraw(beta));
+
+    for ( l_chunk = 0; l_chunk < a->num_chunks; l_chunk++ ) {
+
+        if ( a->chunk_size == 8 ) {
+            SELL_dvusmv_chunk8(a, l_chunk, x, x_bytes, y, y_bytes);
+            continue;
+        }
+
+        // Generic chunk size: rows are processed one after the other over their own length
+        for ( l_row_in_chunk = 0; l_row_in_chunk < a->chunk_size; l_row_in_chunk++ ) {
+
+            l_sorted_row = l_chunk * a->chunk_size + l_row_in_chunk;
+            l_row = a->perm[l_sorted_row];
+
+            // Padding rows of the last chunk
+            if ( l_row < 0 ) {
+                continue;
+            }
+
+            // acc = 0;
+            pcvt_d_p(ROW_ACCU_REG, 0);
+
+            for ( l_col = 0; l_col < a->row_len[l_sorted_row]; l_col++ ) {
+
+                // Values of a row are chunk_size apart
+                l_offset = a->chunk_ptr[l_chunk] + l_col * a->chunk_size + l_row_in_chunk;
+
+                // Compute the address for X[ind]
+                l_x_ptr = ((uintptr_t) x) + a->ind[l_offset] * x_bytes;
+
+                // Load X[ind] in P register
+                ple(X_REG, l_x_ptr, 0, EVP0);
+
+                // Load A value in P register
+                pld(A_REG, (uintptr_t) (a->val + l_offset), 0, EFP0);
+
+                // acc += x[ind] * val
+                pmul(A_REG, X_REG, A_REG, EC0);
+                padd(ROW_ACCU_REG, ROW_ACCU_REG, A_REG, EC0);
+            }
+
+            // acc *= alpha
+            pmul(ROW_ACCU_REG, ROW_ACCU_REG, ALPHA_REG, EC0);
+
+            // Compute the address for Y[l_row]
+            l_y_ptr = ((uintptr_t) y) + l_row * y_bytes;
+
+            // y[l_row] = acc * alpha + beta * y[l_row]
+            ple(Y_REG, l_y_ptr, 0, EVP1);
+            pmul(Y_REG, Y_REG, BETA_REG, EC0);
+            padd(Y_REG, ROW_ACCU_REG, Y_REG, EC0);
+            pse(Y_REG, l_y_ptr, 0, EVP1);
+        }
+    }
+
+    VBLASPERFMONITOR_FUNCTION_END;
+}
@@ -69,6 +69,14 @@ void dvusmv(int precision, char trans,
                                     beta,
                                     y, y_bytes, enable_prefetch);
             break;
+        case SELL:
+            SELL_dvusmv_NxM_handler(precision, trans, a->m, a->n,
+                                    alpha,
+                                    (dmatSELL_t) a->matrix->repr,
+                                    x, x_bytes,
+                                    beta,
+                                    y, y_bytes, enable_prefetch);
+            break;
     }
 
     /* Restore environment */
@@ -36,7 +36,7 @@ cd -
 
 make  clean
 
-foreach VRP_SDK_FIRMWARE ( bicg cg precond_cg qmr)
+foreach VRP_SDK_FIRMWARE ( bicg cg gmres precond_cg qmr)
 
     make BUILD_DIR=build_vrp_vck190 BSP=fpga_vck190 BSP_CONFIG_NCPUS=1 UART_REFCLK=50000000 UART_BAUDRATE=38400 VRP_DATA_ADDRESS=0x0000000880000000ULL VRP_SDK_FIRMWARE=${VRP_SDK_FIRMWARE} VRP_DRIVER_INCLUDE_PATH=${VRP_DRIVER_INCLUDE_PATH}
     make BUILD_DIR=build_vrp_vck190 BSP=fpga_vck190 BSP_CONFIG_NCPUS=1 UART_REFCLK=50000000 UART_BAUDRATE=38400 VRP_DATA_ADDRESS=0x0000000880000000ULL VRP_SDK_FIRMWARE=${VRP_SDK_FIRMWARE} VRP_DRIVER_INCLUDE_PATH=${VRP_DRIVER_INCLUDE_PATH} mem
@@ -0,0 +1,188 @@
+/**
+* Copyright 2023 CEA Commissariat a l'Energie Atomique et aux Energies Alternatives (CEA)
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+/**
+ * Authors       : Jerome Fereyre
+ * Creation Date : October, 2023
+ * Description   : Converts a Matrix Market file to a binary matrix file (see vrp_Matrix_file.hpp), or fills the
+ *                 matrix cache used by vrp_test_solver -C.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <string.h>
+
+#include <string>
+
+#include "OSKIHelper.hpp"
+#include "Preconditionners.hpp"
+#include "VRPOffload/vrp_Matrix_file.hpp"
+
+using namespace VPFloatPackage::Offloading;
+
+void usage(int a_rc) {
+    printf("-h                                      : print help message.\n");
+    printf("-m <matrix_path>                        : path to the Matrix Market file to convert.\n");
+    printf("-o <output_path>                        : path of the binary matrix file to write.\n");
+    printf("-C <cache_directory>                    : write the file in the matrix cache used by vrp_test_solver -C instead of -o.\n");
+    printf("-H                                      : keep real symmetric matrices in half storage (lower triangle), CSR only.\n");
+    printf("-b <block_size>                         : store the matrices in BCSR format with square blocks of block_size.\n");
+    printf("-d <lda_value>                          : store the matrices in DENSE format with padded lines of lda_value (0 => automatic LDA).\n");
+    printf("-u                                      : do not store the transposed matrix.\n");
+    printf("-j <shifter>                            : also store the jacobi preconditioner (CSR format) with the given diagonal shifter.\n");
+    exit(a_rc);
+}
+
+/*
+ * Matrix stored in the file for a CSR matrix loaded from the Matrix Market file.
+ */
+matrix_t convertMatrix(oski_matrix_wrapper_t a_oski_matrix, matrix_t a_matrix, int a_bcsr_block_size, bool a_dense, int a_lda) {
+    if ( a_bcsr_block_size != 0 ) {
+        return VPFloatPackage::OSKIHelper::toBCSR(a_oski_matrix, a_bcsr_block_size, a_bcsr_block_size);
+    }
+
+    if ( a_dense ) {
+        return VPFloatPackage::OSKIHelper::toDense(a_oski_matrix, false, a_lda);
+    }
+
+    return a_matrix;
+}
+
+int main(int argc, char **argv) {
+    char * l_matrix_file_path = NULL;
+    char * l_output_path = NULL;
+    char * l_cache_directory = NULL;
+    bool l_symmetric_half = false;
+    bool l_dense = false;
+    bool l_store_transposed = true;
+    bool l_store_jacobi = false;
+    int l_bcsr_block_size = 0;
+    int l_lda = 0;
+    double l_jacobi_shifter = 0.0;
+    int c;
+
+    while ((c = getopt (argc, argv, "b:C:d:hHj:m:o:u")) != -1) {
+        switch (c) {
+            case 'b':
+                l_bcsr_block_size = atoi(optarg);
+                break;
+            case 'C':
+                l_cache_directory = optarg;
+                break;
+            case 'd':
+                l_dense = true;
+                l_lda = atoi(optarg);
+                break;
+            case 'h':
+                usage(0);
+                break;
+            case 'H':
+                l_symmetric_half = true;
+                break;
+            case 'j':
+                l_store_jacobi = true;
+                sscanf(optarg, "%le", &l_jacobi_shifter);
+                break;
+            case 'm':
+                l_matrix_file_path = optarg;
+                break;
+            case 'o':
+                l_output_path = optarg;
+                break;
+            case 'u':
+                l_store_transposed = false;
+                break;
+            default:
+                usage(-1);
+                break;
+        }
+    }
+
+    if ( l_matrix_file_path == NULL || ( l_output_path == NULL && l_cache_directory == NULL ) ) {
+        printf("-m option and one of -o or -C options are mandatory.\n");
+        usage(1);
+    }
+
+    if ( l_dense && l_bcsr_block_size != 0 ) {
+        printf("-b and -d options can not be used together.\n");
+        exit(1);
+    }
+
+    if ( l_symmetric_half && ( l_dense || l_bcsr_block_size != 0 ) ) {
+        printf("-H option can not be used with BCSR or DENSE matrices (-b or -d options).\n");
+        exit(1);
+    }
+
+    oski_matrix_wrapper_t l_oski_matrix = VPFloatPackage::OSKIHelper::loadFromFile(l_matrix_file_path, l_symmetric_half);
+
+    if ( l_oski_matrix.oski_matrix.real_matrix == NULL && l_oski_matrix.oski_matrix.complex_matrix == NULL) {
+        printf("Fail parsing matrix.\n");
+        exit(1);
+    }
+
+    matrix_t l_matrix = VPFloatPackage::OSKIHelper::toMatrix(l_oski_matrix);
+    matrix_t l_matrices[VRP_MATRIX_FILE_NB_ROLES] = { NULL, NULL, NULL, NULL };
+
+    l_matrices[VRP_MATRIX_FILE_A] = convertMatrix(l_oski_matrix, l_matrix, l_bcsr_block_size, l_dense, l_lda);
+
+    if ( l_store_transposed ) {
+        oski_matrix_wrapper_t l_oski_matrix_transposed = VPFloatPackage::OSKIHelper::transpose(l_oski_matrix);
+        matrix_t l_matrix_transposed = VPFloatPackage::OSKIHelper::toMatrix(l_oski_matrix_transposed);
+
+        l_matrices[VRP_MATRIX_FILE_A_TRANSPOSED] = convertMatrix(l_oski_matrix_transposed, l_matrix_transposed, l_bcsr_block_size, l_dense, l_lda);
+
+        if ( l_store_jacobi ) {
+            l_matrices[VRP_MATRIX_FILE_PRECONDITIONER_TRANSPOSED] = jacobi(l_matrix_transposed, l_jacobi_shifter);
+        }
+    }
+
+    if ( l_store_jacobi ) {
+        l_matrices[VRP_MATRIX_FILE_PRECONDITIONER] = jacobi(l_matrix, l_jacobi_shifter);
+    }
+
+    /*
+     * Cache files are named as vrp_test_solver expects them: CSR files hold the matrices loaded from the file, BCSR
+     * and DENSE files their conversion.
+     */
+    std::string l_file_path;
+    uint64_t l_source_hash = VRP_Matrix_file::hashFile(l_matrix_file_path);
+
+    if ( l_cache_directory != NULL ) {
+        char l_variant[64];
+
+        if ( l_bcsr_block_size != 0 ) {
+            snprintf(l_variant, sizeof(l_variant), "CSR-BCSR%dx%d", l_bcsr_block_size, l_bcsr_block_size);
+        } else if ( l_dense ) {
+            snprintf(l_variant, sizeof(l_variant), "CSR-DENSE%d", l_lda);
+        } else {
+            snprintf(l_variant, sizeof(l_variant), "%s", l_symmetric_half ? "CSR_HALF" : "CSR");
+        }
+
+        l_file_path = VRP_Matrix_file::getCachePath(l_cache_directory, l_source_hash, l_variant);
+    } else {
+        l_file_path = l_output_path;
+    }
+
+    if ( VRP_Matrix_file::save(l_file_path.c_str(), l_source_hash, l_matrices) != 0 ) {
+        printf("Fail writing %s.\n", l_file_path.c_str());
+        exit(1);
+    }
+
+    printf("===== Matrices written to %s.\n", l_file_path.c_str());
+
+    return 0;
+}
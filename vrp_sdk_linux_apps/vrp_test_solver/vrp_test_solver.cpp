@@ -25,16 +25,21 @@
 #include <unistd.h>
 #include <string.h>
 #include <time.h>
+#include <math.h>
 
 #include "VPSolvers.hpp"
 #include "OSKIHelper.hpp"
 #include "Preconditionners.hpp"
 #include "MTXUtil/crs.h"
+#include "VPSDK/VBLAS.hpp"
 #include "VPSDK/VBLASConfig.hpp"
 #include "VRPOffload/vrp_offloading.hpp"
+#include "VRPOffload/vrp_Matrix_file.hpp"
 #include "Matrix/DENSE.h"
+#include "Matrix/matrix_profile.h"
 
 using namespace VPFloatPackage::Solver;
+using namespace VPFloatPackage::Offloading;
 
 void toUpper(char * a_string) {
     int i;
@@ -47,27 +52,130 @@ void toUpper(char * a_string) {
 
 void usage(int a_rc) {
     printf("-h : print help message.\n");
+    printf("-H                                      : keep real symmetric matrices in half storage (lower triangle), CSR only.\n");
+    printf("-A <profile_json_path>                  : analyze the matrix structure, write its profile as JSON and use the recommended format (CSR, BCSR, SELL or DENSE).\n");
     printf("-a <lda_value>                          : padded size of matrice lines. Use for cache prefetching (default:0 => automatic LDA tunning)\n");
-    printf("-b <block_size>                         : size for block in BCSR format\n");
+    printf("-b <block_size>|auto                    : size for block in BCSR format, or auto to choose the block shape from the matrix structure\n");
     printf("-c                                      : enable hardware prefetching\n");
+    printf("-C <cache_directory>                    : keep the matrices built from the matrix file in a binary cache, reused while the file is unchanged.\n");
+    printf("-g <restart>                            : number of iterations between GMRES and FGMRES restarts. (default: 30)\n");
     printf("-e <exponent_size>                      : size of exponent for VPfloat number used during solver computation.(default: 10)\n");
-    printf("-k <kernel_name>                        : name of the kernel to call (BICG, CG, PRECOND_CG, QMR).\n");
+    printf("-i <inner_precision>                    : solve with mixed precision iterative refinement, CG, BICGSTAB or QMR running at <inner_precision> and residuals at <precision>.\n");
+    printf("-k <kernel_name>                        : name of the kernel to call (BICG, BLOCK_CG, CG, FGMRES, GMRES, PIPECG, PRECOND_CG, QMR).\n");
     printf("-m <matrix_path>                        : path to the matrix to which the selected solver will be applied.\n");
     printf("-o                                      : request solver offloading on VRP accelerator\n");
+    printf("-R rcm|partition:<nb_parts>             : reorder the sparse matrix with Reverse Cuthill-McKee or by partitioning its graph, CSR and BCSR only.\n");
     printf("-p <precision>                          : precision used during solver computation. (default: 512)\n");
     printf("-s                                      : flag used to specify kernel work wirth sparse or dense data structure.\n");
     printf("-t <tolerance in scientific notation>   : tolerance used by solver to determine end of iteration.(default: 1e-8)\n");
     printf("-l <log buffer size in byte>            : size of the buffer given to VRP to store solver output traces.\n");
+    printf("-v <initial_precision>                  : solve with the adaptive precision CG, starting at <initial_precision> and raising it up to <precision> when needed.\n");
+    printf("-u                                      : do not build the transposed matrix, solvers use transposed SpMV on A (sparse, host solvers only).\n");
+    printf("-w <nb_right_hand_sides>                : solve for <nb_right_hand_sides> right hand sides (B file columns), with the multiple right hand sides CG (CG) or the block CG (BLOCK_CG). (default: 1)\n");
+    printf("-x                                      : compute solver dot products exactly, with a single final rounding (MPFR only).\n");
     printf("-y                                      : Request transposed version of algorithm to run.\n");
     exit(a_rc);
 }
 
+/*
+ * Arguments of the product benchmarked for the BCSR autotuning: the one of the solver, with the same precision.
+ */
+typedef struct {
+    int precision;
+    uint16_t exponent_size;
+    uint16_t stride_size;
+    int nb_repetitions;
+} bcsr_benchmark_args_t;
+
+double benchmarkBCSRProduct(matrix_t a_bcsr_matrix, void * a_args) {
+    bcsr_benchmark_args_t * l_args = (bcsr_benchmark_args_t *)a_args;
+    short l_bis = l_args->precision + l_args->exponent_size + 1;
+    struct timespec l_timespec_start, l_timespec_stop;
+
+    VPFloatPackage::VPFloatComputingEnvironment::set_precision(l_bis);
+    VPFloatPackage::VPFloatComputingEnvironment::set_tempory_var_environment(l_args->exponent_size, l_bis, 1);
+
+    VPFloatPackage::VPFloatArray l_x(l_args->exponent_size, l_bis, l_args->stride_size, a_bcsr_matrix->n);
+    VPFloatPackage::VPFloatArray l_y(l_args->exponent_size, l_bis, l_args->stride_size, a_bcsr_matrix->m);
+    VPFloatPackage::VPFloat l_beta(l_args->exponent_size, l_bis, l_args->stride_size);
+
+    for ( int l_index = 0 ; l_index < a_bcsr_matrix->n; l_index++ ) {
+        l_x[l_index] = 1.0;
+    }
+    l_beta = 0.0;
+
+    // First product out of the measure (pool start, caches)
+    VPFloatPackage::VBLAS::vgemvd(l_args->precision, 'N', a_bcsr_matrix->m, a_bcsr_matrix->n, 1.0, a_bcsr_matrix, l_x, l_beta, l_y);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_timespec_start);
+    for ( int l_repetition = 0 ; l_repetition < l_args->nb_repetitions; l_repetition++ ) {
+        VPFloatPackage::VBLAS::vgemvd(l_args->precision, 'N', a_bcsr_matrix->m, a_bcsr_matrix->n, 1.0, a_bcsr_matrix, l_x, l_beta, l_y);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &l_timespec_stop);
+
+    return ( ( l_timespec_stop.tv_sec - l_timespec_start.tv_sec ) + ( l_timespec_stop.tv_nsec - l_timespec_start.tv_nsec ) * 1e-9 ) / l_args->nb_repetitions;
+}
+
+/*
+ * Maps a matrix cache file when it holds a real matrix for each needed role, returns NULL otherwise.
+ */
+vrp_matrix_file_t * mapCachedMatrices(const char * a_file_path, uint64_t a_source_hash, const bool a_needed_roles[VRP_MATRIX_FILE_NB_ROLES]) {
+    vrp_matrix_file_t * l_file = VRP_Matrix_file::map(a_file_path, a_source_hash);
+
+    for ( int l_role = 0 ; ( l_file != NULL ) && ( l_role < VRP_MATRIX_FILE_NB_ROLES ); l_role++ ) {
+        if ( a_needed_roles[l_role] ) {
+            matrix_t l_matrix = VRP_Matrix_file::getMatrix(l_file, (vrp_matrix_file_role_e)l_role);
+
+            if ( ( l_matrix == NULL ) || ( l_matrix->type_value != REAL_VALUE ) ) {
+                VRP_Matrix_file::unmap(l_file);
+                l_file = NULL;
+            }
+        }
+    }
+
+    if ( l_file != NULL ) {
+        printf("===== Matrices mapped from cache file %s.\n", a_file_path);
+    }
+
+    return l_file;
+}
+
+/*
+ * BCSR (a_bcsr_block_row_size != 0), SELL (a_sell_chunk_size != 0) or DENSE conversion of a matrix used by the
+ * solvers.
+ */
+matrix_t convertMatrix(oski_matrix_wrapper_t a_oski_matrix, matrix_t a_csr_matrix, int a_bcsr_block_row_size, int a_bcsr_block_col_size, int a_sell_chunk_size, int a_sell_sort_window, int a_lda) {
+    if ( a_bcsr_block_row_size != 0 ) {
+        return VPFloatPackage::OSKIHelper::toBCSR(a_oski_matrix, a_bcsr_block_row_size, a_bcsr_block_col_size);
+    }
+
+    if ( a_sell_chunk_size != 0 ) {
+        return buildSELL(a_csr_matrix, a_sell_chunk_size, a_sell_sort_window);
+    }
+
+    return VPFloatPackage::OSKIHelper::toDense(a_oski_matrix, false, a_lda);
+}
+
 void initB(double * B, int n) {
     for ( int index = 0 ; index < n ; index++ ) {
         B[index] = 1.0;
     }
 }
 
+/*
+ * nb_rhs vectors of n elements stored contiguously: the first one is the one of initB, the next ones are perturbed so
+ * that the vectors are independent, which the block CG needs.
+ */
+void initBlockB(double * B, int n, int nb_rhs) {
+    initB(B, n);
+
+    for ( int l_rhs = 1 ; l_rhs < nb_rhs ; l_rhs++ ) {
+        for ( int index = 0 ; index < n ; index++ ) {
+            B[l_rhs * n + index] = 1.0 + 0.5 * sin(( index + 1 ) * l_rhs);
+        }
+    }
+}
+
 int main(int argc, char ** argv) {
     
     VPFloatPackage::VBLAS::VBLASConfig * l_vblas_config = VPFloatPackage::VBLAS::VBLAS_getConfig();
@@ -75,18 +183,32 @@ int main(int argc, char ** argv) {
     int l_rc = 0;
     int l_opt;
     int l_precision = 512;
+    int l_inner_precision = 0;
+    int l_initial_precision = 0;
+    bool l_adaptive_precision = false;
+    int l_restart = 30;
+    int l_nb_rhs = 1;
     int l_transpose = 0;
     char * l_matrix_file_path = NULL;
     char * l_B_matrix_file_path = NULL;
     char * l_solver_name = NULL;
+    char * l_cache_directory = NULL;
+    char * l_reordering = NULL;
+    char * l_profile_file_path = NULL;
     uint64_t l_log_buffer_size = 0;
     char * l_log_buffer = NULL;
     bool l_sparse_flag = false;
+    bool l_implicit_transpose = false;
     double l_tolerance = 1e-8;
     uint16_t l_exponent_size = 10;
     uint16_t l_stride_size = 1;
     int l_lda = 0;
-    bool l_bcsr_sparse_block_size = 0;
+    int l_bcsr_block_row_size = 0;
+    int l_bcsr_block_col_size = 0;
+    bool l_bcsr_auto_tuning = false;
+    int l_sell_chunk_size = 0;
+    int l_sell_sort_window = 0;
+    bool l_symmetric_half = false;
     matrix_t l_B_matrix_loaded_from_file = NULL;
     oski_matrix_wrapper_t l_oski_B_input_matrix;
     double l_jacobi_shifter = 0.0;
@@ -94,8 +216,11 @@ int main(int argc, char ** argv) {
     // By default deactivate prefetcher
     l_vblas_config->enable_prefetcher = 0;
 
-    while((l_opt = getopt(argc, argv, "a:B:b:ce:hj:k:l:m:on:p:r:st:y")) != -1 ) {
+    while((l_opt = getopt(argc, argv, "A:a:B:b:cC:e:g:hHi:j:k:l:m:on:p:R:r:st:uv:w:xy")) != -1 ) {
         switch(l_opt) {
+            case 'A':
+                l_profile_file_path = optarg;
+                break;
             case 'a':
                 l_lda = atoi(optarg);
                 break;
@@ -104,17 +229,34 @@ int main(int argc, char ** argv) {
                 snprintf(l_B_matrix_file_path, strlen(optarg) + 1 , "%s", optarg);                
                 break;                
             case 'b':
-                l_bcsr_sparse_block_size = atoi(optarg);
+                if ( strcmp(optarg, "auto") == 0 ) {
+                    l_bcsr_auto_tuning = true;
+                } else {
+                    l_bcsr_block_row_size = atoi(optarg);
+                    l_bcsr_block_col_size = l_bcsr_block_row_size;
+                }
                 break;
             case 'c':
                 l_vblas_config->enable_prefetcher = 1;
                 break;                
+            case 'C':
+                l_cache_directory = optarg;
+                break;
             case 'e':
                 sscanf(optarg, "%hd", &l_exponent_size);
                 break;
+            case 'g':
+                l_restart = atoi(optarg);
+                break;
             case 'h':
                 usage(0);
                 break;
+            case 'H':
+                l_symmetric_half = true;
+                break;
+            case 'i':
+                l_inner_precision = atoi(optarg);
+                break;
             case 'j':
                 sscanf(optarg, "%le", &l_jacobi_shifter);
                 break;                 
@@ -139,6 +281,9 @@ int main(int argc, char ** argv) {
             case 'l':
                 sscanf(optarg, "%ld", &l_log_buffer_size);
                 break; 
+            case 'R':
+                l_reordering = optarg;
+                break;
             case 'r':
                 l_vblas_config->nb_rows_per_thread = atoi(optarg);
                 break;                
@@ -148,6 +293,19 @@ int main(int argc, char ** argv) {
             case 't':
                 sscanf(optarg, "%le", &l_tolerance);
                 break;  
+            case 'u':
+                l_implicit_transpose = true;
+                break;
+            case 'v':
+                l_initial_precision = atoi(optarg);
+                l_adaptive_precision = true;
+                break;
+            case 'w':
+                l_nb_rhs = atoi(optarg);
+                break;
+            case 'x':
+                l_vblas_config->enable_exact_dot = 1;
+                break;
             case 'y':
                 l_transpose = 1;
                 break;                              
@@ -162,51 +320,374 @@ int main(int argc, char ** argv) {
         exit(1);
     }
 
+    if ( l_restart < 1 ) {
+        printf("-g option needs a restart of at least one iteration.\n");
+        exit(1);
+    }
+
+    if ( l_adaptive_precision && ( ( l_initial_precision < 1 ) || ( l_initial_precision > l_precision ) ) ) {
+        printf("-v option needs an initial precision between 1 and the precision (%d bits).\n", l_precision);
+        exit(1);
+    }
+
+    if ( l_nb_rhs < 1 ) {
+        printf("-w option needs at least one right hand side.\n");
+        exit(1);
+    }
+
+    if ( l_implicit_transpose && ( getenv(VRP_OFFLAD_ENVIRONMENT_VAR_NAME) != NULL ) && ( atoi(getenv(VRP_OFFLAD_ENVIRONMENT_VAR_NAME)) != 0 ) ) {
+        printf("-u option can not be used with solver offloading (-o option): the VRP solvers need the transposed matrix.\n");
+        exit(1);
+    }
+
+    if ( l_symmetric_half && ( l_bcsr_auto_tuning || l_bcsr_block_row_size != 0 ) ) {
+        printf("-H option can not be used with BCSR matrices (-b option).\n");
+        exit(1);
+    }
+
     printf("===== Tolerance set to %le.\n", l_tolerance);
     printf("===== Exponent size set to %hd.\n", l_exponent_size);
 
-    oski_matrix_wrapper_t l_oski_sparse_input_matrix = VPFloatPackage::OSKIHelper::loadFromFile(l_matrix_file_path);
+    oski_matrix_wrapper_t l_oski_sparse_input_matrix;
+    matrix_t l_sparse_input_matrix = NULL;
 
-    if ( l_oski_sparse_input_matrix.oski_matrix.real_matrix == NULL && l_oski_sparse_input_matrix.oski_matrix.complex_matrix == NULL) {
-        printf("Fail parsing matrix.\n");
-        exit(1);
+    /* With -u, A^T is not needed by the sparse solvers unless the transposed system is solved */
+    oski_matrix_wrapper_t l_oski_sparse_input_matrix_transposed;
+    matrix_t l_sparse_input_matrix_transposed = NULL;
+    bool l_transposed_needed = ( l_transpose == 1 || ! l_implicit_transpose || ! l_sparse_flag );
+
+    /*
+     * With -C, the CSR matrices are mapped from the cache file of the matrix file, unless the file changed.
+     */
+    uint64_t l_source_hash = 0;
+    std::string l_cache_variant = l_symmetric_half ? "CSR_HALF" : "CSR";
+    vrp_matrix_file_t * l_cached_matrices = NULL;
+    bool l_cached_roles[VRP_MATRIX_FILE_NB_ROLES] = { true, l_transposed_needed, false, false };
+
+    if ( l_cache_directory != NULL ) {
+        l_source_hash = VRP_Matrix_file::hashFile(l_matrix_file_path);
+        l_cached_matrices = mapCachedMatrices(VRP_Matrix_file::getCachePath(l_cache_directory, l_source_hash, l_cache_variant.c_str()).c_str(), l_source_hash, l_cached_roles);
     }
-    matrix_t l_sparse_input_matrix = VPFloatPackage::OSKIHelper::toMatrix(l_oski_sparse_input_matrix);
 
-    oski_matrix_wrapper_t l_oski_sparse_input_matrix_transposed = VPFloatPackage::OSKIHelper::transpose(l_oski_sparse_input_matrix);
-    matrix_t l_sparse_input_matrix_transposed = VPFloatPackage::OSKIHelper::toMatrix(l_oski_sparse_input_matrix_transposed);
+    if ( l_cached_matrices != NULL ) {
+        l_sparse_input_matrix = VRP_Matrix_file::getMatrix(l_cached_matrices, VRP_MATRIX_FILE_A);
+        l_oski_sparse_input_matrix = VPFloatPackage::OSKIHelper::fromCSRMatrix(l_sparse_input_matrix);
+
+        if ( l_transposed_needed ) {
+            l_sparse_input_matrix_transposed = VRP_Matrix_file::getMatrix(l_cached_matrices, VRP_MATRIX_FILE_A_TRANSPOSED);
+            l_oski_sparse_input_matrix_transposed = VPFloatPackage::OSKIHelper::fromCSRMatrix(l_sparse_input_matrix_transposed);
+        }
+    } else {
+        l_oski_sparse_input_matrix = VPFloatPackage::OSKIHelper::loadFromFile(l_matrix_file_path, l_symmetric_half);
+
+        if ( l_oski_sparse_input_matrix.oski_matrix.real_matrix == NULL && l_oski_sparse_input_matrix.oski_matrix.complex_matrix == NULL) {
+            printf("Fail parsing matrix.\n");
+            exit(1);
+        }
+        l_sparse_input_matrix = VPFloatPackage::OSKIHelper::toMatrix(l_oski_sparse_input_matrix);
+
+        if ( l_transposed_needed ) {
+            l_oski_sparse_input_matrix_transposed = VPFloatPackage::OSKIHelper::transpose(l_oski_sparse_input_matrix);
+            l_sparse_input_matrix_transposed = VPFloatPackage::OSKIHelper::toMatrix(l_oski_sparse_input_matrix_transposed);
+        }
+
+        if ( ( l_cache_directory != NULL ) && ( l_source_hash != 0 ) && ( l_sparse_input_matrix->type_value == REAL_VALUE ) ) {
+            matrix_t l_matrices[VRP_MATRIX_FILE_NB_ROLES] = { l_sparse_input_matrix, l_sparse_input_matrix_transposed, NULL, NULL };
+
+            VRP_Matrix_file::save(VRP_Matrix_file::getCachePath(l_cache_directory, l_source_hash, l_cache_variant.c_str()).c_str(), l_source_hash, l_matrices);
+        }
+    }
+
+    /*
+     * The solvers work on the reordered matrices P A P^T and P A^T P^T, and permute B and X with P.
+     */
+    int * l_permutation = NULL;
+
+    if ( l_reordering != NULL ) {
+        int l_nb_parts = 0;
+
+        if ( ! l_sparse_flag ) {
+            printf("-R option can only be used with sparse matrices (-s option).\n");
+            exit(1);
+        }
+
+        if ( strcmp(l_reordering, "rcm") == 0 ) {
+            l_permutation = reorderRCM(l_sparse_input_matrix);
+            l_cache_variant += "-RCM";
+        } else if ( sscanf(l_reordering, "partition:%d", &l_nb_parts) == 1 ) {
+            l_permutation = reorderPartition(l_sparse_input_matrix, l_nb_parts);
+            l_cache_variant += "-PARTITION" + std::to_string(l_nb_parts);
+        } else {
+            printf("Unknown reordering %s.\n", l_reordering);
+            usage(-1);
+        }
+
+        if ( l_permutation == NULL ) {
+            printf("Fail reordering matrix.\n");
+            exit(1);
+        }
+
+        int l_bandwidth = getCSRBandwidth(l_sparse_input_matrix);
+
+        l_sparse_input_matrix = permuteCSR(l_sparse_input_matrix, l_permutation);
+        l_oski_sparse_input_matrix = VPFloatPackage::OSKIHelper::fromCSRMatrix(l_sparse_input_matrix);
+
+        if ( l_sparse_input_matrix_transposed != NULL ) {
+            l_sparse_input_matrix_transposed = permuteCSR(l_sparse_input_matrix_transposed, l_permutation);
+            l_oski_sparse_input_matrix_transposed = VPFloatPackage::OSKIHelper::fromCSRMatrix(l_sparse_input_matrix_transposed);
+        }
+
+        printf("===== Matrix reordered with %s, bandwidth %d -> %d.\n", l_reordering, l_bandwidth, getCSRBandwidth(l_sparse_input_matrix));
+    }
+
+    /*
+     * With -A, the format recommended by the structure analysis replaces the -s and -b options.
+     */
+    if ( l_profile_file_path != NULL ) {
+        matrix_profile_t l_profile;
+        size_t l_x_element_size = ( l_precision + l_exponent_size + l_stride_size + 7 ) / 8;
+
+        if ( analyzeMatrix(l_sparse_input_matrix, l_x_element_size, &l_profile) != 0 ) {
+            printf("Fail analyzing matrix.\n");
+            exit(1);
+        }
+
+        FILE * l_profile_file = fopen(l_profile_file_path, "w");
+
+        if ( l_profile_file == NULL ) {
+            printf("Fail opening %s.\n", l_profile_file_path);
+            exit(1);
+        }
+        writeMatrixProfileJSON(&l_profile, l_profile_file);
+        fclose(l_profile_file);
+
+        l_sparse_flag = ( l_profile.recommended_format != DENSE );
+        l_bcsr_auto_tuning = false;
+        l_bcsr_block_row_size = l_profile.recommended_block_row_size;
+        l_bcsr_block_col_size = l_profile.recommended_block_col_size;
+        l_sell_chunk_size = l_profile.recommended_chunk_size;
+        l_sell_sort_window = l_profile.recommended_sort_window;
+
+        // The DENSE solvers always use A^T
+        if ( ! l_sparse_flag && l_sparse_input_matrix_transposed == NULL ) {
+            l_oski_sparse_input_matrix_transposed = VPFloatPackage::OSKIHelper::transpose(l_oski_sparse_input_matrix);
+            l_sparse_input_matrix_transposed = VPFloatPackage::OSKIHelper::toMatrix(l_oski_sparse_input_matrix_transposed);
+        }
+
+        printf("===== Matrix profile written to %s, %.3f bytes per flop in CSR, %s format used.\n",
+            l_profile_file_path,
+            l_profile.csr_bytes_per_flop,
+            ! l_sparse_flag ? "DENSE" : ( l_bcsr_block_row_size != 0 ) ? "BCSR" : ( l_sell_chunk_size != 0 ) ? "SELL" : "CSR");
+    }
+
+    if ( l_bcsr_auto_tuning && l_sparse_flag ) {
+        bcsr_benchmark_args_t l_benchmark_args;
+        l_benchmark_args.precision = l_precision;
+        l_benchmark_args.exponent_size = l_exponent_size;
+        l_benchmark_args.stride_size = l_stride_size;
+        l_benchmark_args.nb_repetitions = 5;
+
+        // 96 is a multiple of every block size up to 8 except 5 and 7
+        bcsr_profile_t l_bcsr_profile = VPFloatPackage::OSKIHelper::benchmarkBCSR(OSKIHELPER_BCSR_MAX_BLOCK_SIZE, OSKIHELPER_BCSR_MAX_BLOCK_SIZE, 96, benchmarkBCSRProduct, &l_benchmark_args);
+
+        double l_cost = VPFloatPackage::OSKIHelper::tuneBCSR(l_oski_sparse_input_matrix, l_bcsr_profile, &l_bcsr_block_row_size, &l_bcsr_block_col_size);
+
+        printf("===== BCSR block size set to %dx%d (estimated fill %.3f, %le s per non zero value).\n",
+            l_bcsr_block_row_size,
+            l_bcsr_block_col_size,
+            VPFloatPackage::OSKIHelper::estimateBCSRFill(l_oski_sparse_input_matrix, l_bcsr_block_row_size, l_bcsr_block_col_size),
+            l_cost);
+    }
+
+    /*
+     * BCSR, SELL or DENSE conversions used by the solvers. CG and GMRES solvers only use the matrix of the solved
+     * system.
+     */
+    bool l_single_matrix_solver = ( strcmp(l_solver_name, "CG") == 0 ) || ( strcmp(l_solver_name, "PIPECG") == 0 ) || ( strcmp(l_solver_name, "PRECOND_CG") == 0 ) ||
+                                  ( strcmp(l_solver_name, "GMRES") == 0 ) || ( strcmp(l_solver_name, "FGMRES") == 0 ) || ( strcmp(l_solver_name, "BLOCK_CG") == 0 );
+    matrix_t l_converted_input_matrix = NULL;
+    matrix_t l_converted_input_matrix_transposed = NULL;
+    vrp_matrix_file_t * l_cached_converted_matrices = NULL;
+    bool l_converted_sparse_format = l_sparse_flag && ( ( l_bcsr_block_row_size != 0 ) || ( l_sell_chunk_size != 0 ) );
+
+    if ( ( ! l_sparse_flag ) || l_converted_sparse_format ) {
+        char l_conversion_variant[64];
+        bool l_converted_roles[VRP_MATRIX_FILE_NB_ROLES] = {
+            ( l_transpose == 0 ) || ( ! l_single_matrix_solver ),
+            ( l_sparse_input_matrix_transposed != NULL ) && ( ( l_transpose == 1 ) || ( ! l_single_matrix_solver ) ),
+            false,
+            false
+        };
+
+        if ( l_sparse_flag && ( l_bcsr_block_row_size != 0 ) ) {
+            snprintf(l_conversion_variant, sizeof(l_conversion_variant), "%s-BCSR%dx%d", l_cache_variant.c_str(), l_bcsr_block_row_size, l_bcsr_block_col_size);
+        } else if ( l_sparse_flag ) {
+            snprintf(l_conversion_variant, sizeof(l_conversion_variant), "%s-SELL%dx%d", l_cache_variant.c_str(), l_sell_chunk_size, l_sell_sort_window);
+        } else {
+            snprintf(l_conversion_variant, sizeof(l_conversion_variant), "%s-DENSE%d", l_cache_variant.c_str(), l_lda);
+        }
+
+        if ( l_source_hash != 0 ) {
+            l_cached_converted_matrices = mapCachedMatrices(VRP_Matrix_file::getCachePath(l_cache_directory, l_source_hash, l_conversion_variant).c_str(), l_source_hash, l_converted_roles);
+        }
+
+        if ( l_cached_converted_matrices != NULL ) {
+            l_converted_input_matrix = VRP_Matrix_file::getMatrix(l_cached_converted_matrices, VRP_MATRIX_FILE_A);
+            l_converted_input_matrix_transposed = VRP_Matrix_file::getMatrix(l_cached_converted_matrices, VRP_MATRIX_FILE_A_TRANSPOSED);
+        } else {
+            if ( l_converted_roles[VRP_MATRIX_FILE_A] ) {
+                l_converted_input_matrix = convertMatrix(l_oski_sparse_input_matrix, l_sparse_input_matrix, l_sparse_flag ? l_bcsr_block_row_size : 0, l_bcsr_block_col_size, l_sparse_flag ? l_sell_chunk_size : 0, l_sell_sort_window, l_lda);
+            }
+
+            if ( l_converted_roles[VRP_MATRIX_FILE_A_TRANSPOSED] ) {
+                l_converted_input_matrix_transposed = convertMatrix(l_oski_sparse_input_matrix_transposed, l_sparse_input_matrix_transposed, l_sparse_flag ? l_bcsr_block_row_size : 0, l_bcsr_block_col_size, l_sparse_flag ? l_sell_chunk_size : 0, l_sell_sort_window, l_lda);
+            }
+
+            if ( l_source_hash != 0 ) {
+                matrix_t l_matrices[VRP_MATRIX_FILE_NB_ROLES] = { l_converted_input_matrix, l_converted_input_matrix_transposed, NULL, NULL };
+
+                VRP_Matrix_file::save(VRP_Matrix_file::getCachePath(l_cache_directory, l_source_hash, l_conversion_variant).c_str(), l_source_hash, l_matrices);
+            }
+        }
+    }
 
     if ( l_log_buffer_size > 0 ) {
         l_log_buffer = (char *)malloc(sizeof(char) * l_log_buffer_size);
         memset(l_log_buffer, 0, sizeof(char) *l_log_buffer_size);
     }
 
-    double * X = (double *)malloc(sizeof(double) * l_sparse_input_matrix->n);
-    memset(X, 0, sizeof(double) * l_sparse_input_matrix->n);
+    /* X and B hold l_nb_rhs vectors stored contiguously */
+    double * X = (double *)malloc(sizeof(double) * l_sparse_input_matrix->n * l_nb_rhs);
+    memset(X, 0, sizeof(double) * l_sparse_input_matrix->n * l_nb_rhs);
 
     /* Using the right B vector if specified */
     double * B = NULL;
     if ( l_B_matrix_file_path == NULL ) {
         std::cout << "Use automatically generated B vector." << std::endl;
-        B = (double *)malloc(sizeof(double) * l_sparse_input_matrix->n);
-        memset(B, 0, sizeof(double) * l_sparse_input_matrix->n);
+        B = (double *)malloc(sizeof(double) * l_sparse_input_matrix->n * l_nb_rhs);
+        memset(B, 0, sizeof(double) * l_sparse_input_matrix->n * l_nb_rhs);
 
-        initB(B, l_sparse_input_matrix->n);
-    } else {
+        initBlockB(B, l_sparse_input_matrix->n, l_nb_rhs);
+    } else if ( l_nb_rhs == 1 ) {
         std::cout << "Use B vector loaded from file." << std::endl;
         l_oski_B_input_matrix = VPFloatPackage::OSKIHelper::loadFromFile(l_B_matrix_file_path);
         l_B_matrix_loaded_from_file = VPFloatPackage::OSKIHelper::toDense(l_oski_B_input_matrix, false, 0);
         B = ((dmatDENSE_t)l_B_matrix_loaded_from_file->matrix->repr)->val;
+    } else {
+        std::cout << "Use B vectors loaded from file." << std::endl;
+        l_oski_B_input_matrix = VPFloatPackage::OSKIHelper::loadFromFile(l_B_matrix_file_path);
+        // Transposed with a leading dimension of n: the columns of the file are stored contiguously
+        l_B_matrix_loaded_from_file = VPFloatPackage::OSKIHelper::toDense(l_oski_B_input_matrix, true, l_sparse_input_matrix->n);
+        B = ((dmatDENSE_t)l_B_matrix_loaded_from_file->matrix->repr)->val;
+
+        if ( ( l_B_matrix_loaded_from_file->n != l_sparse_input_matrix->n ) || ( l_B_matrix_loaded_from_file->m != l_nb_rhs ) ) {
+            printf("B file must hold %d columns of %d elements.\n", l_nb_rhs, l_sparse_input_matrix->n);
+            exit(1);
+        }
     }
     
-    if  ( l_sparse_flag ) {
+    // PIPECG takes the arguments of CG
+    decltype(&cg) l_cg_solver = ( strcmp(l_solver_name, "PIPECG") == 0 ) ? pipecg : cg;
+
+    if ( ( l_nb_rhs > 1 ) || ( strcmp(l_solver_name, "BLOCK_CG") == 0 ) ) {
+        /*
+         * Multiple right hand sides, on the matrices used by the solvers below
+         */
+        bool l_csr_solver_matrices = l_sparse_flag && ! l_converted_sparse_format;
+        matrix_t l_solver_matrix = l_csr_solver_matrices ? l_sparse_input_matrix : l_converted_input_matrix;
+        matrix_t l_solver_matrix_transposed = l_csr_solver_matrices ? l_sparse_input_matrix_transposed : l_converted_input_matrix_transposed;
+        decltype(&cg_multi) l_multi_solver = ( strcmp(l_solver_name, "BLOCK_CG") == 0 ) ? block_cg : cg_multi;
+
+        if ( ( strcmp(l_solver_name, "CG") != 0 ) && ( strcmp(l_solver_name, "BLOCK_CG") != 0 ) ) {
+            printf("Solver %s is not supported with multiple right hand sides.\n", l_solver_name);
+            exit(1);
+        }
+
+        if ( ( l_inner_precision != 0 ) || l_adaptive_precision ) {
+            printf("Multiple right hand sides can not be used with the -i and -v options.\n");
+            exit(1);
+        }
+
+        l_rc = l_multi_solver(l_precision,
+                              l_transpose,
+                              l_sparse_input_matrix->n,
+                              l_nb_rhs,
+                              X,
+                              l_transpose == 1 ? l_solver_matrix_transposed : l_solver_matrix,
+                              B,
+                              l_tolerance,
+                              l_exponent_size,
+                              l_stride_size,
+                              l_log_buffer,
+                              l_log_buffer_size,
+                              l_permutation);
+    } else if ( l_inner_precision != 0 ) {
+        /*
+         * Mixed precision iterative refinement, on the matrices used by the solvers below
+         */
+        refinement_solver_e l_inner_solver = REFINEMENT_CG;
+        bool l_csr_solver_matrices = l_sparse_flag && ! l_converted_sparse_format;
+        matrix_t l_solver_matrix = l_csr_solver_matrices ? l_sparse_input_matrix : l_converted_input_matrix;
+        matrix_t l_solver_matrix_transposed = l_csr_solver_matrices ? l_sparse_input_matrix_transposed : l_converted_input_matrix_transposed;
+
+        if ( strcmp(l_solver_name, "BICGSTAB") == 0 ) {
+            l_inner_solver = REFINEMENT_BICGSTAB;
+        } else if ( strcmp(l_solver_name, "QMR") == 0 ) {
+            l_inner_solver = REFINEMENT_QMR;
+        } else if ( strcmp(l_solver_name, "CG") != 0 ) {
+            printf("Solver %s is not supported by the iterative refinement.\n", l_solver_name);
+            exit(1);
+        }
+
+        l_rc = refine(l_inner_solver,
+                      l_precision,
+                      l_inner_precision,
+                      l_transpose,
+                      l_sparse_input_matrix->n,
+                      X,
+                      l_transpose == 1 ? l_solver_matrix_transposed : l_solver_matrix,
+                      l_transpose == 1 ? l_solver_matrix : l_solver_matrix_transposed,
+                      B,
+                      l_tolerance,
+                      1e-6,
+                      50,
+                      l_exponent_size,
+                      l_stride_size,
+                      l_permutation);
+    } else if ( l_adaptive_precision ) {
+        /*
+         * Adaptive precision CG, on the matrices used by the solvers below
+         */
+        bool l_csr_solver_matrices = l_sparse_flag && ! l_converted_sparse_format;
+        matrix_t l_solver_matrix = l_csr_solver_matrices ? l_sparse_input_matrix : l_converted_input_matrix;
+        matrix_t l_solver_matrix_transposed = l_csr_solver_matrices ? l_sparse_input_matrix_transposed : l_converted_input_matrix_transposed;
+
+        if ( strcmp(l_solver_name, "CG") != 0 ) {
+            printf("Solver %s is not supported by the adaptive precision.\n", l_solver_name);
+            exit(1);
+        }
+
+        l_rc = cg_adaptive(l_precision,
+                           l_initial_precision,
+                           l_transpose,
+                           l_sparse_input_matrix->n,
+                           X,
+                           l_transpose == 1 ? l_solver_matrix_transposed : l_solver_matrix,
+                           B,
+                           l_tolerance,
+                           l_exponent_size,
+                           l_stride_size,
+                           l_log_buffer,
+                           l_log_buffer_size,
+                           l_permutation);
+    } else if  ( l_sparse_flag ) {
         /*
          * SPARSE version of solvers
          */
         if (strcmp(l_solver_name, "BICG") == 0 || strcmp(l_solver_name, "BICGSTAB") == 0 || strcmp(l_solver_name, "PRECOND_BICG") == 0 ) {          
-            if ( l_bcsr_sparse_block_size != 0) {
-                matrix_t l_bcsr_input_matrix = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
-                matrix_t l_bcsr_input_matrix_transposed = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix_transposed, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
+            if ( l_converted_sparse_format ) {
+                matrix_t l_bcsr_input_matrix = l_converted_input_matrix;
+                matrix_t l_bcsr_input_matrix_transposed = l_converted_input_matrix_transposed;
 
                 if (strcmp(l_solver_name, "BICG") == 0) {
                     l_rc = bicg(l_precision,
@@ -220,7 +701,8 @@ int main(int argc, char ** argv) {
                                 l_exponent_size, 
                                 l_stride_size, 
                                 l_log_buffer, 
-                                l_log_buffer_size);
+                                l_log_buffer_size,
+                                l_permutation);
                 } else if (strcmp(l_solver_name, "BICGSTAB") == 0) {
                     l_rc = bicgstab(l_precision, 
                                     l_transpose,
@@ -233,10 +715,11 @@ int main(int argc, char ** argv) {
                                     l_exponent_size, 
                                     l_stride_size, 
                                     l_log_buffer, 
-                                    l_log_buffer_size);
+                                    l_log_buffer_size,
+                                    l_permutation);
                 } else {
                     if ( l_transpose == 1 ) {
-                        matrix_t l_bcsr_input_matrix_transposed = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix_transposed, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
+                        matrix_t l_bcsr_input_matrix_transposed = l_converted_input_matrix_transposed;
                         matrix_t l_iM_transposed = jacobi(l_sparse_input_matrix_transposed, l_jacobi_shifter);
 
                         l_rc = precond_bicg(l_precision,
@@ -251,9 +734,10 @@ int main(int argc, char ** argv) {
                                             l_exponent_size, 
                                             l_stride_size, 
                                             l_log_buffer, 
-                                            l_log_buffer_size);
+                                            l_log_buffer_size,
+                                            l_permutation);
                     } else {
-                        matrix_t l_bcsr_input_matrix = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
+                        matrix_t l_bcsr_input_matrix = l_converted_input_matrix;
                         matrix_t l_iM = jacobi(l_sparse_input_matrix, l_jacobi_shifter);
                         
                         l_rc = precond_bicg(l_precision,
@@ -268,7 +752,8 @@ int main(int argc, char ** argv) {
                                             l_exponent_size, 
                                             l_stride_size, 
                                             l_log_buffer, 
-                                            l_log_buffer_size);
+                                            l_log_buffer_size,
+                                            l_permutation);
                     }
                 }
 
@@ -285,7 +770,8 @@ int main(int argc, char ** argv) {
                                 l_exponent_size, 
                                 l_stride_size, 
                                 l_log_buffer, 
-                                l_log_buffer_size);
+                                l_log_buffer_size,
+                                l_permutation);
                 } else if (strcmp(l_solver_name, "BICGSTAB") == 0) {
                     l_rc = bicgstab(l_precision,
                                 l_transpose,
@@ -298,7 +784,8 @@ int main(int argc, char ** argv) {
                                 l_exponent_size, 
                                 l_stride_size, 
                                 l_log_buffer, 
-                                l_log_buffer_size);
+                                l_log_buffer_size,
+                                l_permutation);
                 } else {
                     if ( l_transpose == 1 ) {
                         matrix_t l_iM_transposed = jacobi(l_sparse_input_matrix_transposed, l_jacobi_shifter);
@@ -315,7 +802,8 @@ int main(int argc, char ** argv) {
                                             l_exponent_size, 
                                             l_stride_size, 
                                             l_log_buffer, 
-                                            l_log_buffer_size);
+                                            l_log_buffer_size,
+                                            l_permutation);
                     } else {
                         matrix_t l_iM = jacobi(l_sparse_input_matrix, l_jacobi_shifter);
 
@@ -331,16 +819,17 @@ int main(int argc, char ** argv) {
                                             l_exponent_size, 
                                             l_stride_size, 
                                             l_log_buffer, 
-                                            l_log_buffer_size);
+                                            l_log_buffer_size,
+                                            l_permutation);
                     }
                 }
             }
-        } else if (strcmp(l_solver_name, "CG") == 0) {
+        } else if (strcmp(l_solver_name, "CG") == 0 || strcmp(l_solver_name, "PIPECG") == 0) {
             
-            if ( l_bcsr_sparse_block_size != 0) {
+            if ( l_converted_sparse_format ) {
                 if ( l_transpose == 1 ) {
-                    matrix_t l_bcsr_input_matrix_transposed = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix_transposed, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
-                    l_rc = cg(  l_precision,
+                    matrix_t l_bcsr_input_matrix_transposed = l_converted_input_matrix_transposed;
+                    l_rc = l_cg_solver(  l_precision,
                             l_transpose, 
                             l_sparse_input_matrix_transposed->n, 
                             X, 
@@ -350,10 +839,11 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size,
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
                 } else {
-                    matrix_t l_bcsr_input_matrix = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
-                    l_rc = cg(  l_precision,
+                    matrix_t l_bcsr_input_matrix = l_converted_input_matrix;
+                    l_rc = l_cg_solver(  l_precision,
                             l_transpose, 
                             l_sparse_input_matrix->n, 
                             X, 
@@ -363,10 +853,11 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size,
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
                 }
             } else {
-                l_rc = cg(  l_precision, 
+                l_rc = l_cg_solver(  l_precision, 
                             l_transpose,
                             l_transpose == 1 ? l_sparse_input_matrix_transposed->n : l_sparse_input_matrix->n, 
                             X, 
@@ -376,14 +867,15 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size,
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
             }
         } else if(strcmp(l_solver_name, "PRECOND_CG") == 0) {
 
-            if ( l_bcsr_sparse_block_size != 0) {
+            if ( l_converted_sparse_format ) {
 
                 if ( l_transpose == 1 ) {
-                    matrix_t l_bcsr_input_matrix_transposed = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix_transposed, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
+                    matrix_t l_bcsr_input_matrix_transposed = l_converted_input_matrix_transposed;
                     matrix_t l_iM_transposed = jacobi(l_sparse_input_matrix_transposed, l_jacobi_shifter);
 
                     l_rc = precond_cg(  l_precision,
@@ -397,9 +889,10 @@ int main(int argc, char ** argv) {
                                         l_exponent_size, 
                                         l_stride_size,
                                         l_log_buffer, 
-                                        l_log_buffer_size);
+                                        l_log_buffer_size,
+                                        l_permutation);
                 } else {
-                    matrix_t l_bcsr_input_matrix = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
+                    matrix_t l_bcsr_input_matrix = l_converted_input_matrix;
                     matrix_t l_iM = jacobi(l_sparse_input_matrix, l_jacobi_shifter);
 
                     l_rc = precond_cg(  l_precision,
@@ -413,7 +906,8 @@ int main(int argc, char ** argv) {
                                         l_exponent_size, 
                                         l_stride_size,
                                         l_log_buffer, 
-                                        l_log_buffer_size);
+                                        l_log_buffer_size,
+                                        l_permutation);
                 }
             } else {
                 if ( l_transpose == 1 ) {
@@ -430,7 +924,8 @@ int main(int argc, char ** argv) {
                                         l_exponent_size, 
                                         l_stride_size,
                                         l_log_buffer, 
-                                        l_log_buffer_size);
+                                        l_log_buffer_size,
+                                        l_permutation);
                 } else {
                     matrix_t l_iM = jacobi(l_sparse_input_matrix, l_jacobi_shifter);
 
@@ -445,13 +940,50 @@ int main(int argc, char ** argv) {
                                         l_exponent_size, 
                                         l_stride_size,
                                         l_log_buffer, 
-                                        l_log_buffer_size);
+                                        l_log_buffer_size,
+                                        l_permutation);
                 }
             }
+        } else if (strcmp(l_solver_name, "GMRES") == 0 || strcmp(l_solver_name, "FGMRES") == 0) {
+            matrix_t l_solver_matrix = l_converted_sparse_format ? l_converted_input_matrix : l_sparse_input_matrix;
+            matrix_t l_solver_matrix_transposed = l_converted_sparse_format ? l_converted_input_matrix_transposed : l_sparse_input_matrix_transposed;
+
+            if (strcmp(l_solver_name, "GMRES") == 0) {
+                l_rc = gmres(   l_precision,
+                                l_transpose,
+                                l_sparse_input_matrix->n,
+                                X,
+                                l_transpose == 1 ? l_solver_matrix_transposed : l_solver_matrix,
+                                B,
+                                l_tolerance,
+                                l_restart,
+                                l_exponent_size,
+                                l_stride_size,
+                                l_log_buffer,
+                                l_log_buffer_size,
+                                l_permutation);
+            } else {
+                matrix_t l_iM = jacobi(l_transpose == 1 ? l_sparse_input_matrix_transposed : l_sparse_input_matrix, l_jacobi_shifter);
+
+                l_rc = fgmres(  l_precision,
+                                l_transpose,
+                                l_sparse_input_matrix->n,
+                                X,
+                                l_transpose == 1 ? l_solver_matrix_transposed : l_solver_matrix,
+                                l_iM,
+                                B,
+                                l_tolerance,
+                                l_restart,
+                                l_exponent_size,
+                                l_stride_size,
+                                l_log_buffer,
+                                l_log_buffer_size,
+                                l_permutation);
+            }
         } else if (strcmp(l_solver_name, "QMR") == 0) {            
-            if ( l_bcsr_sparse_block_size != 0) {
-                matrix_t l_bcsr_input_matrix = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
-                matrix_t l_bcsr_input_matrix_transposed = VPFloatPackage::OSKIHelper::toBCSR(l_oski_sparse_input_matrix_transposed, l_bcsr_sparse_block_size, l_bcsr_sparse_block_size);
+            if ( l_converted_sparse_format ) {
+                matrix_t l_bcsr_input_matrix = l_converted_input_matrix;
+                matrix_t l_bcsr_input_matrix_transposed = l_converted_input_matrix_transposed;
 
                 l_rc = qmr(l_precision,
                             l_transpose,
@@ -464,7 +996,8 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size, 
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
             } else {
                 l_rc = qmr(l_precision,
                             l_transpose,
@@ -477,7 +1010,8 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size, 
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
             }
         } else {
             printf("Solver %s is not supported.\n", l_solver_name);
@@ -488,10 +1022,10 @@ int main(int argc, char ** argv) {
         /*
          * DENSE version of solvers
          */
-        matrix_t l_dense_input_matrix = VPFloatPackage::OSKIHelper::toDense(l_oski_sparse_input_matrix, false, l_lda);
+        matrix_t l_dense_input_matrix = l_converted_input_matrix;
 
         if ( strcmp(l_solver_name, "BICG") == 0 || strcmp(l_solver_name, "BICGSTAB") == 0 || strcmp(l_solver_name, "PRECOND_BICG") == 0) {
-            matrix_t l_dense_input_matrix_transposed = VPFloatPackage::OSKIHelper::toDense(l_oski_sparse_input_matrix_transposed, false, l_lda);
+            matrix_t l_dense_input_matrix_transposed = l_converted_input_matrix_transposed;
             if ( strcmp(l_solver_name, "BICG") == 0 ) {
                 l_rc = bicg(l_precision, 
                             l_transpose,
@@ -504,7 +1038,8 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size, 
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
             } else if ( strcmp(l_solver_name, "BICGSTAB") == 0 ) {
                 l_rc = bicgstab(l_precision, 
                                 l_transpose,
@@ -517,7 +1052,8 @@ int main(int argc, char ** argv) {
                                 l_exponent_size, 
                                 l_stride_size, 
                                 l_log_buffer, 
-                                l_log_buffer_size);
+                                l_log_buffer_size,
+                                l_permutation);
             } else {
                 if ( l_transpose == 1 ) {
                     matrix_t l_sparse_iM_transposed = jacobi(l_sparse_input_matrix_transposed, l_jacobi_shifter);
@@ -536,7 +1072,8 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size, 
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
                 } else {
                         matrix_t l_sparse_iM = jacobi(l_sparse_input_matrix, l_jacobi_shifter);
                         oski_matrix_wrapper_t l_oski_sparse_iM = VPFloatPackage::OSKIHelper::fromCSRMatrix(l_sparse_iM);
@@ -554,14 +1091,15 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size, 
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
                 }
             }
 
-        } else if (strcmp(l_solver_name, "CG") == 0) {
+        } else if (strcmp(l_solver_name, "CG") == 0 || strcmp(l_solver_name, "PIPECG") == 0) {
             if ( l_transpose == 1 ) { 
-                matrix_t l_dense_input_matrix_transposed = VPFloatPackage::OSKIHelper::toDense(l_oski_sparse_input_matrix_transposed, false, l_lda);
-                l_rc = cg(  l_precision, 
+                matrix_t l_dense_input_matrix_transposed = l_converted_input_matrix_transposed;
+                l_rc = l_cg_solver(  l_precision, 
                             l_transpose,
                             l_sparse_input_matrix_transposed->n, 
                             X, 
@@ -571,9 +1109,10 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size, 
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
             } else {
-                l_rc = cg(  l_precision, 
+                l_rc = l_cg_solver(  l_precision, 
                             l_transpose,
                             l_sparse_input_matrix->n, 
                             X, 
@@ -583,13 +1122,14 @@ int main(int argc, char ** argv) {
                             l_exponent_size, 
                             l_stride_size, 
                             l_log_buffer, 
-                            l_log_buffer_size);
+                            l_log_buffer_size,
+                            l_permutation);
             }
 
         } else if (strcmp(l_solver_name, "PRECOND_CG") == 0) {
 
                 if ( l_transpose == 1 ) {
-                    matrix_t l_dense_input_matrix_transposed = VPFloatPackage::OSKIHelper::toDense(l_oski_sparse_input_matrix_transposed, false, l_lda);
+                    matrix_t l_dense_input_matrix_transposed = l_converted_input_matrix_transposed;
                     matrix_t l_sparse_iM_transposed = jacobi(l_sparse_input_matrix_transposed, l_jacobi_shifter);
                     oski_matrix_wrapper_t l_oski_sparse_iM_transposed = VPFloatPackage::OSKIHelper::fromCSRMatrix(l_sparse_iM_transposed);
                     matrix_t l_dense_iM_transposed = VPFloatPackage::OSKIHelper::toDense(l_oski_sparse_iM_transposed, false, l_lda);
@@ -605,7 +1145,8 @@ int main(int argc, char ** argv) {
                                         l_exponent_size, 
                                         l_stride_size,
                                         l_log_buffer, 
-                                        l_log_buffer_size);
+                                        l_log_buffer_size,
+                                        l_permutation);
                 } else {
                     matrix_t l_sparse_iM = jacobi(l_sparse_input_matrix, l_jacobi_shifter);
                     oski_matrix_wrapper_t l_oski_sparse_iM = VPFloatPackage::OSKIHelper::fromCSRMatrix(l_sparse_iM);
@@ -622,10 +1163,48 @@ int main(int argc, char ** argv) {
                                         l_exponent_size, 
                                         l_stride_size,
                                         l_log_buffer, 
-                                        l_log_buffer_size);
+                                        l_log_buffer_size,
+                                        l_permutation);
                 } 
+        } else if ( strcmp(l_solver_name, "GMRES") == 0 || strcmp(l_solver_name, "FGMRES") == 0 ) {
+            matrix_t l_dense_input_matrix_transposed = l_converted_input_matrix_transposed;
+
+            if ( strcmp(l_solver_name, "GMRES") == 0 ) {
+                l_rc = gmres(   l_precision,
+                                l_transpose,
+                                l_sparse_input_matrix->n,
+                                X,
+                                l_transpose == 1 ? l_dense_input_matrix_transposed : l_dense_input_matrix,
+                                B,
+                                l_tolerance,
+                                l_restart,
+                                l_exponent_size,
+                                l_stride_size,
+                                l_log_buffer,
+                                l_log_buffer_size,
+                                l_permutation);
+            } else {
+                matrix_t l_sparse_iM = jacobi(l_transpose == 1 ? l_sparse_input_matrix_transposed : l_sparse_input_matrix, l_jacobi_shifter);
+                oski_matrix_wrapper_t l_oski_sparse_iM = VPFloatPackage::OSKIHelper::fromCSRMatrix(l_sparse_iM);
+                matrix_t l_dense_iM = VPFloatPackage::OSKIHelper::toDense(l_oski_sparse_iM, false, l_lda);
+
+                l_rc = fgmres(  l_precision,
+                                l_transpose,
+                                l_sparse_input_matrix->n,
+                                X,
+                                l_transpose == 1 ? l_dense_input_matrix_transposed : l_dense_input_matrix,
+                                l_dense_iM,
+                                B,
+                                l_tolerance,
+                                l_restart,
+                                l_exponent_size,
+                                l_stride_size,
+                                l_log_buffer,
+                                l_log_buffer_size,
+                                l_permutation);
+            }
         } else if ( strcmp(l_solver_name, "QMR") == 0 ) {
-            matrix_t l_dense_input_matrix_transposed = VPFloatPackage::OSKIHelper::toDense(l_oski_sparse_input_matrix_transposed, false, l_lda);
+            matrix_t l_dense_input_matrix_transposed = l_converted_input_matrix_transposed;
 
             l_rc = qmr( l_precision,
                         l_transpose,
@@ -638,7 +1217,8 @@ int main(int argc, char ** argv) {
                         l_exponent_size, 
                         l_stride_size, 
                         l_log_buffer, 
-                        l_log_buffer_size);
+                        l_log_buffer_size,
+                        l_permutation);
         } else {
             printf("Solver %s is not supported.\n", l_solver_name);
             exit(1);
@@ -666,6 +1246,13 @@ int main(int argc, char ** argv) {
     free(B);
     free(l_solver_name);
     free(l_matrix_file_path);
-    freeMatrix(l_sparse_input_matrix);
+    free(l_permutation);
+
+    if ( l_cached_matrices != NULL ) {
+        VRP_Matrix_file::unmap(l_cached_matrices);
+    } else {
+        freeMatrix(l_sparse_input_matrix);
+    }
+    VRP_Matrix_file::unmap(l_cached_converted_matrices);
     return l_rc;
 }